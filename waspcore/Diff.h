@@ -0,0 +1,255 @@
+#ifndef WASP_DIFF_H
+#define WASP_DIFF_H
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The DiffEdit struct describes a single edit transforming one
+ * document's tree into another's
+ * The 'a' members describe the node of the original document, the 'b' members
+ * the node of the revised document. Deleted nodes have no 'b' node and
+ * inserted nodes have no 'a' node, whose indices are npos.
+ */
+struct WASP_PUBLIC DiffEdit
+{
+    enum Type
+    {
+        INSERTED,
+        DELETED,
+        UPDATED
+    };
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    Type        type;
+    /**
+     * @brief path the path of the edited node, of the revised document's node
+     * unless the node was deleted
+     */
+    std::string path;
+    std::size_t a_node_index = npos;
+    std::size_t a_line       = 0;
+    std::size_t a_column     = 0;
+    std::string a_data;
+    std::size_t b_node_index = npos;
+    std::size_t b_line       = 0;
+    std::size_t b_column     = 0;
+    std::string b_data;
+};
+
+/**
+ * @brief operator << print an edit as a single line,
+ * e.g., 'updated /object/x at 3.5 -> 3.7 (1 -> 2)'
+ */
+inline WASP_PUBLIC std::ostream& operator<<(std::ostream& out,
+                                            const DiffEdit& edit)
+{
+    switch (edit.type)
+    {
+        case DiffEdit::INSERTED:
+            out << "inserted " << edit.path << " at " << edit.b_line << "."
+                << edit.b_column << " (" << edit.b_data << ")";
+            break;
+        case DiffEdit::DELETED:
+            out << "deleted " << edit.path << " at " << edit.a_line << "."
+                << edit.a_column << " (" << edit.a_data << ")";
+            break;
+        case DiffEdit::UPDATED:
+            out << "updated " << edit.path << " at " << edit.a_line << "."
+                << edit.a_column << " -> " << edit.b_line << "."
+                << edit.b_column << " (" << edit.a_data << " -> "
+                << edit.b_data << ")";
+            break;
+    }
+    return out;
+}
+
+namespace detail
+{
+/**
+ * @brief diff_key the key by which children are matched, their declarator and
+ * any declarator id, e.g., 'object' and 'identifier' of
+ * 'object(identifier){}'
+ * The declarator leads a node's children, following any opening bracket (e.g.,
+ * HIT's '[' of '[block]'), and is used rather than the node's name, which
+ * formats may derive from its content. Nodes without one are keyed by name.
+ */
+template<class TAdapter>
+std::string diff_key(const TAdapter& node)
+{
+    std::string key;
+    for (std::size_t i = 0, count = node.child_count(); i < count && i < 2; ++i)
+    {
+        TAdapter child = node.child_at(i);
+        if (child.is_declarator())
+        {
+            key = child.data();
+            break;
+        }
+    }
+    if (key.empty())
+        key = node.name();
+    TAdapter id = node.id_child();
+    if (!id.is_null())
+    {
+        key += '\0';
+        key += id.data();
+    }
+    return key;
+}
+
+template<class TAdapter>
+DiffEdit diff_edit(DiffEdit::Type type, const TAdapter* a, const TAdapter* b)
+{
+    DiffEdit edit;
+    edit.type = type;
+    if (a != nullptr)
+    {
+        edit.path         = a->path();
+        edit.a_node_index = a->node_index();
+        edit.a_line       = a->line();
+        edit.a_column     = a->column();
+        edit.a_data       = a->data();
+    }
+    if (b != nullptr)
+    {
+        edit.path         = b->path();
+        edit.b_node_index = b->node_index();
+        edit.b_line       = b->line();
+        edit.b_column     = b->column();
+        edit.b_data       = b->data();
+    }
+    return edit;
+}
+
+template<class TAdapter>
+void diff_nodes(const TAdapter& a, const TAdapter& b, std::vector<DiffEdit>& edits)
+{
+    if (a.subtree_hash() == b.subtree_hash())
+        return;
+    std::size_t a_count = a.child_count();
+    std::size_t b_count = b.child_count();
+    if (a.type() != b.type() || a_count == 0 || b_count == 0)
+    {
+        edits.push_back(diff_edit(DiffEdit::UPDATED, &a, &b));
+        return;
+    }
+    std::vector<TAdapter> a_children, b_children;
+    a_children.reserve(a_count);
+    b_children.reserve(b_count);
+    for (std::size_t i = 0; i < a_count; ++i)
+    {
+        a_children.push_back(a.child_at(i));
+    }
+    for (std::size_t i = 0; i < b_count; ++i)
+    {
+        b_children.push_back(b.child_at(i));
+    }
+    const std::size_t        npos = DiffEdit::npos;
+    std::vector<std::size_t> a_match(a_count, npos), b_match(b_count, npos);
+
+    // Identical subtrees are matched first, in order, wherever they moved
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> by_hash;
+    for (std::size_t i = 0; i < a_count; ++i)
+    {
+        by_hash[a_children[i].subtree_hash()].push_back(i);
+    }
+    std::unordered_map<std::uint64_t, std::size_t> hash_cursor;
+    for (std::size_t j = 0; j < b_count; ++j)
+    {
+        std::uint64_t hash  = b_children[j].subtree_hash();
+        auto          found = by_hash.find(hash);
+        if (found == by_hash.end())
+            continue;
+        std::size_t& cursor = hash_cursor[hash];
+        if (cursor < found->second.size())
+        {
+            std::size_t i = found->second[cursor++];
+            a_match[i]    = j;
+            b_match[j]    = i;
+        }
+    }
+    // The remaining children are matched by declarator and its id, in order
+    std::unordered_map<std::string, std::vector<std::size_t>> by_key;
+    for (std::size_t i = 0; i < a_count; ++i)
+    {
+        if (a_match[i] == npos)
+            by_key[diff_key(a_children[i])].push_back(i);
+    }
+    std::unordered_map<std::string, std::size_t> key_cursor;
+    for (std::size_t j = 0; j < b_count && !by_key.empty(); ++j)
+    {
+        if (b_match[j] != npos)
+            continue;
+        std::string key   = diff_key(b_children[j]);
+        auto        found = by_key.find(key);
+        if (found == by_key.end())
+            continue;
+        std::size_t& cursor = key_cursor[key];
+        if (cursor < found->second.size())
+        {
+            std::size_t i = found->second[cursor++];
+            a_match[i]    = j;
+            b_match[j]    = i;
+        }
+    }
+
+    std::size_t edit_count = edits.size();
+    for (std::size_t i = 0; i < a_count; ++i)
+    {
+        if (a_match[i] == npos)
+            edits.push_back(diff_edit<TAdapter>(DiffEdit::DELETED,
+                                                &a_children[i], nullptr));
+    }
+    for (std::size_t j = 0; j < b_count; ++j)
+    {
+        if (b_match[j] == npos)
+            edits.push_back(diff_edit<TAdapter>(DiffEdit::INSERTED, nullptr,
+                                                &b_children[j]));
+        else
+            diff_nodes(a_children[b_match[j]], b_children[j], edits);
+    }
+    // the difference is the node's own, e.g., its packed array elements
+    if (edit_count == edits.size())
+        edits.push_back(diff_edit(DiffEdit::UPDATED, &a, &b));
+}
+}  // namespace detail
+
+/**
+ * @brief diff compute the edits transforming one tree into another
+ * Subtrees of equal structural hashes are not descended. The children of
+ * differing subtrees are matched first by hash, capturing moved subtrees,
+ * and then by declarator and declarator id, the matches being descended. The
+ * remaining children are deleted or inserted. Each tree's nodes are visited
+ * at most once, so the cost is linear in the size of the differing subtrees.
+ * @param a the original tree's root
+ * @param b the revised tree's root
+ * @param edits the edits to which this difference's are appended; deletions
+ * of a parent's children precede the insertions and descendants' edits, which
+ * are in the order of the revised tree
+ */
+template<class TAdapter>
+void diff(const TAdapter& a, const TAdapter& b, std::vector<DiffEdit>& edits)
+{
+    detail::diff_nodes(a, b, edits);
+}
+
+/**
+ * @brief diff compute the edits transforming one tree into another
+ * @return the edits, empty if the trees are structurally equal
+ */
+template<class TAdapter>
+std::vector<DiffEdit> diff(const TAdapter& a, const TAdapter& b)
+{
+    std::vector<DiffEdit> edits;
+    diff(a, b, edits);
+    return edits;
+}
+}  // namespace wasp
+#endif
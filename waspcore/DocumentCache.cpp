@@ -0,0 +1,216 @@
+#include "waspcore/DocumentCache.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <sys/stat.h>
+
+namespace wasp
+{
+DocumentCache::DocumentCache()
+    : m_capacity(0), m_bytes(0), m_hits(0), m_misses(0)
+{
+}
+
+DocumentCache& DocumentCache::instance()
+{
+    static DocumentCache cache;
+    return cache;
+}
+
+std::string DocumentCache::canonical_path(const std::string& path)
+{
+#ifdef _WIN32
+    char resolved[_MAX_PATH];
+    if (_fullpath(resolved, path.c_str(), _MAX_PATH) == nullptr)
+        return "";
+    FileStamp file_stamp;
+    if (!stamp(resolved, file_stamp))
+        return "";
+#else
+    char resolved[PATH_MAX];
+    if (::realpath(path.c_str(), resolved) == nullptr)
+        return "";
+#endif
+    return resolved;
+}
+
+bool DocumentCache::stamp(const std::string& path, FileStamp& file_stamp)
+{
+#ifdef _WIN32
+    struct _stat64 st;
+    if (::_stat64(path.c_str(), &st) != 0)
+        return false;
+    file_stamp.modified = static_cast<std::int64_t>(st.st_mtime);
+#else
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0)
+        return false;
+#ifdef __APPLE__
+    // Darwin names the modification timespec st_mtimespec
+    const struct timespec& modified = st.st_mtimespec;
+#else
+    const struct timespec& modified = st.st_mtim;
+#endif
+    file_stamp.modified =
+        static_cast<std::int64_t>(modified.tv_sec) * 1000000000 +
+        modified.tv_nsec;
+#endif
+    file_stamp.size = static_cast<std::uint64_t>(st.st_size);
+    return true;
+}
+
+bool DocumentCache::stamp_all(const std::string&      canonical,
+                              const Entry&            entry,
+                              std::vector<FileStamp>& file_stamps)
+{
+    file_stamps.resize(1 + entry.paths.size());
+    if (canonical.empty() || !stamp(canonical, file_stamps[0]))
+        return false;
+    for (std::size_t i = 0; i < entry.paths.size(); ++i)
+    {
+        if (!stamp(entry.paths[i], file_stamps[i + 1]))
+            return false;
+    }
+    return true;
+}
+
+DocumentCache::EntrySP DocumentCache::find(const std::string& type,
+                                           const std::string& path)
+{
+    if (!enabled())
+        return nullptr;
+    std::string canonical = canonical_path(path);
+    std::string key       = type + '\0' + canonical;
+    EntrySP     entry;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        itr = m_records.find(key);
+        if (itr != m_records.end())
+            entry = itr->second.entry;
+    }
+    // the files are examined outside of the lock as they may be slow to
+    // access, and the entry is immutable
+    std::vector<FileStamp> file_stamps;
+    bool                   current =
+        entry && stamp_all(canonical, *entry, file_stamps);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto                        itr = m_records.find(key);
+    if (itr == m_records.end() || itr->second.entry != entry)
+    {
+        // the entry was removed or replaced concurrently
+        current = false;
+    }
+    else if (!current || itr->second.file_stamps != file_stamps)
+    {
+        // a file has changed or is no longer accessible
+        erase(itr);
+        current = false;
+    }
+    if (!current)
+    {
+        ++m_misses;
+        return nullptr;
+    }
+    ++m_hits;
+    m_recency.splice(m_recency.begin(), m_recency, itr->second.recency);
+    return entry;
+}
+
+void DocumentCache::insert(const std::string& type,
+                           const std::string& path,
+                           Entry              entry)
+{
+    std::string            canonical = canonical_path(path);
+    std::vector<FileStamp> file_stamps;
+    if (!stamp_all(canonical, entry, file_stamps))
+        return;
+    // a file that changed while the documents were read may not be
+    // reflected by the snapshot
+    if (entry.file_stamps.size() != entry.paths.size() ||
+        !std::equal(entry.file_stamps.begin(), entry.file_stamps.end(),
+                    file_stamps.begin() + 1))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (entry.snapshot.size() > m_capacity)
+        return;
+    std::string key = type + '\0' + canonical;
+    auto        itr = m_records.find(key);
+    if (itr != m_records.end())
+        erase(itr);
+    evict(m_capacity - entry.snapshot.size());
+
+    m_bytes += entry.snapshot.size();
+    m_recency.push_front(key);
+    Record& record     = m_records[key];
+    record.file_stamps = std::move(file_stamps);
+    record.entry       = std::make_shared<const Entry>(std::move(entry));
+    record.recency     = m_recency.begin();
+}
+
+void DocumentCache::erase(std::map<std::string, Record>::iterator itr)
+{
+    m_bytes -= itr->second.entry->snapshot.size();
+    m_recency.erase(itr->second.recency);
+    m_records.erase(itr);
+}
+
+void DocumentCache::evict(std::size_t capacity)
+{
+    while (m_bytes > capacity && !m_recency.empty())
+    {
+        erase(m_records.find(m_recency.back()));
+    }
+}
+
+void DocumentCache::set_capacity(std::size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = bytes;
+    evict(m_capacity);
+}
+
+std::size_t DocumentCache::capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+void DocumentCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records.clear();
+    m_recency.clear();
+    m_bytes  = 0;
+    m_hits   = 0;
+    m_misses = 0;
+}
+
+std::size_t DocumentCache::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_records.size();
+}
+
+std::size_t DocumentCache::bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+}
+
+std::size_t DocumentCache::hits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+std::size_t DocumentCache::misses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+}  // end of namespace
@@ -0,0 +1,168 @@
+#ifndef WASP_DOCUMENTCACHE_H
+#define WASP_DOCUMENTCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The DocumentCache class is a process-wide cache of interpreted
+ * included documents
+ * Entries are keyed by the interpreter type, including the modes that
+ * determine its documents' content, and the document's canonical path, and
+ * are valid while the modification time and size of the document and of
+ * each of its nested documents are unchanged. An entry holds the document's
+ * binary snapshot, from which each including interpreter restores its own
+ * copy of the document instead of reinterpreting the file. The cache is
+ * disabled (zero capacity) by default. Least recently used entries are
+ * evicted to keep the total snapshot size within the capacity. All members
+ * are thread safe.
+ */
+class WASP_PUBLIC DocumentCache
+{
+  public:
+    struct FileStamp
+    {
+        FileStamp() : modified(0), size(0) {}
+        std::int64_t  modified;
+        std::uint64_t size;
+        bool operator==(const FileStamp& o) const
+        {
+            return modified == o.modified && size == o.size;
+        }
+        bool operator!=(const FileStamp& o) const { return !(*this == o); }
+    };
+    struct Entry
+    {
+        /**
+         * @brief snapshot the binary snapshot of the document and its
+         * nested documents
+         */
+        std::string snapshot;
+        /**
+         * @brief paths the canonical paths of the document and its nested
+         * documents, used to detect circular inclusion
+         */
+        std::vector<std::string> paths;
+        /**
+         * @brief file_stamps the stamps of the paths taken before each
+         * document was read
+         */
+        std::vector<FileStamp> file_stamps;
+    };
+    typedef std::shared_ptr<const Entry> EntrySP;
+
+    /**
+     * @brief instance acquire the process-wide cache
+     */
+    static DocumentCache& instance();
+
+    /**
+     * @brief canonical_path acquire the absolute path of the given file with
+     * symbolic links and relative components resolved
+     * @return the canonical path, or an empty string if the file is not
+     * accessible
+     */
+    static std::string canonical_path(const std::string& path);
+
+    /**
+     * @brief find acquire the cached entry of the given document
+     * @param type the type of interpreter that interpreted the document
+     * @param path the path of the document's file
+     * @return the entry, or nullptr if the document is not cached, the file
+     * has changed since it was cached, or the cache is disabled
+     */
+    EntrySP find(const std::string& type, const std::string& path);
+    /**
+     * @brief insert cache the given entry for the given document
+     * Entries larger than the capacity are not cached, nor are entries
+     * whose files changed after they were stamped, as the snapshot may not
+     * reflect the current content.
+     * @param type the type of interpreter that interpreted the document
+     * @param path the path of the document's file
+     */
+    void insert(const std::string& type, const std::string& path, Entry entry);
+
+    /**
+     * @brief set_capacity set the maximum total size of cached snapshots
+     * @param bytes the capacity in bytes, 0 disables the cache
+     */
+    void set_capacity(std::size_t bytes);
+    std::size_t capacity() const;
+    /**
+     * @brief enabled determine if the cache has capacity
+     */
+    bool enabled() const { return capacity() > 0; }
+    /**
+     * @brief clear remove all entries and reset the hit and miss counters
+     */
+    void clear();
+
+    /**
+     * @brief stamp acquire the modification time and size of the given file
+     * @return true, iff the file is accessible
+     */
+    static bool stamp(const std::string& path, FileStamp& file_stamp);
+
+    /**
+     * @brief size acquire the number of cached documents
+     */
+    std::size_t size() const;
+    /**
+     * @brief bytes acquire the total size of cached snapshots
+     */
+    std::size_t bytes() const;
+    /**
+     * @brief hits acquire the number of find requests satisfied by the cache
+     */
+    std::size_t hits() const;
+    /**
+     * @brief misses acquire the number of find requests not satisfied by the
+     * cache while it was enabled
+     */
+    std::size_t misses() const;
+
+  private:
+    DocumentCache();
+    DocumentCache(const DocumentCache&);
+    DocumentCache& operator=(const DocumentCache&);
+
+    /**
+     * @brief stamp_all acquire the stamps of the given document and the
+     * given entry's paths
+     * @return true, iff all files are accessible
+     */
+    static bool stamp_all(const std::string&      canonical,
+                          const Entry&            entry,
+                          std::vector<FileStamp>& file_stamps);
+
+    struct Record
+    {
+        // stamps of the document followed by those of the entry's paths
+        std::vector<FileStamp>           file_stamps;
+        EntrySP                          entry;
+        std::list<std::string>::iterator recency;
+    };
+    void erase(std::map<std::string, Record>::iterator itr);
+    void evict(std::size_t capacity);
+
+    mutable std::mutex            m_mutex;
+    std::size_t                   m_capacity;
+    std::size_t                   m_bytes;
+    std::size_t                   m_hits;
+    std::size_t                   m_misses;
+    std::map<std::string, Record> m_records;
+    // record keys, most recently used first
+    std::list<std::string> m_recency;
+};
+}  // end of namespace
+#endif
@@ -0,0 +1,109 @@
+#include "waspcore/DocumentWorkers.h"
+
+#include <algorithm>
+
+namespace wasp
+{
+DocumentWorkers::DocumentWorkers() : m_stopping(false)
+{
+    std::size_t thread_count = std::thread::hardware_concurrency();
+    for (std::size_t t = 1; t < thread_count; ++t)
+    {
+        m_threads.emplace_back(&DocumentWorkers::work, this);
+    }
+}
+
+DocumentWorkers::~DocumentWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_queued.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+DocumentWorkers& DocumentWorkers::instance()
+{
+    static DocumentWorkers workers;
+    return workers;
+}
+
+std::size_t DocumentWorkers::claim(Batch& batch)
+{
+    std::size_t index = batch.next++;
+    if (batch.next == batch.count)
+    {
+        auto itr = std::find(m_batches.begin(), m_batches.end(), &batch);
+        if (itr != m_batches.end())
+            m_batches.erase(itr);
+    }
+    return index;
+}
+
+void DocumentWorkers::run(std::size_t                              count,
+                          std::size_t                              worker_limit,
+                          const std::function<void(std::size_t)>& task)
+{
+    if (count == 0)
+        return;
+    Batch batch;
+    batch.task         = &task;
+    batch.count        = count;
+    batch.next         = 0;
+    batch.done         = 0;
+    batch.workers      = 0;
+    batch.worker_limit = std::min(worker_limit, count - 1);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (batch.worker_limit > 0 && !m_threads.empty())
+    {
+        m_batches.push_back(&batch);
+        m_queued.notify_all();
+    }
+    // this thread interprets documents as well
+    while (batch.next < batch.count)
+    {
+        std::size_t index = claim(batch);
+        lock.unlock();
+        task(index);
+        lock.lock();
+        ++batch.done;
+    }
+    // the remaining documents are being interpreted by pool threads
+    m_completed.wait(lock, [&batch]() { return batch.done == batch.count; });
+}
+
+void DocumentWorkers::work()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        Batch* batch = nullptr;
+        m_queued.wait(lock, [this, &batch]() {
+            for (Batch* queued : m_batches)
+            {
+                if (queued->workers < queued->worker_limit)
+                {
+                    batch = queued;
+                    return true;
+                }
+            }
+            return m_stopping;
+        });
+        if (batch == nullptr)
+            return;
+        std::size_t index = claim(*batch);
+        ++batch->workers;
+        lock.unlock();
+        (*batch->task)(index);
+        lock.lock();
+        --batch->workers;
+        if (++batch->done == batch->count)
+            m_completed.notify_all();
+    }
+}
+}  // end of namespace
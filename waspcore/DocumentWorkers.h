@@ -0,0 +1,87 @@
+#ifndef WASP_DOCUMENTWORKERS_H
+#define WASP_DOCUMENTWORKERS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The DocumentWorkers class is a process-wide pool of threads that
+ * interpret included documents
+ * The pool has one thread fewer than the hardware concurrency, as the thread
+ * requesting a batch of documents interprets them as well. A document that
+ * includes documents of its own submits them as another batch, so nested
+ * includes share the pool's threads rather than creating threads per level.
+ * A thread waits only on documents that other threads are interpreting, so
+ * batches submitted from pool threads cannot deadlock. All members are
+ * thread safe.
+ */
+class WASP_PUBLIC DocumentWorkers
+{
+  public:
+    /**
+     * @brief instance acquire the process-wide pool
+     */
+    static DocumentWorkers& instance();
+    ~DocumentWorkers();
+
+    /**
+     * @brief run invoke the given task for each index of a batch, returning
+     * once every index is complete
+     * @param count the number of indices in the batch
+     * @param worker_limit the maximum number of pool threads assisting the
+     * calling thread, 0 for the calling thread alone
+     * @param task the task, which must not throw
+     */
+    void run(std::size_t                              count,
+             std::size_t                              worker_limit,
+             const std::function<void(std::size_t)>& task);
+
+    /**
+     * @brief size acquire the number of threads in the pool
+     */
+    std::size_t size() const { return m_threads.size(); }
+
+  private:
+    DocumentWorkers();
+    DocumentWorkers(const DocumentWorkers&);
+    DocumentWorkers& operator=(const DocumentWorkers&);
+
+    struct Batch
+    {
+        const std::function<void(std::size_t)>* task;
+        std::size_t                             count;
+        // the next unclaimed index
+        std::size_t next;
+        // the number of completed indices
+        std::size_t done;
+        // the number of pool threads invoking the task
+        std::size_t workers;
+        std::size_t worker_limit;
+    };
+    /**
+     * @brief claim acquire the next index of the given batch, removing the
+     * batch from the queue once all indices are claimed
+     * @note the mutex must be held
+     */
+    std::size_t claim(Batch& batch);
+    void        work();
+
+    std::mutex              m_mutex;
+    std::condition_variable m_queued;
+    std::condition_variable m_completed;
+    // batches with unclaimed indices, in order of submission
+    std::deque<Batch*>       m_batches;
+    std::vector<std::thread> m_threads;
+    bool                     m_stopping;
+};
+}  // end of namespace
+#endif
@@ -26,6 +26,14 @@ Diagnostic::Diagnostic(const Diagnostic& orig)
     wasp_require(interpreter);
     *msg << orig.msg->str();
 }
+Diagnostic::Diagnostic(const Diagnostic& orig, AbstractInterpreter* interp)
+    : sl(orig.sl), el(orig.el), sc(orig.sc), ec(orig.ec), f(orig.f),
+    msg (new std::stringstream()),
+    interpreter(interp)
+{
+    wasp_require(interpreter);
+    *msg << orig.msg->str();
+}
 Diagnostic::~Diagnostic()
 {
     delete msg;
@@ -40,7 +48,7 @@ Diagnostic& Diagnostic::operator<< (location loc)
     sc = loc.begin.column;
     el = loc.end.line;
     ec = loc.end.column;
-    interpreter->error_stream() << loc;
+    interpreter->diagnostic_stream() << loc;
     return *this;
 }
 Diagnostic& Diagnostic::operator<< (position start)
@@ -52,7 +60,7 @@ Diagnostic& Diagnostic::operator<< (position start)
     sc = start.column;
     el = sl;
     ec = sc;
-    interpreter->error_stream() << start;
+    interpreter->diagnostic_stream() << start;
     return *this;
 }
 
@@ -60,7 +68,7 @@ Diagnostic& Diagnostic::operator <<(std::ostream&(*os) (std::ostream&))
 {
     wasp_check(msg);
     *msg << os;
-    interpreter->error_stream() << os;
+    interpreter->diagnostic_stream() << os;
     return *this;
 }
 std::string Diagnostic::message() const
@@ -114,15 +122,79 @@ std::ostream& operator<<(std::ostream& stream, const std::vector<Diagnostic>& di
 }
 
 
+AbstractInterpreter::AbstractInterpreter() : m_deferred_diagnostics(nullptr)
+{
+}
+
+AbstractInterpreter::~AbstractInterpreter()
+{
+    for (auto* child_indices : m_released_child_indices)
+    {
+        delete child_indices;
+    }
+}
+
+std::vector<size_t>* AbstractInterpreter::acquire_child_indices(
+    std::initializer_list<size_t> child_indices)
+{
+    std::vector<size_t>* result;
+    if (m_released_child_indices.empty())
+    {
+        result = new std::vector<size_t>();
+    }
+    else
+    {
+        result = m_released_child_indices.back();
+        m_released_child_indices.pop_back();
+    }
+    result->assign(child_indices);
+    return result;
+}
+
+void AbstractInterpreter::release_child_indices(
+    std::vector<size_t>* child_indices)
+{
+    if (child_indices == nullptr)
+        return;
+    child_indices->clear();
+    m_released_child_indices.push_back(child_indices);
+}
+
 Diagnostic& AbstractInterpreter::error_diagnostic()
 {
+    return push_diagnostic(Diagnostic(this));
+}
+
+Diagnostic& AbstractInterpreter::push_diagnostic(const Diagnostic& diagnostic)
+{
+    if (m_deferred_diagnostics)
+    {
+        m_deferred_diagnostics->diagnostics.push_back(
+            Diagnostic(diagnostic, this));
+        return m_deferred_diagnostics->diagnostics.back();
+    }
     // The following logic ensures that diagnostics are attached to the interpreter
     // with which the caller will be interacting
-    if (document_parent()) return document_parent()->error_diagnostic();
-    m_error_diagnostics.push_back(Diagnostic(&*this));
+    if (document_parent()) return document_parent()->push_diagnostic(diagnostic);
+    m_error_diagnostics.push_back(Diagnostic(diagnostic, this));
     return m_error_diagnostics.back();
 }
 
+std::ostream& AbstractInterpreter::diagnostic_stream()
+{
+    if (m_deferred_diagnostics) return m_deferred_diagnostics->messages;
+    return error_stream();
+}
+
+void AbstractInterpreter::report_diagnostics(const DeferredDiagnostics& deferred)
+{
+    diagnostic_stream() << deferred.messages.str();
+    for (const auto& diagnostic : deferred.diagnostics)
+    {
+        push_diagnostic(diagnostic);
+    }
+}
+
 NodeView::NodeView(std::size_t node_index, wasp::AbstractInterpreter& nodes)
     : m_node_index(node_index), m_pool(&nodes)
 {
@@ -178,7 +250,8 @@ NodeView::Collection NodeView::non_decorative_children() const
 NodeView NodeView::first_non_decorative_child_by_name(
     const std::string& name) const
 {
-    return wasp::first_non_decorative_child_by_name(*this, name);
+    // NodeView nodes are never decorative, so the pool's name index suffices
+    return first_child_by_name(name);
 }
 
 size_t NodeView::non_decorative_children_count() const
@@ -192,6 +265,44 @@ std::string NodeView::data() const
     m_pool->data(m_node_index, str);
     return str.str();
 }
+
+StringView NodeView::data_view() const
+{
+    wasp_insist(m_pool->is_leaf(m_node_index),
+                "only a leaf node's data can be viewed without a buffer!");
+    std::string unused;
+    return m_pool->data_view(m_node_index, unused);
+}
+
+StringView NodeView::data_view(std::string& buffer) const
+{
+    return m_pool->data_view(m_node_index, buffer);
+}
+
+std::uint64_t NodeView::subtree_hash() const
+{
+    return m_pool->subtree_hash(m_node_index);
+}
+
+size_t NodeView::packed_size() const
+{
+    return m_pool->packed_size(m_node_index);
+}
+
+Span<const std::int64_t> NodeView::packed_integers() const
+{
+    return m_pool->packed_integers(m_node_index);
+}
+
+Span<const double> NodeView::packed_reals() const
+{
+    return m_pool->packed_reals(m_node_index);
+}
+
+std::string NodeView::packed_data(size_t element) const
+{
+    return m_pool->packed_data(m_node_index, element);
+}
 void NodeView::set_data(const char* data)
 {
     wasp_insist(is_leaf(), "Data assignment only allowed for leaf nodes!");
@@ -218,21 +329,7 @@ std::size_t  // return type
     NodeView::child_count_by_name(const std::string& name,
                                   std::size_t        limit) const
 {
-    std::size_t matching_named_child_count = 0;
-
-    for (std::size_t i = 0, count = child_count(); i < count; ++i)
-    {
-        auto        child      = child_at(i);
-        std::string child_name = child.name();
-        if (child_name == name)
-        {
-            ++matching_named_child_count;
-        }
-        // limit of 0 is reserved as no limit
-        if (limit != 0 && matching_named_child_count == limit)
-            break;
-    }
-    return matching_named_child_count;
+    return m_pool->child_count_by_name(m_node_index, name.c_str(), limit);
 }
 NodeView NodeView::child_at(std::size_t index) const
 {
@@ -242,31 +339,24 @@ NodeView NodeView::child_at(std::size_t index) const
 NodeView::Collection  // return type
     NodeView::child_by_name(const std::string& name, std::size_t limit) const
 {
-    NodeView::Collection results;
+    std::vector<std::size_t> child_indices;
+    m_pool->child_by_name(m_node_index, name.c_str(), limit, child_indices);
 
-    for (std::size_t i = 0, count = child_count(); i < count; ++i)
+    NodeView::Collection results;
+    results.reserve(child_indices.size());
+    for (std::size_t child_index : child_indices)
     {
-        auto        child      = child_at(i);
-        std::string child_name = child.name();
-        if (child_name == name)
-        {
-            results.push_back(child);
-        }
-        // limit of 0 is reserved as no limit
-        if (limit != 0 && results.size() == limit)
-            break;
+        results.push_back(NodeView(child_index, *m_pool));
     }
     return results;
 }
 NodeView NodeView::first_child_by_name(const std::string& name) const
 {
-    for (std::size_t i = 0, count = child_count(); i < count; ++i)
-    {
-        auto child = child_at(i);
-        if (name == child.name())
-            return child;
-    }
-    return NodeView();  // null view
+    std::size_t child_index = m_pool->first_child_by_name(m_node_index,
+                                                          name.c_str());
+    if (child_index == m_pool->size())
+        return NodeView();  // null view
+    return NodeView(child_index, *m_pool);
 }
 
 std::size_t NodeView::type() const
@@ -289,6 +379,11 @@ const char* NodeView::name() const
     return m_pool->name(m_node_index);
 }
 
+StringView NodeView::name_view() const
+{
+    return m_pool->name_view(m_node_index);
+}
+
 std::size_t NodeView::line() const
 {
     return m_pool->line(m_node_index);
@@ -322,16 +417,12 @@ bool NodeView::to_bool(bool* ok) const
 
 int NodeView::to_int(bool* ok) const
 {
-    int result = 0;
-    to_type(result, data(), ok);
-    return result;
+    return m_pool->to_int(m_node_index, ok);
 }
 
 double NodeView::to_double(bool* ok) const
 {
-    double result = 0.0;
-    to_type(result, data(), ok);
-    return result;
+    return m_pool->to_double(m_node_index, ok);
 }
 
 std::string NodeView::to_string(bool* ok) const
@@ -343,6 +434,18 @@ std::string NodeView::to_string(bool* ok) const
     return result;
 }
 
+StringView NodeView::to_string_view(std::string& buffer) const
+{
+    StringView data = m_pool->data_view(m_node_index, buffer);
+    // trim front quotes, as strip_quotes
+    if (data.size() >= 2 && (data.front() == '\'' || data.front() == '"')
+        && data.back() == data.front())
+    {
+        return data.substr(1, data.size() - 2);
+    }
+    return data;
+}
+
 std::string NodeView::last_as_string(bool* ok) const
 {
     return wasp::last_as_string(*this, ok);
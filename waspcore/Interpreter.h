@@ -1,13 +1,26 @@
 #ifndef WASP_INTERPRETER_H
 #define WASP_INTERPRETER_H
 #include <algorithm>
+#include <deque>
+#include <exception>
+#include <initializer_list>
+#include <thread>
+#include <typeinfo>
 #include <vector>
 #include <map>
 #include <string>
 #include <cstddef>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include "waspcore/decl.h"
+#include "waspcore/DocumentCache.h"
+#include "waspcore/DocumentWorkers.h"
+#include "waspcore/MappedFile.h"
+#include "waspcore/Snapshot.h"
+#include "waspcore/Span.h"
+#include "waspcore/StreamHandler.h"
+#include "waspcore/StringView.h"
 #include "waspcore/TreeNodePool.h"
 #include "waspcore/wasp_node.h"
 #include "waspcore/wasp_bug.h"
@@ -29,6 +42,11 @@ public:
     Diagnostic (); // for Python bindings
     Diagnostic(class AbstractInterpreter*);
     Diagnostic(const Diagnostic& orig);
+    /**
+     * @brief Diagnostic copy the given diagnostic, attaching the copy to the
+     * given interpreter
+     */
+    Diagnostic(const Diagnostic& orig, class AbstractInterpreter* interp);
     ~Diagnostic();
     Diagnostic& operator<< (location loc);
     Diagnostic& operator<< (position start);
@@ -79,6 +97,48 @@ class WASP_PUBLIC NodeView
      * @return the node's data
      */
     std::string data() const;
+    /**
+     * @brief data_view acquire a view of the leaf node's data without
+     * copying it
+     * Throws if this is a parent node, whose data is formatted; use
+     * data_view(buffer) for any node.
+     */
+    StringView data_view() const;
+    /**
+     * @brief data_view acquire a view of the node's data
+     * @param buffer storage for a parent node's formatted data, reusable
+     * across calls
+     */
+    StringView data_view(std::string& buffer) const;
+
+    /**
+     * @brief subtree_hash the structural hash of this node's subtree
+     * Subtrees of equal names, types and leaf data hash equal regardless of
+     * their position, suiting detection of duplicate blocks and diffing.
+     */
+    std::uint64_t subtree_hash() const;
+
+    /**
+     * @brief packed_size the number of elements of this packed array
+     * The elements of an array packed by the document's pack_arrays are not
+     * child nodes; they are acquired through the packed_* accessors.
+     * @return the element count, or zero if this is not a packed array
+     */
+    size_t packed_size() const;
+    /**
+     * @brief packed_integers acquire the elements of this packed array of
+     * integers, empty if this is not one
+     */
+    Span<const std::int64_t> packed_integers() const;
+    /**
+     * @brief packed_reals acquire the elements of this packed array of
+     * reals, empty if this is not one
+     */
+    Span<const double> packed_reals() const;
+    /**
+     * @brief packed_data acquire the text of the given packed element
+     */
+    std::string packed_data(size_t element) const;
 
     /**
      * @brief Set the data of this node
@@ -220,6 +280,10 @@ class WASP_PUBLIC NodeView
      * @return the node's name
      */
     const char* name() const;
+    /**
+     * @brief name_view acquire a view of the node's name without copying it
+     */
+    StringView name_view() const;
 
     /**
      * @brief line acquire the node's starting line
@@ -276,6 +340,13 @@ class WASP_PUBLIC NodeView
      * front and back).
      */
     std::string to_string(bool* ok = nullptr) const;
+    /**
+     * @brief to_string_view acquire a view of the data as to_string would
+     * produce it, without copying a leaf's data
+     * @param buffer storage for data that is not viewed in place, reusable
+     * across calls
+     */
+    StringView to_string_view(std::string& buffer) const;
 
     /**
      * @brief last_as_string this node or last child's data as a string
@@ -307,7 +378,8 @@ class WASP_PUBLIC AbstractInterpreter
 {
   public:
     typedef std::shared_ptr<AbstractInterpreter> SP;
-    virtual ~AbstractInterpreter(){}
+    AbstractInterpreter();
+    virtual ~AbstractInterpreter();
     /**
      * @brief root acquire the root of the document
      * @return TreeNodeView view into the document parse tree
@@ -319,6 +391,13 @@ class WASP_PUBLIC AbstractInterpreter
      * If this document is nested, the diagnostic is attached to the root-most interpreter
     */
     Diagnostic& error_diagnostic();
+    /**
+     * @brief diagnostic_stream acquire the stream on which diagnostic
+     * messages are emitted
+     * @return the deferred diagnostics' stream while diagnostics are
+     * deferred, otherwise the error stream
+     */
+    std::ostream& diagnostic_stream();
     /**
      * Obtain diagnostics
     */
@@ -381,6 +460,83 @@ class WASP_PUBLIC AbstractInterpreter
      * @return the name of the node
      */
     virtual const char* name(size_t node_index) const = 0;
+    /**
+     * @brief name_view acquire a view of the name of the node at the given
+     * index without copying it
+     */
+    virtual StringView name_view(size_t node_index) const = 0;
+    /**
+     * @brief name_symbol acquire the interned symbol of the node's name
+     * @param node_index the node index
+     * @return the name symbol, equal for all nodes of this document with
+     * equal names
+     */
+    virtual size_t name_symbol(size_t node_index) const = 0;
+    /**
+     * @brief find_name_symbol acquire the symbol of the given name
+     * @param name the name for which the symbol is requested
+     * @return the symbol, or SymbolTable<>::npos if no node of this document
+     * has the given name
+     */
+    virtual size_t find_name_symbol(const char* name) const = 0;
+    /**
+     * @brief first_child_by_name acquire the first child with the given name
+     * @param node_index the index of the parent node
+     * @param name the name of the requested child
+     * @return the index of the child, or size() if no child has the name
+     */
+    virtual size_t first_child_by_name(size_t      node_index,
+                                       const char* name) const = 0;
+    /**
+     * @brief child_count_by_name determine the number of children with the
+     * given name
+     * @param node_index the index of the parent node
+     * @param name the name of the child nodes to count
+     * @param limit the limit (0 reserved as no limit) on the count
+     * @return the number of children with the given name
+     */
+    virtual size_t child_count_by_name(size_t      node_index,
+                                       const char* name,
+                                       size_t      limit) const = 0;
+    /**
+     * @brief child_by_name acquire the indices of children with the given name
+     * @param node_index the index of the parent node
+     * @param name the name of the children to be retrieved
+     * @param limit the limit (0 reserved as no limit) on the number of children
+     * @param child_indices the indices of the matching children
+     */
+    virtual void child_by_name(size_t               node_index,
+                               const char*          name,
+                               size_t               limit,
+                               std::vector<size_t>& child_indices) const = 0;
+    /**
+     * @brief child_by_name_symbol acquire the indices of children with the
+     * given name symbol
+     * @param node_index the index of the parent node
+     * @param symbol the name symbol of the children to be retrieved
+     * @param limit the limit (0 reserved as no limit) on the number of children
+     * @param child_indices the indices of the matching children
+     */
+    virtual void
+    child_by_name_symbol(size_t               node_index,
+                         size_t               symbol,
+                         size_t               limit,
+                         std::vector<size_t>& child_indices) const = 0;
+    /**
+     * @brief find_name_symbols acquire the symbols of all names matching the
+     * given wildcard pattern
+     * @param pattern the name pattern, e.g., 'material' or 'mat*'
+     * @param symbols the matching symbols, appended in ascending order
+     */
+    virtual void find_name_symbols(const char*          pattern,
+                                   std::vector<size_t>& symbols) const = 0;
+    /**
+     * @brief may_have_descendant determine whether any descendant of the
+     * given node may have the given name symbol
+     * @return false, iff no descendant of the node has the name
+     */
+    virtual bool may_have_descendant(size_t node_index,
+                                     size_t symbol) const = 0;
 
     virtual bool set_name(size_t node_index, const char* name) = 0;
     virtual void set_type(size_t node_index, size_t node_type) = 0;
@@ -391,6 +547,59 @@ class WASP_PUBLIC AbstractInterpreter
      */
     virtual std::string data(size_t node_index) const = 0;
     virtual void set_data(size_t noded_index, const char* data) = 0;
+    /**
+     * @brief data_view acquire a view of the data of the node at the given
+     * index
+     * A leaf's data is viewed without copying, while a parent's data is
+     * formatted into the given buffer, which is viewed.
+     * @param buffer storage for a parent's data, reusable across calls
+     */
+    virtual StringView data_view(size_t       node_index,
+                                 std::string& buffer) const = 0;
+    /**
+     * @brief to_int acquire the data of the node at the given index converted
+     * to an integer
+     * Leaf conversions are cached, so repeated conversions are a lookup.
+     * @param ok optional indication of whether the conversion succeeded
+     */
+    virtual int to_int(size_t node_index, bool* ok = nullptr) const = 0;
+    /**
+     * @brief to_double acquire the data of the node at the given index
+     * converted to a double
+     */
+    virtual double to_double(size_t node_index, bool* ok = nullptr) const = 0;
+
+    /**
+     * @brief subtree_hash the structural hash of the given node's subtree
+     */
+    virtual std::uint64_t subtree_hash(size_t node_index) const = 0;
+
+    /**
+     * @brief packed_size the number of packed elements of the given array
+     * @return the element count, or zero if the node is not a packed array
+     */
+    virtual size_t packed_size(size_t node_index) const = 0;
+    /**
+     * @brief packed_position the number of the packed array's children
+     * preceding its elements
+     */
+    virtual size_t packed_position(size_t node_index) const = 0;
+    virtual bool   packed_separated(size_t node_index) const = 0;
+    /**
+     * @brief packed_integers acquire the elements of a packed integer array
+     * @return the elements, empty if the node is not a packed integer array
+     */
+    virtual Span<const std::int64_t>
+    packed_integers(size_t node_index) const = 0;
+    /**
+     * @brief packed_reals acquire the elements of a packed real array
+     * @return the elements, empty if the node is not a packed real array
+     */
+    virtual Span<const double> packed_reals(size_t node_index) const = 0;
+    virtual std::string        packed_data(size_t node_index,
+                                           size_t element) const = 0;
+    virtual size_t packed_line(size_t node_index, size_t element) const   = 0;
+    virtual size_t packed_column(size_t node_index, size_t element) const = 0;
 
     /**
      * @brief token_data acquires the data for the token at the given index
@@ -446,6 +655,20 @@ class WASP_PUBLIC AbstractInterpreter
      * children
      */
     virtual size_t commit_staged(size_t stage_index) = 0;
+    /**
+     * @brief stream_root_members stream the given members of the document's
+     * root object or array to the stream handler
+     * @param child_indices the member's indices, including any separator
+     * @return true, iff the members were streamed and discarded, otherwise
+     * the caller retains them
+     */
+    virtual bool
+    stream_root_members(const std::vector<size_t>& child_indices) = 0;
+    /**
+     * @brief stream_document emit the events of the document's root members,
+     * and of the documents they include, to the given handler
+     */
+    virtual void stream_document(StreamHandler* handler) const = 0;
 
     virtual const size_t& staged_type(size_t staged_index) const = 0;
     virtual size_t& staged_type(size_t staged_index)             = 0;
@@ -546,6 +769,33 @@ class WASP_PUBLIC AbstractInterpreter
      */
     virtual AbstractInterpreter* document_parent() const = 0;
 
+    /**
+     * @brief freeze make the interpreted document and its nested documents
+     * read-only
+     * Acceleration structures are built eagerly so that any number of threads
+     * may concurrently traverse, select from, and validate a frozen document
+     * through its NodeViews. Parsing into, or otherwise modifying, a frozen
+     * document throws until the interpreter is reset.
+     */
+    virtual void freeze() = 0;
+    virtual bool frozen() const = 0;
+
+    /**
+     * @brief is_descendant determine if the given node is a descendant of
+     * the given ancestor within this document
+     * Constant time when the document has been relaid out in pre-order.
+     */
+    virtual bool is_descendant(size_t ancestor_index,
+                               size_t node_index) const = 0;
+
+    /**
+     * @brief nodes_of_type acquire this document's nodes of the given type
+     * A lookup when the document is type indexed, otherwise a scan.
+     */
+    virtual void nodes_of_type(size_t               type,
+                               std::vector<size_t>& node_indices) const = 0;
+    virtual bool type_indexed() const = 0;
+
     /**
      * Process a node into a new staged node for committal to the parse tree
      * @param new_staged_index is the stage_index of the newly pushed staged node
@@ -573,8 +823,68 @@ class WASP_PUBLIC AbstractInterpreter
         (void) err;              // suppress unused variable warning
         return true;
     }
+
+    /**
+     * @brief acquire_child_indices acquire a list in which parser actions
+     * accumulate the child node indices of a parent node
+     * Released lists are reused, retaining their capacity, so a parse
+     * allocates only as many lists as are simultaneously in use
+     * @param child_indices the initial child node indices of the list
+     * @return the list, to be returned via release_child_indices
+     */
+    std::vector<size_t>*
+    acquire_child_indices(std::initializer_list<size_t> child_indices = {});
+    /**
+     * @brief release_child_indices return a list acquired via
+     * acquire_child_indices for reuse
+     * @param child_indices the list to release, ignored when nullptr
+     */
+    void release_child_indices(std::vector<size_t>* child_indices);
+
+  protected:
+    /**
+     * @brief DeferredDiagnostics diagnostics captured rather than reported
+     * Included documents are interpreted concurrently, so their diagnostics,
+     * and those of the including document that follow the include, are
+     * captured and subsequently reported in document order.
+     */
+    struct DeferredDiagnostics
+    {
+        std::stringstream       messages;
+        std::vector<Diagnostic> diagnostics;
+    };
+    /**
+     * @brief defer_diagnostics capture subsequent diagnostics
+     * @param deferred where to capture diagnostics, nullptr to resume
+     * reporting them
+     */
+    void defer_diagnostics(DeferredDiagnostics* deferred)
+    {
+        m_deferred_diagnostics = deferred;
+    }
+    DeferredDiagnostics* deferred_diagnostics() const
+    {
+        return m_deferred_diagnostics;
+    }
+    /**
+     * @brief report_diagnostics report the given captured diagnostics as if
+     * they originated from this interpreter
+     */
+    void report_diagnostics(const DeferredDiagnostics& deferred);
+
   private:
+    /**
+     * @brief push_diagnostic attach a copy of the given diagnostic to this
+     * interpreter's deferred diagnostics, or to the root-most interpreter
+     */
+    Diagnostic& push_diagnostic(const Diagnostic& diagnostic);
+
     std::vector<Diagnostic> m_error_diagnostics;
+    DeferredDiagnostics*    m_deferred_diagnostics;
+    /**
+     * @brief m_released_child_indices the released, empty, child index lists
+     */
+    std::vector<std::vector<size_t>*> m_released_child_indices;
 };
 
 template<class NodeStorage = TreeNodePool<>>
@@ -621,11 +931,36 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
     virtual size_t document_count() const;
     /**
      * @brief load_document interprets document at the given node and path
+     * During a parse the document is queued and interpreted, concurrently
+     * with the other documents included by this document, once this
+     * document's parse completes. The documents are then attached, and their
+     * diagnostics reported, in the order they were included.
      * @param document_errors a stream for capturing document parse errors
-     * @return true iff the document was successfully interpreted
+     * @return true iff the document was successfully interpreted, or queued
      */
     virtual bool load_document(size_t node_index, const std::string& path);
 
+    /**
+     * @brief set_document_threads set the maximum number of threads used to
+     * interpret the documents included by a document
+     * The calling thread is assisted by threads of the DocumentWorkers pool,
+     * which are shared by all documents and levels of inclusion.
+     * @param thread_count the thread count, 0 for the hardware concurrency,
+     * or 1 to interpret included documents serially
+     */
+    void set_document_threads(size_t thread_count)
+    {
+        m_document_threads = thread_count;
+    }
+    size_t document_threads() const { return m_document_threads; }
+    /**
+     * @brief concurrent_documents indicates if included documents can be
+     * interpreted after, and concurrently with, the including document
+     * @return false if included documents must be interpreted at the point
+     * of inclusion, e.g., because they modify the including document's state
+     */
+    virtual bool concurrent_documents() const { return true; }
+
     /**
      * @brief path_already_included checks if file path was already included
      * @param path file path to child document that is trying to be included
@@ -687,11 +1022,69 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
         wasp_not_implemented("Generic Interpreter parseFile");
     }
 
+    /**
+     * @brief save_snapshot write the interpreted document, including all
+     * loaded nested documents, to a binary snapshot
+     * A snapshot captures the tokens, node tree, and document associations so
+     * that load_snapshot can restore the document without reinterpreting it.
+     * Snapshots are specific to this interpreter's storage types and the
+     * platform's byte order.
+     * @param path the path of the snapshot file to write
+     * @return true, iff the snapshot was completely written
+     */
+    bool save_snapshot(const std::string& path) const;
+    bool save_snapshot(std::ostream& out) const;
+    /**
+     * @brief load_snapshot replace this interpreter's document with that of
+     * the given snapshot
+     * Nested documents are restored with interpreters created by
+     * create_nested_interpreter.
+     * @param path the path of the snapshot file to read
+     * @return true, iff a valid snapshot was completely read
+     */
+    bool load_snapshot(const std::string& path);
+    bool load_snapshot(std::istream& in);
+
+    /**
+     * @brief reset discard the interpreted document so that this interpreter
+     * can interpret another
+     * The token, string, and node pools are emptied but retain their
+     * allocated capacity, so reinterpreting a document of similar size makes
+     * no pool reallocations. Nested documents and error diagnostics are
+     * discarded. Search paths and the line index setting are retained.
+     */
+    virtual void reset();
+    /**
+     * @brief reserve_for_bytes allocate pool capacity for a document of the
+     * given size
+     * The token, node, and line counts are estimated from the byte count, so
+     * the reservation is a hint rather than a guarantee.
+     * @param byte_count the size of the document in bytes
+     */
+    void reserve_for_bytes(size_t byte_count);
+
     /**
      * @brief token_count acquires the number of tokens so far interpreted
      * @return the number of tokens
      */
-    size_t token_count() const { return m_nodes.token_data().size(); }
+    size_t token_count() const
+    {
+        return m_nodes.token_data().size() + m_discarded_tokens;
+    }
+    /**
+     * @brief retained_token_count acquires the number of tokens held, i.e.,
+     * those interpreted less those discarded by streaming
+     */
+    size_t retained_token_count() const { return m_nodes.token_data().size(); }
+    /**
+     * @brief retained_line_count acquires the number of line offsets held,
+     * i.e., those interpreted less those discarded by streaming
+     */
+    size_t retained_line_count() const
+    {
+        const auto& tokens = m_nodes.token_data();
+        return tokens.line_count() - tokens.discarded_line_count();
+    }
     /**
      * @brief push appends a token
      * @param str the token's string data
@@ -713,6 +1106,79 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
 
     void pop_line() { m_nodes.pop_line(); }
 
+    /**
+     * @brief enable_line_index records the line of each token so node line
+     * and column lookups are constant time rather than a search of the line
+     * offsets
+     * Tokens already interpreted are indexed immediately. When enabled prior
+     * to parsing, lines are recorded as tokens are pushed and nested
+     * documents loaded by this interpreter are indexed too.
+     */
+    void enable_line_index()
+    {
+        wasp_insist(!frozen(), "a frozen document cannot be line indexed!");
+        m_nodes.token_data().enable_line_index();
+    }
+    bool has_line_index() const { return m_nodes.token_data().has_line_index(); }
+
+    void freeze();
+    bool frozen() const { return m_nodes.frozen(); }
+
+    /**
+     * @brief relayout renumber this document's nodes, and those of its
+     * nested documents, into pre-order
+     * Afterward each subtree is the contiguous node range
+     * [node_index, subtree_end(node_index)), so that descendant scans sweep
+     * the node data linearly and descendant tests are constant time. The
+     * document root becomes node 0. NodeViews and node indices acquired
+     * before the relayout are invalidated; the returned mapping translates
+     * this document's prior node indices.
+     * @return the new index of each node, indexed by its prior index
+     */
+    std::vector<size_t> relayout();
+    bool preordered() const { return m_nodes.preordered(); }
+    /**
+     * @brief pack_arrays store this document's, and its nested documents',
+     * numeric arrays of at least min_size elements as contiguous values
+     * A packed array keeps its declarator and delimiter children while its
+     * elements are acquired through NodeView::packed_integers,
+     * packed_reals, and packed_data rather than as child nodes. Printing
+     * the document reproduces the elements' values and positions, but not
+     * their original text, e.g., 1.50 prints as 1.5. NodeViews and node
+     * indices acquired before packing are invalidated; the returned mapping
+     * translates this document's prior node indices, removed elements
+     * mapping to the prior node count.
+     * @return the new index of each node, indexed by its prior index
+     */
+    std::vector<size_t> pack_arrays(size_t min_size);
+    size_t subtree_end(size_t node_index) const
+    {
+        return m_nodes.subtree_end(node_index);
+    }
+    bool is_descendant(size_t ancestor_index, size_t node_index) const
+    {
+        return m_nodes.is_descendant(ancestor_index, node_index);
+    }
+
+    /**
+     * @brief enable_type_index maintain each node type's list of nodes, of
+     * this document and its nested documents, so that nodes_of_type is a
+     * lookup rather than a scan of every node
+     * Nested documents loaded after the index is enabled are indexed too.
+     */
+    void enable_type_index();
+    bool type_indexed() const { return m_nodes.type_indexed(); }
+    /**
+     * @brief nodes_of_type acquire this document's nodes of the given type
+     * @param type the node type of interest (wasp::OBJECT, wasp::FILE, etc.)
+     * @param node_indices the ascending indices of the nodes of the type
+     * Nodes of nested documents are acquired from their own interpreter.
+     */
+    void nodes_of_type(size_t type, std::vector<size_t>& node_indices) const
+    {
+        m_nodes.nodes_of_type(static_cast<node_type_size>(type), node_indices);
+    }
+
     /**
      * @brief set_start_line sets the line to start parsing
      * @param line parsing start line
@@ -793,6 +1259,51 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
      * @return the name of the node
      */
     const char* name(size_t node_index) const;
+    StringView  name_view(size_t node_index) const
+    {
+        return m_nodes.name_view(node_index);
+    }
+    size_t name_symbol(size_t node_index) const
+    {
+        return m_nodes.name_symbol(node_index);
+    }
+    size_t find_name_symbol(const char* name) const
+    {
+        return m_nodes.find_name_symbol(name);
+    }
+    size_t first_child_by_name(size_t node_index, const char* name) const
+    {
+        return m_nodes.first_child_by_name(node_index, name);
+    }
+    size_t child_count_by_name(size_t      node_index,
+                               const char* name,
+                               size_t      limit) const
+    {
+        return m_nodes.child_count_by_name(node_index, name, limit);
+    }
+    void child_by_name(size_t               node_index,
+                       const char*          name,
+                       size_t               limit,
+                       std::vector<size_t>& child_indices) const
+    {
+        m_nodes.child_by_name(node_index, name, child_indices, limit);
+    }
+    void child_by_name_symbol(size_t               node_index,
+                              size_t               symbol,
+                              size_t               limit,
+                              std::vector<size_t>& child_indices) const
+    {
+        m_nodes.child_by_name_symbol(node_index, symbol, child_indices, limit);
+    }
+    void find_name_symbols(const char*          pattern,
+                           std::vector<size_t>& symbols) const
+    {
+        m_nodes.find_name_symbols(pattern, symbols);
+    }
+    bool may_have_descendant(size_t node_index, size_t symbol) const
+    {
+        return m_nodes.may_have_descendant(node_index, symbol);
+    }
     bool set_name(size_t node_index, const char* name);
     void set_type(size_t node_index, size_t node_type);
     /**
@@ -804,6 +1315,58 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
 
     void set_data(size_t node_index, const char* data);
 
+    StringView data_view(size_t node_index, std::string& buffer) const
+    {
+        return m_nodes.data_view(node_index, buffer);
+    }
+
+    int to_int(size_t node_index, bool* ok = nullptr) const
+    {
+        return m_nodes.to_int(node_index, ok);
+    }
+    double to_double(size_t node_index, bool* ok = nullptr) const
+    {
+        return m_nodes.to_double(node_index, ok);
+    }
+
+    std::uint64_t subtree_hash(size_t node_index) const
+    {
+        return m_nodes.subtree_hash(node_index);
+    }
+
+    size_t packed_size(size_t node_index) const
+    {
+        return m_nodes.packed_size(node_index);
+    }
+    size_t packed_position(size_t node_index) const
+    {
+        return m_nodes.packed_position(node_index);
+    }
+    bool packed_separated(size_t node_index) const
+    {
+        return m_nodes.packed_separated(node_index);
+    }
+    Span<const std::int64_t> packed_integers(size_t node_index) const
+    {
+        return m_nodes.packed_integers(node_index);
+    }
+    Span<const double> packed_reals(size_t node_index) const
+    {
+        return m_nodes.packed_reals(node_index);
+    }
+    std::string packed_data(size_t node_index, size_t element) const
+    {
+        return m_nodes.packed_data(node_index, element);
+    }
+    size_t packed_line(size_t node_index, size_t element) const
+    {
+        return m_nodes.packed_line(node_index, element);
+    }
+    size_t packed_column(size_t node_index, size_t element) const
+    {
+        return m_nodes.packed_column(node_index, element);
+    }
+
     /**
      * @brief token_data acquires the data for the token at the given index
      * @param token_index the index of the token for which the data is requested
@@ -911,6 +1474,12 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
     size_t push_staged_child(const std::vector<size_t>& child_indices)
     {
         wasp_require(m_staged.empty() == false);
+        // stream the children together as discarding one renumbers the next
+        if (m_stream_handler != nullptr)
+        {
+            stream(child_indices);
+            return m_staged.back().m_child_indices.size();
+        }
         size_t child_count = 0;
         for (size_t child_index : child_indices)
         {
@@ -973,6 +1542,30 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
     size_t       staged_count() const { return m_staged.size(); }
     virtual bool single_parse() const { return false; }
 
+    /**
+     * @brief set_stream_handler stream the events of subsequently parsed
+     * documents to the given handler instead of retaining their nodes
+     * Each top-level construct (a statement, a block's header, or a member of
+     * a JSON document's root) is streamed and discarded once parsed, so the
+     * tree holds at most one such construct at a time. The tokens and the
+     * line offsets preceding the retained constructs are discarded too.
+     * Included documents are interpreted as they are included rather than
+     * concurrently, and their events are emitted within those of the include,
+     * following its own. The constructs that include them are still retained
+     * as children of the root, so the tree is empty once the parse completes
+     * only when the document includes none.
+     * Streaming is supported by the SON, JSON, and HIT interpreters.
+     * @param handler the handler to receive the events, or nullptr to retain
+     * the nodes, the default. The handler is not owned.
+     */
+    void set_stream_handler(StreamHandler* handler)
+    {
+        m_stream_handler = handler;
+    }
+    StreamHandler* stream_handler() const { return m_stream_handler; }
+    bool stream_root_members(const std::vector<size_t>& child_indices);
+    void stream_document(StreamHandler* handler) const;
+
   protected:
     template<class PARSER_IMPL>
     bool parse_impl(std::istream&      input,
@@ -1033,6 +1626,96 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
     TreeNodePool_type m_nodes;
     // Parsed failed?
     bool m_failed;
+    /**
+     * @brief save_snapshot_document write this document and its nested
+     * documents to the snapshot stream
+     */
+    void save_snapshot_document(std::ostream& out) const;
+    /**
+     * @brief load_snapshot_document read this document and its nested
+     * documents from the snapshot stream
+     */
+    bool load_snapshot_document(std::istream& in);
+
+    /**
+     * @brief document_cache_type acquire the DocumentCache key of this
+     * document's interpreter type and the modes that determine its content
+     */
+    std::string document_cache_type() const;
+    /**
+     * @brief restore_cached_document restore the DocumentCache's copy of the
+     * document at the given node and path into the given nested interpreter
+     * and attach it
+     * @return true, iff a cached copy was attached, otherwise the nested
+     * interpreter is unchanged
+     */
+    bool restore_cached_document(size_t             node_index,
+                                 const std::string& path,
+                                 Interpreter*       interp);
+    /**
+     * @brief cache_document add the given loaded document to the
+     * DocumentCache
+     */
+    void cache_document(const Interpreter* document, const std::string& path) const;
+    /**
+     * @brief document_paths acquire the canonical paths of this document and
+     * its nested documents, and the stamps of their files
+     */
+    void document_paths(DocumentCache::Entry& entry) const;
+    /**
+     * @brief set_document_stamps assign the stamps of this document and its
+     * nested documents, in the order of document_paths
+     */
+    void set_document_stamps(
+        const std::vector<DocumentCache::FileStamp>& file_stamps,
+        size_t&                                      index);
+    /**
+     * @brief rename_document name this document's stream, and those of its
+     * nested documents relative to it
+     * Nested documents that were found adjacent to this document are named
+     * adjacent to its new name. Those found on a search path, or by their
+     * absolute path, keep their names.
+     */
+    void rename_document(const std::string& name);
+    // the stamp of this document's file, taken before the file was read
+    DocumentCache::FileStamp m_document_stamp;
+
+    /**
+     * @brief PendingDocument an included document queued for interpretation
+     */
+    struct PendingDocument
+    {
+        PendingDocument()
+            : m_node_index(0), m_interpreter(nullptr), m_loaded(false)
+        {
+        }
+        size_t             m_node_index;
+        std::string        m_path;
+        Interpreter*       m_interpreter;
+        bool               m_loaded;
+        std::exception_ptr m_exception;
+        // the included document's diagnostics
+        DeferredDiagnostics m_diagnostics;
+        // this document's diagnostics following the include
+        DeferredDiagnostics m_following_diagnostics;
+    };
+    /**
+     * @brief load_pending_documents interpret the queued documents
+     * concurrently, on the threads of the DocumentWorkers pool, and attach
+     * them in the order they were queued
+     * @return true, iff all documents were successfully interpreted
+     */
+    bool load_pending_documents();
+    /**
+     * @brief discard_pending_documents discard the queued documents without
+     * interpreting them
+     */
+    void discard_pending_documents();
+    std::deque<PendingDocument> m_pending_documents;
+    // diagnostics deferral in effect when the first document was queued
+    DeferredDiagnostics* m_pending_diagnostics;
+    size_t               m_document_threads;
+    bool                 m_parsing;
 
   protected:
     struct Stage
@@ -1063,6 +1746,38 @@ class WASP_PUBLIC Interpreter : public AbstractInterpreter
     InterpNodeMap m_interp_node;
     NodeInterpMap m_node_interp;
     NodeInterpPathMap m_node_interp_path;
+    /**
+     * @brief renumber translate the root, staged, and nested document node
+     * indices after the nodes are renumbered
+     * @param new_index the new index of each node, indexed by its prior index
+     */
+    void renumber(const std::vector<size_t>& new_index);
+
+  private:
+    StreamHandler* m_stream_handler;
+    // tokens discarded with streamed nodes, the difference between a token's
+    // index as lexed and its index in the token pool
+    size_t m_discarded_tokens;
+    // the bracket and brace nesting depth of the streamed document
+    size_t m_stream_depth;
+    // the end of the last streamed construct
+    size_t m_stream_last_line;
+    size_t m_stream_last_column;
+    /**
+     * @brief stream emit the events of the given subtrees to the stream
+     * handler and discard their nodes
+     * Subtrees that include another document are instead retained as
+     * children of the root once their events are emitted.
+     */
+    void stream(const std::vector<size_t>& node_indices);
+    /**
+     * @brief stream_events emit the events of the given subtree, and of any
+     * documents it includes, to the handler, if any, and lower first_index to
+     * the subtree's least node
+     */
+    void stream_events(StreamHandler* handler,
+                       size_t         node_index,
+                       size_t&        first_index) const;
 };
 
 #include "waspcore/Interpreter.i.h"
@@ -3,7 +3,7 @@ Diagnostic&
 Diagnostic::operator<< (const X& x)
 {
     *msg << x;
-    interpreter->error_stream() << x;
+    interpreter->diagnostic_stream() << x;
     return *this;
 }
 
@@ -15,7 +15,15 @@ Interpreter<NodeStorage>::Interpreter(std::ostream& err)
     , m_stream_name("stream input")
     , m_error_stream(err)
     , m_failed(false)
+    , m_pending_diagnostics(nullptr)
+    , m_document_threads(0)
+    , m_parsing(false)
     , m_root_index(-1)
+    , m_stream_handler(nullptr)
+    , m_discarded_tokens(0)
+    , m_stream_depth(0)
+    , m_stream_last_line(0)
+    , m_stream_last_column(0)
 {
     // All documents have a root.
     // However, if no elements are parsed
@@ -25,6 +33,7 @@ Interpreter<NodeStorage>::Interpreter(std::ostream& err)
 template<class NodeStorage>
 Interpreter<NodeStorage>::~Interpreter()
 {
+    discard_pending_documents();
     for (auto itr = m_node_interp.begin(); itr != m_node_interp.end(); ++itr)
     {
         delete itr->second;
@@ -92,7 +101,15 @@ size_t Interpreter<NodeStorage>::push_leaf(size_t      node_type,
                                            size_t      token_index)
 {
     size_t node_index = node_count();
-    m_nodes.push_leaf(node_type, node_name, token_index);
+    if (m_stream_handler != nullptr)
+    {
+        if (node_type == wasp::LBRACE || node_type == wasp::LBRACKET)
+            ++m_stream_depth;
+        else if ((node_type == wasp::RBRACE || node_type == wasp::RBRACKET) &&
+                 m_stream_depth > 0)
+            --m_stream_depth;
+    }
+    m_nodes.push_leaf(node_type, node_name, token_index - m_discarded_tokens);
     return node_index;
 }
 template<class NodeStorage>
@@ -182,7 +199,7 @@ const char* Interpreter<NodeStorage>::token_data(size_t index) const
     {
         return nullptr;
     }
-    return token_pool.str(index);
+    return token_pool.str(index - m_discarded_tokens);
 }
 
 template<class NodeStorage>
@@ -194,7 +211,7 @@ size_t Interpreter<NodeStorage>::token_line(size_t index) const
     {
         return 0;
     }
-    return token_pool.line(index);
+    return token_pool.line(index - m_discarded_tokens);
 }
 
 template<class NodeStorage>
@@ -207,19 +224,35 @@ bool Interpreter<NodeStorage>::parse_impl(std::istream&      in,
     //    lexer.set_debug(m_trace_lexing);
     //    lexer.set_debug(true);
 
+    wasp_insist(!frozen(), "a frozen document must be reset before parsing!");
     m_stream_name  = stream_name;
     m_start_line   = start_line;
     m_start_column = start_column;
     m_nodes.set_start_line(start_line);
     m_nodes.set_start_column(start_column);
+    // a mapped file's lines are recorded in a single sweep of the mapping
+    // rather than by the lexer as it scans each newline
+    auto* mapped = dynamic_cast<MappedFileBuffer*>(in.rdbuf());
+    auto& tokens = m_nodes.token_data();
+    if (mapped != nullptr && mapped->is_open() && tokens.size() == 0 &&
+        tokens.line_count() == 0 && in.tellg() == std::streampos(0))
+    {
+        tokens.index_newlines(mapped->data(), mapped->size());
+    }
     PARSER_IMPL parser(*this, in, nullptr);
     //    parser.set_debug_level(true);
 
+    // included documents are queued during the parse
+    m_parsing = true;
+    int status = parser.parse();
+    m_parsing = false;
+    if (!load_pending_documents()) set_failed(true);
+
     // parsed is understood to be that
     // the parse method did not immediately fail (i.e., non-zero return)
     // and that an underlying parse did not fail (i.e. the failed flag was
     // assigned true)
-    bool parsed = parser.parse() == 0 && !failed();
+    bool parsed = status == 0 && !failed();
 
     commit_stages();
 
@@ -261,11 +294,25 @@ Interpreter<NodeStorage>::push_staged(size_t                     node_type,
                                       const std::string&         node_name,
                                       const std::vector<size_t>& child_indices)
 {
+    bool streamed = m_stream_handler != nullptr && !m_staged.empty();
     m_staged.push_back(Stage());
     auto& back           = m_staged.back();
     back.m_type          = node_type;
     back.m_name          = node_name;
-    back.m_child_indices = child_indices;
+    if (!streamed)
+    {
+        back.m_child_indices = child_indices;
+        return m_staged.size() - 1;
+    }
+    // a streamed stage is started by its header and ended when committed
+    size_t line = 0, column = 0;
+    if (!child_indices.empty())
+    {
+        line   = m_nodes.line(child_indices.front());
+        column = m_nodes.column(child_indices.front());
+    }
+    m_stream_handler->start_object(node_type, back.m_name, line, column);
+    stream(child_indices);
     return m_staged.size() - 1;
 }
 
@@ -274,6 +321,11 @@ size_t Interpreter<NodeStorage>::push_staged_child(size_t child_index)
 {
     wasp_require(m_staged.empty() == false);
     auto& back = m_staged.back();
+    if (m_stream_handler != nullptr)
+    {
+        stream({child_index});
+        return back.m_child_indices.size();
+    }
     back.m_child_indices.push_back(child_index);
     return back.m_child_indices.size();
 }
@@ -284,6 +336,13 @@ size_t Interpreter<NodeStorage>::commit_staged(size_t stage_index)
     wasp_require(stage_index < m_staged.size());
 
     Stage& stage = m_staged[stage_index];
+    if (m_stream_handler != nullptr && stage_index > 0)
+    {
+        m_stream_handler->end_object(stage.m_type, stage.m_name,
+                                     m_stream_last_line, m_stream_last_column);
+        m_staged.pop_back();
+        return m_nodes.size();
+    }
     size_t node_index =
         push_parent(stage.m_type, stage.m_name.c_str(), stage.m_child_indices);
 
@@ -296,6 +355,99 @@ size_t Interpreter<NodeStorage>::commit_staged(size_t stage_index)
     return node_index;
 }
 
+template<class NodeStorage>
+bool Interpreter<NodeStorage>::stream_root_members(
+    const std::vector<size_t>& child_indices)
+{
+    if (m_stream_handler == nullptr || m_stream_depth != 1)
+        return false;
+    stream(child_indices);
+    return true;
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::stream(const std::vector<size_t>& node_indices)
+{
+    if (node_indices.empty())
+        return;
+    size_t first_index = node_count();
+    for (size_t node_index : node_indices)
+    {
+        stream_events(m_stream_handler, node_index, first_index);
+    }
+    m_stream_last_line   = m_nodes.last_line(node_indices.back());
+    m_stream_last_column = m_nodes.last_column(node_indices.back());
+    // included documents are attached to their nodes, which are retained
+    if (m_node_interp_path.lower_bound(first_index) !=
+        m_node_interp_path.end())
+    {
+        auto& root = m_staged.front().m_child_indices;
+        root.insert(root.end(), node_indices.begin(), node_indices.end());
+        return;
+    }
+    m_discarded_tokens += m_nodes.discard(first_index);
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::stream_document(StreamHandler* handler) const
+{
+    if (m_nodes.size() == 0)
+        return;
+    size_t first_index = m_nodes.size();
+    size_t child_count = m_nodes.child_count(m_root_index);
+    for (size_t i = 0; i < child_count; ++i)
+    {
+        stream_events(handler, m_nodes.child_at(m_root_index, i), first_index);
+    }
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::stream_events(StreamHandler* handler,
+                                             size_t         node_index,
+                                             size_t&        first_index) const
+{
+    first_index = std::min(first_index, node_index);
+    size_t type = m_nodes.type(node_index);
+    if (m_nodes.is_leaf(node_index))
+    {
+        if (handler != nullptr && type == wasp::VALUE)
+        {
+            std::string buffer;
+            handler->value(m_nodes.data_view(node_index, buffer),
+                           m_nodes.line(node_index),
+                           m_nodes.column(node_index));
+        }
+        return;
+    }
+    bool keyed = type == wasp::KEYED_VALUE;
+    if (handler != nullptr)
+    {
+        if (keyed)
+            handler->key(m_nodes.name_view(node_index),
+                         m_nodes.line(node_index), m_nodes.column(node_index));
+        else
+            handler->start_object(type, m_nodes.name_view(node_index),
+                                  m_nodes.line(node_index),
+                                  m_nodes.column(node_index));
+    }
+    size_t child_count = m_nodes.child_count(node_index);
+    for (size_t i = 0; i < child_count; ++i)
+    {
+        stream_events(handler, m_nodes.child_at(node_index, i), first_index);
+    }
+    // the included document's events follow the include's own
+    if (handler != nullptr)
+    {
+        const AbstractInterpreter* included = document(node_index);
+        if (included != nullptr)
+            included->stream_document(handler);
+    }
+    if (handler != nullptr && !keyed)
+        handler->end_object(type, m_nodes.name_view(node_index),
+                            m_nodes.last_line(node_index),
+                            m_nodes.last_column(node_index));
+}
+
 template<class NodeStorage>
 void Interpreter<NodeStorage>::add_document_path(size_t node_index,
                                                         const std::string& path)
@@ -353,22 +505,36 @@ bool Interpreter<NodeStorage>::load_document(size_t node_index,
                            << std::endl;
             return false;
         }
-
         auto * interp = create_nested_interpreter(this);
         wasp_check(interp);
-        if ( !interp->parseFile(document_path) )
+        if (has_line_index()) interp->enable_line_index();
+        if (type_indexed()) interp->enable_type_index();
+        if (restore_cached_document(node_index, document_path, interp))
         {
-            passed &= false;
-            delete interp;
+            return true;
         }
-        else
+        interp->set_document_threads(document_threads());
+
+        if (m_pending_documents.empty())
         {
-            wasp_check(m_node_interp.find(node_index)
-                       == m_node_interp.end());
-            wasp_check(m_interp_node.find(interp)
-                       == m_interp_node.end());
-            m_node_interp[node_index] = interp;
-            m_interp_node[interp] = node_index;
+            m_pending_diagnostics = deferred_diagnostics();
+        }
+        m_pending_documents.emplace_back();
+        auto& pending         = m_pending_documents.back();
+        pending.m_node_index  = node_index;
+        pending.m_path        = document_path;
+        pending.m_interpreter = interp;
+        // capture the document's diagnostics, and those of this document
+        // that follow the include, so they are reported in document order
+        interp->defer_diagnostics(&pending.m_diagnostics);
+        defer_diagnostics(&pending.m_following_diagnostics);
+
+        // outside of a parse there are no further documents to wait for
+        // a streamed document's events are emitted as it is parsed
+        if (!m_parsing || !concurrent_documents() ||
+            m_stream_handler != nullptr)
+        {
+            passed &= load_pending_documents();
         }
     }
     else
@@ -383,6 +549,205 @@ bool Interpreter<NodeStorage>::load_document(size_t node_index,
     return passed;
 }
 
+template<class NodeStorage>
+bool Interpreter<NodeStorage>::load_pending_documents()
+{
+    if (m_pending_documents.empty()) return true;
+
+    auto load = [this](size_t i)
+    {
+        auto& pending = m_pending_documents[i];
+        // the file is stamped before it is read, so that a change while it
+        // is read keeps the document from being cached
+        if (DocumentCache::instance().enabled())
+        {
+            DocumentCache::stamp(pending.m_path,
+                                 pending.m_interpreter->m_document_stamp);
+        }
+        try
+        {
+            pending.m_loaded = pending.m_interpreter->parseFile(pending.m_path);
+        }
+        catch (...)
+        {
+            pending.m_exception = std::current_exception();
+        }
+    };
+    size_t thread_count = document_threads();
+    if (thread_count == 0) thread_count = std::thread::hardware_concurrency();
+    // this thread interprets documents as well
+    size_t worker_limit = thread_count > 1 ? thread_count - 1 : 0;
+    DocumentWorkers::instance().run(m_pending_documents.size(), worker_limit,
+                                    load);
+
+    // attach documents and report diagnostics in the order of inclusion
+    defer_diagnostics(m_pending_diagnostics);
+    bool               passed = true;
+    std::exception_ptr exception;
+    for (auto& pending : m_pending_documents)
+    {
+        auto* interp = pending.m_interpreter;
+        interp->defer_diagnostics(nullptr);
+        report_diagnostics(pending.m_diagnostics);
+        if (pending.m_exception && !exception)
+        {
+            exception = pending.m_exception;
+        }
+        if (!pending.m_loaded)
+        {
+            passed &= false;
+            delete interp;
+        }
+        else
+        {
+            wasp_check(m_node_interp.find(pending.m_node_index)
+                       == m_node_interp.end());
+            wasp_check(m_interp_node.find(interp)
+                       == m_interp_node.end());
+            m_node_interp[pending.m_node_index] = interp;
+            m_interp_node[interp] = pending.m_node_index;
+            // only documents interpreted without diagnostics are shared, so
+            // that each inclusion reports the same diagnostics
+            if (pending.m_diagnostics.diagnostics.empty() &&
+                pending.m_diagnostics.messages.tellp() <= 0)
+            {
+                cache_document(interp, pending.m_path);
+            }
+        }
+        report_diagnostics(pending.m_following_diagnostics);
+    }
+    m_pending_documents.clear();
+    if (exception) std::rethrow_exception(exception);
+    return passed;
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::discard_pending_documents()
+{
+    if (m_pending_documents.empty()) return;
+    defer_diagnostics(m_pending_diagnostics);
+    for (auto& pending : m_pending_documents)
+    {
+        delete pending.m_interpreter;
+    }
+    m_pending_documents.clear();
+}
+
+template<class NodeStorage>
+std::string Interpreter<NodeStorage>::document_cache_type() const
+{
+    // the node storage and its layout policy are part of the type, the
+    // remaining modes are chosen at runtime
+    std::string type = typeid(*this).name();
+    if (has_line_index()) type += " line indexed";
+    if (type_indexed()) type += " type indexed";
+    if (preordered()) type += " preordered";
+    if (m_nodes.packed_array_count() > 0) type += " packed";
+    if (frozen()) type += " frozen";
+    return type;
+}
+
+template<class NodeStorage>
+bool Interpreter<NodeStorage>::restore_cached_document(size_t node_index,
+                                                       const std::string& path,
+                                                       Interpreter* interp)
+{
+    // documents that interpret into their parent cannot be restored apart
+    // from it
+    auto& cache = DocumentCache::instance();
+    if (!concurrent_documents() || !cache.enabled()) return false;
+    auto entry = cache.find(interp->document_cache_type(), path);
+    if (!entry) return false;
+
+    // reinterpret a document that would include an including document so
+    // the circular reference is reported
+    for (const AbstractInterpreter* doc = this; doc != nullptr;
+         doc = doc->document_parent())
+    {
+        std::string canonical = DocumentCache::canonical_path(doc->stream_name());
+        if (!canonical.empty() &&
+            std::find(entry->paths.begin(), entry->paths.end(), canonical)
+                != entry->paths.end())
+        {
+            return false;
+        }
+    }
+
+    // the entry is immutable and outlives the read, so is read in place
+    SnapshotBuffer buffer(entry->snapshot.data(), entry->snapshot.size());
+    std::istream   in(&buffer);
+    if (!interp->load_snapshot_document(in)) return false;
+    interp->rename_document(path);
+    size_t stamp_index = 0;
+    interp->set_document_stamps(entry->file_stamps, stamp_index);
+    wasp_check(m_node_interp.find(node_index) == m_node_interp.end());
+    m_node_interp[node_index] = interp;
+    m_interp_node[interp] = node_index;
+    return true;
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::cache_document(const Interpreter* document,
+                                              const std::string& path) const
+{
+    auto& cache = DocumentCache::instance();
+    if (!concurrent_documents() || !cache.enabled()) return;
+    DocumentCache::Entry entry;
+    document->document_paths(entry);
+    std::stringstream out;
+    document->save_snapshot_document(out);
+    entry.snapshot = out.str();
+    cache.insert(document->document_cache_type(), path, std::move(entry));
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::document_paths(DocumentCache::Entry& entry) const
+{
+    entry.paths.push_back(DocumentCache::canonical_path(m_stream_name));
+    entry.file_stamps.push_back(m_document_stamp);
+    for (const auto& node_interp : m_node_interp)
+    {
+        static_cast<const Interpreter*>(node_interp.second)
+            ->document_paths(entry);
+    }
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::set_document_stamps(
+    const std::vector<DocumentCache::FileStamp>& file_stamps, size_t& index)
+{
+    wasp_check(index < file_stamps.size());
+    m_document_stamp = file_stamps[index++];
+    for (const auto& node_interp : m_node_interp)
+    {
+        const_cast<Interpreter*>(
+            static_cast<const Interpreter*>(node_interp.second))
+            ->set_document_stamps(file_stamps, index);
+    }
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::rename_document(const std::string& name)
+{
+    std::string prior_directory = wasp::dir_name(m_stream_name);
+    if (prior_directory == m_stream_name) prior_directory = ".";
+    m_stream_name = name;
+    std::string directory_name = wasp::dir_name(name);
+    if (directory_name == name) directory_name = ".";
+    for (const auto& node_interp : m_node_interp)
+    {
+        auto* interp = const_cast<Interpreter*>(
+            static_cast<const Interpreter*>(node_interp.second));
+        // nested documents that were included from adjacent to this
+        // document remain adjacent to it
+        const std::string& path = m_node_interp_path[node_interp.first];
+        interp->rename_document(interp->m_stream_name ==
+                                        prior_directory + "/" + path
+                                    ? directory_name + "/" + path
+                                    : interp->m_stream_name);
+    }
+}
+
 template<class NodeStorage>
 bool Interpreter<NodeStorage>::path_already_included(const std::string& path) const
 {
@@ -408,3 +773,292 @@ size_t Interpreter<NodeStorage>::document_node(const AbstractInterpreter* docume
     if (itr == m_interp_node.end()) return size(); // size() = 'unknown'
     return itr->second;
 }
+
+template<class NodeStorage>
+bool Interpreter<NodeStorage>::save_snapshot(const std::string& path) const
+{
+    std::ofstream out(path.c_str(), std::ios_base::binary);
+    if (!out.good()) return false;
+    return save_snapshot(out);
+}
+
+template<class NodeStorage>
+bool Interpreter<NodeStorage>::save_snapshot(std::ostream& out) const
+{
+    const std::uint8_t type_sizes[] = {
+        sizeof(node_type_size), sizeof(node_index_size),
+        sizeof(token_type_size), sizeof(token_index_type_size),
+        sizeof(file_offset_type_size)};
+    out.write(snapshot_magic, sizeof(snapshot_magic));
+    write_binary(out, snapshot_version);
+    write_binary(out, type_sizes);
+    save_snapshot_document(out);
+    out.flush();
+    return out.good();
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::save_snapshot_document(std::ostream& out) const
+{
+    write_binary(out, m_stream_name);
+    write_binary(out, static_cast<std::uint64_t>(m_start_line));
+    write_binary(out, static_cast<std::uint64_t>(m_start_column));
+    write_binary(out, static_cast<std::uint64_t>(m_root_index));
+    write_binary(out, m_failed);
+    m_nodes.save(out);
+    // nested documents, in node order, whether or not they were loaded
+    write_binary(out, static_cast<std::uint64_t>(m_node_interp_path.size()));
+    for (const auto& node_path : m_node_interp_path)
+    {
+        write_binary(out, static_cast<std::uint64_t>(node_path.first));
+        write_binary(out, node_path.second);
+        auto itr = m_node_interp.find(node_path.first);
+        bool loaded = itr != m_node_interp.end();
+        write_binary(out, loaded);
+        if (loaded)
+        {
+            static_cast<const Interpreter*>(itr->second)
+                ->save_snapshot_document(out);
+        }
+    }
+}
+
+template<class NodeStorage>
+bool Interpreter<NodeStorage>::load_snapshot(const std::string& path)
+{
+    MappedFile in(path);
+    if (!in.good())
+    {
+        error_diagnostic()
+            << position(&path)
+            << " is either inaccessible or doesn't exist! Unable to read."
+            << std::endl;
+        return false;
+    }
+    if (!load_snapshot(in))
+    {
+        error_diagnostic()
+            << position(&path) << " is not a valid version "
+            << snapshot_version << " snapshot for this interpreter!"
+            << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template<class NodeStorage>
+bool Interpreter<NodeStorage>::load_snapshot(std::istream& in)
+{
+    wasp_insist(!frozen(), "a frozen document must be reset before loading!");
+    char         magic[sizeof(snapshot_magic)];
+    std::uint32_t version = 0;
+    std::uint8_t type_sizes[5];
+    const std::uint8_t expected_type_sizes[] = {
+        sizeof(node_type_size), sizeof(node_index_size),
+        sizeof(token_type_size), sizeof(token_index_type_size),
+        sizeof(file_offset_type_size)};
+    if (!read_binary(in, magic) ||
+        !std::equal(magic, magic + sizeof(magic), snapshot_magic) ||
+        !read_binary(in, version) || version != snapshot_version ||
+        !read_binary(in, type_sizes) ||
+        !std::equal(type_sizes, type_sizes + sizeof(type_sizes),
+                    expected_type_sizes))
+    {
+        return false;
+    }
+    return load_snapshot_document(in);
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::reset()
+{
+    discard_pending_documents();
+    for (auto itr = m_node_interp.begin(); itr != m_node_interp.end(); ++itr)
+    {
+        delete itr->second;
+    }
+    m_node_interp.clear();
+    m_interp_node.clear();
+    m_node_interp_path.clear();
+    error_diagnostics().clear();
+
+    m_nodes.clear();
+    m_start_line   = 1;
+    m_start_column = 1;
+    m_stream_name  = "stream input";
+    m_failed       = false;
+    m_root_index   = -1;
+    m_discarded_tokens   = 0;
+    m_stream_depth       = 0;
+    m_stream_last_line   = 0;
+    m_stream_last_column = 0;
+    m_staged.clear();
+    // as on construction, the document root is not staged through overrides
+    Interpreter::push_staged(wasp::DOCUMENT_ROOT, "document", {});
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::freeze()
+{
+    m_nodes.freeze();
+    for (const auto& node_interp : m_node_interp)
+    {
+        const_cast<AbstractInterpreter*>(node_interp.second)->freeze();
+    }
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::enable_type_index()
+{
+    wasp_insist(!frozen(), "a frozen document cannot be type indexed!");
+    m_nodes.enable_type_index();
+    for (const auto& node_interp : m_node_interp)
+    {
+        static_cast<Interpreter*>(const_cast<AbstractInterpreter*>(
+                                      node_interp.second))
+            ->enable_type_index();
+    }
+}
+
+template<class NodeStorage>
+std::vector<size_t> Interpreter<NodeStorage>::relayout()
+{
+    wasp_insist(!frozen(), "a frozen document cannot be relaid out!");
+    std::vector<size_t> new_index = m_nodes.relayout();
+    renumber(new_index);
+    for (const auto& entry : m_node_interp)
+    {
+        static_cast<Interpreter*>(const_cast<AbstractInterpreter*>(entry.second))
+            ->relayout();
+    }
+    return new_index;
+}
+
+template<class NodeStorage>
+std::vector<size_t> Interpreter<NodeStorage>::pack_arrays(size_t min_size)
+{
+    wasp_insist(!frozen(), "a frozen document cannot be packed!");
+    std::vector<size_t> new_index = m_nodes.pack_arrays(min_size);
+    renumber(new_index);
+    for (const auto& entry : m_node_interp)
+    {
+        static_cast<Interpreter*>(const_cast<AbstractInterpreter*>(entry.second))
+            ->pack_arrays(min_size);
+    }
+    return new_index;
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::renumber(const std::vector<size_t>& new_index)
+{
+    if (m_root_index < new_index.size())
+    {
+        m_root_index = new_index[m_root_index];
+    }
+    for (auto& stage : m_staged)
+    {
+        for (auto& child_index : stage.m_child_indices)
+        {
+            child_index = new_index[child_index];
+        }
+    }
+    NodeInterpMap     node_interp;
+    NodeInterpPathMap node_interp_path;
+    for (const auto& entry : m_node_interp)
+    {
+        auto node_index = static_cast<node_index_size>(new_index[entry.first]);
+        node_interp[node_index] = entry.second;
+        m_interp_node[entry.second] = node_index;
+    }
+    for (const auto& entry : m_node_interp_path)
+    {
+        node_interp_path[static_cast<node_index_size>(
+            new_index[entry.first])] = entry.second;
+    }
+    m_node_interp.swap(node_interp);
+    m_node_interp_path.swap(node_interp_path);
+}
+
+template<class NodeStorage>
+void Interpreter<NodeStorage>::reserve_for_bytes(size_t byte_count)
+{
+    // estimates for typical input - a token per 4 bytes, a parent node per
+    // 2 tokens, and a line per 32 bytes
+    size_t token_count = byte_count / 4;
+    size_t node_count  = token_count + token_count / 2;
+    size_t line_count  = byte_count / 32;
+    // token data is at most the input plus a null terminator per token
+    m_nodes.reserve(node_count, token_count, byte_count + token_count,
+                    line_count);
+}
+
+template<class NodeStorage>
+bool Interpreter<NodeStorage>::load_snapshot_document(std::istream& in)
+{
+    // the document and its nested documents are read aside, replacing the
+    // existing document only once completely read
+    std::string       stream_name;
+    bool              failed = false;
+    TreeNodePool_type nodes;
+    if (m_nodes.type_indexed())
+        nodes.enable_type_index();
+    std::uint64_t start_line = 0, start_column = 0, root_index = 0,
+                  document_count = 0;
+    if (!read_binary(in, stream_name) || !read_binary(in, start_line) ||
+        !read_binary(in, start_column) || !read_binary(in, root_index) ||
+        !read_binary(in, failed) || !nodes.load(in) ||
+        !read_binary(in, document_count) ||
+        (nodes.size() > 0 && root_index >= nodes.size()))
+    {
+        return false;
+    }
+
+    InterpNodeMap     interp_node;
+    NodeInterpMap     node_interp;
+    NodeInterpPathMap node_interp_path;
+    bool              loaded_documents = true;
+    for (std::uint64_t d = 0; d < document_count && loaded_documents; ++d)
+    {
+        std::uint64_t node_index = 0;
+        std::string   path;
+        bool          loaded = false;
+        if (!read_binary(in, node_index) || !read_binary(in, path) ||
+            !read_binary(in, loaded) || node_index >= nodes.size())
+        {
+            loaded_documents = false;
+            break;
+        }
+        node_interp_path[static_cast<node_index_size>(node_index)] = path;
+        if (!loaded) continue;
+
+        auto* interp = create_nested_interpreter(this);
+        wasp_check(interp);
+        node_interp[static_cast<node_index_size>(node_index)] = interp;
+        interp_node[interp] = static_cast<node_index_size>(node_index);
+        loaded_documents = interp->load_snapshot_document(in);
+    }
+    if (!loaded_documents)
+    {
+        for (auto itr = node_interp.begin(); itr != node_interp.end(); ++itr)
+        {
+            delete itr->second;
+        }
+        return false;
+    }
+
+    // discard the existing document
+    for (auto itr = m_node_interp.begin(); itr != m_node_interp.end(); ++itr)
+    {
+        delete itr->second;
+    }
+    m_node_interp.swap(node_interp);
+    m_interp_node.swap(interp_node);
+    m_node_interp_path.swap(node_interp_path);
+    m_nodes.swap(nodes);
+    m_stream_name.swap(stream_name);
+    m_failed       = failed;
+    m_start_line   = static_cast<size_t>(start_line);
+    m_start_column = static_cast<size_t>(start_column);
+    m_root_index   = static_cast<size_t>(root_index);
+    return true;
+}
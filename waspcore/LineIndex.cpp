@@ -0,0 +1,36 @@
+#include "waspcore/LineIndex.h"
+#include <algorithm>
+
+namespace wasp
+{
+void LineIndex::index(const char* data, std::size_t size)
+{
+    m_newlines.clear();
+    m_size = size;
+    find_newlines(data, size, m_newlines);
+}
+
+std::size_t LineIndex::line(std::size_t offset) const
+{
+    return static_cast<std::size_t>(std::distance(
+               m_newlines.begin(), std::lower_bound(m_newlines.begin(),
+                                                    m_newlines.end(), offset))) +
+           1;
+}
+
+std::size_t LineIndex::column(std::size_t offset) const
+{
+    std::size_t line_index = line(offset) - 1;
+    std::size_t start = line_index == 0 ? 0 : m_newlines[line_index - 1] + 1;
+    return offset - start + 1;
+}
+
+std::size_t LineIndex::offset(std::size_t line, std::size_t column) const
+{
+    if (line == 0 || line > line_count())
+        return m_size;
+    std::size_t start = line == 1 ? 0 : m_newlines[line - 2] + 1;
+    std::size_t end   = line > m_newlines.size() ? m_size : m_newlines[line - 1];
+    return std::min(start + (column == 0 ? 0 : column - 1), end);
+}
+}  // namespace wasp
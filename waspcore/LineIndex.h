@@ -0,0 +1,154 @@
+#ifndef WASP_LINEINDEX_H
+#define WASP_LINEINDEX_H
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define WASP_NEWLINE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WASP_NEWLINE_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+namespace detail
+{
+/**
+ * @brief push_newlines append the offset of each set bit of a comparison mask
+ * @param offset the offset of the mask's first byte
+ */
+template<typename T>
+inline void
+push_newlines(unsigned mask, std::size_t offset, std::vector<T>& offsets)
+{
+    while (mask != 0)
+    {
+#if defined(_MSC_VER)
+        unsigned long bit;
+        _BitScanForward(&bit, mask);
+#else
+        unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+        offsets.push_back(static_cast<T>(offset + bit));
+        mask &= mask - 1;
+    }
+}
+}  // namespace detail
+
+/**
+ * @brief find_newlines append the offset of every newline of the buffer
+ * The buffer is compared 32 bytes at a time when compiled for AVX2 (e.g.,
+ * -mavx2), 16 bytes at a time with SSE2, the x86-64 baseline, and otherwise
+ * searched with std::memchr.
+ * @param data the buffer
+ * @param size the buffer's size in bytes
+ * @param offsets the offsets to which the newlines' offsets are appended
+ * @param base_offset the offset of the buffer's first byte
+ */
+template<typename T>
+void find_newlines(const char*     data,
+                   std::size_t     size,
+                   std::vector<T>& offsets,
+                   std::size_t     base_offset = 0)
+{
+    std::size_t i = 0;
+#if defined(WASP_NEWLINE_AVX2)
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i chunk =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        detail::push_newlines(static_cast<unsigned>(_mm256_movemask_epi8(
+                                  _mm256_cmpeq_epi8(chunk, newline))),
+                              base_offset + i, offsets);
+    }
+#elif defined(WASP_NEWLINE_SSE2)
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i chunk =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        detail::push_newlines(static_cast<unsigned>(_mm_movemask_epi8(
+                                  _mm_cmpeq_epi8(chunk, newline))),
+                              base_offset + i, offsets);
+    }
+#else
+    for (const char* p = data; size > 0;)
+    {
+        p = static_cast<const char*>(
+            std::memchr(p, '\n', size - static_cast<std::size_t>(p - data)));
+        if (p == nullptr)
+            break;
+        offsets.push_back(static_cast<T>(base_offset + (p - data)));
+        if (++p == data + size)
+            break;
+    }
+    i = size;
+#endif
+    for (; i < size; ++i)
+    {
+        if (data[i] == '\n')
+            offsets.push_back(static_cast<T>(base_offset + i));
+    }
+}
+
+/**
+ * @brief The LineIndex class maps between the byte offsets and the (1-based)
+ * lines and columns of text
+ * Unlike a document's token pool, the index needs no interpretation of the
+ * text, suiting an editor's position conversions of text as it is typed.
+ * A newline belongs to the line it ends.
+ */
+class WASP_PUBLIC LineIndex
+{
+  public:
+    LineIndex() : m_size(0) {}
+    LineIndex(const char* data, std::size_t size) { index(data, size); }
+    explicit LineIndex(const std::string& text)
+    {
+        index(text.data(), text.size());
+    }
+
+    /**
+     * @brief index replace the indexed text's lines with the given text's
+     */
+    void index(const char* data, std::size_t size);
+
+    /**
+     * @brief line_count the number of lines, one more than the newlines
+     */
+    std::size_t line_count() const { return m_newlines.size() + 1; }
+    /**
+     * @brief line acquire the (1-based) line of the given byte offset
+     */
+    std::size_t line(std::size_t offset) const;
+    /**
+     * @brief column acquire the (1-based) column of the given byte offset
+     */
+    std::size_t column(std::size_t offset) const;
+    /**
+     * @brief offset acquire the byte offset of the given (1-based) line and
+     * column
+     * @return the offset, limited to the line's end (its newline) and to the
+     * text's size
+     */
+    std::size_t offset(std::size_t line, std::size_t column) const;
+    /**
+     * @brief newlines acquire the byte offsets of the text's newlines
+     */
+    const std::vector<std::size_t>& newlines() const { return m_newlines; }
+
+  private:
+    std::vector<std::size_t> m_newlines;
+    std::size_t              m_size;
+};
+}  // namespace wasp
+#endif
@@ -0,0 +1,113 @@
+#include "waspcore/MappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wasp
+{
+MappedFileBuffer::MappedFileBuffer() : m_data(nullptr), m_size(0)
+{
+}
+
+MappedFileBuffer::~MappedFileBuffer()
+{
+    close();
+}
+
+bool MappedFileBuffer::open(const std::string& path)
+{
+    close();
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    // only regular, non-empty files can be mapped
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping remains valid after the descriptor is closed
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+    m_data = static_cast<char*>(addr);
+    m_size = size;
+    setg(m_data, m_data, m_data + m_size);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void MappedFileBuffer::close()
+{
+#ifndef _WIN32
+    if (m_data != nullptr)
+    {
+        ::munmap(m_data, m_size);
+    }
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    setg(nullptr, nullptr, nullptr);
+}
+
+MappedFileBuffer::pos_type
+MappedFileBuffer::seekoff(off_type                off,
+                          std::ios_base::seekdir  dir,
+                          std::ios_base::openmode which)
+{
+    if (!(which & std::ios_base::in) || !is_open())
+        return pos_type(off_type(-1));
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+        base = gptr() - eback();
+    else if (dir == std::ios_base::end)
+        base = static_cast<off_type>(m_size);
+    return seekpos(pos_type(base + off), which);
+}
+
+MappedFileBuffer::pos_type
+MappedFileBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    off_type offset = off_type(pos);
+    if (!(which & std::ios_base::in) || !is_open() || offset < 0 ||
+        offset > static_cast<off_type>(m_size))
+    {
+        return pos_type(off_type(-1));
+    }
+    setg(m_data, m_data + offset, m_data + m_size);
+    return pos;
+}
+
+MappedFile::MappedFile(const std::string& path) : std::istream(nullptr)
+{
+    if (m_mapped.open(path))
+    {
+        rdbuf(&m_mapped);
+    }
+    else if (m_file.open(path.c_str(), std::ios_base::in))
+    {
+        rdbuf(&m_file);
+    }
+    else
+    {
+        setstate(std::ios_base::failbit);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+}
+
+}  // end of namespace
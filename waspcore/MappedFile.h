@@ -0,0 +1,98 @@
+#ifndef WASP_MAPPEDFILE_H
+#define WASP_MAPPEDFILE_H
+
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The MappedFileBuffer class is a read-only stream buffer whose get
+ * area is the memory mapped content of a file
+ * Reading from the buffer copies directly out of the mapping, avoiding the
+ * intermediate read buffer and system calls of a std::filebuf. This is not a
+ * zero-copy read: scanners still copy the content into their own input
+ * buffer, and token text is still copied into the TokenPool. The mapping's
+ * content is also available in place, e.g., to sweep the file's newlines.
+ */
+class WASP_PUBLIC MappedFileBuffer : public std::streambuf
+{
+  public:
+    MappedFileBuffer();
+    ~MappedFileBuffer();
+
+    /**
+     * @brief open map the given file
+     * @param path the path to the file to map
+     * @return true, iff the file was mapped. Empty files and platforms
+     * without memory mapping support are not mapped.
+     */
+    bool open(const std::string& path);
+    /**
+     * @brief close unmap the file, if mapped
+     */
+    void close();
+    /**
+     * @brief is_open determine if a file is mapped
+     */
+    bool is_open() const { return m_data != nullptr; }
+    /**
+     * @brief data acquire the mapped file content
+     * @return the first byte of the mapping, or nullptr if not mapped
+     */
+    const char* data() const { return m_data; }
+    /**
+     * @brief size acquire the mapped file size in bytes
+     */
+    std::size_t size() const { return m_size; }
+
+  protected:
+    pos_type seekoff(off_type               off,
+                     std::ios_base::seekdir dir,
+                     std::ios_base::openmode which = std::ios_base::in);
+    pos_type seekpos(pos_type                pos,
+                     std::ios_base::openmode which = std::ios_base::in);
+
+  private:
+    MappedFileBuffer(const MappedFileBuffer&);
+    MappedFileBuffer& operator=(const MappedFileBuffer&);
+
+    char*       m_data;
+    std::size_t m_size;
+};
+
+/**
+ * @brief The MappedFile class is an input file stream reading from a memory
+ * mapping of the file when possible
+ * When the file cannot be mapped (e.g., empty files, special files, or
+ * platforms without mapping support) the stream falls back to a std::filebuf
+ * so it can be used wherever a std::ifstream was used for input. Parsing
+ * through it copies the same token data as a std::ifstream, so the peak
+ * memory of a parse is not reduced.
+ */
+class WASP_PUBLIC MappedFile : public std::istream
+{
+  public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    /**
+     * @brief is_mapped determine if the stream reads from a memory mapping
+     * @return false, if the stream fell back to a file buffer or failed to open
+     */
+    bool is_mapped() const { return m_mapped.is_open(); }
+
+  private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    MappedFileBuffer m_mapped;
+    std::filebuf     m_file;
+};
+}  // end of namespace
+#endif
@@ -0,0 +1,278 @@
+#ifndef WASP_NODEDATA_H
+#define WASP_NODEDATA_H
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "waspcore/Snapshot.h"
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The BasicNodeData struct describes all node's basic data
+ */
+template<typename NTS, typename NIS, typename TITS>
+struct BasicNodeData
+{
+    BasicNodeData() {}
+    BasicNodeData(NTS type, NIS parent_index, TITS name_index)
+        : m_node_type(type)
+        , m_parent_node_index(parent_index)
+        , m_name_index(name_index)
+    {
+    }
+
+    bool is_leaf() const { return m_token_index != static_cast<TITS>(-1); }
+    bool has_parent_data() const
+    {
+        return m_node_parent_data_index != static_cast<NIS>(-1);
+    }
+    /**
+     * @brief m_type the node type
+     */
+    NTS m_node_type = -1;
+    /**
+     * @brief m_parent_node_index the node's parent node index
+     */
+    NIS m_parent_node_index = -1;
+
+    /**
+     * @brief m_token_index the node's token data index
+     * Use is_leaf() to determine if this is assigned to
+     * existing token data (m_token_data[m_token_index])
+     */
+    TITS m_token_index = -1;
+    /**
+     * @brief m_node_parent_data_index node's parent data index
+     * Use has_parent_data() to determine if this is assigned to
+     * existing parent-node data (m_node_parent_data[m_node_parent_data_index])
+     */
+    NIS m_node_parent_data_index = -1;
+    /**
+     * @brief m_name_index the node's name symbol into m_node_names
+     */
+    TITS m_name_index = -1;
+};
+
+/**
+ * @brief The AoSNodeData class stores each node's basic data contiguously
+ * (array of structures)
+ * Suits access of several fields of a node at a time, such as when
+ * descending into a node's children or acquiring a leaf's token.
+ */
+template<typename NTS, typename NIS, typename TITS>
+class AoSNodeData
+{
+  public:
+    typedef BasicNodeData<NTS, NIS, TITS> BasicNodeData_type;
+
+    std::size_t size() const { return m_data.size(); }
+    bool        empty() const { return m_data.empty(); }
+    void        clear() { m_data.clear(); }
+    void        reserve(std::size_t count) { m_data.reserve(count); }
+    void        resize(std::size_t count) { m_data.resize(count); }
+    void        swap(AoSNodeData& other) { m_data.swap(other.m_data); }
+
+    void push_back(const BasicNodeData_type& data) { m_data.push_back(data); }
+    BasicNodeData_type record(std::size_t i) const { return m_data[i]; }
+
+    NTS  type(std::size_t i) const { return m_data[i].m_node_type; }
+    NIS  parent(std::size_t i) const { return m_data[i].m_parent_node_index; }
+    TITS token(std::size_t i) const { return m_data[i].m_token_index; }
+    NIS  parent_data(std::size_t i) const
+    {
+        return m_data[i].m_node_parent_data_index;
+    }
+    TITS name(std::size_t i) const { return m_data[i].m_name_index; }
+    bool is_leaf(std::size_t i) const { return m_data[i].is_leaf(); }
+    bool has_parent_data(std::size_t i) const
+    {
+        return m_data[i].has_parent_data();
+    }
+
+    void set_type(std::size_t i, NTS type) { m_data[i].m_node_type = type; }
+    void set_parent(std::size_t i, NIS parent)
+    {
+        m_data[i].m_parent_node_index = parent;
+    }
+    void set_token(std::size_t i, TITS token) { m_data[i].m_token_index = token; }
+    void set_parent_data(std::size_t i, NIS parent_data)
+    {
+        m_data[i].m_node_parent_data_index = parent_data;
+    }
+    void set_name(std::size_t i, TITS name) { m_data[i].m_name_index = name; }
+
+    /**
+     * @brief save write the node data to a snapshot as an array of each
+     * BasicNodeData field, the snapshot format of every layout
+     */
+    void save(std::ostream& out) const
+    {
+        write_field(out, m_data, &BasicNodeData_type::m_node_type);
+        write_field(out, m_data, &BasicNodeData_type::m_parent_node_index);
+        write_field(out, m_data, &BasicNodeData_type::m_token_index);
+        write_field(out, m_data, &BasicNodeData_type::m_node_parent_data_index);
+        write_field(out, m_data, &BasicNodeData_type::m_name_index);
+    }
+    bool load(std::istream& in)
+    {
+        m_data.clear();
+        return read_field(in, m_data, &BasicNodeData_type::m_node_type) &&
+               read_field(in, m_data, &BasicNodeData_type::m_parent_node_index) &&
+               read_field(in, m_data, &BasicNodeData_type::m_token_index) &&
+               read_field(in, m_data,
+                          &BasicNodeData_type::m_node_parent_data_index) &&
+               read_field(in, m_data, &BasicNodeData_type::m_name_index);
+    }
+
+  private:
+    std::vector<BasicNodeData_type> m_data;
+};
+
+/**
+ * @brief The SoANodeData class stores each basic data field of all nodes
+ * contiguously (structure of arrays)
+ * Suits scans that read a single field of many nodes, such as filtering
+ * nodes by type or walking parent chains, as only that field is brought into
+ * cache.
+ */
+template<typename NTS, typename NIS, typename TITS>
+class SoANodeData
+{
+  public:
+    typedef BasicNodeData<NTS, NIS, TITS> BasicNodeData_type;
+
+    std::size_t size() const { return m_types.size(); }
+    bool        empty() const { return m_types.empty(); }
+    void        clear()
+    {
+        m_types.clear();
+        m_parents.clear();
+        m_tokens.clear();
+        m_parent_data.clear();
+        m_names.clear();
+    }
+    void reserve(std::size_t count)
+    {
+        m_types.reserve(count);
+        m_parents.reserve(count);
+        m_tokens.reserve(count);
+        m_parent_data.reserve(count);
+        m_names.reserve(count);
+    }
+    void resize(std::size_t count)
+    {
+        m_types.resize(count);
+        m_parents.resize(count);
+        m_tokens.resize(count);
+        m_parent_data.resize(count);
+        m_names.resize(count);
+    }
+    void swap(SoANodeData& other)
+    {
+        m_types.swap(other.m_types);
+        m_parents.swap(other.m_parents);
+        m_tokens.swap(other.m_tokens);
+        m_parent_data.swap(other.m_parent_data);
+        m_names.swap(other.m_names);
+    }
+
+    void push_back(const BasicNodeData_type& data)
+    {
+        m_types.push_back(data.m_node_type);
+        m_parents.push_back(data.m_parent_node_index);
+        m_tokens.push_back(data.m_token_index);
+        m_parent_data.push_back(data.m_node_parent_data_index);
+        m_names.push_back(data.m_name_index);
+    }
+    BasicNodeData_type record(std::size_t i) const
+    {
+        BasicNodeData_type data(m_types[i], m_parents[i], m_names[i]);
+        data.m_token_index            = m_tokens[i];
+        data.m_node_parent_data_index = m_parent_data[i];
+        return data;
+    }
+
+    NTS  type(std::size_t i) const { return m_types[i]; }
+    NIS  parent(std::size_t i) const { return m_parents[i]; }
+    TITS token(std::size_t i) const { return m_tokens[i]; }
+    NIS  parent_data(std::size_t i) const { return m_parent_data[i]; }
+    TITS name(std::size_t i) const { return m_names[i]; }
+    bool is_leaf(std::size_t i) const
+    {
+        return m_tokens[i] != static_cast<TITS>(-1);
+    }
+    bool has_parent_data(std::size_t i) const
+    {
+        return m_parent_data[i] != static_cast<NIS>(-1);
+    }
+
+    void set_type(std::size_t i, NTS type) { m_types[i] = type; }
+    void set_parent(std::size_t i, NIS parent) { m_parents[i] = parent; }
+    void set_token(std::size_t i, TITS token) { m_tokens[i] = token; }
+    void set_parent_data(std::size_t i, NIS parent_data)
+    {
+        m_parent_data[i] = parent_data;
+    }
+    void set_name(std::size_t i, TITS name) { m_names[i] = name; }
+
+    /**
+     * @brief save write the node data to a snapshot as an array of each
+     * BasicNodeData field, the snapshot format of every layout
+     */
+    void save(std::ostream& out) const
+    {
+        write_binary(out, m_types);
+        write_binary(out, m_parents);
+        write_binary(out, m_tokens);
+        write_binary(out, m_parent_data);
+        write_binary(out, m_names);
+    }
+    bool load(std::istream& in)
+    {
+        if (!read_binary(in, m_types) || !read_binary(in, m_parents) ||
+            !read_binary(in, m_tokens) || !read_binary(in, m_parent_data) ||
+            !read_binary(in, m_names))
+        {
+            clear();
+            return false;
+        }
+        std::size_t count = m_types.size();
+        if (m_parents.size() != count || m_tokens.size() != count ||
+            m_parent_data.size() != count || m_names.size() != count)
+        {
+            clear();
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    std::vector<NTS>  m_types;
+    std::vector<NIS>  m_parents;
+    std::vector<TITS> m_tokens;
+    std::vector<NIS>  m_parent_data;
+    std::vector<TITS> m_names;
+};
+
+/**
+ * @brief AoSNodeLayout the TreeNodePool layout policy storing each node's
+ * basic data together, the default
+ */
+struct AoSNodeLayout
+{
+    template<typename NTS, typename NIS, typename TITS>
+    using storage = AoSNodeData<NTS, NIS, TITS>;
+};
+/**
+ * @brief SoANodeLayout the TreeNodePool layout policy storing each basic
+ * data field in a separate dense array
+ */
+struct SoANodeLayout
+{
+    template<typename NTS, typename NIS, typename TITS>
+    using storage = SoANodeData<NTS, NIS, TITS>;
+};
+}  // namespace wasp
+#endif
@@ -0,0 +1,156 @@
+#ifndef WASP_SNAPSHOT_H
+#define WASP_SNAPSHOT_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief snapshot_version the version of the snapshot file format
+ * Increment when the layout of any snapshotted data changes so that stale
+ * snapshots are rejected rather than misread.
+ */
+static const std::uint32_t snapshot_version = 4;
+/**
+ * @brief snapshot_magic the leading bytes identifying a snapshot file
+ */
+static const char snapshot_magic[8] = {'W', 'A', 'S', 'P', 'S', 'N', 'A', 'P'};
+
+/**
+ * @brief The SnapshotBuffer class is a read-only stream buffer over a
+ * snapshot held in memory
+ * Reading a snapshot through it reads the memory in place, where a
+ * std::istringstream would first copy the whole snapshot.
+ */
+class SnapshotBuffer : public std::streambuf
+{
+  public:
+    SnapshotBuffer(const char* data, std::size_t size)
+    {
+        // the get area is only read from
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+/**
+ * @brief write_binary writes the bytes of the given trivially copyable value
+ * Snapshots are written in native byte order and are not portable across
+ * architectures. Structures are written a field at a time, see write_field,
+ * so that their padding is never written.
+ */
+template<typename T>
+void write_binary(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+/**
+ * @brief read_binary reads the bytes of the given trivially copyable value
+ * @return true, iff the value was completely read
+ */
+template<typename T>
+bool read_binary(std::istream& in, T& value)
+{
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return in.good();
+}
+/**
+ * @brief write_binary writes the element count followed by the elements
+ */
+template<typename T>
+void write_binary(std::ostream& out, const std::vector<T>& values)
+{
+    write_binary(out, static_cast<std::uint64_t>(values.size()));
+    if (!values.empty())
+    {
+        out.write(reinterpret_cast<const char*>(values.data()),
+                  values.size() * sizeof(T));
+    }
+}
+/**
+ * @brief read_binary reads the element count followed by the elements
+ * The vector is grown as elements are read so a corrupt count fails at the
+ * end of the stream instead of over-allocating
+ * @return true, iff all elements were read
+ */
+template<typename T>
+bool read_binary(std::istream& in, std::vector<T>& values)
+{
+    std::uint64_t count = 0;
+    values.clear();
+    if (!read_binary(in, count))
+        return false;
+    const std::uint64_t chunk = (1u << 20) / sizeof(T) + 1;
+    while (values.size() < count)
+    {
+        std::size_t offset = values.size();
+        std::size_t n = static_cast<std::size_t>(
+            std::min<std::uint64_t>(chunk, count - offset));
+        values.resize(offset + n);
+        in.read(reinterpret_cast<char*>(values.data() + offset),
+                n * sizeof(T));
+        if (!in.good())
+            return false;
+    }
+    return true;
+}
+/**
+ * @brief write_field writes the given field of every element
+ * Each field of an array of structures is written in turn, so the snapshot
+ * is deterministic and holds no padding bytes.
+ */
+template<typename T, typename F>
+void write_field(std::ostream& out, const std::vector<T>& values, F T::*field)
+{
+    std::vector<F> fields;
+    fields.reserve(values.size());
+    for (const T& value : values)
+    {
+        fields.push_back(value.*field);
+    }
+    write_binary(out, fields);
+}
+/**
+ * @brief read_field reads the given field of every element
+ * The first field read sizes the (empty) elements, which subsequent fields
+ * must agree with.
+ * @return true, iff all fields were read and agree with the element count
+ */
+template<typename T, typename F>
+bool read_field(std::istream& in, std::vector<T>& values, F T::*field)
+{
+    std::vector<F> fields;
+    if (!read_binary(in, fields))
+        return false;
+    if (values.empty())
+        values.resize(fields.size());
+    else if (values.size() != fields.size())
+        return false;
+    for (std::size_t i = 0; i < fields.size(); ++i)
+    {
+        values[i].*field = fields[i];
+    }
+    return true;
+}
+inline void write_binary(std::ostream& out, const std::string& str)
+{
+    write_binary(out, static_cast<std::uint64_t>(str.size()));
+    out.write(str.data(), str.size());
+}
+inline bool read_binary(std::istream& in, std::string& str)
+{
+    std::vector<char> chars;
+    if (!read_binary(in, chars))
+        return false;
+    str.assign(chars.begin(), chars.end());
+    return true;
+}
+}  // end of namespace
+#endif
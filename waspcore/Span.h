@@ -0,0 +1,50 @@
+#ifndef WASP_SPAN_H
+#define WASP_SPAN_H
+#include <cstddef>
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The Span class is a non-owning view of a contiguous sequence of
+ * values
+ * Acquiring a packed array's elements as a span avoids copying them out of
+ * their document. A span is valid while the viewed values are, i.e., until
+ * the document is modified, reset, or destroyed.
+ */
+template<typename T>
+class Span
+{
+  public:
+    typedef T        value_type;
+    typedef T*       iterator;
+    typedef const T* const_iterator;
+
+    Span() : m_data(nullptr), m_size(0) {}
+    Span(T* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    T*          data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    bool        empty() const { return m_size == 0; }
+
+    T* begin() const { return m_data; }
+    T* end() const { return m_data + m_size; }
+    T& operator[](std::size_t i) const { return m_data[i]; }
+    T& front() const { return m_data[0]; }
+    T& back() const { return m_data[m_size - 1]; }
+
+    /**
+     * @brief subspan acquire a view of count values starting at the given
+     * position
+     */
+    Span subspan(std::size_t pos, std::size_t count) const
+    {
+        return Span(m_data + pos, count);
+    }
+
+  private:
+    T*          m_data;
+    std::size_t m_size;
+};
+}  // namespace wasp
+#endif
@@ -0,0 +1,75 @@
+#ifndef WASP_STREAMHANDLER_H
+#define WASP_STREAMHANDLER_H
+#include <cstddef>
+#include "waspcore/StringView.h"
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The StreamHandler class receives the events of a streamed parse
+ * An interpreter given a stream handler emits the events of each top-level
+ * construct of the document as the construct is parsed and then discards its
+ * nodes, so that the interpreter's memory does not grow with the input.
+ * Objects, arrays, and other compound constructs are bracketed by
+ * start_object and end_object, key-value pairs are a key followed by their
+ * values, and decorative syntax (delimiters, separators, comments) emits
+ * nothing. Every event carries the (1-based) line and column at which the
+ * construct starts, or for end_object, ends.
+ * Names and data are viewed in the interpreter's pools and are only valid
+ * for the duration of the event.
+ */
+class WASP_PUBLIC StreamHandler
+{
+  public:
+    virtual ~StreamHandler() {}
+    /**
+     * @brief start_object a compound construct begins
+     * @param type the construct's node type (wasp::OBJECT, wasp::ARRAY, etc.)
+     * @param name the construct's name
+     */
+    virtual void start_object(std::size_t type,
+                              StringView  name,
+                              std::size_t line,
+                              std::size_t column)
+    {
+        (void)type;
+        (void)name;
+        (void)line;
+        (void)column;
+    }
+    /**
+     * @brief key a key-value pair begins, its values follow
+     */
+    virtual void key(StringView name, std::size_t line, std::size_t column)
+    {
+        (void)name;
+        (void)line;
+        (void)column;
+    }
+    /**
+     * @brief value a value of the enclosing key or compound construct
+     * @param data the value's data as written, including any quotes
+     */
+    virtual void value(StringView data, std::size_t line, std::size_t column)
+    {
+        (void)data;
+        (void)line;
+        (void)column;
+    }
+    /**
+     * @brief end_object the compound construct last begun ends
+     */
+    virtual void end_object(std::size_t type,
+                            StringView  name,
+                            std::size_t line,
+                            std::size_t column)
+    {
+        (void)type;
+        (void)name;
+        (void)line;
+        (void)column;
+    }
+};
+}  // namespace wasp
+#endif
@@ -1,8 +1,11 @@
 #ifndef WASP_STRINGPOOL_H
 #define WASP_STRINGPOOL_H
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 #include <iostream>
+#include "waspcore/Snapshot.h"
+#include "waspcore/StringView.h"
 #include "waspcore/decl.h"
 
 namespace wasp
@@ -25,6 +28,11 @@ class WASP_PUBLIC StringPool
     ~StringPool();
     // acquire the string data for the token at the given index
     const char* data(index_type_size index) const;
+    /**
+     * @brief view acquire a view of the string at the given index
+     * The length is known from the pool's indices, so no scan is needed.
+     */
+    StringView view(index_type_size index) const;
     /**
      * @brief push push a new string into the pool
      * @param str the new string to place into the pool
@@ -56,6 +64,43 @@ class WASP_PUBLIC StringPool
      */
     bool set(index_type_size data_index, const char* str);
 
+    /**
+     * @brief remove remove the flagged strings
+     * The remaining strings are renumbered in order. Only the strings from
+     * the first flagged onward are moved, in place.
+     * @param removed the removal flag of each string from the first onward,
+     * strings past the last flag are retained
+     * @param first the index of the string of the first flag
+     */
+    void remove(const std::vector<bool>& removed, std::size_t first = 0);
+
+    /**
+     * @brief clear remove all strings while retaining the allocated capacity
+     */
+    void clear();
+    /**
+     * @brief reserve allocate capacity for the given number of strings and
+     * characters (including null terminators)
+     */
+    void reserve(std::size_t string_count, std::size_t char_count);
+    /**
+     * @brief swap exchange the strings of this pool with the given pool's
+     */
+    void swap(StringPool& other);
+
+    /**
+     * @brief save write the pool's data to the given binary snapshot stream
+     * @param out the stream to write to
+     */
+    void save(std::ostream& out) const;
+    /**
+     * @brief load replace the pool's data with that of the given binary
+     * snapshot stream
+     * @param in the stream to read from
+     * @return true, iff the data was completely read and is consistent
+     */
+    bool load(std::istream& in);
+
   private:
     /**
      * @brief m_data null terminated character array
@@ -7,6 +7,17 @@ const char* StringPool<T>::data(T index) const
     return &m_data[data_index];
 }
 template<typename T>
+StringView StringPool<T>::view(T index) const
+{
+    std::size_t data_index = m_token_data_indices[index];
+    // strings are contiguous, each followed by its null terminator
+    std::size_t end_index = static_cast<std::size_t>(index) + 1 <
+                                    m_token_data_indices.size()
+                                ? m_token_data_indices[index + 1]
+                                : m_data.size();
+    return StringView(&m_data[data_index], end_index - data_index - 1);
+}
+template<typename T>
 void StringPool<T>::push(const char* str)
 {
     std::size_t string_index = m_data.size();
@@ -60,6 +71,71 @@ void StringPool<T>::pop()
     m_data.erase(m_data.begin() + index, m_data.end());
     m_token_data_indices.pop_back();
 }
+template<typename T>
+void StringPool<T>::remove(const std::vector<bool>& removed, std::size_t first)
+{
+    std::size_t string_count = m_token_data_indices.size();
+    if (first >= string_count)
+        return;
+    std::size_t count = first;
+    // the end of the remaining characters
+    std::size_t end = m_token_data_indices[first];
+    for (std::size_t i = first; i < string_count; ++i)
+    {
+        std::size_t begin = m_token_data_indices[i];
+        std::size_t size  = (i + 1 < string_count ? m_token_data_indices[i + 1]
+                                                  : m_data.size()) -
+                           begin;
+        if (i - first < removed.size() && removed[i - first])
+            continue;
+        // strings only move toward the front, so copying forward is safe
+        std::copy(m_data.begin() + begin, m_data.begin() + begin + size,
+                  m_data.begin() + end);
+        m_token_data_indices[count++] = static_cast<T>(end);
+        end += size;
+    }
+    m_token_data_indices.resize(count);
+    m_data.resize(end);
+}
+template<typename T>
+void StringPool<T>::clear()
+{
+    m_data.clear();
+    m_token_data_indices.clear();
+}
+template<typename T>
+void StringPool<T>::reserve(std::size_t string_count, std::size_t char_count)
+{
+    m_data.reserve(char_count);
+    m_token_data_indices.reserve(string_count);
+}
+template<typename T>
+void StringPool<T>::swap(StringPool<T>& other)
+{
+    m_data.swap(other.m_data);
+    m_token_data_indices.swap(other.m_token_data_indices);
+}
+template<typename T>
+void StringPool<T>::save(std::ostream& out) const
+{
+    write_binary(out, m_data);
+    write_binary(out, m_token_data_indices);
+}
+template<typename T>
+bool StringPool<T>::load(std::istream& in)
+{
+    if (!read_binary(in, m_data) || !read_binary(in, m_token_data_indices))
+        return false;
+    // every string must start within, and be terminated in, the data
+    if (!m_data.empty() && m_data.back() != '\0')
+        return false;
+    for (T index : m_token_data_indices)
+    {
+        if (static_cast<std::size_t>(index) >= m_data.size())
+            return false;
+    }
+    return true;
+}
 // default constructor
 template<typename T>
 StringPool<T>::StringPool()
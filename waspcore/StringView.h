@@ -0,0 +1,132 @@
+#ifndef WASP_STRINGVIEW_H
+#define WASP_STRINGVIEW_H
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <ostream>
+#include <string>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The StringView class is a non-owning view of a character range
+ * Acquiring node names and leaf node data as views avoids copying the
+ * characters out of their pool. A view is valid while the viewed characters
+ * are, i.e., until the document is modified, reset, or destroyed.
+ * Converts to std::string_view when compiled as C++17 or later.
+ */
+class WASP_PUBLIC StringView
+{
+  public:
+    typedef const char*                           const_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    StringView() : m_data(""), m_size(0) {}
+    StringView(const char* data) : m_data(data), m_size(std::strlen(data)) {}
+    StringView(const char* data, std::size_t size) : m_data(data), m_size(size)
+    {
+    }
+    StringView(const std::string& str) : m_data(str.data()), m_size(str.size())
+    {
+    }
+
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    std::size_t length() const { return m_size; }
+    bool        empty() const { return m_size == 0; }
+
+    const_iterator begin() const { return m_data; }
+    const_iterator end() const { return m_data + m_size; }
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+    char           operator[](std::size_t i) const { return m_data[i]; }
+    char           front() const { return m_data[0]; }
+    char           back() const { return m_data[m_size - 1]; }
+
+    /**
+     * @brief substr acquire a view of at most count characters starting at
+     * the given position
+     */
+    StringView substr(std::size_t pos, std::size_t count = npos) const
+    {
+        pos = std::min(pos, m_size);
+        return StringView(m_data + pos, std::min(count, m_size - pos));
+    }
+    /**
+     * @brief compare lexicographically compare this view with the given view
+     * @return negative, zero, or positive as this view is less than, equal
+     * to, or greater than the given view
+     */
+    int compare(StringView other) const
+    {
+        std::size_t count  = std::min(m_size, other.m_size);
+        int         result = count == 0 ? 0 : std::memcmp(m_data, other.m_data, count);
+        if (result != 0)
+            return result;
+        return m_size < other.m_size ? -1 : (m_size > other.m_size ? 1 : 0);
+    }
+
+    /**
+     * @brief str acquire a copy of the viewed characters
+     */
+    std::string str() const { return std::string(m_data, m_size); }
+    explicit    operator std::string() const { return str(); }
+#if __cplusplus >= 201703L
+    operator std::string_view() const
+    {
+        return std::string_view(m_data, m_size);
+    }
+#endif
+
+  private:
+    const char* m_data;
+    std::size_t m_size;
+};
+
+inline bool operator==(StringView a, StringView b)
+{
+    return a.size() == b.size() && a.compare(b) == 0;
+}
+inline bool operator!=(StringView a, StringView b) { return !(a == b); }
+inline bool operator<(StringView a, StringView b) { return a.compare(b) < 0; }
+// disambiguate comparisons with strings, which convert to both types
+inline bool operator==(StringView a, const std::string& b)
+{
+    return a == StringView(b);
+}
+inline bool operator==(const std::string& a, StringView b)
+{
+    return StringView(a) == b;
+}
+inline bool operator!=(StringView a, const std::string& b) { return !(a == b); }
+inline bool operator!=(const std::string& a, StringView b) { return !(a == b); }
+inline bool operator==(StringView a, const char* b)
+{
+    return a == StringView(b);
+}
+inline bool operator==(const char* a, StringView b)
+{
+    return StringView(a) == b;
+}
+inline bool operator!=(StringView a, const char* b) { return !(a == b); }
+inline bool operator!=(const char* a, StringView b) { return !(a == b); }
+
+inline std::ostream& operator<<(std::ostream& out, StringView view)
+{
+    return out.write(view.data(), static_cast<std::streamsize>(view.size()));
+}
+
+}  // namespace wasp
+#endif
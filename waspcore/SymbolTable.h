@@ -0,0 +1,108 @@
+#ifndef WASP_SYMBOLTABLE_H
+#define WASP_SYMBOLTABLE_H
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "waspcore/StringPool.h"
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @class SymbolTable Interned string storage
+ * Each distinct string is stored once and identified by a dense symbol index
+ * [0-size()). Interning the same string twice yields the same symbol, so
+ * symbols can be compared in place of the strings they represent.
+ */
+template<typename symbol_index_type_size = default_token_index_type_size>
+class WASP_PUBLIC SymbolTable
+{
+  public:
+    typedef symbol_index_type_size index_type_size;
+    /**
+     * @brief npos the symbol returned by find when a string is not interned
+     */
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    SymbolTable();
+    SymbolTable(const SymbolTable<index_type_size>& orig);
+    ~SymbolTable();
+    /**
+     * @brief intern acquire the symbol of the given string, adding the string
+     * to the table when it is not already present
+     * @param str the null terminated string to intern
+     * @return the string's symbol
+     */
+    index_type_size intern(const char* str);
+    /**
+     * @brief find acquire the symbol of the given string without adding it
+     * @param str the null terminated string to find
+     * @return the string's symbol, or npos if the string is not interned
+     */
+    std::size_t find(const char* str) const;
+    /**
+     * @brief data acquire the string of the given symbol
+     * @param symbol the symbol [0-size())
+     * @return the null terminated string data
+     */
+    const char* data(index_type_size symbol) const
+    {
+        return m_strings.data(symbol);
+    }
+    StringView view(index_type_size symbol) const
+    {
+        return m_strings.view(symbol);
+    }
+    /**
+     * @brief size acquire the number of distinct strings in the table
+     * @return std::size_t the number of symbols
+     */
+    std::size_t size() const { return m_strings.string_count(); }
+    /**
+     * @brief clear remove all symbols while retaining the allocated capacity
+     */
+    void clear();
+    /**
+     * @brief swap exchange the symbols of this table with the given table's
+     */
+    void swap(SymbolTable& other);
+
+    /**
+     * @brief save write the table to the given binary snapshot stream
+     * @param out the stream to write to
+     */
+    void save(std::ostream& out) const;
+    /**
+     * @brief load replace the table with that of the given binary snapshot
+     * stream
+     * @param in the stream to read from
+     * @return true, iff the table was completely read and is consistent
+     */
+    bool load(std::istream& in);
+
+  private:
+    static std::size_t hash(const char* str);
+    /**
+     * @brief bucket acquire the bucket in which the string resides, or the
+     * empty bucket at which it would reside
+     */
+    std::size_t bucket(const char* str, std::size_t str_hash) const;
+    /**
+     * @brief rehash redistribute all symbols across the given bucket count
+     */
+    void rehash(std::size_t bucket_count);
+    /**
+     * @brief m_strings the distinct strings, indexed by symbol
+     */
+    StringPool<index_type_size> m_strings;
+    /**
+     * @brief m_buckets open addressing hash table of symbols
+     * Empty buckets contain index_type_size(-1). The bucket count is always
+     * a power of two.
+     */
+    std::vector<index_type_size> m_buckets;
+};
+#include "waspcore/SymbolTable.i.h"
+}  // end of namespace
+#endif
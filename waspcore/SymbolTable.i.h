@@ -0,0 +1,119 @@
+#ifndef WASP_SYMBOLTABLE_I_H
+#define WASP_SYMBOLTABLE_I_H
+template<typename T>
+const std::size_t SymbolTable<T>::npos;
+
+// default constructor
+template<typename T>
+SymbolTable<T>::SymbolTable()
+{
+}
+// copy constructor
+template<typename T>
+SymbolTable<T>::SymbolTable(const SymbolTable<T>& orig)
+    : m_strings(orig.m_strings), m_buckets(orig.m_buckets)
+{
+}
+// default destructor
+template<typename T>
+SymbolTable<T>::~SymbolTable()
+{
+}
+template<typename T>
+std::size_t SymbolTable<T>::hash(const char* str)
+{
+    // FNV-1a
+    std::uint64_t h = 14695981039346656037ULL;
+    for (; *str != '\0'; ++str)
+    {
+        h ^= static_cast<unsigned char>(*str);
+        h *= 1099511628211ULL;
+    }
+    return static_cast<std::size_t>(h);
+}
+template<typename T>
+std::size_t SymbolTable<T>::bucket(const char* str, std::size_t str_hash) const
+{
+    std::size_t mask = m_buckets.size() - 1;
+    std::size_t b    = str_hash & mask;
+    // linear probe until the string or an empty bucket is found
+    while (m_buckets[b] != static_cast<T>(-1) &&
+           std::strcmp(m_strings.data(m_buckets[b]), str) != 0)
+    {
+        b = (b + 1) & mask;
+    }
+    return b;
+}
+template<typename T>
+void SymbolTable<T>::rehash(std::size_t bucket_count)
+{
+    m_buckets.assign(bucket_count, static_cast<T>(-1));
+    for (std::size_t symbol = 0, count = size(); symbol < count; ++symbol)
+    {
+        const char* str = m_strings.data(static_cast<T>(symbol));
+        m_buckets[bucket(str, hash(str))] = static_cast<T>(symbol);
+    }
+}
+template<typename T>
+std::size_t SymbolTable<T>::find(const char* str) const
+{
+    if (m_buckets.empty())
+        return npos;
+    T symbol = m_buckets[bucket(str, hash(str))];
+    if (symbol == static_cast<T>(-1))
+        return npos;
+    return symbol;
+}
+template<typename T>
+T SymbolTable<T>::intern(const char* str)
+{
+    // keep the load factor at or below one half
+    if (2 * (size() + 1) > m_buckets.size())
+    {
+        rehash(m_buckets.empty() ? 16 : 2 * m_buckets.size());
+    }
+    std::size_t b = bucket(str, hash(str));
+    if (m_buckets[b] == static_cast<T>(-1))
+    {
+        m_buckets[b] = static_cast<T>(size());
+        m_strings.push(str);
+    }
+    return m_buckets[b];
+}
+template<typename T>
+void SymbolTable<T>::clear()
+{
+    m_strings.clear();
+    std::fill(m_buckets.begin(), m_buckets.end(), static_cast<T>(-1));
+}
+template<typename T>
+void SymbolTable<T>::swap(SymbolTable<T>& other)
+{
+    m_strings.swap(other.m_strings);
+    m_buckets.swap(other.m_buckets);
+}
+template<typename T>
+void SymbolTable<T>::save(std::ostream& out) const
+{
+    m_strings.save(out);
+    write_binary(out, m_buckets);
+}
+template<typename T>
+bool SymbolTable<T>::load(std::istream& in)
+{
+    if (!m_strings.load(in) || !read_binary(in, m_buckets))
+        return false;
+    // bucket count must be a power of two referencing existing symbols
+    if ((m_buckets.size() & (m_buckets.size() - 1)) != 0 ||
+        2 * size() > m_buckets.size())
+        return false;
+    for (T symbol : m_buckets)
+    {
+        if (symbol != static_cast<T>(-1) &&
+            static_cast<std::size_t>(symbol) >= size())
+            return false;
+    }
+    return true;
+}
+
+#endif
@@ -1,9 +1,13 @@
 #ifndef WASP_TOKENPOOL_H
 #define WASP_TOKENPOOL_H
 #include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <vector>
+#include "waspcore/LineIndex.h"
 #include "waspcore/StringPool.h"
 #include "waspcore/decl.h"
 
@@ -48,6 +52,14 @@ struct WASP_PUBLIC TokenPool
      * @return char * of the token's string data
      */
     const char* str(token_index_type_size index) const;
+    /**
+     * @brief view acquires a view of the string data for the token at the
+     * given index
+     */
+    StringView view(token_index_type_size index) const
+    {
+        return m_strings.view(index);
+    }
     /**
      * @brief line acquires the line for the token at the given index
      * @return std::size_t the line number for which the token exists
@@ -94,14 +106,57 @@ struct WASP_PUBLIC TokenPool
      * @param line_file_offset byte offset into the file/stream for the newline
      */
     void push_line(file_offset_type_size line_file_offset);
+    /**
+     * @brief index_newlines record the line of every newline of the buffer
+     * being tokenized in a single sweep of the buffer
+     * The recorded lines are replaced. Lines subsequently pushed within the
+     * buffer, and newlines embedded in tokens within it, are already recorded
+     * and so are ignored.
+     * @param data the buffer, whose first byte is at token offset 0
+     * @param size the buffer's size in bytes
+     */
+    void index_newlines(const char* data, std::size_t size);
     /**
      * @brief pop_token removes the last token
      */
-    void pop_token() { m_tokens.pop_back(); }
+    void pop_token();
     /**
      * @brief pop_line removes the last line
      */
-    void pop_line() { m_line_offsets.pop_back(); }
+    void pop_line();
+
+    /**
+     * @brief enable_line_index records the line of every token so that line
+     * and column lookups are constant time instead of a search of the line
+     * offsets
+     * Existing tokens are indexed immediately; subsequently pushed tokens are
+     * indexed as they are pushed. This costs one file offset per token.
+     */
+    void enable_line_index();
+    /**
+     * @brief has_line_index determine if token lines are indexed
+     * @return true, iff enable_line_index has been called
+     */
+    bool has_line_index() const { return m_line_indexed; }
+
+    /**
+     * @brief clear remove all tokens and lines while retaining the allocated
+     * capacity
+     * The line index remains enabled if it was enabled.
+     */
+    void clear();
+    /**
+     * @brief reserve allocate capacity for the given number of tokens, token
+     * characters, and lines
+     */
+    void reserve(std::size_t token_count,
+                 std::size_t char_count,
+                 std::size_t line_count);
+    /**
+     * @brief swap exchange the tokens and lines of this pool with the given
+     * pool's
+     */
+    void swap(TokenPool& other);
 
     /**
      * @brief size the number of tokens in this token pool
@@ -115,17 +170,91 @@ struct WASP_PUBLIC TokenPool
      */
     token_type_size type(token_index_type_size token_index) const;
 
+    /**
+     * @brief to_int acquire the token's data converted to an integer
+     * Converts as std::stoi does, without allocation. The conversion is
+     * cached so repeated requests of the same token are a lookup.
+     * @param ok optional indication of whether the conversion succeeded
+     * @param cache false to reuse but not store a conversion, such that the
+     * pool is not modified by concurrent readers
+     * @return the integer, or 0 if the conversion failed
+     */
+    int to_int(token_index_type_size index,
+               bool*                 ok    = nullptr,
+               bool                  cache = true) const;
+    /**
+     * @brief to_double acquire the token's data converted to a double
+     * Converts as std::stod does, cached as to_int is.
+     * @return the double, or 0.0 if the conversion failed
+     */
+    double to_double(token_index_type_size index,
+                     bool*                 ok    = nullptr,
+                     bool                  cache = true) const;
+
     /**
      * @brief line_count the number of new lines stored in this pool
-     * @return the new line count
+     * @return the new line count, including discarded lines
+     */
+    std::size_t line_count() const
+    {
+        return m_discarded_lines + m_line_offsets.size();
+    }
+    /**
+     * @brief discarded_line_count the number of leading new lines discarded
+     * by discard_lines, whose offsets are no longer stored
      */
-    std::size_t line_count() const { return m_line_offsets.size(); }
+    std::size_t discarded_line_count() const { return m_discarded_lines; }
     /**
      * @brief line_offset acquire the byte offset of the line at the given index
-     * @param line_index the index of the line for which the offset is desired
+     * @param line_index the index of the line for which the offset is desired,
+     * which must not be discarded
      * @return the byte offset of the line
      */
     file_offset_type_size line_offset(token_index_type_size line_index) const;
+    /**
+     * @brief offset_line acquire the (1-based) line of the given byte offset
+     */
+    std::size_t offset_line(file_offset_type_size offset) const
+    {
+        return search_line(offset);
+    }
+    /**
+     * @brief offset_column acquire the (1-based) column of the given byte
+     * offset
+     */
+    std::size_t offset_column(file_offset_type_size offset) const;
+
+    /**
+     * @brief remove_tokens remove the flagged tokens
+     * The remaining tokens are renumbered in order and the lines are
+     * unchanged. Only the tokens from the first flagged onward are moved.
+     * @param removed the removal flag of each token from the first onward,
+     * tokens past the last flag are retained
+     * @param first the index of the token of the first flag
+     */
+    void remove_tokens(const std::vector<bool>& removed, std::size_t first = 0);
+    /**
+     * @brief discard_lines discard the line offsets preceding the line of the
+     * earliest token, or of the given offset when there are no tokens
+     * Line numbers are unchanged, but no token or offset preceding the
+     * earliest line may subsequently be located. The lines are erased in
+     * amortized steps, once they are at least half of those stored.
+     * @param end_offset the offset lexing has reached
+     */
+    void discard_lines(file_offset_type_size end_offset);
+
+    /**
+     * @brief save write the pool's data to the given binary snapshot stream
+     * @param out the stream to write to
+     */
+    void save(std::ostream& out) const;
+    /**
+     * @brief load replace the pool's data with that of the given binary
+     * snapshot stream
+     * @param in the stream to read from
+     * @return true, iff the data was completely read and is consistent
+     */
+    bool load(std::istream& in);
 
   private:
     /**
@@ -137,6 +266,7 @@ struct WASP_PUBLIC TokenPool
      */
     struct Token
     {
+        Token() : m_token_type(0), m_token_file_offset(0) {}
         Token(token_type_size type, file_offset_type_size offset)
             : m_token_type(type), m_token_file_offset(offset)
         {
@@ -157,6 +287,99 @@ struct WASP_PUBLIC TokenPool
      * @brief m_line_offsets byte offsets of a line
      */
     std::vector<file_offset_type_size> m_line_offsets;
+    /**
+     * @brief m_newlines_indexed the size of the buffer whose newlines are
+     * recorded by index_newlines, 0 if none
+     */
+    std::size_t m_newlines_indexed;
+    /**
+     * @brief m_discarded_lines the number of leading line offsets discarded,
+     * the line of m_line_offsets' first offset less one
+     */
+    std::size_t m_discarded_lines;
+
+    /**
+     * @brief search_line determines the (1-based) line of the given offset by
+     * searching the line offsets
+     */
+    std::size_t search_line(file_offset_type_size offset) const;
+    /**
+     * @brief end_line_offset acquires the first line offset after the given
+     * token end position
+     */
+    typename std::vector<file_offset_type_size>::const_iterator
+    end_line_offset(token_index_type_size index,
+                    file_offset_type_size end_position) const;
+    /**
+     * @brief index_lines (re)computes the line of all tokens
+     */
+    void index_lines();
+    /**
+     * @brief order_tokens recomputes the largest token offset and the tokens
+     * pushed out of offset order
+     */
+    void order_tokens();
+    /**
+     * @brief update_lines identifies the indexed tokens whose line is changed
+     * by adding or removing the line at the given offset
+     */
+    void update_lines(file_offset_type_size line_file_offset);
+    /**
+     * @brief update_lines recomputes the lines of the identified tokens once
+     * the line change has taken place
+     */
+    void update_lines();
+    /**
+     * @brief m_line_indexed indicates token lines are recorded in m_token_lines
+     */
+    bool m_line_indexed;
+    /**
+     * @brief m_max_token_offset the largest token offset, used to identify
+     * line changes that invalidate indexed token lines
+     */
+    file_offset_type_size m_max_token_offset;
+    /**
+     * @brief m_line_update_begin the first token whose indexed line is
+     * invalidated by a line change
+     */
+    std::size_t m_line_update_begin;
+    /**
+     * @brief m_unordered_tokens the indices, ascending, of the tokens pushed
+     * at an offset preceding an earlier token's, when lines are indexed
+     */
+    std::vector<std::size_t> m_unordered_tokens;
+    /**
+     * @brief m_token_lines the (1-based) line of each token when indexed
+     */
+    std::vector<file_offset_type_size> m_token_lines;
+
+    /**
+     * @brief The Number struct caches the numeric conversions of a token
+     */
+    struct Number
+    {
+        Number() : m_real(0.0), m_integer(0), m_state(0) {}
+        enum : std::uint8_t
+        {
+            INTEGER_CONVERTED = 1,
+            INTEGER_OK        = 2,
+            REAL_CONVERTED    = 4,
+            REAL_OK           = 8
+        };
+        double       m_real;
+        int          m_integer;
+        std::uint8_t m_state;
+    };
+    /**
+     * @brief m_numbers lazily filled numeric conversions, indexed by token
+     * Only allocated once a token is converted, and never saved
+     */
+    mutable std::vector<Number> m_numbers;
+    /**
+     * @brief number acquire the given token's cached conversions, or nullptr
+     * if a conversion cannot be cached
+     */
+    Number* number(token_index_type_size index, bool cache) const;
 };
 #include "waspcore/TokenPool.i.h"
 }  // end of namespace
@@ -4,6 +4,11 @@
 // default constructor
 template<typename TTS, typename TITS, typename FOTS>
 TokenPool<TTS, TITS, FOTS>::TokenPool()
+    : m_newlines_indexed(0)
+    , m_discarded_lines(0)
+    , m_line_indexed(false)
+    , m_max_token_offset(0)
+    , m_line_update_begin(0)
 {
 }
 // copy constructor
@@ -12,6 +17,14 @@ TokenPool<TTS, TITS, FOTS>::TokenPool(const TokenPool<TTS, TITS, FOTS>& orig)
     : m_strings(orig.m_strings)
     , m_tokens(orig.m_tokens)
     , m_line_offsets(orig.m_line_offsets)
+    , m_newlines_indexed(orig.m_newlines_indexed)
+    , m_discarded_lines(orig.m_discarded_lines)
+    , m_line_indexed(orig.m_line_indexed)
+    , m_max_token_offset(orig.m_max_token_offset)
+    , m_line_update_begin(0)
+    , m_unordered_tokens(orig.m_unordered_tokens)
+    , m_token_lines(orig.m_token_lines)
+    , m_numbers(orig.m_numbers)
 {
 }
 // default destructor
@@ -25,24 +38,38 @@ const char* TokenPool<TTS, TITS, FOTS>::str(TITS index) const
 {
     return m_strings.data(index);
 }
-// GET THE TOKEN'S LINE
+// SEARCH FOR THE OFFSET'S LINE
 template<typename TTS, typename TITS, typename FOTS>
-std::size_t TokenPool<TTS, TITS, FOTS>::line(TITS index) const
+std::size_t TokenPool<TTS, TITS, FOTS>::search_line(FOTS offset) const
 {
-    FOTS token_file_offset = m_tokens[index].m_token_file_offset;
     typename std::vector<FOTS>::const_iterator ub = std::upper_bound(
-        m_line_offsets.begin(), m_line_offsets.end(), token_file_offset);
+        m_line_offsets.begin(), m_line_offsets.end(), offset);
 
     auto line = std::distance(m_line_offsets.begin(), ub) + 1;
-    return static_cast<std::size_t>(line);
+    return static_cast<std::size_t>(line) + m_discarded_lines;
+}
+// GET THE TOKEN'S LINE
+template<typename TTS, typename TITS, typename FOTS>
+std::size_t TokenPool<TTS, TITS, FOTS>::line(TITS index) const
+{
+    if (m_line_indexed)
+    {
+        return m_token_lines[index];
+    }
+    return search_line(m_tokens[index].m_token_file_offset);
 }
 // GET THE TOKEN'S COLUMN
 template<typename TTS, typename TITS, typename FOTS>
 std::size_t TokenPool<TTS, TITS, FOTS>::column(TITS index) const
 {
     FOTS token_file_offset = m_tokens[index].m_token_file_offset;
-    typename std::vector<FOTS>::const_iterator ub = std::upper_bound(
-        m_line_offsets.begin(), m_line_offsets.end(), token_file_offset);
+    // the upper bound is the line following the token's line
+    typename std::vector<FOTS>::const_iterator ub =
+        m_line_indexed
+            ? m_line_offsets.begin() +
+                  (m_token_lines[index] - 1 - m_discarded_lines)
+            : std::upper_bound(m_line_offsets.begin(), m_line_offsets.end(),
+                               token_file_offset);
     std::size_t column = 0;
     // check if token is on first line
     if (ub == m_line_offsets.begin())
@@ -60,6 +87,36 @@ std::size_t TokenPool<TTS, TITS, FOTS>::column(TITS index) const
     return column;
 }
 
+// GET THE OFFSET'S COLUMN
+template<typename TTS, typename TITS, typename FOTS>
+std::size_t TokenPool<TTS, TITS, FOTS>::offset_column(FOTS offset) const
+{
+    std::size_t line = search_line(offset);
+    // the first line's column is base 1, others are relative to the newline
+    if (line == 1)
+        return offset + 1;
+    return offset - m_line_offsets[line - 2 - m_discarded_lines];
+}
+
+// FIND THE FIRST NEWLINE AFTER THE GIVEN TOKEN END POSITION
+template<typename TTS, typename TITS, typename FOTS>
+typename std::vector<FOTS>::const_iterator
+TokenPool<TTS, TITS, FOTS>::end_line_offset(TITS index, FOTS end_position) const
+{
+    if (!m_line_indexed)
+    {
+        return std::upper_bound(m_line_offsets.begin(), m_line_offsets.end(),
+                                end_position);
+    }
+    // the token ends at or after its starting line, so only the newlines
+    // embedded in the token need be stepped over
+    auto ub =
+        m_line_offsets.begin() + (m_token_lines[index] - 1 - m_discarded_lines);
+    while (ub != m_line_offsets.end() && *ub <= end_position)
+        ++ub;
+    return ub;
+}
+
 // GET THE TOKEN'S LAST LINE
 template<typename TTS, typename TITS, typename FOTS>
 std::size_t TokenPool<TTS, TITS, FOTS>::last_line(TITS index) const
@@ -73,12 +130,11 @@ std::size_t TokenPool<TTS, TITS, FOTS>::last_line(TITS index) const
                                           : token_file_offset + strlen - 1;
 
     // first newline after the end of the token
-    auto ub = std::upper_bound(m_line_offsets.begin(), m_line_offsets.end(),
-                               token_end_position);
+    auto ub = end_line_offset(index, token_end_position);
 
     // calculate/return line number
     auto line = std::distance(m_line_offsets.begin(), ub) + 1;
-    return static_cast<std::size_t>(line);
+    return static_cast<std::size_t>(line) + m_discarded_lines;
 }
 
 // GET THE TOKEN'S LAST_COLUMN
@@ -94,8 +150,7 @@ std::size_t TokenPool<TTS, TITS, FOTS>::last_column(TITS index) const
                                           : token_file_offset + strlen - 1;
 
     // first newline after the end of the token
-    auto ub = std::upper_bound(m_line_offsets.begin(), m_line_offsets.end(),
-                               token_end_position);
+    auto ub = end_line_offset(index, token_end_position);
 
     // last column
     std::size_t column;
@@ -131,23 +186,254 @@ void TokenPool<TTS, TITS, FOTS>::push(const char* str,
 {
     // capture the token's string in the string pool
     m_strings.push(str);
+    if (m_line_indexed)
+    {
+        if (m_tokens.empty() || token_file_offset >= m_max_token_offset)
+            m_max_token_offset = token_file_offset;
+        else
+            m_unordered_tokens.push_back(m_tokens.size());
+        // tokens typically follow all recorded lines
+        if (m_line_offsets.empty() || m_line_offsets.back() <= token_file_offset)
+            m_token_lines.push_back(static_cast<FOTS>(
+                m_line_offsets.size() + 1 + m_discarded_lines));
+        else
+            m_token_lines.push_back(static_cast<FOTS>(search_line(token_file_offset)));
+    }
     m_tokens.push_back(Token(type, token_file_offset));
 
     // push embedded newlines
+    bool has_newline = false;
     for (size_t i = 0; str[i] != 0; i++)
     {
         // this is a newline, push its offset
-        if (str[i] == '\n' && track_newline)
+        if (str[i] == '\n' && track_newline &&
+            token_file_offset + i >= m_newlines_indexed)
         {
+            if (!has_newline)
+                update_lines(token_file_offset + i);
+            has_newline = true;
             m_line_offsets.push_back(token_file_offset + i);
         }
     }
+    if (has_newline)
+        update_lines();
 }
 // PUSH A NEW LINE
 template<typename TTS, typename TITS, typename FOTS>
 void TokenPool<TTS, TITS, FOTS>::push_line(FOTS line_file_offset)
 {
+    if (static_cast<std::size_t>(line_file_offset) < m_newlines_indexed)
+        return;
+    update_lines(line_file_offset);
     m_line_offsets.push_back(line_file_offset);
+    update_lines();
+}
+// INDEX ALL LINES OF THE BUFFER
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::index_newlines(const char* data,
+                                                std::size_t size)
+{
+    m_line_offsets.clear();
+    m_discarded_lines = 0;
+    find_newlines(data, size, m_line_offsets);
+    m_newlines_indexed = size;
+    if (m_line_indexed)
+        index_lines();
+}
+// POP THE LAST LINE
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::pop_line()
+{
+    update_lines(m_line_offsets.back());
+    m_line_offsets.pop_back();
+    update_lines();
+}
+// UPDATE INDEXED TOKEN LINES AFTER A LINE CHANGE
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::update_lines(FOTS line_file_offset)
+{
+    // identify the tokens at or after the changing line
+    m_line_update_begin = m_tokens.size();
+    if (!m_line_indexed || m_tokens.empty() ||
+        line_file_offset > m_max_token_offset)
+    {
+        return;
+    }
+    // an ordered token preceding the line is preceded only by tokens
+    // preceding the line, so walk back to it stepping over unordered tokens
+    std::size_t unordered = m_unordered_tokens.size();
+    while (m_line_update_begin > 0)
+    {
+        std::size_t index = m_line_update_begin - 1;
+        if (unordered > 0 && m_unordered_tokens[unordered - 1] == index)
+            --unordered;
+        else if (m_tokens[index].m_token_file_offset < line_file_offset)
+            break;
+        --m_line_update_begin;
+    }
+}
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::update_lines()
+{
+    if (!m_line_indexed)
+        return;
+    for (std::size_t i = m_line_update_begin; i < m_tokens.size(); ++i)
+    {
+        m_token_lines[i] =
+            static_cast<FOTS>(search_line(m_tokens[i].m_token_file_offset));
+    }
+}
+// POP THE LAST TOKEN
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::pop_token()
+{
+    m_tokens.pop_back();
+    // the token's string, which a subsequently pushed token would otherwise
+    // be given
+    m_strings.pop();
+    if (m_line_indexed)
+        m_token_lines.pop_back();
+    if (!m_unordered_tokens.empty() &&
+        m_unordered_tokens.back() == m_tokens.size())
+        m_unordered_tokens.pop_back();
+    // a subsequently pushed token reuses the index
+    if (m_numbers.size() > m_tokens.size())
+        m_numbers.resize(m_tokens.size());
+}
+// REMOVE THE FLAGGED TOKENS
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::remove_tokens(const std::vector<bool>& removed,
+                                               std::size_t first)
+{
+    // tokens preceding the first flag are unchanged
+    m_strings.remove(removed, first);
+    std::size_t count = first;
+    for (std::size_t i = first; i < m_tokens.size(); ++i)
+    {
+        if (i - first < removed.size() && removed[i - first])
+            continue;
+        m_tokens[count] = m_tokens[i];
+        if (m_line_indexed)
+            m_token_lines[count] = m_token_lines[i];
+        ++count;
+    }
+    m_tokens.resize(count);
+    if (m_line_indexed)
+    {
+        m_token_lines.resize(count);
+        order_tokens();
+    }
+    // conversions are indexed by the prior token numbering
+    m_numbers.clear();
+    m_line_update_begin = 0;
+}
+// DISCARD THE LINES PRECEDING ALL TOKENS
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::discard_lines(FOTS end_offset)
+{
+    FOTS offset = end_offset;
+    for (const Token& token : m_tokens)
+    {
+        offset = std::min(offset, token.m_token_file_offset);
+    }
+    // the newline preceding the offset locates the columns of its line
+    std::size_t line  = search_line(offset) - m_discarded_lines;
+    std::size_t count = line > 1 ? line - 2 : 0;
+    // erase once half the lines are discardable, so each line is moved a
+    // bounded number of times
+    if (count == 0 || count * 2 < m_line_offsets.size())
+        return;
+    m_line_offsets.erase(m_line_offsets.begin(),
+                         m_line_offsets.begin() + count);
+    m_discarded_lines += count;
+}
+// INDEX ALL TOKEN LINES
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::enable_line_index()
+{
+    m_line_indexed = true;
+    order_tokens();
+    index_lines();
+}
+// IDENTIFY THE TOKENS PUSHED OUT OF OFFSET ORDER
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::order_tokens()
+{
+    m_max_token_offset = 0;
+    m_unordered_tokens.clear();
+    for (std::size_t i = 0; i < m_tokens.size(); ++i)
+    {
+        FOTS offset = m_tokens[i].m_token_file_offset;
+        if (i == 0 || offset >= m_max_token_offset)
+            m_max_token_offset = offset;
+        else
+            m_unordered_tokens.push_back(i);
+    }
+}
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::index_lines()
+{
+    m_token_lines.resize(m_tokens.size());
+    // tokens are largely in offset order, so walk the line offsets
+    // alongside the tokens, searching only when a token is out of order
+    std::size_t line = 0;  // number of line offsets <= the token offset
+    FOTS        previous_offset = 0;
+    for (std::size_t i = 0; i < m_tokens.size(); ++i)
+    {
+        FOTS offset = m_tokens[i].m_token_file_offset;
+        if (offset < previous_offset)
+        {
+            line = search_line(offset) - 1 - m_discarded_lines;
+        }
+        while (line < m_line_offsets.size() && m_line_offsets[line] <= offset)
+        {
+            ++line;
+        }
+        m_token_lines[i] = static_cast<FOTS>(line + 1 + m_discarded_lines);
+        previous_offset  = offset;
+    }
+}
+// CLEAR ALL TOKENS, RETAINING CAPACITY
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::clear()
+{
+    m_strings.clear();
+    m_tokens.clear();
+    m_line_offsets.clear();
+    m_token_lines.clear();
+    m_numbers.clear();
+    m_unordered_tokens.clear();
+    m_newlines_indexed  = 0;
+    m_discarded_lines   = 0;
+    m_max_token_offset  = 0;
+    m_line_update_begin = 0;
+}
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::reserve(std::size_t token_count,
+                                         std::size_t char_count,
+                                         std::size_t line_count)
+{
+    m_strings.reserve(token_count, char_count);
+    m_tokens.reserve(token_count);
+    m_line_offsets.reserve(line_count);
+    if (m_line_indexed)
+        m_token_lines.reserve(token_count);
+}
+// EXCHANGE ALL TOKENS AND LINES
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::swap(TokenPool<TTS, TITS, FOTS>& other)
+{
+    m_strings.swap(other.m_strings);
+    m_tokens.swap(other.m_tokens);
+    m_line_offsets.swap(other.m_line_offsets);
+    std::swap(m_newlines_indexed, other.m_newlines_indexed);
+    std::swap(m_discarded_lines, other.m_discarded_lines);
+    std::swap(m_line_indexed, other.m_line_indexed);
+    std::swap(m_max_token_offset, other.m_max_token_offset);
+    std::swap(m_line_update_begin, other.m_line_update_begin);
+    m_unordered_tokens.swap(other.m_unordered_tokens);
+    m_token_lines.swap(other.m_token_lines);
+    m_numbers.swap(other.m_numbers);
 }
 // GET A TOKEN'S TYPE
 template<typename TTS, typename TITS, typename FOTS>
@@ -155,10 +441,118 @@ TTS TokenPool<TTS, TITS, FOTS>::type(TITS index) const
 {
     return m_tokens[index].m_token_type;
 }
+// GET THE TOKEN'S CACHED NUMERIC CONVERSIONS
+template<typename TTS, typename TITS, typename FOTS>
+typename TokenPool<TTS, TITS, FOTS>::Number*
+TokenPool<TTS, TITS, FOTS>::number(TITS index, bool cache) const
+{
+    if (static_cast<std::size_t>(index) >= m_numbers.size())
+    {
+        if (!cache)
+            return nullptr;
+        m_numbers.resize(m_tokens.size());
+    }
+    return &m_numbers[index];
+}
+// GET THE TOKEN'S DATA AS AN INTEGER
+template<typename TTS, typename TITS, typename FOTS>
+int TokenPool<TTS, TITS, FOTS>::to_int(TITS index, bool* ok, bool cache) const
+{
+    Number* n = number(index, cache);
+    if (n == nullptr || !(n->m_state & Number::INTEGER_CONVERTED))
+    {
+        const char* data = str(index);
+        char*       end  = nullptr;
+        errno            = 0;
+        long value       = std::strtol(data, &end, 10);
+        bool converted   = end != data && errno != ERANGE &&
+                         value >= INT_MIN && value <= INT_MAX;
+        int result = converted ? static_cast<int>(value) : 0;
+        if (ok)
+            *ok = converted;
+        if (n == nullptr || !cache)
+            return result;
+        n->m_integer = result;
+        n->m_state |= Number::INTEGER_CONVERTED |
+                      (converted ? Number::INTEGER_OK : 0);
+    }
+    if (ok)
+        *ok = (n->m_state & Number::INTEGER_OK) != 0;
+    return n->m_integer;
+}
+// GET THE TOKEN'S DATA AS A DOUBLE
+template<typename TTS, typename TITS, typename FOTS>
+double TokenPool<TTS, TITS, FOTS>::to_double(TITS index, bool* ok, bool cache) const
+{
+    Number* n = number(index, cache);
+    if (n == nullptr || !(n->m_state & Number::REAL_CONVERTED))
+    {
+        const char* data = str(index);
+        char*       end  = nullptr;
+        errno            = 0;
+        double value     = std::strtod(data, &end);
+        bool converted   = end != data && errno != ERANGE;
+        double result    = converted ? value : 0.0;
+        if (ok)
+            *ok = converted;
+        if (n == nullptr || !cache)
+            return result;
+        n->m_real = result;
+        n->m_state |= Number::REAL_CONVERTED |
+                      (converted ? Number::REAL_OK : 0);
+    }
+    if (ok)
+        *ok = (n->m_state & Number::REAL_OK) != 0;
+    return n->m_real;
+}
 // GET A LINE's OFFSET
 template<typename TTS, typename TITS, typename FOTS>
 FOTS TokenPool<TTS, TITS, FOTS>::line_offset(TITS line_index) const
 {
-    return m_line_offsets[line_index];
+    return m_line_offsets[line_index - m_discarded_lines];
+}
+// WRITE THE POOL TO A SNAPSHOT
+template<typename TTS, typename TITS, typename FOTS>
+void TokenPool<TTS, TITS, FOTS>::save(std::ostream& out) const
+{
+    m_strings.save(out);
+    write_field(out, m_tokens, &Token::m_token_type);
+    write_field(out, m_tokens, &Token::m_token_file_offset);
+    write_binary(out, m_line_offsets);
+    write_binary(out, m_line_indexed);
+    write_binary(out, m_token_lines);
+}
+// READ THE POOL FROM A SNAPSHOT
+template<typename TTS, typename TITS, typename FOTS>
+bool TokenPool<TTS, TITS, FOTS>::load(std::istream& in)
+{
+    m_line_update_begin = 0;
+    m_newlines_indexed  = 0;
+    m_discarded_lines   = 0;
+    m_numbers.clear();
+    m_tokens.clear();
+    if (!m_strings.load(in) ||
+        !read_field(in, m_tokens, &Token::m_token_type) ||
+        !read_field(in, m_tokens, &Token::m_token_file_offset) ||
+        !read_binary(in, m_line_offsets) || !read_binary(in, m_line_indexed) ||
+        !read_binary(in, m_token_lines))
+    {
+        return false;
+    }
+    if (m_strings.string_count() != m_tokens.size() ||
+        m_token_lines.size() != (m_line_indexed ? m_tokens.size() : 0))
+    {
+        return false;
+    }
+    // every token's line must be within the line offsets, the last line
+    // following the last newline
+    for (std::size_t token_line : m_token_lines)
+    {
+        if (token_line < 1 + m_discarded_lines ||
+            token_line > m_line_offsets.size() + 1 + m_discarded_lines)
+            return false;
+    }
+    order_tokens();
+    return true;
 }
 #endif
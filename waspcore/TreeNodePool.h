@@ -1,11 +1,22 @@
 #ifndef WASP_TREENODEPOOL_H
 #define WASP_TREENODEPOOL_H
+#include <algorithm>
+#include <cerrno>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <sstream>
 #include <ostream>
 #include <iostream>
+#include "waspcore/NodeData.h"
+#include "waspcore/Span.h"
 #include "waspcore/StringPool.h"
+#include "waspcore/SymbolTable.h"
 #include "waspcore/TokenPool.h"
 #include "waspcore/wasp_node.h"
 #include "waspcore/utils.h"
@@ -26,15 +37,22 @@ template<
     // size type describing node occurrence maximum
     typename nis = default_node_index_size,
     // Token Pool storage type
-    class TP = TokenPool<>>
+    class TP = TokenPool<>,
+    // node data layout policy (AoSNodeLayout or SoANodeLayout)
+    class NL = AoSNodeLayout>
 class WASP_PUBLIC TreeNodePool
 {
   public:
     typedef nts node_type_size;
     typedef nis node_index_size;
     typedef TP  TokenPool_type;
+    typedef NL  NodeLayout_type;
+    typedef typename NL::template storage<
+        nts, nis, typename TP::token_index_type_size>
+                                                   NodeData_type;
+    typedef typename NodeData_type::BasicNodeData_type BasicNodeData_type;
     TreeNodePool();
-    TreeNodePool(const TreeNodePool<node_type_size, node_index_size, TP>& orig);
+    TreeNodePool(const TreeNodePool& orig);
     ~TreeNodePool();
 
     /**
@@ -84,7 +102,7 @@ class WASP_PUBLIC TreeNodePool
 
     bool is_leaf(size_t node_index) const
     {
-        return m_node_basic_data[node_index].is_leaf();
+        return m_node_basic_data.is_leaf(node_index);
     }
     /**
      * @brief size acquire the number of nodes (leaf and parent)
@@ -114,6 +132,7 @@ class WASP_PUBLIC TreeNodePool
                     typename TP::token_type_size type,
                     size_t                       token_file_offset)
     {
+        wasp_insist(!m_frozen, frozen_message);
         m_token_data.push(str, type, token_file_offset);
     }
     /**
@@ -173,8 +192,105 @@ class WASP_PUBLIC TreeNodePool
      */
     const char* name(node_index_size node_index) const
     {
-        return m_node_names.data(node_index);
+        return m_node_names.data(m_node_basic_data.name(node_index));
     }
+    /**
+     * @brief name_view acquire a view of the node's name without copying it
+     */
+    StringView name_view(node_index_size node_index) const
+    {
+        return m_node_names.view(m_node_basic_data.name(node_index));
+    }
+    /**
+     * @brief name_symbol acquire the interned symbol of the node's name
+     * @param node_index the index of the node to acquire the name symbol
+     * @return the node's name symbol
+     * Nodes with equal names have equal name symbols
+     */
+    std::size_t name_symbol(node_index_size node_index) const
+    {
+        return m_node_basic_data.name(node_index);
+    }
+    /**
+     * @brief find_name_symbol acquire the symbol of the given name
+     * @param name the name for which the symbol is requested
+     * @return the name's symbol, or SymbolTable::npos if no node has ever
+     * been given the name
+     */
+    std::size_t find_name_symbol(const char* name) const
+    {
+        return m_node_names.find(name);
+    }
+    /**
+     * @brief node_names acquire the symbol table of all node names
+     */
+    const SymbolTable<typename TP::token_index_type_size>& node_names() const
+    {
+        return m_node_names;
+    }
+    /**
+     * @brief child_name_index_threshold the child count at which a parent's
+     * children are indexed by name
+     * The by-name lookups of parents with fewer children scan the children.
+     * Larger parents have their children indexed by name on first lookup,
+     * after which each lookup is a binary search. Parents that are never
+     * looked up by name are never indexed.
+     */
+    static const std::size_t child_name_index_threshold = 16;
+    /**
+     * @brief first_child_by_name acquire the first child with the given name
+     * @param node_index the index of the parent node
+     * @param name the name of the requested child
+     * @return the child's node index, or size() if no child has the name
+     */
+    std::size_t first_child_by_name(node_index_size node_index,
+                                    const char*     name) const;
+    /**
+     * @brief child_count_by_name determine the number of children with the
+     * given name
+     * @param node_index the index of the parent node
+     * @param name the name of the child nodes to count
+     * @param limit the limit (0 reserved as no limit) on the count
+     * @return the number of children with the given name
+     */
+    std::size_t child_count_by_name(node_index_size node_index,
+                                    const char*     name,
+                                    std::size_t     limit = 0) const;
+    /**
+     * @brief child_by_name acquire the children with the given name
+     * @param node_index the index of the parent node
+     * @param name the name of the children to be retrieved
+     * @param child_indices the node indices of the matching children
+     * @param limit the limit (0 reserved as no limit) on the number of children
+     */
+    void child_by_name(node_index_size           node_index,
+                       const char*               name,
+                       std::vector<std::size_t>& child_indices,
+                       std::size_t               limit = 0) const;
+    /**
+     * @brief child_by_name_symbol acquire the children with the given name
+     * symbol
+     * @param node_index the index of the parent node
+     * @param symbol the name symbol of the children to be retrieved
+     * @param child_indices the node indices of the matching children
+     * @param limit the limit (0 reserved as no limit) on the number of children
+     */
+    void child_by_name_symbol(node_index_size           node_index,
+                              std::size_t               symbol,
+                              std::vector<std::size_t>& child_indices,
+                              std::size_t               limit = 0) const;
+    /**
+     * @brief find_name_symbols acquire the symbols of all names matching the
+     * given wildcard pattern
+     * @param pattern the name pattern, e.g., 'material', 'mat*', or '*al'
+     * @param symbols the matching symbols, appended in ascending order
+     * Literal names are looked up directly. Prefix ('mat*') and suffix
+     * ('*al') patterns are served by ranges of the names sorted by their
+     * leading and trailing characters. Other patterns are matched against
+     * each distinct name.
+     */
+    void find_name_symbols(const char*               pattern,
+                           std::vector<std::size_t>& symbols) const;
     /**
      * @brief set_name updates the name of the existing node
      * @param node_index the index of the node for which the name will be
@@ -193,7 +309,7 @@ class WASP_PUBLIC TreeNodePool
 
     node_type_size type(node_index_size node_index) const
     {
-        return m_node_basic_data[node_index].m_node_type;
+        return m_node_basic_data.type(node_index);
     }
     void set_type(node_index_size node_index, node_type_size node_type);
     /**
@@ -227,6 +343,26 @@ class WASP_PUBLIC TreeNodePool
      */
     std::string data(node_index_size node_index) const;
     void data(node_index_size node_index, std::ostream& out) const;
+    /**
+     * @brief data_view acquire a view of the node's data
+     * A leaf's data is viewed in place without copying. A parent's data is
+     * formatted from its descendants into the given buffer, which is viewed.
+     * @param buffer storage for a parent's data, reusable across calls
+     */
+    StringView data_view(node_index_size node_index, std::string& buffer) const;
+    /**
+     * @brief to_int acquire the node's data converted to an integer
+     * A leaf's conversion is cached by its token, so repeated conversions of
+     * the leaf do not reformat its data. Conversions are not cached while
+     * the pool is frozen.
+     * @param ok optional indication of whether the conversion succeeded
+     */
+    int to_int(node_index_size node_index, bool* ok = nullptr) const;
+    /**
+     * @brief to_double acquire the node's data converted to a double
+     * Leaf conversions are cached as with to_int.
+     */
+    double to_double(node_index_size node_index, bool* ok = nullptr) const;
 
     /**
      * @brief line acquire the line the node starts on
@@ -307,6 +443,219 @@ class WASP_PUBLIC TreeNodePool
     void set_start_column(size_t col) { m_start_column = col; }
     size_t                       start_column() const { return m_start_column; }
 
+    /**
+     * @brief clear remove all tokens and nodes while retaining the allocated
+     * capacity so that a subsequent document of similar size can be pushed
+     * without reallocation
+     * A frozen pool is thawed.
+     */
+    void clear();
+    /**
+     * @brief swap exchange the tokens, nodes, and indices of this pool with
+     * the given pool's
+     */
+    void swap(TreeNodePool& other);
+    /**
+     * @brief reserve allocate capacity for the given number of nodes, tokens,
+     * token characters, and lines
+     */
+    void reserve(std::size_t node_count,
+                 std::size_t token_count,
+                 std::size_t char_count,
+                 std::size_t line_count);
+
+    /**
+     * @brief save write the pool's tokens and nodes to the given binary
+     * snapshot stream
+     * @param out the stream to write to
+     */
+    void save(std::ostream& out) const;
+    /**
+     * @brief load replace the pool's tokens and nodes with those of the given
+     * binary snapshot stream
+     * A frozen pool is thawed.
+     * @param in the stream to read from
+     * @return true, iff the data was completely read and is consistent
+     */
+    bool load(std::istream& in);
+
+    /**
+     * @brief freeze make the pool read-only
+     * The name index of every parent with at least child_name_index_threshold
+     * children, the subtree hashes, and the descendant name filters are
+     * built, so that no const member modifies the pool and any number of
+     * threads may read a frozen pool concurrently. Pushing or setting tokens
+     * and nodes of a frozen pool throws. The pool remains frozen until it is
+     * cleared or loaded.
+     */
+    void freeze();
+    bool frozen() const { return m_frozen; }
+
+    /**
+     * @brief relayout renumber the nodes into pre-order
+     * Each tree's root is followed by its descendants in depth-first order,
+     * so every subtree occupies the contiguous node range
+     * [node_index, subtree_end(node_index)) and a descendant scan is a linear
+     * sweep of the node data. Parent child lists are stored in the same
+     * order. Trees are laid out most recently pushed first, so a document's
+     * root, pushed last, becomes node 0. Tokens and names are unchanged.
+     * Node indices acquired prior to the relayout are invalidated. Pushing
+     * further nodes discards the layout's subtree ranges.
+     * @return the new index of each node, indexed by its prior index
+     */
+    std::vector<std::size_t> relayout();
+    /**
+     * @brief preordered determine if the nodes are laid out in pre-order
+     * with subtree ranges
+     */
+    bool preordered() const { return m_preordered; }
+    /**
+     * @brief subtree_end acquire one past the last descendant of the given
+     * node
+     * Only available when the pool is preordered.
+     */
+    std::size_t subtree_end(node_index_size node_index) const
+    {
+        wasp_require(m_preordered);
+        return m_subtree_end[node_index];
+    }
+    /**
+     * @brief is_descendant determine if the given node is a descendant of
+     * the given ancestor
+     * Constant time when the pool is preordered, otherwise the node's
+     * parents are walked.
+     */
+    bool is_descendant(node_index_size ancestor_index,
+                       node_index_size node_index) const;
+    /**
+     * @brief subtree_hash acquire the structural hash of the given node's
+     * subtree
+     * The hash covers the type, name, and leaf data of the subtree's nodes
+     * and the order of each parent's children, but not their positions, so
+     * equal subtrees hash equally within a document and across documents.
+     * The subtrees of all nodes are hashed in one bottom-up pass when first
+     * requested, and again once the pool is modified.
+     * A packed array's elements contribute their values rather than their
+     * text, so a packed array's hash differs from its unpacked hash.
+     * The hash covers only this pool's nodes. An include (wasp::FILE) node
+     * contributes its own subtree, e.g., the include path, but not the
+     * content of the included document, so equal hashes do not imply equal
+     * included content.
+     */
+    std::uint64_t subtree_hash(node_index_size node_index) const;
+    /**
+     * @brief may_have_descendant determine whether any descendant of the
+     * given node may have the given name symbol
+     * @return false, iff no descendant has the name; true if a descendant
+     * has the name or, rarely, when the node's filter is a false positive
+     * Each node's descendant names are summarized by a 64-bit bloom filter,
+     * so selections of descendants by name can skip subtrees without the
+     * name. The filters of all nodes are built in one bottom-up pass when
+     * first requested, and again once the pool is modified. Like the
+     * subtree hashes, the filters cover only this pool's nodes and not the
+     * nodes of included documents.
+     */
+    bool may_have_descendant(node_index_size node_index,
+                             std::size_t     symbol) const;
+
+    /**
+     * @brief enable_type_index maintain each node type's list of nodes so
+     * that nodes_of_type need not scan every node
+     * Nodes already pushed are indexed immediately and subsequently pushed
+     * nodes are indexed as they are pushed. The index remains enabled when
+     * the pool is cleared or loaded.
+     */
+    void enable_type_index();
+    bool type_indexed() const { return m_type_indexed; }
+    /**
+     * @brief nodes_of_type acquire all nodes of the given type
+     * @param type the node type of interest (wasp::OBJECT, wasp::FILE, etc.)
+     * @param node_indices the ascending indices of the nodes of the type
+     * A lookup of the type index when enabled, otherwise a scan of all nodes.
+     */
+    void nodes_of_type(node_type_size            type,
+                       std::vector<std::size_t>& node_indices) const;
+
+    /**
+     * @brief discard remove the nodes from the given index onward
+     * Tokens lexed while the discarded nodes were pushed that no remaining
+     * node references are removed too. Tokens lexed afterward, such as a
+     * parser's lookahead, are retained but renumbered, each decreasing by
+     * the number of tokens removed. Remaining nodes must not reference a
+     * discarded node.
+     * @param first_index the first node to discard
+     * @return the number of tokens removed
+     */
+    std::size_t discard(node_index_size first_index);
+
+    /**
+     * @brief pack_arrays store long homogeneous numeric arrays compactly
+     * An ARRAY whose elements are all integer or real value leaves, at least
+     * min_size of them, keeps its declarator, assignment, and delimiter
+     * children while its elements, and the commas separating them, cease to
+     * be nodes and tokens. The elements' values are stored contiguously,
+     * as int64 when all are integers and as double otherwise, along with the
+     * offset each element starts at. Packed elements are acquired through
+     * the packed_* accessors, are not among the array's children, and are
+     * printed as the shortest text that reproduces their value.
+     * Remaining nodes and tokens are renumbered in order, so a preordered
+     * pool remains preordered. Node indices acquired prior to packing are
+     * invalidated.
+     * @return the new index of each node, indexed by its prior index, where
+     * removed nodes map to the prior node count
+     */
+    std::vector<std::size_t> pack_arrays(std::size_t min_size);
+    /**
+     * @brief packed_array_count the number of packed arrays
+     */
+    std::size_t packed_array_count() const { return m_packed_arrays.size(); }
+    /**
+     * @brief packed_size the number of packed elements of the given node
+     * @return the element count, or zero if the node is not a packed array
+     */
+    std::size_t packed_size(node_index_size node_index) const
+    {
+        const PackedArray* array = packed_array(node_index);
+        return array == nullptr ? 0 : array->m_count;
+    }
+    /**
+     * @brief packed_position the child position the packed elements occupy,
+     * i.e., the number of the array's children preceding the elements
+     */
+    std::size_t packed_position(node_index_size node_index) const;
+    /**
+     * @brief packed_separated determine if the packed elements are
+     * separated by commas
+     */
+    bool packed_separated(node_index_size node_index) const;
+    /**
+     * @brief packed_integers acquire the packed elements of an array of
+     * integers
+     * @return the elements, empty if the array's elements are not integers
+     */
+    Span<const std::int64_t> packed_integers(node_index_size node_index) const;
+    /**
+     * @brief packed_reals acquire the packed elements of an array of reals
+     * @return the elements, empty if the array's elements are integers
+     */
+    Span<const double> packed_reals(node_index_size node_index) const;
+    /**
+     * @brief packed_data acquire the text of the packed element at the given
+     * position, the shortest that reproduces its value
+     */
+    std::string packed_data(node_index_size node_index,
+                            std::size_t     element) const;
+    /**
+     * @brief packed_line acquire the line the packed element starts on
+     */
+    std::size_t packed_line(node_index_size node_index,
+                            std::size_t     element) const;
+    /**
+     * @brief packed_column acquire the column the packed element starts on
+     */
+    std::size_t packed_column(node_index_size node_index,
+                              std::size_t     element) const;
+
   private:
     typename TP::file_offset_type_size m_start_line;
     typename TP::file_offset_type_size m_start_column;
@@ -316,49 +665,15 @@ class WASP_PUBLIC TreeNodePool
      */
     TP m_token_data;  //
     /**
-     * @brief m_node_names all node names are stored here
+     * @brief m_node_names all distinct node names are interned here
+     * Nodes reference their name by symbol (BasicNodeData::m_name_index)
      */
-    StringPool<typename TP::token_index_type_size> m_node_names;
-    /**
-     * @brief The BasicNodeData struct describes all node's basic data
-     */
-    struct BasicNodeData
-    {
-        BasicNodeData(){}
-        BasicNodeData(node_type_size type, node_index_size parent_index)
-            : m_node_type(type), m_parent_node_index(parent_index)
-        {
-        }
-
-        bool is_leaf() const {return m_token_index != static_cast<typename TP::token_index_type_size>(-1);}
-        bool has_parent_data() const {return m_node_parent_data_index != static_cast<node_index_size>(-1);}
-        /**
-         * @brief m_type the node type
-         */
-        node_type_size m_node_type = -1;
-        /**
-         * @brief m_parent_node_index the node's parent index into
-         * m_node_basic_data
-         */
-        node_index_size m_parent_node_index = -1;
-
-        /**
-         * @brief m_token_index the node's token data index
-         * Use is_leaf() to determine if this is assigned to
-         * existing token data (m_token_data[m_token_index])
-         */
-        typename TP::token_index_type_size m_token_index = -1;
-        /**
-         * @brief m_node_parent_data_index node's parent data index
-         * Use has_parent_data() to determine if this is assigned to
-         * existing parent-node data (m_node_parent_data[m_node_parent_data_index])
-         */
-        node_index_size m_node_parent_data_index = -1;
-    };
+    SymbolTable<typename TP::token_index_type_size> m_node_names;
     /**
-     * @brief m_node_basic_data basic data for all nodes
+     * @brief m_node_basic_data basic data for all nodes, in the layout of
+     * the NL policy
      */
-    std::vector<BasicNodeData> m_node_basic_data;
+    NodeData_type m_node_basic_data;
     /**
      * @brief The ParentNodeData struct describes parent node's data
      */
@@ -393,6 +708,195 @@ class WASP_PUBLIC TreeNodePool
      */
     std::vector<node_index_size> m_node_child_indices;
 
+    typedef std::vector<node_index_size> NamedChildren;
+    typedef typename NamedChildren::const_iterator NamedChildIterator;
+    /**
+     * @brief named_children acquire the given parent's children with the
+     * given name symbol, in child order, from the parent's name index
+     * @return false, iff the parent has too few children to be indexed, in
+     * which case the range is not assigned
+     */
+    bool named_children(node_index_size     node_index,
+                        std::size_t         symbol,
+                        NamedChildIterator& begin,
+                        NamedChildIterator& end) const;
+    /**
+     * @brief m_child_name_index lazily built name index of large parents
+     * Maps the parent's node index to its children stably sorted by name
+     * symbol. Built on demand by the const by-name lookups, so concurrent
+     * first lookups of a parent are not thread safe unless the pool is
+     * frozen, which builds every parent's index.
+     */
+    mutable std::unordered_map<node_index_size, NamedChildren>
+        m_child_name_index;
+    /**
+     * @brief index_children build the name index of the given parent
+     */
+    const NamedChildren& index_children(node_index_size node_index) const;
+    typedef std::vector<typename TP::token_index_type_size> NameSymbols;
+    /**
+     * @brief m_names_by_prefix all name symbols sorted by name
+     * Lazily built by find_name_symbols, or by freeze
+     */
+    mutable NameSymbols m_names_by_prefix;
+    /**
+     * @brief m_names_by_suffix all name symbols sorted by reversed name
+     */
+    mutable NameSymbols m_names_by_suffix;
+    /**
+     * @brief index_names sort the name symbols, iff names were interned since
+     * they were last sorted
+     */
+    void index_names() const;
+    bool m_frozen;
+    static const char* const frozen_message;
+    /**
+     * @brief m_subtree_end one past the last descendant of each node
+     * Only populated while the pool is preordered
+     */
+    std::vector<node_index_size> m_subtree_end;
+    bool                         m_preordered;
+    /**
+     * @brief discard_layout discard the pre-order subtree ranges as nodes
+     * are pushed
+     */
+    void discard_layout()
+    {
+        if (!m_preordered)
+            return;
+        m_preordered = false;
+        m_subtree_end.clear();
+    }
+    /**
+     * @brief m_type_index each node type's node indices in ascending order
+     * Indexed by node type and only maintained while m_type_indexed
+     */
+    std::vector<std::vector<node_index_size>> m_type_index;
+    bool                                      m_type_indexed;
+    /**
+     * @brief index_type add the given node, the last pushed, to its type's
+     * list
+     */
+    void index_type(node_index_size node_index)
+    {
+        if (!m_type_indexed)
+            return;
+        std::size_t type = m_node_basic_data.type(node_index);
+        if (type >= m_type_index.size())
+            m_type_index.resize(type + 1);
+        m_type_index[type].push_back(node_index);
+    }
+    /**
+     * @brief index_types rebuild the type index of all nodes
+     */
+    void index_types();
+    /**
+     * @brief index_subtrees compute the subtree range of all nodes, which
+     * must be in pre-order
+     */
+    void index_subtrees();
+
+    /**
+     * @brief The PackedArray struct describes an array's packed elements
+     */
+    struct PackedArray
+    {
+        /**
+         * @brief m_node the array node
+         */
+        node_index_size m_node;
+        /**
+         * @brief m_position the number of the array's children preceding
+         * the elements
+         */
+        node_index_size m_position;
+        /**
+         * @brief m_first the index of the first element's value into
+         * m_packed_integers or m_packed_reals
+         */
+        std::uint64_t m_first;
+        /**
+         * @brief m_first_offset the index of the first element's offset into
+         * m_packed_offsets
+         */
+        std::uint64_t m_first_offset;
+        std::uint64_t m_count;
+        /**
+         * @brief m_integral the elements are integers in m_packed_integers
+         */
+        std::uint8_t m_integral;
+        /**
+         * @brief m_separated the elements are separated by commas
+         */
+        std::uint8_t m_separated;
+    };
+    std::vector<PackedArray> m_packed_arrays;
+    /**
+     * @brief m_packed_array_index maps an array node to its m_packed_arrays
+     * index
+     */
+    std::unordered_map<node_index_size, std::size_t> m_packed_array_index;
+    std::vector<std::int64_t>                        m_packed_integers;
+    std::vector<double>                              m_packed_reals;
+    /**
+     * @brief m_packed_offsets the byte offset each packed element starts at
+     */
+    std::vector<typename TP::file_offset_type_size> m_packed_offsets;
+    const PackedArray* packed_array(node_index_size node_index) const
+    {
+        if (m_packed_arrays.empty())
+            return nullptr;
+        auto itr = m_packed_array_index.find(node_index);
+        if (itr == m_packed_array_index.end())
+            return nullptr;
+        return &m_packed_arrays[itr->second];
+    }
+    /**
+     * @brief index_packed_arrays rebuild the packed array node index
+     */
+    void index_packed_arrays();
+    /**
+     * @brief packed_offset acquire the byte offset of the packed element
+     */
+    typename TP::file_offset_type_size
+    packed_offset(node_index_size node_index, std::size_t element) const;
+
+    /**
+     * @brief m_subtree_hashes the structural hash of each node's subtree,
+     * empty until requested
+     */
+    mutable std::vector<std::uint64_t> m_subtree_hashes;
+    /**
+     * @brief hash_subtrees compute the structural hash of all subtrees
+     */
+    void hash_subtrees() const;
+    /**
+     * @brief m_descendant_names the bloom filter of each node's descendants'
+     * name symbols, empty until requested
+     */
+    mutable std::vector<std::uint64_t> m_descendant_names;
+    /**
+     * @brief name_filter the bloom filter bits of the given name symbol
+     */
+    static std::uint64_t name_filter(std::size_t symbol)
+    {
+        std::uint64_t h = symbol * 0x9e3779b97f4a7c15ULL;
+        return (std::uint64_t(1) << (h >> 58)) |
+               (std::uint64_t(1) << ((h >> 52) & 63));
+    }
+    /**
+     * @brief filter_descendant_names build every node's descendant name filter
+     */
+    void filter_descendant_names() const;
+    /**
+     * @brief discard_hashes discard the subtree hashes and descendant name
+     * filters of a modified pool
+     */
+    void discard_hashes()
+    {
+        m_subtree_hashes.clear();
+        m_descendant_names.clear();
+    }
 };
 
 #include "waspcore/TreeNodePool.i.h"
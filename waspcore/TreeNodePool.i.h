@@ -1,13 +1,25 @@
 #ifndef WASP_TREENODEPOOL_I_H
 #define WASP_TREENODEPOOL_I_H
 
-template<typename NTS, typename NIS, typename TP>
-TreeNodePool<NTS, NIS, TP>::TreeNodePool() : m_start_line(1), m_start_column(1)
+template<typename NTS, typename NIS, class TP, class NL>
+const std::size_t TreeNodePool<NTS, NIS, TP, NL>::child_name_index_threshold;
+
+template<typename NTS, typename NIS, class TP, class NL>
+const char* const TreeNodePool<NTS, NIS, TP, NL>::frozen_message =
+    "frozen tree nodes cannot be modified!";
+
+template<typename NTS, typename NIS, class TP, class NL>
+TreeNodePool<NTS, NIS, TP, NL>::TreeNodePool()
+    : m_start_line(1)
+    , m_start_column(1)
+    , m_frozen(false)
+    , m_preordered(false)
+    , m_type_indexed(false)
 {
 }
 // copy constructor
-template<typename NTS, typename NIS, typename TP>
-TreeNodePool<NTS, NIS, TP>::TreeNodePool(const TreeNodePool<NTS, NIS, TP>& orig)
+template<typename NTS, typename NIS, class TP, class NL>
+TreeNodePool<NTS, NIS, TP, NL>::TreeNodePool(const TreeNodePool<NTS, NIS, TP, NL>& orig)
     : m_start_line(1)
     , m_start_column(1)
     , m_token_data(orig.m_token_data)
@@ -15,23 +27,37 @@ TreeNodePool<NTS, NIS, TP>::TreeNodePool(const TreeNodePool<NTS, NIS, TP>& orig)
     , m_node_basic_data(orig.m_node_basic_data)
     , m_node_parent_data(orig.m_node_parent_data)
     , m_node_child_indices(orig.m_node_child_indices)
+    , m_frozen(false)
+    , m_subtree_end(orig.m_subtree_end)
+    , m_preordered(orig.m_preordered)
+    , m_type_index(orig.m_type_index)
+    , m_type_indexed(orig.m_type_indexed)
+    , m_packed_arrays(orig.m_packed_arrays)
+    , m_packed_array_index(orig.m_packed_array_index)
+    , m_packed_integers(orig.m_packed_integers)
+    , m_packed_reals(orig.m_packed_reals)
+    , m_packed_offsets(orig.m_packed_offsets)
+    , m_subtree_hashes(orig.m_subtree_hashes)
 {
 }
 // default destructor
-template<typename NTS, typename NIS, class TP>
-TreeNodePool<NTS, NIS, TP>::~TreeNodePool()
+template<typename NTS, typename NIS, class TP, class NL>
+TreeNodePool<NTS, NIS, TP, NL>::~TreeNodePool()
 {
 }
 // Create a parent node
-template<typename NTS, typename NIS, class TP>
-void TreeNodePool<NTS, NIS, TP>::push_parent(
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::push_parent(
     NTS type, const char* name, const std::vector<size_t>& child_indices)
 {
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
+    discard_layout();
     // Capture node's basic information
-    m_node_names.push(name);
     NIS basic_data_index = static_cast<NIS>(m_node_basic_data.size());
-    // capture type - parent index is unknown
-    m_node_basic_data.push_back(BasicNodeData(type, -1));
+    // capture type and name - parent index is unknown
+    m_node_basic_data.push_back(
+        BasicNodeData_type(type, -1, m_node_names.intern(name)));
 
     // capture node's parental info
     NIS parent_data_index = static_cast<NIS>(m_node_parent_data.size());
@@ -43,7 +69,7 @@ void TreeNodePool<NTS, NIS, TP>::push_parent(
     // capture index association between basic and parent data
     // basic data is type, and parent index
     // parent data is only present when the node has children
-    m_node_basic_data.back().m_node_parent_data_index = parent_data_index;
+    m_node_basic_data.set_parent_data(basic_data_index, parent_data_index);
 
     // update the children's parent index
     // TODO check children for lack of parent
@@ -54,27 +80,43 @@ void TreeNodePool<NTS, NIS, TP>::push_parent(
         // assign parent
         wasp_check(c < child_indices.size());
         node_index_size child_index                            = child_indices[c];
-        m_node_basic_data[child_index].m_parent_node_index = basic_data_index;
+        m_node_basic_data.set_parent(child_index, basic_data_index);
         // assign lookup index mapping parent to list
         // of arbitrary indices into basic node data
         // describing the children of this parent node
         m_node_child_indices.push_back(child_index);
     }
+    index_type(basic_data_index);
 }
-template<typename NTS, typename NIS, class TP>
-void TreeNodePool<NTS, NIS, TP>::set_type(NIS node_index, NTS type)
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::set_type(NIS node_index, NTS type)
 {
-    m_node_basic_data[node_index].m_node_type = type;
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
+    if (m_type_indexed && m_node_basic_data.type(node_index) != type)
+    {
+        // move the node from its prior type's list to that of the new type
+        std::vector<NIS>& prior = m_type_index[m_node_basic_data.type(node_index)];
+        prior.erase(std::lower_bound(prior.begin(), prior.end(), node_index));
+        if (static_cast<std::size_t>(type) >= m_type_index.size())
+            m_type_index.resize(static_cast<std::size_t>(type) + 1);
+        std::vector<NIS>& nodes = m_type_index[type];
+        nodes.insert(std::lower_bound(nodes.begin(), nodes.end(), node_index),
+                     node_index);
+    }
+    m_node_basic_data.set_type(node_index, type);
 }
-template<typename NTS, typename NIS, class TP>
-void TreeNodePool<NTS, NIS, TP>::set_data(NIS node_index, const char* data)
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::set_data(NIS node_index, const char* data)
 {
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
     wasp_insist(is_leaf(node_index), "data assignment only allowed for leaf nodes!");
-    auto tindex      = m_node_basic_data[node_index].m_token_index;
+    auto tindex      = m_node_basic_data.token(node_index);
     auto file_offset = m_token_data.offset(tindex);
     auto type        = m_token_data.type(tindex);
 
-    m_node_basic_data[node_index].m_token_index = m_token_data.size();
+    m_node_basic_data.set_token(node_index, m_token_data.size());
 
     // TODO - add logic/accessors to allow overwriting
     // existing token data in the case where new value's size is equal to or less than
@@ -83,51 +125,55 @@ void TreeNodePool<NTS, NIS, TP>::set_data(NIS node_index, const char* data)
     m_token_data.push(data, type, file_offset, track_newlines);
 }
 // Create a leaf node
-template<typename NTS, typename NIS, class TP>
-void TreeNodePool<NTS, NIS, TP>::push_leaf(
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::push_leaf(
     NTS                                node_type,
     const char*                        node_name,
     typename TP::token_type_size       token_type,
     typename TP::file_offset_type_size token_offset,
     const char*                        token_data)
 {
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
+    discard_layout();
     // capture the token data index
     typename TP::token_index_type_size token_data_index =
         static_cast<typename TP::token_index_type_size>(m_token_data.size());
     m_token_data.push(token_data, token_type, token_offset);
 
-    // Capture node's basic information
-    m_node_names.push(node_name);
-
-    // capture type - parent index is unknown
-    m_node_basic_data.push_back(BasicNodeData(node_type, -1));
+    // capture type and name - parent index is unknown
+    m_node_basic_data.push_back(
+        BasicNodeData_type(node_type, -1, m_node_names.intern(node_name)));
 
     // make the leaf node to token index association
-    m_node_basic_data.back().m_token_index = token_data_index;
+    m_node_basic_data.set_token(m_node_basic_data.size() - 1, token_data_index);
+    index_type(static_cast<NIS>(m_node_basic_data.size() - 1));
 }
 // Create a leaf node for a given token
-template<typename NTS, typename NIS, class TP>
-void TreeNodePool<NTS, NIS, TP>::push_leaf(
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::push_leaf(
     NTS                                node_type,
     const char*                        node_name,
     typename TP::token_index_type_size token_data_index)
 {
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
+    discard_layout();
     // TODO - check the token_data_index is legit
 
-    // Capture node's basic information
-    m_node_names.push(node_name);
-
-    // capture type - parent index is unknown
-    m_node_basic_data.push_back(BasicNodeData(node_type, -1));
+    // capture type and name - parent index is unknown
+    m_node_basic_data.push_back(
+        BasicNodeData_type(node_type, -1, m_node_names.intern(node_name)));
 
     // make the leaf node to token index association
-    m_node_basic_data.back().m_token_index = token_data_index;
+    m_node_basic_data.set_token(m_node_basic_data.size() - 1, token_data_index);
+    index_type(static_cast<NIS>(m_node_basic_data.size() - 1));
 }
 // Acquire the given token's parent meta data (child indices, count) index
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::parent_data_index(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::parent_data_index(NIS node_index) const
 {
-    if (!m_node_basic_data[node_index].has_parent_data())
+    if (!m_node_basic_data.has_parent_data(node_index))
     {
         return size();  // when root, return size of nodes
     }
@@ -135,32 +181,37 @@ std::size_t TreeNodePool<NTS, NIS, TP>::parent_data_index(NIS node_index) const
     // TODO - could check parent children for consistency
 
     // return the index of the
-    return m_node_basic_data[node_index].m_node_parent_data_index;
+    return m_node_basic_data.parent_data(node_index);
 }
 
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::parent_node_index(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::parent_node_index(NIS node_index) const
 {
     wasp_check(node_index < m_node_basic_data.size());
-    auto parent_index = m_node_basic_data[node_index].m_parent_node_index;
+    auto parent_index = m_node_basic_data.parent(node_index);
     if (parent_index == NIS(-1))
     {
         return size();
     }
     return parent_index;
 }
-template<typename NTS, typename NIS, class TP>
-bool TreeNodePool<NTS, NIS, TP>::set_name(NIS node_index, const char* name)
+template<typename NTS, typename NIS, class TP, class NL>
+bool TreeNodePool<NTS, NIS, TP, NL>::set_name(NIS node_index, const char* name)
 {
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
     if (m_node_basic_data.empty())
         return false;
-    if (node_index < m_node_basic_data.size() - 1 ||
-        node_index > m_node_basic_data.size() - 1)
+    if (static_cast<std::size_t>(node_index) < m_node_basic_data.size() - 1 ||
+        static_cast<std::size_t>(node_index) > m_node_basic_data.size() - 1)
         return false;
-    return m_node_names.set(node_index, name);
+    m_node_basic_data.set_name(node_index, m_node_names.intern(name));
+    // the renamed node may be an indexed child
+    m_child_name_index.clear();
+    return true;
 }
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::child_count(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::child_count(NIS node_index) const
 {
     // acquire the index into the parent meta data
     std::size_t parent_index = parent_data_index(node_index);
@@ -168,8 +219,243 @@ std::size_t TreeNodePool<NTS, NIS, TP>::child_count(NIS node_index) const
         return 0;
     return m_node_parent_data[parent_index].m_child_count;
 }
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::child_at(NIS node_index,
+template<typename NTS, typename NIS, class TP, class NL>
+const typename TreeNodePool<NTS, NIS, TP, NL>::NamedChildren&
+TreeNodePool<NTS, NIS, TP, NL>::index_children(NIS node_index) const
+{
+    std::size_t    count    = child_count(node_index);
+    NamedChildren& children = m_child_name_index[node_index];
+    children.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        children.push_back(static_cast<NIS>(child_at(node_index, i)));
+    }
+    // stable to retain child order amongst same named children
+    std::stable_sort(children.begin(), children.end(),
+                     [this](NIS a, NIS b) {
+                         return m_node_basic_data.name(a) <
+                                m_node_basic_data.name(b);
+                     });
+    return children;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+bool TreeNodePool<NTS, NIS, TP, NL>::named_children(NIS                 node_index,
+                                                std::size_t         symbol,
+                                                NamedChildIterator& begin,
+                                                NamedChildIterator& end) const
+{
+    if (child_count(node_index) < child_name_index_threshold)
+        return false;
+    auto itr = m_child_name_index.find(node_index);
+    // a frozen pool's parents are all indexed
+    wasp_check(!m_frozen || itr != m_child_name_index.end());
+    const NamedChildren& children = itr == m_child_name_index.end()
+                                        ? index_children(node_index)
+                                        : itr->second;
+    begin = std::lower_bound(children.begin(), children.end(), symbol,
+                             [this](NIS child, std::size_t s) {
+                                 std::size_t name =
+                                     m_node_basic_data.name(child);
+                                 return name < s;
+                             });
+    end = std::upper_bound(begin, children.end(), symbol,
+                           [this](std::size_t s, NIS child) {
+                               std::size_t name =
+                                   m_node_basic_data.name(child);
+                               return s < name;
+                           });
+    return true;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::first_child_by_name(NIS node_index,
+                                                            const char* name) const
+{
+    std::size_t symbol = find_name_symbol(name);
+    // no node has the name
+    if (symbol == m_node_names.npos)
+        return size();
+    NamedChildIterator begin, end;
+    if (named_children(node_index, symbol, begin, end))
+    {
+        return begin == end ? size() : *begin;
+    }
+    for (std::size_t i = 0, count = child_count(node_index); i < count; ++i)
+    {
+        std::size_t child_index = child_at(node_index, i);
+        if (static_cast<std::size_t>(m_node_basic_data.name(child_index)) ==
+            symbol)
+            return child_index;
+    }
+    return size();
+}
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::child_count_by_name(
+    NIS node_index, const char* name, std::size_t limit) const
+{
+    std::size_t symbol = find_name_symbol(name);
+    // no node has the name
+    if (symbol == m_node_names.npos)
+        return 0;
+    NamedChildIterator begin, end;
+    if (named_children(node_index, symbol, begin, end))
+    {
+        std::size_t count = std::distance(begin, end);
+        // limit of 0 is reserved as no limit
+        return limit != 0 && limit < count ? limit : count;
+    }
+    std::size_t matching_named_child_count = 0;
+    for (std::size_t i = 0, count = child_count(node_index); i < count; ++i)
+    {
+        std::size_t child_index = child_at(node_index, i);
+        if (static_cast<std::size_t>(m_node_basic_data.name(child_index)) ==
+            symbol)
+        {
+            ++matching_named_child_count;
+            // limit of 0 is reserved as no limit
+            if (matching_named_child_count == limit)
+                break;
+        }
+    }
+    return matching_named_child_count;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::child_by_name(
+    NIS                       node_index,
+    const char*               name,
+    std::vector<std::size_t>& child_indices,
+    std::size_t               limit) const
+{
+    std::size_t symbol = find_name_symbol(name);
+    // no node has the name
+    if (symbol == m_node_names.npos)
+        return;
+    child_by_name_symbol(node_index, symbol, child_indices, limit);
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::child_by_name_symbol(
+    NIS                       node_index,
+    std::size_t               symbol,
+    std::vector<std::size_t>& child_indices,
+    std::size_t               limit) const
+{
+    NamedChildIterator begin, end;
+    if (named_children(node_index, symbol, begin, end))
+    {
+        // limit of 0 is reserved as no limit
+        if (limit != 0 && limit < static_cast<std::size_t>(end - begin))
+            end = begin + limit;
+        child_indices.insert(child_indices.end(), begin, end);
+        return;
+    }
+    std::size_t matching_named_child_count = 0;
+    for (std::size_t i = 0, count = child_count(node_index); i < count; ++i)
+    {
+        std::size_t child_index = child_at(node_index, i);
+        if (static_cast<std::size_t>(m_node_basic_data.name(child_index)) ==
+            symbol)
+        {
+            child_indices.push_back(child_index);
+            // limit of 0 is reserved as no limit
+            if (++matching_named_child_count == limit)
+                break;
+        }
+    }
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::index_names() const
+{
+    std::size_t count = m_node_names.size();
+    // names are only ever added, so the sorted names are current iff complete
+    if (m_names_by_prefix.size() == count)
+        return;
+    m_names_by_prefix.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_names_by_prefix[i] =
+            static_cast<typename TP::token_index_type_size>(i);
+    }
+    m_names_by_suffix = m_names_by_prefix;
+    const SymbolTable<typename TP::token_index_type_size>& names =
+        m_node_names;
+    std::sort(m_names_by_prefix.begin(), m_names_by_prefix.end(),
+              [&names](std::size_t a, std::size_t b) {
+                  return names.view(a).compare(names.view(b)) < 0;
+              });
+    std::sort(m_names_by_suffix.begin(), m_names_by_suffix.end(),
+              [&names](std::size_t a, std::size_t b) {
+                  StringView va = names.view(a), vb = names.view(b);
+                  return std::lexicographical_compare(
+                      va.rbegin(), va.rend(), vb.rbegin(), vb.rend());
+              });
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::find_name_symbols(
+    const char* pattern, std::vector<std::size_t>& symbols) const
+{
+    const char* wildcard = std::strpbrk(pattern, "*?");
+    if (wildcard == nullptr)
+    {
+        std::size_t symbol = find_name_symbol(pattern);
+        if (symbol != m_node_names.npos)
+            symbols.push_back(symbol);
+        return;
+    }
+    std::size_t first = symbols.size();
+    StringView  view(pattern);
+    if (std::strpbrk(wildcard + 1, "*?") == nullptr &&
+        (wildcard == view.end() - 1 || wildcard == view.begin()) &&
+        *wildcard == '*')
+    {
+        index_names();
+        const SymbolTable<typename TP::token_index_type_size>& names =
+            m_node_names;
+        if (wildcard == view.end() - 1)
+        {  // prefix, e.g., 'mat*'
+            StringView prefix = view.substr(0, view.size() - 1);
+            auto       itr    = std::lower_bound(
+                m_names_by_prefix.begin(), m_names_by_prefix.end(), prefix,
+                [&names](std::size_t s, StringView p) {
+                    return names.view(s).compare(p) < 0;
+                });
+            for (; itr != m_names_by_prefix.end() &&
+                   names.view(*itr).substr(0, prefix.size()) == prefix;
+                 ++itr)
+            {
+                symbols.push_back(*itr);
+            }
+        }
+        else
+        {  // suffix, e.g., '*al'
+            StringView suffix = view.substr(1);
+            auto       itr    = std::lower_bound(
+                m_names_by_suffix.begin(), m_names_by_suffix.end(), suffix,
+                [&names](std::size_t s, StringView p) {
+                    StringView v = names.view(s);
+                    return std::lexicographical_compare(
+                        v.rbegin(), v.rend(), p.rbegin(), p.rend());
+                });
+            for (; itr != m_names_by_suffix.end(); ++itr)
+            {
+                StringView name = names.view(*itr);
+                if (name.size() < suffix.size() ||
+                    name.substr(name.size() - suffix.size()) != suffix)
+                    break;
+                symbols.push_back(*itr);
+            }
+        }
+    }
+    else
+    {
+        for (std::size_t s = 0, count = m_node_names.size(); s < count; ++s)
+        {
+            if (wildcard_string_match(pattern, m_node_names.data(s)))
+                symbols.push_back(s);
+        }
+    }
+    std::sort(symbols.begin() + first, symbols.end());
+}
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::child_at(NIS node_index,
                                                  NIS child_relative_index) const
 {
     // acquire the index into the parent meta data
@@ -182,8 +468,8 @@ std::size_t TreeNodePool<NTS, NIS, TP>::child_at(NIS node_index,
     auto child_basic_data_index = m_node_child_indices[child_indices_index];
     return child_basic_data_index;
 }
-template<typename NTS, typename NIS, class TP>
-void TreeNodePool<NTS, NIS, TP>::node_path(NIS node_index,
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::node_path(NIS node_index,
                                            std::ostream& out) const
 {
     // TODO range check node index
@@ -215,8 +501,8 @@ void TreeNodePool<NTS, NIS, TP>::node_path(NIS node_index,
         lineage.pop_back();
     }
 }
-template<typename NTS, typename NIS, class TP>
-void TreeNodePool<NTS, NIS, TP>::node_paths(NIS node_index,
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::node_paths(NIS node_index,
                                             std::ostream& out) const
 {
     wasp_require(node_index < size());
@@ -238,10 +524,10 @@ void TreeNodePool<NTS, NIS, TP>::node_paths(NIS node_index,
 }
 
 // determine if the given node has a parent
-template<typename NTS, typename NIS, class TP>
-bool TreeNodePool<NTS, NIS, TP>::has_parent(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+bool TreeNodePool<NTS, NIS, TP, NL>::has_parent(NIS node_index) const
 {
-    if (size() == 0 || node_index >= size() - 1)
+    if (size() == 0 || static_cast<std::size_t>(node_index) >= size())
     {
         return false;
     }
@@ -250,15 +536,14 @@ bool TreeNodePool<NTS, NIS, TP>::has_parent(NIS node_index) const
 }
 
 // Obtain a nodes starting line
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::line(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::line(NIS node_index) const
 {
     auto leaf_node_index = leaf_index(node_index);
-    auto node_basic_data = m_node_basic_data[leaf_node_index];
     // obtain the token's line
-    if (node_basic_data.is_leaf())
+    if (m_node_basic_data.is_leaf(leaf_node_index))
     {
-        auto token_index = node_basic_data.m_token_index;
+        auto token_index = m_node_basic_data.token(leaf_node_index);
         return m_token_data.line(token_index) + m_start_line - 1;
     }
     // neither a leaf node or a parent node
@@ -266,21 +551,19 @@ std::size_t TreeNodePool<NTS, NIS, TP>::line(NIS node_index) const
     return -1;
 }
 // Obtain a nodes starting column
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::column(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::column(NIS node_index) const
 {
     auto leaf_node_index = leaf_index(node_index);
-    auto node_basic_data = m_node_basic_data[leaf_node_index];
     // obtain the token's column
-    if (node_basic_data.is_leaf())
+    if (m_node_basic_data.is_leaf(leaf_node_index))
     {
-        auto token_index = node_basic_data.m_token_index;
+        auto token_index = m_node_basic_data.token(leaf_node_index);
         // check if token exists on first line
         // in which case first column is applicable
         if (start_column() != 1)
         {
-            if (line_count() == 0 ||
-                line_offset(0) > m_token_data.offset(token_index))
+            if (m_token_data.line(token_index) == 1)
             {
                 return m_token_data.column(token_index) + m_start_column - 1;
             }
@@ -293,8 +576,8 @@ std::size_t TreeNodePool<NTS, NIS, TP>::column(NIS node_index) const
 }
 
 // Obtain a nodes starting line
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::last_line(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::last_line(NIS node_index) const
 {
     // current node's child count
     auto node_child_count = child_count(node_index);
@@ -308,11 +591,10 @@ std::size_t TreeNodePool<NTS, NIS, TP>::last_line(NIS node_index) const
     }
 
     auto leaf_node_index = leaf_index(node_index);
-    auto node_basic_data = m_node_basic_data[leaf_node_index];
 
-    if (node_basic_data.is_leaf())
+    if (m_node_basic_data.is_leaf(leaf_node_index))
     {
-        auto token_index = node_basic_data.m_token_index;
+        auto token_index = m_node_basic_data.token(leaf_node_index);
         return m_token_data.last_line(token_index);
     }
 
@@ -322,8 +604,8 @@ std::size_t TreeNodePool<NTS, NIS, TP>::last_line(NIS node_index) const
 }
 
 // Obtain a nodes starting column
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::last_column(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::last_column(NIS node_index) const
 {
     // current node's child count
     auto node_child_count = child_count(node_index);
@@ -337,11 +619,10 @@ std::size_t TreeNodePool<NTS, NIS, TP>::last_column(NIS node_index) const
     }
 
     auto leaf_node_index = leaf_index(node_index);
-    auto node_basic_data = m_node_basic_data[leaf_node_index];
 
-    if (node_basic_data.is_leaf())
+    if (m_node_basic_data.is_leaf(leaf_node_index))
     {
-        auto token_index = node_basic_data.m_token_index;
+        auto token_index = m_node_basic_data.token(leaf_node_index);
         return m_token_data.last_column(token_index);
     }
 
@@ -351,18 +632,18 @@ std::size_t TreeNodePool<NTS, NIS, TP>::last_column(NIS node_index) const
 }
 
 // Obtain a node's first leaf node index
-template<typename NTS, typename NIS, class TP>
-std::size_t TreeNodePool<NTS, NIS, TP>::leaf_index(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::leaf_index(NIS node_index) const
 {
     // Already have the leaf index?
-    if (m_node_basic_data[node_index].is_leaf())
+    if (m_node_basic_data.is_leaf(node_index))
     {
         return node_index;
     }
     // node must be a parent, need first child
-    if (m_node_basic_data[node_index].has_parent_data())
+    if (m_node_basic_data.has_parent_data(node_index))
     {
-        auto parent_data_index = m_node_basic_data[node_index].m_node_parent_data_index;
+        auto parent_data_index = m_node_basic_data.parent_data(node_index);
         auto parent_data       = m_node_parent_data[parent_data_index];
         if (parent_data.m_child_count == 0)
             return -1;
@@ -375,61 +656,57 @@ std::size_t TreeNodePool<NTS, NIS, TP>::leaf_index(NIS node_index) const
     wasp_not_implemented("node leaf index where node is not a leaf or a parent node!");
 }
 // Obtain a leaf node's token type
-template<typename NTS, typename NIS, class TP>
+template<typename NTS, typename NIS, class TP, class NL>
 typename TP::token_type_size
-TreeNodePool<NTS, NIS, TP>::node_token_type(NIS node_index) const
+TreeNodePool<NTS, NIS, TP, NL>::node_token_type(NIS node_index) const
 {
-    auto node_basic_data = m_node_basic_data[node_index];
 
-    if (node_basic_data.is_leaf())
+    if (m_node_basic_data.is_leaf(node_index))
     {
-        auto token_index = node_basic_data.m_token_index;
+        auto token_index = m_node_basic_data.token(node_index);
         return m_token_data.type(token_index);
     }
     return wasp::UNKNOWN;
 }
-template<typename NTS, typename NIS, class TP>
+template<typename NTS, typename NIS, class TP, class NL>
 size_t
-TreeNodePool<NTS, NIS, TP>::node_token_line(NIS node_index) const
+TreeNodePool<NTS, NIS, TP, NL>::node_token_line(NIS node_index) const
 {
     auto leaf_node_index = leaf_index(node_index);
-    auto node_basic_data = m_node_basic_data[leaf_node_index];
-    wasp_check(node_basic_data.is_leaf());
+    wasp_check(m_node_basic_data.is_leaf(leaf_node_index));
     
-    auto token_index = node_basic_data.m_token_index;
+    auto token_index = m_node_basic_data.token(leaf_node_index);
     return m_token_data.line(token_index);
 }
 // Obtain a leaf node's token type
-template<typename NTS, typename NIS, class TP>
+template<typename NTS, typename NIS, class TP, class NL>
 typename TP::file_offset_type_size
-TreeNodePool<NTS, NIS, TP>::node_token_offset(NIS node_index) const
+TreeNodePool<NTS, NIS, TP, NL>::node_token_offset(NIS node_index) const
 {
     auto leaf_node_index = leaf_index(node_index);
-    auto node_basic_data = m_node_basic_data[leaf_node_index];
-    wasp_check(node_basic_data.is_leaf());
+    wasp_check(m_node_basic_data.is_leaf(leaf_node_index));
     
-    auto token_index = node_basic_data.m_token_index;
+    auto token_index = m_node_basic_data.token(leaf_node_index);
     return m_token_data.offset(token_index);    
 }
 // Obtain the node's data (string contents)
-template<typename NTS, typename NIS, class TP>
-std::string TreeNodePool<NTS, NIS, TP>::data(NIS node_index) const
+template<typename NTS, typename NIS, class TP, class NL>
+std::string TreeNodePool<NTS, NIS, TP, NL>::data(NIS node_index) const
 {
     std::stringstream data_stream;
     data(node_index, data_stream);
     return data_stream.str();
 }
 // Obtain the node's data (string contents)
-template<typename NTS, typename NIS, class TP>
-void TreeNodePool<NTS, NIS, TP>::data(NIS node_index, std::ostream& out) const
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::data(NIS node_index, std::ostream& out) const
 {
     // two scenarios - 1 leaf node, 2 parent node
     // 1. obtain the leaf node's token data
-    auto node_basic_data = m_node_basic_data[node_index];
 
-    if (node_basic_data.is_leaf())
+    if (m_node_basic_data.is_leaf(node_index))
     {
-        auto token_index = node_basic_data.m_token_index;
+        auto token_index = m_node_basic_data.token(node_index);
         out << m_token_data.str(token_index);
     }
     // 2. accumulate the parent
@@ -440,5 +717,944 @@ void TreeNodePool<NTS, NIS, TP>::data(NIS node_index, std::ostream& out) const
         print_from(out, *this, node_index, node_line, node_column);
     }
 }
+// Obtain a view of the node's data
+template<typename NTS, typename NIS, class TP, class NL>
+StringView TreeNodePool<NTS, NIS, TP, NL>::data_view(NIS          node_index,
+                                                     std::string& buffer) const
+{
+    if (m_node_basic_data.is_leaf(node_index))
+    {
+        return m_token_data.view(m_node_basic_data.token(node_index));
+    }
+    // format the parent's data into the buffer's existing capacity
+    buffer.clear();
+    StringAppendBuffer append(buffer);
+    std::ostream       out(&append);
+    data(node_index, out);
+    return StringView(buffer);
+}
+// Obtain the node's data as an integer
+template<typename NTS, typename NIS, class TP, class NL>
+int TreeNodePool<NTS, NIS, TP, NL>::to_int(NIS node_index, bool* ok) const
+{
+    if (m_node_basic_data.is_leaf(node_index))
+    {
+        return m_token_data.to_int(m_node_basic_data.token(node_index), ok,
+                                   !m_frozen);
+    }
+    int result = 0;
+    to_type(result, data(node_index), ok);
+    return result;
+}
+// Obtain the node's data as a double
+template<typename NTS, typename NIS, class TP, class NL>
+double TreeNodePool<NTS, NIS, TP, NL>::to_double(NIS node_index, bool* ok) const
+{
+    if (m_node_basic_data.is_leaf(node_index))
+    {
+        return m_token_data.to_double(m_node_basic_data.token(node_index), ok,
+                                      !m_frozen);
+    }
+    double result = 0.0;
+    to_type(result, data(node_index), ok);
+    return result;
+}
+// Remove all tokens and nodes, retaining capacity
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::clear()
+{
+    m_start_line   = 1;
+    m_start_column = 1;
+    m_token_data.clear();
+    m_node_names.clear();
+    m_names_by_prefix.clear();
+    m_names_by_suffix.clear();
+    m_node_basic_data.clear();
+    m_node_parent_data.clear();
+    m_node_child_indices.clear();
+    m_child_name_index.clear();
+    for (auto& nodes : m_type_index)
+    {
+        nodes.clear();
+    }
+    m_packed_arrays.clear();
+    m_packed_array_index.clear();
+    m_packed_integers.clear();
+    m_packed_reals.clear();
+    m_packed_offsets.clear();
+    m_frozen = false;
+    discard_layout();
+    discard_hashes();
+}
+// Exchange all tokens, nodes, and indices
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::swap(TreeNodePool<NTS, NIS, TP, NL>& other)
+{
+    std::swap(m_start_line, other.m_start_line);
+    std::swap(m_start_column, other.m_start_column);
+    m_token_data.swap(other.m_token_data);
+    m_node_names.swap(other.m_node_names);
+    m_node_basic_data.swap(other.m_node_basic_data);
+    m_node_parent_data.swap(other.m_node_parent_data);
+    m_node_child_indices.swap(other.m_node_child_indices);
+    m_child_name_index.swap(other.m_child_name_index);
+    m_names_by_prefix.swap(other.m_names_by_prefix);
+    m_names_by_suffix.swap(other.m_names_by_suffix);
+    std::swap(m_frozen, other.m_frozen);
+    m_subtree_end.swap(other.m_subtree_end);
+    std::swap(m_preordered, other.m_preordered);
+    m_type_index.swap(other.m_type_index);
+    std::swap(m_type_indexed, other.m_type_indexed);
+    m_packed_arrays.swap(other.m_packed_arrays);
+    m_packed_array_index.swap(other.m_packed_array_index);
+    m_packed_integers.swap(other.m_packed_integers);
+    m_packed_reals.swap(other.m_packed_reals);
+    m_packed_offsets.swap(other.m_packed_offsets);
+    m_subtree_hashes.swap(other.m_subtree_hashes);
+    m_descendant_names.swap(other.m_descendant_names);
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::reserve(std::size_t node_count,
+                                         std::size_t token_count,
+                                         std::size_t char_count,
+                                         std::size_t line_count)
+{
+    m_token_data.reserve(token_count, char_count, line_count);
+    m_node_basic_data.reserve(node_count);
+    // all nodes but the root are the child of one parent
+    m_node_child_indices.reserve(node_count);
+    // leaf nodes have no parent data
+    m_node_parent_data.reserve(node_count > token_count
+                                   ? node_count - token_count
+                                   : 0);
+}
+// Build all acceleration structures and prohibit modification
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::freeze()
+{
+    if (m_frozen)
+        return;
+    for (std::size_t i = 0, count = size(); i < count; ++i)
+    {
+        NIS node_index = static_cast<NIS>(i);
+        if (child_count(node_index) >= child_name_index_threshold &&
+            m_child_name_index.find(node_index) == m_child_name_index.end())
+        {
+            index_children(node_index);
+        }
+    }
+    if (m_subtree_hashes.size() != size())
+        hash_subtrees();
+    if (m_descendant_names.size() != size())
+        filter_descendant_names();
+    index_names();
+    m_frozen = true;
+}
+// Renumber the nodes into pre-order
+template<typename NTS, typename NIS, class TP, class NL>
+std::vector<std::size_t> TreeNodePool<NTS, NIS, TP, NL>::relayout()
+{
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
+    const std::size_t        count = size();
+    const NIS                npos  = static_cast<NIS>(-1);
+    std::vector<std::size_t> new_index(count, count);
+    std::vector<NIS>         order;
+    order.reserve(count);
+    std::vector<NIS> stack;
+    for (std::size_t r = count; r-- > 0;)
+    {
+        if (m_node_basic_data.parent(r) != npos)
+            continue;
+        stack.push_back(static_cast<NIS>(r));
+        while (!stack.empty())
+        {
+            NIS node_index = stack.back();
+            stack.pop_back();
+            new_index[node_index] = order.size();
+            order.push_back(node_index);
+            // push the children last to first so the first is visited next
+            for (std::size_t c = child_count(node_index); c-- > 0;)
+            {
+                stack.push_back(static_cast<NIS>(child_at(node_index, c)));
+            }
+        }
+    }
+    wasp_check(order.size() == count);
+
+    NodeData_type               basic_data;
+    std::vector<ParentNodeData> parent_data;
+    std::vector<NIS>            child_indices;
+    basic_data.reserve(count);
+    parent_data.reserve(m_node_parent_data.size());
+    child_indices.reserve(m_node_child_indices.size());
+    for (NIS node_index : order)
+    {
+        auto data = m_node_basic_data.record(node_index);
+        if (data.m_parent_node_index != npos)
+        {
+            data.m_parent_node_index =
+                static_cast<NIS>(new_index[data.m_parent_node_index]);
+        }
+        if (data.has_parent_data())
+        {
+            const ParentNodeData& parent =
+                m_node_parent_data[data.m_node_parent_data_index];
+            data.m_node_parent_data_index = static_cast<NIS>(parent_data.size());
+            parent_data.push_back(ParentNodeData(
+                static_cast<NIS>(child_indices.size()), parent.m_child_count));
+            for (std::size_t i = parent.m_first_child_index,
+                             end = i + parent.m_child_count;
+                 i < end; ++i)
+            {
+                child_indices.push_back(
+                    static_cast<NIS>(new_index[m_node_child_indices[i]]));
+            }
+        }
+        basic_data.push_back(data);
+    }
+    m_node_basic_data.swap(basic_data);
+    m_node_parent_data.swap(parent_data);
+    m_node_child_indices.swap(child_indices);
+    m_child_name_index.clear();
+    if (m_type_indexed)
+        index_types();
+    for (auto& array : m_packed_arrays)
+    {
+        array.m_node = static_cast<NIS>(new_index[array.m_node]);
+    }
+    index_packed_arrays();
+    index_subtrees();
+    m_preordered = true;
+    return new_index;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::index_subtrees()
+{
+    // descendants follow their ancestor, so a reverse sweep visits each
+    // node's last child before the node
+    const std::size_t count = size();
+    m_subtree_end.resize(count);
+    for (std::size_t n = count; n-- > 0;)
+    {
+        NIS         node_index = static_cast<NIS>(n);
+        std::size_t children   = child_count(node_index);
+        m_subtree_end[n] =
+            children == 0 ? static_cast<NIS>(n + 1)
+                          : m_subtree_end[child_at(node_index, children - 1)];
+    }
+}
+template<typename NTS, typename NIS, class TP, class NL>
+bool TreeNodePool<NTS, NIS, TP, NL>::is_descendant(NIS ancestor_index,
+                                               NIS node_index) const
+{
+    if (m_preordered)
+    {
+        return ancestor_index < node_index &&
+               node_index < m_subtree_end[ancestor_index];
+    }
+    const NIS npos = static_cast<NIS>(-1);
+    for (NIS parent = m_node_basic_data.parent(node_index); parent != npos;
+         parent     = m_node_basic_data.parent(parent))
+    {
+        if (parent == ancestor_index)
+            return true;
+    }
+    return false;
+}
+// Write the tokens and nodes to a snapshot
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::save(std::ostream& out) const
+{
+    write_binary(out, m_start_line);
+    write_binary(out, m_start_column);
+    m_token_data.save(out);
+    m_node_names.save(out);
+    m_node_basic_data.save(out);
+    write_field(out, m_node_parent_data, &ParentNodeData::m_first_child_index);
+    write_field(out, m_node_parent_data, &ParentNodeData::m_child_count);
+    write_binary(out, m_node_child_indices);
+    write_binary(out, m_subtree_end);
+    write_field(out, m_packed_arrays, &PackedArray::m_node);
+    write_field(out, m_packed_arrays, &PackedArray::m_position);
+    write_field(out, m_packed_arrays, &PackedArray::m_first);
+    write_field(out, m_packed_arrays, &PackedArray::m_first_offset);
+    write_field(out, m_packed_arrays, &PackedArray::m_count);
+    write_field(out, m_packed_arrays, &PackedArray::m_integral);
+    write_field(out, m_packed_arrays, &PackedArray::m_separated);
+    write_binary(out, m_packed_integers);
+    write_binary(out, m_packed_reals);
+    write_binary(out, m_packed_offsets);
+}
+// Read the tokens and nodes from a snapshot
+template<typename NTS, typename NIS, class TP, class NL>
+bool TreeNodePool<NTS, NIS, TP, NL>::load(std::istream& in)
+{
+    m_child_name_index.clear();
+    m_names_by_prefix.clear();
+    m_names_by_suffix.clear();
+    m_frozen = false;
+    discard_layout();
+    discard_hashes();
+    m_node_parent_data.clear();
+    m_packed_arrays.clear();
+    if (!read_binary(in, m_start_line) || !read_binary(in, m_start_column) ||
+        !m_token_data.load(in) || !m_node_names.load(in) ||
+        !m_node_basic_data.load(in) ||
+        !read_field(in, m_node_parent_data,
+                    &ParentNodeData::m_first_child_index) ||
+        !read_field(in, m_node_parent_data, &ParentNodeData::m_child_count) ||
+        !read_binary(in, m_node_child_indices) ||
+        !read_binary(in, m_subtree_end) ||
+        !read_field(in, m_packed_arrays, &PackedArray::m_node) ||
+        !read_field(in, m_packed_arrays, &PackedArray::m_position) ||
+        !read_field(in, m_packed_arrays, &PackedArray::m_first) ||
+        !read_field(in, m_packed_arrays, &PackedArray::m_first_offset) ||
+        !read_field(in, m_packed_arrays, &PackedArray::m_count) ||
+        !read_field(in, m_packed_arrays, &PackedArray::m_integral) ||
+        !read_field(in, m_packed_arrays, &PackedArray::m_separated) ||
+        !read_binary(in, m_packed_integers) ||
+        !read_binary(in, m_packed_reals) || !read_binary(in, m_packed_offsets))
+    {
+        m_subtree_end.clear();
+        m_packed_arrays.clear();
+        m_packed_array_index.clear();
+        return false;
+    }
+    index_packed_arrays();
+    // ensure all node references are within the loaded data
+    const NIS npos = static_cast<NIS>(-1);
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        if ((m_node_basic_data.parent(i) != npos &&
+             static_cast<std::size_t>(m_node_basic_data.parent(i)) >= size()) ||
+            (m_node_basic_data.is_leaf(i) &&
+             static_cast<std::size_t>(m_node_basic_data.token(i)) >=
+                 m_token_data.size()) ||
+            (m_node_basic_data.has_parent_data(i) &&
+             static_cast<std::size_t>(m_node_basic_data.parent_data(i)) >=
+                 m_node_parent_data.size()) ||
+            static_cast<std::size_t>(m_node_basic_data.name(i)) >=
+                m_node_names.size())
+        {
+            return false;
+        }
+    }
+    for (const auto& parent : m_node_parent_data)
+    {
+        if (static_cast<std::size_t>(parent.m_first_child_index) +
+                parent.m_child_count >
+            m_node_child_indices.size())
+        {
+            return false;
+        }
+    }
+    for (NIS child_index : m_node_child_indices)
+    {
+        if (static_cast<std::size_t>(child_index) >= size())
+            return false;
+    }
+    for (const auto& array : m_packed_arrays)
+    {
+        std::size_t values =
+            array.m_integral ? m_packed_integers.size() : m_packed_reals.size();
+        if (static_cast<std::size_t>(array.m_node) >= size() ||
+            static_cast<std::size_t>(array.m_position) >
+                child_count(array.m_node) ||
+            array.m_first + array.m_count > values ||
+            array.m_first_offset + array.m_count > m_packed_offsets.size())
+        {
+            return false;
+        }
+    }
+    // subtree ranges are present only for preordered pools
+    if (!m_subtree_end.empty())
+    {
+        if (m_subtree_end.size() != size())
+            return false;
+        for (std::size_t i = 0; i < m_subtree_end.size(); ++i)
+        {
+            if (static_cast<std::size_t>(m_subtree_end[i]) <= i ||
+                static_cast<std::size_t>(m_subtree_end[i]) > size())
+                return false;
+        }
+        m_preordered = true;
+    }
+    if (m_type_indexed)
+        index_types();
+    return true;
+}
+// Index every node by type
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::enable_type_index()
+{
+    wasp_insist(!m_frozen, frozen_message);
+    if (m_type_indexed)
+        return;
+    m_type_indexed = true;
+    index_types();
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::index_types()
+{
+    for (auto& nodes : m_type_index)
+    {
+        nodes.clear();
+    }
+    for (std::size_t i = 0, count = size(); i < count; ++i)
+    {
+        index_type(static_cast<NIS>(i));
+    }
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::nodes_of_type(
+    NTS type, std::vector<std::size_t>& node_indices) const
+{
+    node_indices.clear();
+    if (m_type_indexed)
+    {
+        if (static_cast<std::size_t>(type) < m_type_index.size())
+        {
+            node_indices.assign(m_type_index[type].begin(),
+                                m_type_index[type].end());
+        }
+        return;
+    }
+    for (std::size_t i = 0, count = size(); i < count; ++i)
+    {
+        if (m_node_basic_data.type(i) == type)
+            node_indices.push_back(i);
+    }
+}
+
+// Acquire the structural hash of the subtree
+template<typename NTS, typename NIS, class TP, class NL>
+std::uint64_t TreeNodePool<NTS, NIS, TP, NL>::subtree_hash(NIS node_index) const
+{
+    wasp_require(node_index < size());
+    if (m_subtree_hashes.size() != size())
+    {
+        wasp_check(!m_frozen);
+        hash_subtrees();
+    }
+    return m_subtree_hashes[node_index];
+}
+template<typename NTS, typename NIS, class TP, class NL>
+bool TreeNodePool<NTS, NIS, TP, NL>::may_have_descendant(NIS         node_index,
+                                                     std::size_t symbol) const
+{
+    wasp_require(node_index < size());
+    if (m_descendant_names.size() != size())
+    {
+        wasp_check(!m_frozen);
+        filter_descendant_names();
+    }
+    std::uint64_t bits = name_filter(symbol);
+    return (m_descendant_names[node_index] & bits) == bits;
+}
+// Filter all descendant names bottom-up
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::filter_descendant_names() const
+{
+    const std::size_t          count = size();
+    const NIS                  npos  = static_cast<NIS>(-1);
+    std::vector<std::uint64_t> filters(count, 0);
+    // a node is filtered once its children are, its children being pushed to
+    // the stack above it when first visited
+    std::vector<std::pair<NIS, bool>> stack;
+    for (std::size_t r = 0; r < count; ++r)
+    {
+        if (m_node_basic_data.parent(r) != npos)
+            continue;
+        stack.emplace_back(static_cast<NIS>(r), false);
+        while (!stack.empty())
+        {
+            NIS node_index = stack.back().first;
+            if (!stack.back().second)
+            {
+                stack.back().second = true;
+                for (std::size_t c = 0, n = child_count(node_index); c < n; ++c)
+                {
+                    stack.emplace_back(
+                        static_cast<NIS>(child_at(node_index, c)), false);
+                }
+                continue;
+            }
+            stack.pop_back();
+            std::uint64_t& filter = filters[node_index];
+            for (std::size_t c = 0, n = child_count(node_index); c < n; ++c)
+            {
+                std::size_t child_index = child_at(node_index, c);
+                filter |= filters[child_index] |
+                          name_filter(m_node_basic_data.name(child_index));
+            }
+        }
+    }
+    m_descendant_names.swap(filters);
+}
+// Hash all subtrees bottom-up
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::hash_subtrees() const
+{
+    // FNV-1a of a string
+    auto hash_string = [](const char* str) {
+        std::uint64_t h = 14695981039346656037ULL;
+        for (; *str != '\0'; ++str)
+        {
+            h ^= static_cast<unsigned char>(*str);
+            h *= 1099511628211ULL;
+        }
+        return h;
+    };
+    // order-dependent combination of a hash with a value
+    auto combine = [](std::uint64_t h, std::uint64_t value) {
+        value *= 0x9e3779b97f4a7c15ULL;
+        value ^= value >> 32;
+        h = (h ^ value) * 0xbf58476d1ce4e5b9ULL;
+        return h ^ (h >> 31);
+    };
+    const std::size_t          count = size();
+    const NIS                  npos  = static_cast<NIS>(-1);
+    std::vector<std::uint64_t> hashes(count);
+    // each distinct name is hashed once
+    std::vector<std::uint64_t> name_hashes(m_node_names.size());
+    for (std::size_t i = 0; i < name_hashes.size(); ++i)
+    {
+        name_hashes[i] = hash_string(m_node_names.data(i));
+    }
+    // a node is hashed once its children are, its children being pushed to
+    // the stack above it when first visited
+    std::vector<std::pair<NIS, bool>> stack;
+    for (std::size_t r = 0; r < count; ++r)
+    {
+        if (m_node_basic_data.parent(r) != npos)
+            continue;
+        stack.emplace_back(static_cast<NIS>(r), false);
+        while (!stack.empty())
+        {
+            NIS node_index = stack.back().first;
+            if (!stack.back().second)
+            {
+                stack.back().second = true;
+                for (std::size_t c = 0, n = child_count(node_index); c < n; ++c)
+                {
+                    stack.emplace_back(
+                        static_cast<NIS>(child_at(node_index, c)), false);
+                }
+                continue;
+            }
+            stack.pop_back();
+            std::uint64_t h = combine(m_node_basic_data.type(node_index),
+                                      name_hashes[m_node_basic_data.name(
+                                          node_index)]);
+            if (m_node_basic_data.is_leaf(node_index))
+            {
+                h = combine(h, hash_string(m_token_data.str(
+                                   m_node_basic_data.token(node_index))));
+            }
+            std::size_t children = child_count(node_index);
+            h = combine(h, children);
+            for (std::size_t c = 0; c < children; ++c)
+            {
+                h = combine(h, hashes[child_at(node_index, c)]);
+            }
+            if (const PackedArray* packed = packed_array(node_index))
+            {
+                h = combine(h, packed->m_count);
+                for (std::size_t i = 0; i < packed->m_count; ++i)
+                {
+                    std::uint64_t bits;
+                    if (packed->m_integral)
+                    {
+                        bits = static_cast<std::uint64_t>(
+                            m_packed_integers[packed->m_first + i]);
+                    }
+                    else
+                    {
+                        std::memcpy(&bits, &m_packed_reals[packed->m_first + i],
+                                    sizeof(bits));
+                    }
+                    h = combine(h, bits);
+                }
+            }
+            hashes[node_index] = h;
+        }
+    }
+    m_subtree_hashes.swap(hashes);
+}
+// Discard the trailing nodes and their tokens
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::discard(NIS first_index)
+{
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
+    wasp_require(first_index <= size());
+    wasp_require(m_packed_arrays.empty());
+    const std::size_t count       = size();
+    const std::size_t token_count = m_token_data.size();
+    discard_layout();
+
+    // the range of tokens referenced by the discarded leaves
+    std::size_t first_token = token_count, last_token = 0;
+    std::size_t first_parent_data = m_node_parent_data.size();
+    std::size_t first_child_index = m_node_child_indices.size();
+    for (std::size_t n = first_index; n < count; ++n)
+    {
+        if (m_node_basic_data.is_leaf(n))
+        {
+            std::size_t token = m_node_basic_data.token(n);
+            first_token       = std::min(first_token, token);
+            last_token        = std::max(last_token, token);
+        }
+        if (m_node_basic_data.has_parent_data(n))
+        {
+            std::size_t parent_data = m_node_basic_data.parent_data(n);
+            first_parent_data       = std::min(first_parent_data, parent_data);
+            first_child_index       = std::min<std::size_t>(
+                first_child_index,
+                m_node_parent_data[parent_data].m_first_child_index);
+        }
+    }
+    // parent data and child indices are appended as parents are pushed
+    m_node_basic_data.resize(first_index);
+    m_node_parent_data.resize(first_parent_data);
+    m_node_child_indices.resize(first_child_index);
+    for (auto itr = m_child_name_index.begin(); itr != m_child_name_index.end();)
+    {
+        if (itr->first >= first_index)
+            itr = m_child_name_index.erase(itr);
+        else
+            ++itr;
+    }
+    for (auto& nodes : m_type_index)
+    {
+        while (!nodes.empty() && nodes.back() >= first_index)
+            nodes.pop_back();
+    }
+    if (first_token == token_count)
+        return 0;
+
+    // flag the range's tokens, from the first, so that the remaining tokens
+    // preceding the range are neither visited nor moved
+    std::vector<bool> removed(last_token - first_token + 1, true);
+    for (std::size_t n = 0; n < static_cast<std::size_t>(first_index); ++n)
+    {
+        if (!m_node_basic_data.is_leaf(n))
+            continue;
+        std::size_t token = m_node_basic_data.token(n);
+        if (token >= first_token && token <= last_token)
+            removed[token - first_token] = false;
+    }
+    // the remaining leaves' new token indices
+    std::vector<std::size_t> removed_before(token_count - first_token + 1, 0);
+    for (std::size_t t = first_token; t < token_count; ++t)
+    {
+        bool is_removed = t <= last_token && removed[t - first_token];
+        removed_before[t - first_token + 1] =
+            removed_before[t - first_token] + (is_removed ? 1 : 0);
+    }
+    for (std::size_t n = 0; n < static_cast<std::size_t>(first_index); ++n)
+    {
+        if (!m_node_basic_data.is_leaf(n))
+            continue;
+        std::size_t token = m_node_basic_data.token(n);
+        if (token > first_token)
+        {
+            m_node_basic_data.set_token(
+                n, static_cast<typename TP::token_index_type_size>(
+                       token - removed_before[token - first_token]));
+        }
+    }
+    auto end_offset = m_token_data.offset(
+        static_cast<typename TP::token_index_type_size>(last_token));
+    m_token_data.remove_tokens(removed, first_token);
+    // lines preceding the remaining tokens are no longer located
+    m_token_data.discard_lines(end_offset);
+    return removed_before.back();
+}
+// Pack long numeric arrays into contiguous values
+template<typename NTS, typename NIS, class TP, class NL>
+std::vector<std::size_t>
+TreeNodePool<NTS, NIS, TP, NL>::pack_arrays(std::size_t min_size)
+{
+    wasp_insist(!m_frozen, frozen_message);
+    discard_hashes();
+    const std::size_t        count = size();
+    const NIS                npos  = static_cast<NIS>(-1);
+    std::vector<bool>        removed(count, false);
+    std::vector<bool>        removed_tokens(m_token_data.size(), false);
+    std::vector<PackedArray> packed;
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        NIS node_index = static_cast<NIS>(n);
+        if (m_node_basic_data.type(node_index) != ARRAY ||
+            packed_array(node_index) != nullptr)
+            continue;
+        // the elements span the first through the last value child
+        std::size_t children = child_count(node_index);
+        std::size_t first = children, last = children, values = 0;
+        for (std::size_t c = 0; c < children; ++c)
+        {
+            if (m_node_basic_data.type(child_at(node_index, c)) != VALUE)
+                continue;
+            if (first == children)
+                first = c;
+            last = c;
+            ++values;
+        }
+        if (values == 0 || values < min_size)
+            continue;
+        // elements must be numeric leaves, consistently comma separated
+        bool separated = last - first + 1 > values;
+        if (separated && last - first + 1 != 2 * values - 1)
+            continue;
+        bool integral = true, numeric = true;
+        for (std::size_t c = first; c <= last && numeric; ++c)
+        {
+            NIS  child    = static_cast<NIS>(child_at(node_index, c));
+            bool is_value = !separated || (c - first) % 2 == 0;
+            if (!m_node_basic_data.is_leaf(child) ||
+                m_node_basic_data.type(child) != (is_value ? VALUE : WASP_COMMA))
+            {
+                numeric = false;
+            }
+            else if (is_value)
+            {
+                auto token_type =
+                    m_token_data.type(m_node_basic_data.token(child));
+                if (token_type == REAL)
+                    integral = false;
+                else if (token_type != INTEGER)
+                    numeric = false;
+            }
+        }
+        if (!numeric)
+            continue;
+        PackedArray array;
+        array.m_node         = node_index;
+        array.m_position     = static_cast<NIS>(first);
+        array.m_first        = integral ? m_packed_integers.size()
+                                        : m_packed_reals.size();
+        array.m_first_offset = m_packed_offsets.size();
+        array.m_count        = values;
+        array.m_integral     = integral;
+        array.m_separated    = separated;
+        for (std::size_t c = first; c <= last && numeric; ++c)
+        {
+            NIS child = static_cast<NIS>(child_at(node_index, c));
+            if (m_node_basic_data.type(child) != VALUE)
+                continue;
+            auto        token = m_node_basic_data.token(child);
+            const char* str   = m_token_data.str(token);
+            char*       end   = nullptr;
+            errno             = 0;
+            if (integral)
+                m_packed_integers.push_back(std::strtoll(str, &end, 10));
+            else
+                m_packed_reals.push_back(std::strtod(str, &end));
+            numeric = end != str && errno != ERANGE;
+            m_packed_offsets.push_back(m_token_data.offset(token));
+        }
+        if (!numeric)
+        {
+            // an out of range element, discard the array's values
+            m_packed_integers.resize(integral ? array.m_first
+                                              : m_packed_integers.size());
+            m_packed_reals.resize(integral ? m_packed_reals.size()
+                                           : array.m_first);
+            m_packed_offsets.resize(array.m_first_offset);
+            continue;
+        }
+        for (std::size_t c = first; c <= last; ++c)
+        {
+            NIS child      = static_cast<NIS>(child_at(node_index, c));
+            removed[child] = true;
+            removed_tokens[m_node_basic_data.token(child)] = true;
+        }
+        packed.push_back(array);
+    }
+    std::vector<std::size_t> new_index(count, count);
+    if (packed.empty())
+    {
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            new_index[n] = n;
+        }
+        return new_index;
+    }
+
+    // renumber the remaining nodes and tokens in order
+    std::vector<std::size_t> new_token(m_token_data.size());
+    for (std::size_t t = 0, next = 0; t < new_token.size(); ++t)
+    {
+        if (!removed_tokens[t])
+            new_token[t] = next++;
+    }
+    std::size_t next = 0;
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        if (!removed[n])
+            new_index[n] = next++;
+    }
+    NodeData_type               basic_data;
+    std::vector<ParentNodeData> parent_data;
+    std::vector<NIS>            child_indices;
+    basic_data.reserve(next);
+    parent_data.reserve(m_node_parent_data.size());
+    child_indices.reserve(next);
+    for (std::size_t n = 0; n < count; ++n)
+    {
+        if (removed[n])
+            continue;
+        auto data = m_node_basic_data.record(n);
+        if (data.m_parent_node_index != npos)
+        {
+            data.m_parent_node_index =
+                static_cast<NIS>(new_index[data.m_parent_node_index]);
+        }
+        if (data.is_leaf())
+        {
+            data.m_token_index = static_cast<typename TP::token_index_type_size>(
+                new_token[data.m_token_index]);
+        }
+        if (data.has_parent_data())
+        {
+            const ParentNodeData& parent =
+                m_node_parent_data[data.m_node_parent_data_index];
+            std::size_t first_child = child_indices.size();
+            for (std::size_t i = parent.m_first_child_index,
+                             end = i + parent.m_child_count;
+                 i < end; ++i)
+            {
+                if (!removed[m_node_child_indices[i]])
+                {
+                    child_indices.push_back(
+                        static_cast<NIS>(new_index[m_node_child_indices[i]]));
+                }
+            }
+            data.m_node_parent_data_index = static_cast<NIS>(parent_data.size());
+            parent_data.push_back(ParentNodeData(
+                static_cast<NIS>(first_child),
+                static_cast<NIS>(child_indices.size() - first_child)));
+        }
+        basic_data.push_back(data);
+    }
+    m_node_basic_data.swap(basic_data);
+    m_node_parent_data.swap(parent_data);
+    m_node_child_indices.swap(child_indices);
+    m_token_data.remove_tokens(removed_tokens);
+    m_child_name_index.clear();
+    for (auto& array : m_packed_arrays)
+    {
+        array.m_node = static_cast<NIS>(new_index[array.m_node]);
+    }
+    for (auto& array : packed)
+    {
+        array.m_node = static_cast<NIS>(new_index[array.m_node]);
+        m_packed_arrays.push_back(array);
+    }
+    index_packed_arrays();
+    if (m_type_indexed)
+        index_types();
+    // removing nodes retains the order of those remaining
+    if (m_preordered)
+        index_subtrees();
+    return new_index;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+void TreeNodePool<NTS, NIS, TP, NL>::index_packed_arrays()
+{
+    m_packed_array_index.clear();
+    for (std::size_t i = 0; i < m_packed_arrays.size(); ++i)
+    {
+        m_packed_array_index[m_packed_arrays[i].m_node] = i;
+    }
+}
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::packed_position(NIS node_index) const
+{
+    const PackedArray* array = packed_array(node_index);
+    wasp_require(array != nullptr);
+    return array->m_position;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+bool TreeNodePool<NTS, NIS, TP, NL>::packed_separated(NIS node_index) const
+{
+    const PackedArray* array = packed_array(node_index);
+    wasp_require(array != nullptr);
+    return array->m_separated != 0;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+Span<const std::int64_t>
+TreeNodePool<NTS, NIS, TP, NL>::packed_integers(NIS node_index) const
+{
+    const PackedArray* array = packed_array(node_index);
+    if (array == nullptr || !array->m_integral)
+        return Span<const std::int64_t>();
+    return Span<const std::int64_t>(m_packed_integers.data() + array->m_first,
+                                    array->m_count);
+}
+template<typename NTS, typename NIS, class TP, class NL>
+Span<const double>
+TreeNodePool<NTS, NIS, TP, NL>::packed_reals(NIS node_index) const
+{
+    const PackedArray* array = packed_array(node_index);
+    if (array == nullptr || array->m_integral)
+        return Span<const double>();
+    return Span<const double>(m_packed_reals.data() + array->m_first,
+                              array->m_count);
+}
+template<typename NTS, typename NIS, class TP, class NL>
+std::string TreeNodePool<NTS, NIS, TP, NL>::packed_data(NIS         node_index,
+                                                        std::size_t element) const
+{
+    const PackedArray* array = packed_array(node_index);
+    wasp_require(array != nullptr && element < array->m_count);
+    if (array->m_integral)
+    {
+        return std::to_string(
+            static_cast<long long>(m_packed_integers[array->m_first + element]));
+    }
+    // the fewest significant digits that reproduce the value
+    double value = m_packed_reals[array->m_first + element];
+    char   text[32];
+    for (int precision = 1; precision <= 17; ++precision)
+    {
+        std::snprintf(text, sizeof(text), "%.*g", precision, value);
+        if (std::strtod(text, nullptr) == value)
+            break;
+    }
+    return text;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+typename TP::file_offset_type_size
+TreeNodePool<NTS, NIS, TP, NL>::packed_offset(NIS         node_index,
+                                              std::size_t element) const
+{
+    const PackedArray* array = packed_array(node_index);
+    wasp_require(array != nullptr && element < array->m_count);
+    return m_packed_offsets[array->m_first_offset + element];
+}
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t TreeNodePool<NTS, NIS, TP, NL>::packed_line(NIS         node_index,
+                                                        std::size_t element) const
+{
+    return m_token_data.offset_line(packed_offset(node_index, element)) +
+           m_start_line - 1;
+}
+template<typename NTS, typename NIS, class TP, class NL>
+std::size_t
+TreeNodePool<NTS, NIS, TP, NL>::packed_column(NIS         node_index,
+                                              std::size_t element) const
+{
+    auto offset = packed_offset(node_index, element);
+    // as with column, elements of the first line are relative to the
+    // starting column
+    if (start_column() != 1 && m_token_data.offset_line(offset) == 1)
+    {
+        return m_token_data.offset_column(offset) + m_start_column - 1;
+    }
+    return m_token_data.offset_column(offset);
+}
 
 #endif
@@ -0,0 +1,181 @@
+#include "waspcore/DocumentCache.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace wasp;
+
+namespace
+{
+void write_file(const std::string& path, const std::string& content)
+{
+    std::ofstream out(path.c_str(), std::ios_base::binary);
+    out << content;
+}
+void add_path(DocumentCache::Entry& e, const std::string& path)
+{
+    e.paths.push_back(DocumentCache::canonical_path(path));
+    e.file_stamps.emplace_back();
+    DocumentCache::stamp(path, e.file_stamps.back());
+}
+DocumentCache::Entry entry(const std::string& snapshot,
+                           const std::string& path)
+{
+    DocumentCache::Entry e;
+    e.snapshot = snapshot;
+    add_path(e, path);
+    return e;
+}
+}  // namespace
+
+TEST(DocumentCache, disabled)
+{
+    auto& cache = DocumentCache::instance();
+    cache.clear();
+    cache.set_capacity(0);
+    std::string path = "tstDocumentCache.disabled.txt";
+    write_file(path, "content");
+    cache.insert("type", path, entry("snapshot", path));
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(nullptr, cache.find("type", path));
+    // a disabled cache counts nothing
+    ASSERT_EQ(0, cache.hits());
+    ASSERT_EQ(0, cache.misses());
+    std::remove(path.c_str());
+}
+
+TEST(DocumentCache, find)
+{
+    auto& cache = DocumentCache::instance();
+    cache.clear();
+    cache.set_capacity(1024);
+    std::string path = "tstDocumentCache.find.txt";
+    write_file(path, "content");
+    ASSERT_FALSE(DocumentCache::canonical_path(path).empty());
+    ASSERT_TRUE(DocumentCache::canonical_path("not a file").empty());
+
+    ASSERT_EQ(nullptr, cache.find("type", path));
+    cache.insert("type", path, entry("snapshot", path));
+    ASSERT_EQ(1, cache.size());
+    ASSERT_EQ(8, cache.bytes());
+
+    // equivalent paths find the same entry
+    auto found = cache.find("type", "./" + path);
+    ASSERT_NE(nullptr, found);
+    ASSERT_EQ("snapshot", found->snapshot);
+    ASSERT_EQ(found, cache.find("type", path));
+    // entries are distinct per type
+    ASSERT_EQ(nullptr, cache.find("other type", path));
+    ASSERT_EQ(2, cache.hits());
+    ASSERT_EQ(2, cache.misses());
+
+    cache.clear();
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(0, cache.bytes());
+    ASSERT_EQ(0, cache.hits());
+    ASSERT_EQ(0, cache.misses());
+    cache.set_capacity(0);
+    std::remove(path.c_str());
+}
+
+TEST(DocumentCache, invalidate)
+{
+    auto& cache = DocumentCache::instance();
+    cache.clear();
+    cache.set_capacity(1024);
+    std::string path   = "tstDocumentCache.invalidate.txt";
+    std::string nested = "tstDocumentCache.invalidate.nested.txt";
+    write_file(path, "content");
+    write_file(nested, "nested");
+    auto e = entry("snapshot", path);
+    add_path(e, nested);
+    cache.insert("type", path, e);
+    ASSERT_NE(nullptr, cache.find("type", path));
+
+    // a changed document is no longer cached
+    write_file(path, "changed content");
+    ASSERT_EQ(nullptr, cache.find("type", path));
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(0, cache.bytes());
+    // and can not be cached from stamps taken before the change
+    cache.insert("type", path, e);
+    ASSERT_EQ(0, cache.size());
+
+    // nor is one whose nested document changed
+    e = entry("snapshot", path);
+    add_path(e, nested);
+    cache.insert("type", path, e);
+    ASSERT_NE(nullptr, cache.find("type", path));
+    write_file(nested, "changed nested");
+    ASSERT_EQ(nullptr, cache.find("type", path));
+    ASSERT_EQ(0, cache.size());
+    cache.insert("type", path, e);
+    ASSERT_EQ(0, cache.size());
+
+    // nor one whose nested document was removed
+    e = entry("snapshot", path);
+    add_path(e, nested);
+    cache.insert("type", path, e);
+    ASSERT_NE(nullptr, cache.find("type", path));
+    std::remove(nested.c_str());
+    ASSERT_EQ(nullptr, cache.find("type", path));
+    ASSERT_EQ(0, cache.size());
+    // which can not be cached either
+    cache.insert("type", path, e);
+    ASSERT_EQ(0, cache.size());
+
+    ASSERT_EQ(3, cache.hits());
+    ASSERT_EQ(3, cache.misses());
+    cache.clear();
+    cache.set_capacity(0);
+    std::remove(path.c_str());
+}
+
+TEST(DocumentCache, evict)
+{
+    auto& cache = DocumentCache::instance();
+    cache.clear();
+    cache.set_capacity(10);
+    std::string a = "tstDocumentCache.evict.a.txt";
+    std::string b = "tstDocumentCache.evict.b.txt";
+    std::string c = "tstDocumentCache.evict.c.txt";
+    write_file(a, "a");
+    write_file(b, "b");
+    write_file(c, "c");
+
+    // larger than the capacity
+    cache.insert("type", a, entry("12345678901", a));
+    ASSERT_EQ(0, cache.size());
+
+    cache.insert("type", a, entry("1234", a));
+    cache.insert("type", b, entry("1234", b));
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ(8, cache.bytes());
+    // a is now the most recently used
+    ASSERT_NE(nullptr, cache.find("type", a));
+    cache.insert("type", c, entry("1234", c));
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ(8, cache.bytes());
+    ASSERT_NE(nullptr, cache.find("type", a));
+    ASSERT_EQ(nullptr, cache.find("type", b));
+    ASSERT_NE(nullptr, cache.find("type", c));
+
+    // replacing an entry releases its size
+    cache.insert("type", c, entry("123456", c));
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ(10, cache.bytes());
+
+    // reducing the capacity evicts the least recently used
+    cache.set_capacity(6);
+    ASSERT_EQ(1, cache.size());
+    ASSERT_EQ(6, cache.bytes());
+    ASSERT_EQ(nullptr, cache.find("type", a));
+    ASSERT_NE(nullptr, cache.find("type", c));
+
+    cache.clear();
+    cache.set_capacity(0);
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+    std::remove(c.c_str());
+}
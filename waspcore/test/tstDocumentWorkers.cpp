@@ -0,0 +1,51 @@
+#include "waspcore/DocumentWorkers.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace wasp;
+
+TEST(DocumentWorkers, serial)
+{
+    auto&                    workers = DocumentWorkers::instance();
+    std::vector<std::size_t> order;
+    std::thread::id          caller = std::this_thread::get_id();
+    bool                     same_thread = true;
+    // without workers the batch is run in order on the calling thread
+    workers.run(5, 0, [&](std::size_t i) {
+        order.push_back(i);
+        same_thread &= std::this_thread::get_id() == caller;
+    });
+    ASSERT_EQ((std::vector<std::size_t>{0, 1, 2, 3, 4}), order);
+    ASSERT_TRUE(same_thread);
+    workers.run(0, 4, [&](std::size_t i) { order.push_back(i); });
+    ASSERT_EQ(5, order.size());
+}
+
+TEST(DocumentWorkers, nested)
+{
+    auto&                 workers = DocumentWorkers::instance();
+    const std::size_t     count   = 16;
+    std::atomic<unsigned> runs[count * count];
+    for (auto& r : runs) r = 0;
+    std::mutex                 mutex;
+    std::set<std::thread::id> threads;
+    // each task submits a batch of its own, as an included document that
+    // includes documents does
+    workers.run(count, count, [&](std::size_t i) {
+        workers.run(count, count, [&](std::size_t j) {
+            ++runs[i * count + j];
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        });
+    });
+    for (const auto& r : runs)
+    {
+        ASSERT_EQ(1u, r);
+    }
+    // the pool threads and the calling thread are the only threads
+    ASSERT_LE(threads.size(), workers.size() + 1);
+}
@@ -0,0 +1,66 @@
+#include "waspcore/LineIndex.h"
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace wasp;
+
+TEST(LineIndex, find_newlines)
+{
+    // newlines at every position of, and either side of, the vector widths
+    std::string text;
+    for (std::size_t i = 0; i < 200; ++i)
+    {
+        text += (i % 7 == 0 || i % 31 == 0 || i % 32 == 15) ? '\n' : 'x';
+    }
+    for (std::size_t start = 0; start < 33; ++start)
+    {
+        for (std::size_t size = 0; start + size <= text.size(); size += 5)
+        {
+            SCOPED_TRACE(start);
+            SCOPED_TRACE(size);
+            std::vector<std::size_t> expected;
+            for (std::size_t i = start; i < start + size; ++i)
+            {
+                if (text[i] == '\n')
+                    expected.push_back(i);
+            }
+            std::vector<std::uint32_t> found;
+            find_newlines(text.data() + start, size, found, start);
+            ASSERT_EQ(expected.size(), found.size());
+            for (std::size_t i = 0; i < found.size(); ++i)
+            {
+                ASSERT_EQ(expected[i], found[i]);
+            }
+        }
+    }
+}
+
+TEST(LineIndex, positions)
+{
+    LineIndex index("ab\n\ncd");
+    ASSERT_EQ(3, index.line_count());
+    ASSERT_EQ(2, index.newlines().size());
+    // a newline belongs to the line it ends
+    ASSERT_EQ(1, index.line(0));
+    ASSERT_EQ(1, index.line(2));
+    ASSERT_EQ(3, index.column(2));
+    ASSERT_EQ(2, index.line(3));
+    ASSERT_EQ(1, index.column(3));
+    ASSERT_EQ(3, index.line(5));
+    ASSERT_EQ(2, index.column(5));
+
+    ASSERT_EQ(0, index.offset(1, 1));
+    ASSERT_EQ(1, index.offset(1, 2));
+    ASSERT_EQ(3, index.offset(2, 1));
+    ASSERT_EQ(5, index.offset(3, 2));
+    // positions beyond a line or the text are limited to their end
+    ASSERT_EQ(2, index.offset(1, 10));
+    ASSERT_EQ(6, index.offset(3, 10));
+    ASSERT_EQ(6, index.offset(4, 1));
+
+    index.index("", 0);
+    ASSERT_EQ(1, index.line_count());
+    ASSERT_EQ(0, index.offset(1, 1));
+}
@@ -0,0 +1,77 @@
+#include "waspcore/wasp_bug.h"
+#include "waspcore/MappedFile.h"
+#include "waspcore/TokenPool.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace wasp;
+
+/**
+ * @brief write_document write a document of about the given size whose
+ * lines vary in length as input lines do
+ */
+void write_document(const std::string& path, std::size_t byte_count)
+{
+    std::ofstream out(path.c_str(), std::ios_base::binary);
+    std::string   line;
+    for (std::size_t size = 0, i = 0; size < byte_count; ++i)
+    {
+        line.assign(i % 97, ' ');
+        line += "key" + std::to_string(i) + " = " + std::to_string(i * 7);
+        line += '\n';
+        out << line;
+        size += line.size();
+    }
+}
+
+// The benchmark's document is 64 MiB unless WASP_BENCHMARK_BYTES is given,
+// e.g., WASP_BENCHMARK_BYTES=1073741824 for 1 GiB
+TEST(LineIndex, benchmark_line_offsets)
+{
+    std::size_t byte_count = 64u << 20;
+    if (const char* bytes = std::getenv("WASP_BENCHMARK_BYTES"))
+        byte_count = std::strtoull(bytes, nullptr, 10);
+    const std::string path = "tstLineIndexBenchmark.txt";
+    write_document(path, byte_count);
+    MappedFileBuffer mapped;
+    ASSERT_TRUE(mapped.open(path));
+    const char* data = mapped.data();
+    std::size_t size = mapped.size();
+
+    // the lexers' approach - a newline rule pushes each line as it is scanned
+    TokenPool<> lexed;
+    wasp_timer(lexed_timer);
+    wasp_timer_start(lexed_timer);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (data[i] == '\n')
+            lexed.push_line(i);
+    }
+    wasp_timer_stop(lexed_timer);
+
+    // a single sweep of the buffer
+    TokenPool<> swept;
+    wasp_timer(swept_timer);
+    wasp_timer_start(swept_timer);
+    swept.index_newlines(data, size);
+    wasp_timer_stop(swept_timer);
+
+    wasp_timer_block(std::cout << size << " bytes, " << swept.line_count()
+                               << " lines - pushed per line "
+                               << lexed_timer.duration() / 1e6 << " ms, "
+                               << "swept " << swept_timer.duration() / 1e6
+                               << " ms" << std::endl);
+    mapped.close();
+    std::remove(path.c_str());
+
+    ASSERT_GT(swept.line_count(), 0);
+    ASSERT_EQ(lexed.line_count(), swept.line_count());
+    for (std::size_t i = 0; i < lexed.line_count(); ++i)
+    {
+        ASSERT_EQ(lexed.line_offset(i), swept.line_offset(i));
+    }
+}
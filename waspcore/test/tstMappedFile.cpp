@@ -0,0 +1,79 @@
+#include "waspcore/MappedFile.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace wasp;
+
+namespace
+{
+void write_file(const std::string& path, const std::string& content)
+{
+    std::ofstream out(path.c_str(), std::ios_base::binary);
+    out << content;
+}
+}  // namespace
+
+TEST(MappedFile, read)
+{
+    std::string path    = "tstMappedFile.read.txt";
+    std::string content = "first line\nsecond line\n\nfourth";
+    write_file(path, content);
+    {
+        MappedFile in(path);
+        ASSERT_TRUE(in.good());
+#ifndef _WIN32
+        ASSERT_TRUE(in.is_mapped());
+#endif
+        std::stringstream str;
+        str << in.rdbuf();
+        ASSERT_EQ(content, str.str());
+    }
+    {
+        MappedFile  in(path);
+        std::string line;
+        ASSERT_TRUE(std::getline(in, line));
+        ASSERT_EQ("first line", line);
+        ASSERT_EQ(11, in.tellg());
+        ASSERT_TRUE(std::getline(in, line));
+        ASSERT_EQ("second line", line);
+        ASSERT_TRUE(std::getline(in, line));
+        ASSERT_EQ("", line);
+        ASSERT_TRUE(std::getline(in, line));
+        ASSERT_EQ("fourth", line);
+        ASSERT_TRUE(in.eof());
+        // rewind and read a partial buffer
+        in.clear();
+        in.seekg(-6, std::ios_base::end);
+        char buffer[4] = {0};
+        in.read(buffer, 3);
+        ASSERT_EQ(3, in.gcount());
+        ASSERT_EQ(std::string("fou"), buffer);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MappedFile, empty)
+{
+    std::string path = "tstMappedFile.empty.txt";
+    write_file(path, "");
+    {
+        // empty files cannot be mapped and fall back to a file buffer
+        MappedFile in(path);
+        ASSERT_TRUE(in.good());
+        ASSERT_FALSE(in.is_mapped());
+        char c;
+        ASSERT_FALSE(in.get(c));
+        ASSERT_TRUE(in.eof());
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MappedFile, missing)
+{
+    MappedFile in("tstMappedFile.does.not.exist");
+    ASSERT_FALSE(in.good());
+    ASSERT_FALSE(in.is_mapped());
+}
@@ -1,6 +1,7 @@
 #include "waspcore/StringPool.h"
 #include "gtest/gtest.h"
 #include <iostream>
+#include <sstream>
 #include <string>
 using namespace wasp;
 
@@ -183,3 +184,48 @@ TEST(StringPool, set_illegal)
         EXPECT_EQ(ndata, result);
     }
 }
+
+TEST(StringPool, view_test)
+{
+    StringPool<> sp;
+    sp.push("ted");
+    sp.push("");
+    sp.push("data");
+    ASSERT_EQ(3, sp.view(0).size());
+    ASSERT_EQ(sp.data(0), sp.view(0).data());
+    ASSERT_TRUE(sp.view(1).empty());
+    ASSERT_EQ("data", sp.view(2));
+    ASSERT_EQ("data", sp.view(2).str());
+    ASSERT_NE("dat", sp.view(2));
+    ASSERT_EQ("at", sp.view(2).substr(1, 2));
+    std::stringstream out;
+    out << sp.view(0) << sp.view(2);
+    ASSERT_EQ("teddata", out.str());
+    // the last string's view follows replacement
+    ASSERT_TRUE(sp.set(2, "other"));
+    ASSERT_EQ("other", sp.view(2));
+
+    ASSERT_TRUE(StringView("a") < StringView("ab"));
+    ASSERT_TRUE(StringView("ab") < StringView("b"));
+    ASSERT_EQ(0, StringView("ab").compare(std::string("ab")));
+}
+
+TEST(StringPool, remove_test)
+{
+    StringPool<> sp;
+    sp.push("ted");
+    sp.push("");
+    sp.push("data");
+    sp.push("more");
+    sp.push("x");
+    // flags begin at the second string, the last is unflagged
+    sp.remove({true, false, true}, 1);
+    ASSERT_EQ(3, sp.string_count());
+    ASSERT_EQ("ted", sp.view(0));
+    ASSERT_EQ("data", sp.view(1));
+    ASSERT_EQ(std::string("x"), sp.data(2));
+    ASSERT_EQ(11, sp.size());
+    sp.remove({true, true, true});
+    ASSERT_EQ(0, sp.string_count());
+    ASSERT_EQ(0, sp.size());
+}
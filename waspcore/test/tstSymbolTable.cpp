@@ -0,0 +1,61 @@
+#include "waspcore/SymbolTable.h"
+#include "gtest/gtest.h"
+#include <iostream>
+#include <string>
+using namespace wasp;
+
+TEST(SymbolTable, intern_test)
+{
+    SymbolTable<> st;
+    ASSERT_EQ(0, st.size());
+    ASSERT_EQ(0, st.intern("ted"));
+    ASSERT_EQ(1, st.intern("fred"));
+    // interning an existing string yields the existing symbol
+    ASSERT_EQ(0, st.intern("ted"));
+    ASSERT_EQ(1, st.intern(std::string("fred").c_str()));
+    ASSERT_EQ(2, st.size());
+    ASSERT_EQ(std::string("ted"), st.data(0));
+    ASSERT_EQ(std::string("fred"), st.data(1));
+}
+
+TEST(SymbolTable, find_test)
+{
+    SymbolTable<> st;
+    ASSERT_EQ(SymbolTable<>::npos, st.find("ted"));
+    st.intern("ted");
+    st.intern("");
+    ASSERT_EQ(0, st.find("ted"));
+    ASSERT_EQ(1, st.find(""));
+    ASSERT_EQ(SymbolTable<>::npos, st.find("te"));
+    ASSERT_EQ(SymbolTable<>::npos, st.find("teddy"));
+    ASSERT_EQ(2, st.size());
+}
+
+/**
+ * @brief TEST interning enough strings to force the table to grow
+ * and interning strings that originate within the table
+ */
+TEST(SymbolTable, growth_test)
+{
+    SymbolTable<> st;
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i, st.intern(("name_" + std::to_string(i)).c_str()));
+    }
+    ASSERT_EQ(1000, st.size());
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+        std::string name = "name_" + std::to_string(i);
+        ASSERT_EQ(i, st.find(name.c_str()));
+        ASSERT_EQ(name, st.data(i));
+        ASSERT_EQ(i, st.intern(st.data(i)));
+    }
+    // suffix of an existing string
+    std::size_t symbol = st.intern(st.data(999) + 5);
+    ASSERT_EQ(1000, symbol);
+    ASSERT_EQ(std::string("999"), st.data(symbol));
+
+    SymbolTable<> copy(st);
+    ASSERT_EQ(st.size(), copy.size());
+    ASSERT_EQ(500, copy.find("name_500"));
+}
@@ -1,7 +1,10 @@
 #include "waspcore/TokenPool.h"
+#include "waspcore/utils.h"
 #include "gtest/gtest.h"
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <vector>
 
 using namespace wasp;
 
@@ -153,6 +156,11 @@ TEST(TokenPool, pop_test)
     }
     ASSERT_EQ(1, tp.line_count());
     ASSERT_EQ(7, tp.line_offset(0));
+    {  // a token pushed after a pop has its own string
+        tp.push("pushed", word, 20);
+        ASSERT_EQ(4, tp.size());
+        ASSERT_EQ(std::string("pushed"), tp.str(3));
+    }
 }
 
 TEST(TokenPool, copy_test)
@@ -350,3 +358,252 @@ TEST(TokenPool, multiple_line_column)
         tp.push_line(line.back().offset + line.back().data.size());
     }
 }
+
+/**
+ * @brief TEST line index agreement
+ * Pools with and without the line index are given identical tokens and
+ * lines, including embedded newlines, tokens starting with a newline,
+ * out of order tokens, and line removal. All line and column lookups
+ * must agree.
+ */
+TEST(TokenPool, line_index)
+{
+    TokenPool<> searched, indexed, late;
+    indexed.enable_line_index();
+    ASSERT_TRUE(indexed.has_line_index());
+    ASSERT_FALSE(searched.has_line_index());
+
+    auto push = [&](const char* str, size_t offset) {
+        searched.push(str, word, offset);
+        indexed.push(str, word, offset);
+        late.push(str, word, offset);
+    };
+    auto push_line = [&](size_t offset) {
+        searched.push_line(offset);
+        indexed.push_line(offset);
+        late.push_line(offset);
+    };
+    auto pop_line = [&]() {
+        searched.pop_line();
+        indexed.pop_line();
+        late.pop_line();
+    };
+    auto check = [&](const TokenPool<>& tp) {
+        ASSERT_EQ(searched.size(), tp.size());
+        for (size_t i = 0; i < searched.size(); ++i)
+        {
+            SCOPED_TRACE(i);
+            ASSERT_EQ(searched.line(i), tp.line(i));
+            ASSERT_EQ(searched.column(i), tp.column(i));
+            ASSERT_EQ(searched.last_line(i), tp.last_line(i));
+            ASSERT_EQ(searched.last_column(i), tp.last_column(i));
+        }
+    };
+    //'ted 234\n'
+    //'"multi\n'
+    //'line" x\n'
+    //'\n'
+    //'y'
+    push("ted", 0);
+    push("234", 4);
+    check(indexed);
+    push_line(7);
+    push("\"multi\nline\"", 8);
+    push("x", 20);
+    push_line(21);
+    check(indexed);
+    // token starting with a newline
+    push("\ny", 22);
+    check(indexed);
+    // line preceding existing tokens
+    push_line(16);
+    check(indexed);
+    pop_line();
+    check(indexed);
+    // out of order token
+    push("ted", 4);
+    push_line(2);
+    check(indexed);
+    pop_line();
+    check(indexed);
+    indexed.pop_token();
+    searched.pop_token();
+    late.pop_token();
+    check(indexed);
+    // a line following an out of order token that precedes it
+    push("a", 30);
+    push("b", 40);
+    push("c", 35);
+    push_line(37);
+    check(indexed);
+    push_line(41);
+    push("d", 42);
+    check(indexed);
+
+    // indexing after the fact
+    ASSERT_FALSE(late.has_line_index());
+    late.enable_line_index();
+    check(late);
+
+    // copies retain the index
+    TokenPool<> copy(indexed);
+    ASSERT_TRUE(copy.has_line_index());
+    check(copy);
+
+    // snapshots retain the index
+    std::stringstream snapshot;
+    indexed.save(snapshot);
+    TokenPool<> loaded;
+    ASSERT_TRUE(loaded.load(snapshot));
+    ASSERT_TRUE(loaded.has_line_index());
+    check(loaded);
+
+    // snapshots with a token line outside of the lines are rejected, the
+    // last token's line being the last field of the snapshot
+    typedef TokenPool<>::file_offset_type_size line_type;
+    for (line_type corrupt_line :
+         {line_type(0), line_type(indexed.line_count() + 2)})
+    {
+        SCOPED_TRACE(corrupt_line);
+        std::string corrupt = snapshot.str();
+        corrupt.replace(corrupt.size() - sizeof(line_type), sizeof(line_type),
+                        reinterpret_cast<const char*>(&corrupt_line),
+                        sizeof(line_type));
+        std::stringstream corrupt_snapshot(corrupt);
+        ASSERT_FALSE(loaded.load(corrupt_snapshot));
+    }
+}
+
+TEST(TokenPool, index_newlines)
+{
+    // tokens and lines as a lexer pushes them for
+    // 'key = "multi\nline"\n\n   value # comment\n'
+    std::string text = "key = \"multi\nline\"\n\n   value # comment\n";
+    TokenPool<> lexed, swept;
+    swept.enable_line_index();
+    swept.index_newlines(text.data(), text.size());
+    ASSERT_EQ(4, swept.line_count());
+    for (TokenPool<>* tp : {&lexed, &swept})
+    {
+        tp->push("key", word, 0);
+        tp->push("=", assign, 4);
+        tp->push("\"multi\nline\"", word, 6);
+        tp->push_line(18);
+        tp->push_line(19);
+        tp->push("value", word, 23);
+        tp->push("# comment", word, 29);
+        tp->push_line(38);
+    }
+    // the swept lines are not pushed again
+    ASSERT_EQ(lexed.line_count(), swept.line_count());
+    for (size_t i = 0; i < lexed.line_count(); ++i)
+    {
+        ASSERT_EQ(lexed.line_offset(i), swept.line_offset(i));
+    }
+    for (size_t i = 0; i < lexed.size(); ++i)
+    {
+        SCOPED_TRACE(i);
+        ASSERT_EQ(lexed.line(i), swept.line(i));
+        ASSERT_EQ(lexed.column(i), swept.column(i));
+        ASSERT_EQ(lexed.last_line(i), swept.last_line(i));
+        ASSERT_EQ(lexed.last_column(i), swept.last_column(i));
+    }
+    ASSERT_EQ(4, swept.line(3));
+    ASSERT_EQ(4, swept.column(3));
+    swept.clear();
+    swept.push_line(0);
+    ASSERT_EQ(1, swept.line_count());
+}
+
+TEST(TokenPool, remove_tokens)
+{
+    // 'a = 1\nb = 2\nc = 3\nd = 4\ne = 5\n'
+    TokenPool<> lexed, indexed;
+    indexed.enable_line_index();
+    for (TokenPool<>* tp : {&lexed, &indexed})
+    {
+        for (int i = 0; i < 5; ++i)
+        {
+            std::string key(1, static_cast<char>('a' + i));
+            std::string value = std::to_string(i + 1);
+            tp->push(key.c_str(), word, 6 * i);
+            tp->push("=", assign, 6 * i + 2);
+            tp->push(value.c_str(), integer, 6 * i + 4);
+            tp->push_line(6 * i + 5);
+        }
+        // flags begin at the second token, the second line's '=' is retained
+        tp->remove_tokens({true, true, true, false, true}, 1);
+        ASSERT_EQ(11, tp->size());
+        ASSERT_EQ(std::string("a"), tp->str(0));
+        ASSERT_EQ(std::string("="), tp->str(1));
+        ASSERT_EQ("c", tp->view(2));
+        ASSERT_EQ(2, tp->line(1));
+        ASSERT_EQ(3, tp->column(1));
+
+        // lines preceding the first token's are discarded
+        tp->discard_lines(30);
+        ASSERT_EQ(0, tp->discarded_line_count());
+        tp->remove_tokens(std::vector<bool>(8, true));
+        ASSERT_EQ(3, tp->size());
+        tp->discard_lines(30);
+        ASSERT_EQ(3, tp->discarded_line_count());
+        ASSERT_EQ(5, tp->line_count());
+        ASSERT_EQ(23, tp->line_offset(3));
+        ASSERT_EQ(5, tp->line(0));
+        ASSERT_EQ(1, tp->column(0));
+        ASSERT_EQ(5, tp->last_line(2));
+        ASSERT_EQ(5, tp->last_column(2));
+        ASSERT_EQ(5, tp->offset_line(28));
+        ASSERT_EQ(5, tp->offset_column(28));
+        // subsequent tokens are located
+        tp->push("f", word, 30);
+        ASSERT_EQ(6, tp->line(3));
+        ASSERT_EQ(1, tp->column(3));
+    }
+}
+
+TEST(TokenPool, numeric_conversion)
+{
+    // conversions agree with to_type
+    std::vector<std::string> data = {"3",    " -42",  "+7",   "1.5e3", "12abc",
+                                     "abc",  "",      "0x1F", "9e999", "1e-999",
+                                     "3000000000", "-2147483648", ".5", "inf"};
+    TokenPool<> tp;
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        tp.push(data[i].c_str(), word, i);
+    }
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            SCOPED_TRACE(data[i]);
+            int    expected_int = 0, actual_int = 0;
+            double expected_double = 0.0, actual_double = 0.0;
+            bool   expected_ok = false, actual_ok = false;
+            to_type(expected_int, data[i], &expected_ok);
+            actual_int = tp.to_int(i, &actual_ok);
+            ASSERT_EQ(expected_ok, actual_ok);
+            ASSERT_EQ(expected_int, actual_int);
+            to_type(expected_double, data[i], &expected_ok);
+            actual_double = tp.to_double(i, &actual_ok);
+            ASSERT_EQ(expected_ok, actual_ok);
+            ASSERT_EQ(expected_double, actual_double);
+        }
+    }
+
+    // uncached conversions are equal
+    TokenPool<> uncached;
+    uncached.push("2.25", real, 0);
+    bool ok = false;
+    ASSERT_EQ(2.25, uncached.to_double(0, &ok, false));
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(2, uncached.to_int(0, &ok, false));
+    ASSERT_TRUE(ok);
+
+    // conversions are not retained for the tokens of a cleared pool
+    ASSERT_EQ(2.25, uncached.to_double(0));
+    uncached.clear();
+    uncached.push("5", integer, 0);
+    ASSERT_EQ(5, uncached.to_int(0));
+}
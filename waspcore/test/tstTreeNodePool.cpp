@@ -1,8 +1,12 @@
 #include "waspcore/TreeNodePool.h"
 #include "waspcore/TokenPool.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace wasp;
 
@@ -274,3 +278,446 @@ TEST(TreeNodePool, last_line_and_column)
     ASSERT_EQ(2, tp.last_line(key_index));
     ASSERT_EQ(10, tp.last_column(key_index));
 }
+
+TEST(TreeNodePool, name_symbols)
+{
+    TreeNodePool<> tp;
+    std::vector<size_t> child_indices;
+    std::vector<std::string> names = {"a", "b", "a", "c", "a"};
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        tp.push_token("data", wasp::STRING, i);
+        tp.push_leaf(wasp::VALUE, names[i].c_str(), i);
+        child_indices.push_back(i);
+    }
+    tp.push_parent(wasp::OBJECT, "a", child_indices);
+    size_t parent = tp.size() - 1;
+
+    // equal names share a symbol, names are stored once
+    ASSERT_EQ(3, tp.node_names().size());
+    ASSERT_EQ(tp.name_symbol(0), tp.name_symbol(2));
+    ASSERT_EQ(tp.name_symbol(0), tp.name_symbol(parent));
+    ASSERT_NE(tp.name_symbol(0), tp.name_symbol(1));
+    ASSERT_EQ(tp.name_symbol(1), tp.find_name_symbol("b"));
+    ASSERT_EQ(SymbolTable<>::npos, tp.find_name_symbol("d"));
+    ASSERT_EQ(std::string("c"), tp.name(3));
+
+    ASSERT_EQ(0, tp.first_child_by_name(parent, "a"));
+    ASSERT_EQ(3, tp.first_child_by_name(parent, "c"));
+    ASSERT_EQ(tp.size(), tp.first_child_by_name(parent, "d"));
+    ASSERT_EQ(3, tp.child_count_by_name(parent, "a"));
+    ASSERT_EQ(2, tp.child_count_by_name(parent, "a", 2));
+    ASSERT_EQ(0, tp.child_count_by_name(parent, "d"));
+    std::vector<size_t> matches;
+    tp.child_by_name(parent, "a", matches);
+    ASSERT_EQ((std::vector<size_t>{0, 2, 4}), matches);
+    matches.clear();
+    tp.child_by_name(parent, "a", matches, 1);
+    ASSERT_EQ((std::vector<size_t>{0}), matches);
+
+    // renaming the last node reuses or creates symbols
+    ASSERT_TRUE(tp.set_name(parent, "b"));
+    ASSERT_EQ(tp.name_symbol(1), tp.name_symbol(parent));
+    ASSERT_TRUE(tp.set_name(parent, "root"));
+    ASSERT_EQ(std::string("root"), tp.name(parent));
+    ASSERT_EQ(4, tp.node_names().size());
+}
+
+TEST(TreeNodePool, child_name_index)
+{
+    TreeNodePool<> tp;
+    std::vector<size_t> child_indices;
+    // enough children for the parent to be indexed by name
+    const size_t child_count = 10 * TreeNodePool<>::child_name_index_threshold;
+    std::vector<std::string> names = {"x", "y", "z", "y"};
+    for (size_t i = 0; i < child_count; ++i)
+    {
+        tp.push_token("data", wasp::STRING, i);
+        tp.push_leaf(wasp::VALUE, names[i % names.size()].c_str(), i);
+        child_indices.push_back(i);
+    }
+    // a small parent whose children are scanned
+    tp.push_parent(wasp::OBJECT, "small", {0, 1, 2});
+    size_t small = tp.size() - 1;
+    tp.push_parent(wasp::OBJECT, "big", child_indices);
+    size_t big = tp.size() - 1;
+
+    ASSERT_EQ(0, tp.first_child_by_name(big, "x"));
+    ASSERT_EQ(1, tp.first_child_by_name(big, "y"));
+    ASSERT_EQ(2, tp.first_child_by_name(big, "z"));
+    ASSERT_EQ(tp.size(), tp.first_child_by_name(big, "small"));
+    ASSERT_EQ(child_count / 4, tp.child_count_by_name(big, "x"));
+    ASSERT_EQ(child_count / 2, tp.child_count_by_name(big, "y"));
+    ASSERT_EQ(3, tp.child_count_by_name(big, "y", 3));
+    ASSERT_EQ(0, tp.child_count_by_name(big, "big"));
+
+    // named children are acquired in child order
+    std::vector<size_t> matches;
+    tp.child_by_name(big, "y", matches);
+    ASSERT_EQ(child_count / 2, matches.size());
+    for (size_t i = 0; i < matches.size(); ++i)
+    {
+        ASSERT_EQ(2 * i + 1, matches[i]);
+    }
+    matches.clear();
+    tp.child_by_name(big, "z", matches, 2);
+    ASSERT_EQ((std::vector<size_t>{2, 6}), matches);
+
+    ASSERT_EQ(1, tp.first_child_by_name(small, "y"));
+    ASSERT_EQ(1, tp.child_count_by_name(small, "z"));
+
+    // renaming invalidates the index
+    tp.push_parent(wasp::OBJECT, "root", {small, big});
+    ASSERT_TRUE(tp.set_name(tp.size() - 1, "x"));
+    ASSERT_EQ(child_count / 4, tp.child_count_by_name(big, "x"));
+    ASSERT_EQ(big, tp.first_child_by_name(tp.size() - 1, "big"));
+}
+
+TEST(TreeNodePool, find_name_symbols)
+{
+    TreeNodePool<> tp;
+    std::vector<size_t> child_indices;
+    std::vector<std::string> names = {"material", "mat", "metal", "mesh",
+                                      "al",       "x",   "material"};
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        tp.push_token("data", wasp::STRING, i);
+        tp.push_leaf(wasp::VALUE, names[i].c_str(), i);
+        child_indices.push_back(i);
+    }
+    tp.push_parent(wasp::OBJECT, "materials", child_indices);
+    size_t parent = tp.size() - 1;
+
+    // symbols are acquired in ascending order
+    auto find = [&tp](const char* pattern) {
+        std::vector<size_t> symbols;
+        tp.find_name_symbols(pattern, symbols);
+        std::vector<std::string> found;
+        for (size_t s : symbols)
+        {
+            found.push_back(tp.node_names().data(s));
+        }
+        EXPECT_TRUE(std::is_sorted(symbols.begin(), symbols.end()));
+        return found;
+    };
+    // literal
+    ASSERT_EQ((std::vector<std::string>{"material"}), find("material"));
+    ASSERT_TRUE(find("materia").empty());
+    // prefix
+    ASSERT_EQ((std::vector<std::string>{"material", "mat", "materials"}),
+              find("mat*"));
+    ASSERT_EQ((std::vector<std::string>{"material", "mat", "metal", "mesh",
+                                        "materials"}),
+              find("m*"));
+    ASSERT_EQ(7u, find("*").size());
+    ASSERT_TRUE(find("q*").empty());
+    // suffix
+    ASSERT_EQ((std::vector<std::string>{"material", "metal", "al"}),
+              find("*al"));
+    ASSERT_EQ((std::vector<std::string>{"materials"}), find("*s"));
+    ASSERT_TRUE(find("*q").empty());
+    // other patterns
+    ASSERT_EQ((std::vector<std::string>{"material", "metal"}), find("m*al"));
+    ASSERT_EQ((std::vector<std::string>{"mesh"}), find("m?sh"));
+
+    // names interned since a lookup are found
+    tp.push_token("data", wasp::STRING, names.size());
+    tp.push_leaf(wasp::VALUE, "matrix", names.size());
+    ASSERT_EQ((std::vector<std::string>{"material", "mat", "materials",
+                                        "matrix"}),
+              find("mat*"));
+
+    std::vector<size_t> matches;
+    tp.child_by_name_symbol(parent, tp.find_name_symbol("material"), matches);
+    ASSERT_EQ((std::vector<size_t>{0, 6}), matches);
+}
+
+TEST(TreeNodePool, may_have_descendant)
+{
+    TreeNodePool<> tp;
+    // root
+    // |_ a
+    // | |_ b
+    // |   |_ c
+    // |_ d
+    tp.push_token("data", wasp::STRING, 0);
+    tp.push_leaf(wasp::VALUE, "c", 0);
+    tp.push_parent(wasp::OBJECT, "b", {0});
+    tp.push_parent(wasp::OBJECT, "a", {1});
+    tp.push_token("data", wasp::STRING, 1);
+    tp.push_leaf(wasp::VALUE, "d", 1);
+    tp.push_parent(wasp::OBJECT, "root", {2, 3});
+    size_t root = tp.size() - 1;
+    auto   may  = [&tp](size_t node_index, const char* name) {
+        return tp.may_have_descendant(node_index, tp.find_name_symbol(name));
+    };
+    // descendants always pass the filter
+    ASSERT_TRUE(may(root, "a"));
+    ASSERT_TRUE(may(root, "b"));
+    ASSERT_TRUE(may(root, "c"));
+    ASSERT_TRUE(may(root, "d"));
+    ASSERT_TRUE(may(2, "b"));
+    ASSERT_TRUE(may(2, "c"));
+    ASSERT_TRUE(may(1, "c"));
+    // a node is not its own descendant, and leaves have no descendants
+    ASSERT_FALSE(may(root, "root"));
+    ASSERT_FALSE(may(0, "c"));
+    ASSERT_FALSE(may(3, "d"));
+    // modification refilters
+    tp.push_token("data", wasp::STRING, 2);
+    tp.push_leaf(wasp::VALUE, "e", 2);
+    tp.push_parent(wasp::OBJECT, "top", {root, tp.size() - 1});
+    ASSERT_TRUE(may(tp.size() - 1, "e"));
+    ASSERT_TRUE(may(tp.size() - 1, "c"));
+    ASSERT_FALSE(may(root, "e"));
+}
+
+TEST(TreeNodePool, freeze)
+{
+    TreeNodePool<> tp;
+    std::vector<size_t> child_indices;
+    const size_t child_count = 2 * TreeNodePool<>::child_name_index_threshold;
+    for (size_t i = 0; i < child_count; ++i)
+    {
+        tp.push_token("data", wasp::STRING, i);
+        tp.push_leaf(wasp::VALUE, i % 2 ? "odd" : "even", i);
+        child_indices.push_back(i);
+    }
+    tp.push_parent(wasp::OBJECT, "big", child_indices);
+    size_t big = tp.size() - 1;
+    ASSERT_FALSE(tp.frozen());
+    tp.freeze();
+    ASSERT_TRUE(tp.frozen());
+    // freezing again is harmless
+    tp.freeze();
+    ASSERT_TRUE(tp.frozen());
+
+    // lookups are unchanged
+    ASSERT_EQ(0, tp.first_child_by_name(big, "even"));
+    ASSERT_EQ(1, tp.first_child_by_name(big, "odd"));
+    ASSERT_EQ(child_count / 2, tp.child_count_by_name(big, "odd"));
+    std::vector<size_t> matches;
+    tp.child_by_name(big, "even", matches, 2);
+    ASSERT_EQ((std::vector<size_t>{0, 2}), matches);
+    // subtree hashes were computed by the freeze
+    ASSERT_EQ(tp.subtree_hash(0), tp.subtree_hash(2));
+    ASSERT_NE(tp.subtree_hash(0), tp.subtree_hash(1));
+    ASSERT_NE(tp.subtree_hash(0), tp.subtree_hash(big));
+
+    // modification is prohibited
+    ASSERT_THROW(tp.push_token("data", wasp::STRING, 0), std::runtime_error);
+    ASSERT_THROW(tp.push_leaf(wasp::VALUE, "leaf", 0), std::runtime_error);
+    ASSERT_THROW(tp.push_parent(wasp::OBJECT, "root", {big}),
+                 std::runtime_error);
+    ASSERT_THROW(tp.set_name(big, "renamed"), std::runtime_error);
+    ASSERT_THROW(tp.set_data(0, "changed"), std::runtime_error);
+    ASSERT_THROW(tp.set_type(big, wasp::ARRAY), std::runtime_error);
+    ASSERT_EQ(big + 1, tp.size());
+    ASSERT_EQ("data", std::string(tp.data(0)));
+
+    // copies and cleared pools are modifiable
+    TreeNodePool<> copy(tp);
+    ASSERT_FALSE(copy.frozen());
+    copy.push_parent(wasp::OBJECT, "root", {big});
+    tp.clear();
+    ASSERT_FALSE(tp.frozen());
+    tp.push_token("data", wasp::STRING, 0);
+    tp.push_leaf(wasp::VALUE, "leaf", 0);
+    ASSERT_EQ(1, tp.size());
+}
+
+TEST(TreeNodePool, relayout)
+{
+    // a (b (c d) e) with an unattached node f, pushed bottom-up
+    TreeNodePool<> tp;
+    const char* data[] = {"c", "d", "e", "f"};
+    for (size_t i = 0; i < 4; ++i)
+    {
+        tp.push_token(data[i], wasp::STRING, i);
+    }
+    tp.push_leaf(wasp::VALUE, "c", 0);       // 0
+    tp.push_leaf(wasp::VALUE, "d", 1);       // 1
+    tp.push_parent(wasp::OBJECT, "b", {0, 1});  // 2
+    tp.push_leaf(wasp::VALUE, "f", 3);       // 3
+    tp.push_leaf(wasp::VALUE, "e", 2);       // 4
+    tp.push_parent(wasp::OBJECT, "a", {2, 4});  // 5
+    ASSERT_FALSE(tp.preordered());
+    ASSERT_TRUE(tp.is_descendant(5, 0));
+    ASSERT_FALSE(tp.is_descendant(2, 4));
+
+    std::vector<size_t> new_index = tp.relayout();
+    ASSERT_TRUE(tp.preordered());
+    ASSERT_EQ((std::vector<size_t>{2, 3, 1, 5, 4, 0}), new_index);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < tp.size(); ++i)
+    {
+        names.push_back(tp.name(i));
+    }
+    ASSERT_EQ((std::vector<std::string>{"a", "b", "c", "d", "e", "f"}), names);
+    ASSERT_EQ((std::vector<size_t>{5, 4, 3, 4, 5, 6}),
+              (std::vector<size_t>{tp.subtree_end(0), tp.subtree_end(1),
+                                   tp.subtree_end(2), tp.subtree_end(3),
+                                   tp.subtree_end(4), tp.subtree_end(5)}));
+    // structure and data are retained
+    ASSERT_EQ(2, tp.child_count(0));
+    ASSERT_EQ(1, tp.child_at(0, 0));
+    ASSERT_EQ(4, tp.child_at(0, 1));
+    ASSERT_EQ(0, tp.parent_node_index(1));
+    ASSERT_EQ(1, tp.parent_node_index(3));
+    ASSERT_EQ(tp.size(), tp.parent_node_index(5));
+    ASSERT_EQ("d", std::string(tp.data(3)));
+    ASSERT_EQ("f", std::string(tp.data(5)));
+    ASSERT_EQ(4, tp.first_child_by_name(0, "e"));
+
+    ASSERT_TRUE(tp.is_descendant(0, 3));
+    ASSERT_TRUE(tp.is_descendant(1, 2));
+    ASSERT_FALSE(tp.is_descendant(1, 4));
+    ASSERT_FALSE(tp.is_descendant(0, 5));
+    ASSERT_FALSE(tp.is_descendant(1, 1));
+
+    // pushing nodes discards the layout
+    tp.push_parent(wasp::OBJECT, "root", {0, 5});
+    ASSERT_FALSE(tp.preordered());
+    ASSERT_TRUE(tp.is_descendant(6, 3));
+    tp.relayout();
+    ASSERT_TRUE(tp.preordered());
+    ASSERT_EQ("root", std::string(tp.name(0)));
+    ASSERT_EQ(tp.size(), tp.subtree_end(0));
+}
+
+TEST(TreeNodePool, soa_node_layout)
+{
+    typedef TreeNodePool<default_node_type_size, default_node_index_size,
+                         TokenPool<>, SoANodeLayout>
+                   SoATreeNodePool;
+    TreeNodePool<> aos;
+    SoATreeNodePool soa;
+    const char*    data[] = {"c", "d", "e"};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        aos.push_token(data[i], wasp::STRING, i);
+        soa.push_token(data[i], wasp::STRING, i);
+    }
+    aos.push_leaf(wasp::VALUE, "c", 0);
+    soa.push_leaf(wasp::VALUE, "c", 0);
+    aos.push_leaf(wasp::VALUE, "d", 1);
+    soa.push_leaf(wasp::VALUE, "d", 1);
+    aos.push_parent(wasp::OBJECT, "b", {0, 1});
+    soa.push_parent(wasp::OBJECT, "b", {0, 1});
+    aos.push_leaf(wasp::VALUE, "e", 2);
+    soa.push_leaf(wasp::VALUE, "e", 2);
+    aos.push_parent(wasp::OBJECT, "a", {2, 3});
+    soa.push_parent(wasp::OBJECT, "a", {2, 3});
+
+    auto expect_equal = [](const TreeNodePool<>& a, const SoATreeNodePool& s)
+    {
+        ASSERT_EQ(a.size(), s.size());
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            SCOPED_TRACE(i);
+            ASSERT_EQ(a.type(i), s.type(i));
+            ASSERT_EQ(std::string(a.name(i)), std::string(s.name(i)));
+            ASSERT_EQ(a.parent_node_index(i), s.parent_node_index(i));
+            ASSERT_EQ(a.child_count(i), s.child_count(i));
+            ASSERT_EQ(a.line(i), s.line(i));
+            ASSERT_EQ(a.column(i), s.column(i));
+            ASSERT_EQ(a.data(i), s.data(i));
+        }
+    };
+    expect_equal(aos, soa);
+
+    aos.set_type(3, wasp::ARRAY);
+    soa.set_type(3, wasp::ARRAY);
+    ASSERT_TRUE(aos.set_name(4, "f"));
+    ASSERT_TRUE(soa.set_name(4, "f"));
+    expect_equal(aos, soa);
+    ASSERT_EQ(3, soa.first_child_by_name(4, "e"));
+
+    ASSERT_EQ(aos.relayout(), soa.relayout());
+    ASSERT_TRUE(soa.preordered());
+    expect_equal(aos, soa);
+    ASSERT_EQ(aos.subtree_end(1), soa.subtree_end(1));
+
+    // snapshots are interchangeable between layouts
+    std::stringstream aos_snapshot;
+    aos.save(aos_snapshot);
+    SoATreeNodePool loaded;
+    ASSERT_TRUE(loaded.load(aos_snapshot));
+    expect_equal(aos, loaded);
+    ASSERT_TRUE(loaded.preordered());
+
+    std::stringstream soa_snapshot;
+    soa.save(soa_snapshot);
+    TreeNodePool<> reloaded;
+    ASSERT_TRUE(reloaded.load(soa_snapshot));
+    expect_equal(reloaded, soa);
+}
+
+TEST(TreeNodePool, type_index)
+{
+    // a (b (c d) e), with b pushed prior to enabling the index
+    TreeNodePool<> tp;
+    const char*    data[] = {"c", "d", "e"};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        tp.push_token(data[i], wasp::STRING, i);
+    }
+    tp.push_leaf(wasp::VALUE, "c", 0);          // 0
+    tp.push_leaf(wasp::VALUE, "d", 1);          // 1
+    tp.push_parent(wasp::OBJECT, "b", {0, 1});  // 2
+    std::vector<size_t> nodes;
+    // without the index the nodes are scanned
+    ASSERT_FALSE(tp.type_indexed());
+    tp.nodes_of_type(wasp::VALUE, nodes);
+    ASSERT_EQ((std::vector<size_t>{0, 1}), nodes);
+
+    tp.enable_type_index();
+    ASSERT_TRUE(tp.type_indexed());
+    tp.nodes_of_type(wasp::VALUE, nodes);
+    ASSERT_EQ((std::vector<size_t>{0, 1}), nodes);
+    tp.push_leaf(wasp::DECL, "e", 2);           // 3
+    tp.push_parent(wasp::OBJECT, "a", {2, 3});  // 4
+    tp.nodes_of_type(wasp::OBJECT, nodes);
+    ASSERT_EQ((std::vector<size_t>{2, 4}), nodes);
+    tp.nodes_of_type(wasp::DECL, nodes);
+    ASSERT_EQ((std::vector<size_t>{3}), nodes);
+    tp.nodes_of_type(wasp::FILE, nodes);
+    ASSERT_TRUE(nodes.empty());
+
+    // retyped nodes move between lists, retaining order
+    tp.set_type(1, wasp::DECL);
+    tp.nodes_of_type(wasp::VALUE, nodes);
+    ASSERT_EQ((std::vector<size_t>{0}), nodes);
+    tp.nodes_of_type(wasp::DECL, nodes);
+    ASSERT_EQ((std::vector<size_t>{1, 3}), nodes);
+    tp.set_type(0, wasp::FILE);
+    tp.nodes_of_type(wasp::FILE, nodes);
+    ASSERT_EQ((std::vector<size_t>{0}), nodes);
+    tp.set_type(0, wasp::VALUE);
+
+    // the index follows the relayout a (b (c d) e)
+    tp.relayout();
+    tp.nodes_of_type(wasp::OBJECT, nodes);
+    ASSERT_EQ((std::vector<size_t>{0, 1}), nodes);
+    tp.nodes_of_type(wasp::DECL, nodes);
+    ASSERT_EQ((std::vector<size_t>{3, 4}), nodes);
+
+    // and is rebuilt when loaded or copied
+    std::stringstream snapshot;
+    tp.save(snapshot);
+    TreeNodePool<> loaded;
+    loaded.enable_type_index();
+    ASSERT_TRUE(loaded.load(snapshot));
+    loaded.nodes_of_type(wasp::VALUE, nodes);
+    ASSERT_EQ((std::vector<size_t>{2}), nodes);
+    TreeNodePool<> copy(loaded);
+    ASSERT_TRUE(copy.type_indexed());
+    copy.nodes_of_type(wasp::DECL, nodes);
+    ASSERT_EQ((std::vector<size_t>{3, 4}), nodes);
+
+    // clearing retains the index
+    loaded.clear();
+    ASSERT_TRUE(loaded.type_indexed());
+    loaded.nodes_of_type(wasp::DECL, nodes);
+    ASSERT_TRUE(nodes.empty());
+}
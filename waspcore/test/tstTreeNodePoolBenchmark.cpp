@@ -0,0 +1,96 @@
+#include "waspcore/wasp_bug.h"
+#include "waspcore/TreeNodePool.h"
+#include "gtest/gtest.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace wasp;
+
+/**
+ * @brief build_tree push a complete 4-ary tree of about the given number of
+ * nodes, leaves first, then each level of parents bottom-up
+ */
+template<class Pool>
+void build_tree(Pool& pool, std::size_t node_count)
+{
+    const std::size_t   arity      = 4;
+    const std::size_t   leaf_count = node_count - node_count / arity;
+    std::vector<size_t> level, parents, children;
+    for (std::size_t i = 0; i < leaf_count; ++i)
+    {
+        pool.push_leaf(i % 2 ? wasp::VALUE : wasp::DECL, i % 2 ? "value" : "decl",
+                       wasp::INTEGER, i, "1");
+        level.push_back(pool.size() - 1);
+    }
+    while (level.size() > 1)
+    {
+        parents.clear();
+        for (std::size_t i = 0; i < level.size(); i += arity)
+        {
+            children.assign(level.begin() + i,
+                            level.begin() + std::min(i + arity, level.size()));
+            pool.push_parent(wasp::OBJECT, "object", children);
+            parents.push_back(pool.size() - 1);
+        }
+        level.swap(parents);
+    }
+}
+
+template<class Pool>
+void scan_tree(const std::string& layout,
+               std::size_t&       object_count,
+               std::size_t&       total_depth)
+{
+    Pool pool;
+    build_tree(pool, 5000000);
+    ASSERT_GE(pool.size(), 5000000);
+
+    // type scan - the type of every node
+    wasp_timer(type_timer);
+    wasp_timer_start(type_timer);
+    object_count = 0;
+    for (int repeat = 0; repeat < 10; ++repeat)
+    {
+        for (std::size_t i = 0, n = pool.size(); i < n; ++i)
+        {
+            object_count += pool.type(i) == wasp::OBJECT;
+        }
+    }
+    wasp_timer_stop(type_timer);
+
+    // parent walks - the parent chain of every node
+    wasp_timer(parent_timer);
+    wasp_timer_start(parent_timer);
+    total_depth = 0;
+    for (std::size_t i = 0, n = pool.size(); i < n; ++i)
+    {
+        for (std::size_t p = pool.parent_node_index(i); p != n;
+             p = pool.parent_node_index(p))
+        {
+            ++total_depth;
+        }
+    }
+    wasp_timer_stop(parent_timer);
+
+    wasp_timer_block(std::cout << layout << " " << pool.size()
+                               << " nodes - type scans "
+                               << type_timer.duration() / 1e6 << " ms, "
+                               << "parent walks "
+                               << parent_timer.duration() / 1e6 << " ms"
+                               << std::endl);
+    (void) layout; // suppress unused variable warning without timing
+}
+
+TEST(TreeNodePool, benchmark_node_layout)
+{
+    std::size_t aos_objects = 0, aos_depth = 0;
+    std::size_t soa_objects = 0, soa_depth = 0;
+    scan_tree<TreeNodePool<>>("array of structures", aos_objects, aos_depth);
+    scan_tree<TreeNodePool<default_node_type_size, default_node_index_size,
+                           TokenPool<>, SoANodeLayout>>(
+        "structure of arrays", soa_objects, soa_depth);
+    ASSERT_GT(aos_objects, 0);
+    ASSERT_EQ(aos_objects, soa_objects);
+    ASSERT_EQ(aos_depth, soa_depth);
+}
@@ -13,6 +13,7 @@
 #include <memory>
 #include <vector>
 #include "waspcore/decl.h"
+#include "waspcore/StringView.h"
 #include "waspcore/wasp_node.h"
 
 #ifdef _WIN32
@@ -297,12 +298,148 @@ inline WASP_PUBLIC bool wildcard_string_match(const char* first,
     return false;
 }
 
+/**
+ * @brief The NameSymbolMatch class compares node names by interned symbol
+ * The given name's symbol is looked up once per document (node pool), after
+ * which each node comparison is an integer comparison
+ */
+class NameSymbolMatch
+{
+  public:
+    NameSymbolMatch(const char* name)
+        : m_name(name), m_pool(nullptr), m_symbol(-1)
+    {
+    }
+    template<class Node>
+    bool operator()(const Node& n)
+    {
+        if (n.node_pool() != m_pool)
+        {
+            m_pool   = n.node_pool();
+            m_symbol = n.node_pool()->find_name_symbol(m_name);
+        }
+        return m_symbol != static_cast<std::size_t>(-1) &&
+               n.node_pool()->name_symbol(n.node_index()) == m_symbol;
+    }
+
+  private:
+    const char* m_name;
+    const void* m_pool;
+    std::size_t m_symbol;
+};
+
 class NullNodeDeRef{
 public:
     template<class T>
     T operator()(const T& node)const{return node;}
 };
 
+/**
+ * @brief The StringAppendBuffer class is a write-only stream buffer appending
+ * to a referenced string
+ * Formatting through it writes into the string's existing capacity, where a
+ * std::ostringstream would allocate its own storage and copy it out.
+ */
+class StringAppendBuffer : public std::streambuf
+{
+  public:
+    StringAppendBuffer(std::string& str) : m_str(str) {}
+
+  protected:
+    int_type overflow(int_type ch)
+    {
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+            m_str.push_back(traits_type::to_char_type(ch));
+        return traits_type::not_eof(ch);
+    }
+    std::streamsize xsputn(const char* s, std::streamsize count)
+    {
+        m_str.append(s, static_cast<std::size_t>(count));
+        return count;
+    }
+
+  private:
+    std::string& m_str;
+};
+
+namespace detail
+{
+// rank the adapter accessors, preferring the overload taking an int
+template<class TAdapter>
+auto adapted_data_view(const TAdapter& node, std::string& buffer, int)
+    -> decltype(node.data_view(buffer))
+{
+    return node.data_view(buffer);
+}
+template<class TAdapter>
+StringView adapted_data_view(const TAdapter& node, std::string& buffer, long)
+{
+    buffer = node.data();
+    return StringView(buffer);
+}
+template<class TAdapter>
+auto adapted_string_view(const TAdapter& node, std::string& buffer, int)
+    -> decltype(node.to_string_view(buffer))
+{
+    return node.to_string_view(buffer);
+}
+template<class TAdapter>
+StringView adapted_string_view(const TAdapter& node, std::string& buffer, long)
+{
+    buffer = node.to_string();
+    return StringView(buffer);
+}
+}  // namespace detail
+
+/**
+ * @brief adapted_data_view acquire a view of the adapted node's data
+ * Adapters without a data_view(std::string&) member have their data() copied
+ * into the buffer.
+ * @param buffer storage for data that is not viewed in place, reusable across
+ * calls
+ */
+template<class TAdapter>
+StringView adapted_data_view(const TAdapter& node, std::string& buffer)
+{
+    return detail::adapted_data_view(node, buffer, 0);
+}
+/**
+ * @brief adapted_string_view acquire a view of the adapted node's data as
+ * to_string() would produce it, i.e., quoteless
+ * Adapters without a to_string_view(std::string&) member have their
+ * to_string() copied into the buffer.
+ * @param buffer storage for data that is not viewed in place, reusable across
+ * calls
+ */
+template<class TAdapter>
+StringView adapted_string_view(const TAdapter& node, std::string& buffer)
+{
+    return detail::adapted_string_view(node, buffer, 0);
+}
+/**
+ * @brief adapted_string assign the adapted node's to_string() data into the
+ * given string, reusing its capacity
+ * @param result the string to assign
+ * @return the result
+ */
+template<class TAdapter>
+const std::string& adapted_string(const TAdapter& node, std::string& result)
+{
+    StringView view = adapted_string_view(node, result);
+    const char* begin = result.data();
+    if (view.data() >= begin && view.data() <= begin + result.size())
+    {
+        // the view is within the result, e.g., formatted parent data
+        result.erase(0, static_cast<std::size_t>(view.data() - begin));
+        result.resize(view.size());
+    }
+    else
+    {
+        result.assign(view.data(), view.size());
+    }
+    return result;
+}
+
 template<class TV>
 WASP_PUBLIC std::string info(const TV& view)
 {
@@ -315,6 +452,46 @@ WASP_PUBLIC std::string info(const TV& view)
                std::to_string(view.type()) + ", n'" + view.name() + "'" + ")";
 }
 
+/**
+ * @brief print_packed_from print the packed elements of the given array
+ * Each element is positioned relative to the previously printed data as
+ * leaves are.
+ */
+template<class Pool>
+WASP_PUBLIC void print_packed_from(std::ostream& stream,
+                                   const Pool&   node_pool,
+                                   size_t        node_index,
+                                   size_t&       last_line,
+                                   size_t&       last_column)
+{
+    size_t packed_size = node_pool.packed_size(node_index);
+    bool   separated   = node_pool.packed_separated(node_index);
+    for (size_t e = 0; e < packed_size; ++e)
+    {
+        size_t line   = node_pool.packed_line(node_index, e);
+        size_t column = node_pool.packed_column(node_index, e);
+        size_t ldiff  = line > last_line ? line - last_line : 0;
+        size_t cdiff;
+        if (ldiff > 0)
+            cdiff = column - 1;
+        else if (column >= last_column)
+            cdiff = column - last_column;
+        else
+            cdiff = 1;
+        for (size_t i = 0; i < ldiff; i++)
+            stream << std::endl;
+        if (cdiff > 0)
+            stream << std::string(cdiff, ' ');
+        std::string data = node_pool.packed_data(node_index, e);
+        // separators immediately follow their element
+        if (separated && e + 1 < packed_size)
+            data += ',';
+        stream << data;
+        last_line   = line;
+        last_column = column + data.size();
+    }
+}
+
 template<class Pool>
 WASP_PUBLIC void print_from(std::ostream& stream,
                             const Pool&   node_pool,
@@ -371,8 +548,19 @@ WASP_PUBLIC void print_from(std::ostream& stream,
         last_column = column + data.size();
         return;
     }
-    for (size_t i = 0, cc = child_count; i < cc; i++)
+    // packed array elements are printed where they occur among the children
+    size_t packed_size     = node_pool.packed_size(node_index);
+    size_t packed_position =
+        packed_size == 0 ? child_count : node_pool.packed_position(node_index);
+    for (size_t i = 0, cc = child_count; i <= cc; i++)
     {
+        if (i == packed_position && packed_size > 0)
+        {
+            print_packed_from(stream, node_pool, node_index, last_line,
+                              last_column);
+        }
+        if (i == cc)
+            break;
         size_t child_index = node_pool.child_at(node_index, i);
         print_from(stream, node_pool, child_index, last_line, last_column);
     }
@@ -394,6 +582,33 @@ WASP_PUBLIC void print(std::ostream& out, const TAdapter& node_view)
     print_from(out, *node_view.node_pool(), node_view.node_index(), l, c);
 }
 
+/**
+ * @brief to_doubles acquire the data of each of the given nodes converted to
+ * a double
+ * Conversions of leaf nodes are cached by the nodes' documents, so that
+ * repeated conversions of the same nodes do not reformat their data.
+ * @param nodes the nodes to convert
+ * @param ok optional indication of whether every conversion succeeded
+ * @return the doubles in node order, 0.0 for a failed conversion
+ */
+template<class Collection>
+WASP_PUBLIC std::vector<double> to_doubles(const Collection& nodes,
+                                           bool*             ok = nullptr)
+{
+    std::vector<double> results;
+    results.reserve(nodes.size());
+    bool all_ok = true;
+    for (const auto& node : nodes)
+    {
+        bool node_ok = false;
+        results.push_back(node.to_double(&node_ok));
+        all_ok = all_ok && node_ok;
+    }
+    if (ok)
+        *ok = all_ok;
+    return results;
+}
+
 template<class TAdapter, class DeRef=NullNodeDeRef>
 WASP_PUBLIC typename TAdapter::Collection
 non_decorative_children(const TAdapter& node)
@@ -453,11 +668,61 @@ WASP_PUBLIC TAdapter first_non_decorative_child_by_name(const TAdapter& node,
     return TAdapter();  // null node
 }
 
+/**
+ * @brief fe_indexed_child_by_name acquire the given node's children with the
+ * given name from the node pool's name index, excluding include (FILE) nodes
+ * @param n the parent node
+ * @param name the name of the children to be retrieved
+ * @param limit the limit (0 reserved as no limit) on the number of children
+ * @param child_indices the node indices of the matching children
+ */
+template<class Node>
+void fe_indexed_child_by_name(const Node&               n,
+                              const std::string&        name,
+                              std::size_t               limit,
+                              std::vector<std::size_t>& child_indices)
+{
+    const auto* pool    = n.node_pool();
+    auto        is_file = [pool](std::size_t child_index) {
+        return pool->type(child_index) == wasp::FILE;
+    };
+    pool->child_by_name(n.node_index(), name.c_str(), limit, child_indices);
+    auto end = std::remove_if(child_indices.begin(), child_indices.end(),
+                              is_file);
+    if (end == child_indices.end())
+        return;
+    child_indices.erase(end, child_indices.end());
+    // limit of 0 is reserved as no limit
+    if (limit == 0)
+        return;
+    // an include took the place of a match within the limit
+    child_indices.clear();
+    pool->child_by_name(n.node_index(), name.c_str(), 0, child_indices);
+    child_indices.erase(std::remove_if(child_indices.begin(),
+                                       child_indices.end(), is_file),
+                        child_indices.end());
+    if (child_indices.size() > limit)
+        child_indices.resize(limit);
+}
+
 // File enabled variant
 template<class Node>
 WASP_PUBLIC Node
 fe_first_non_decorative_child_by_name(const Node& n, const std::string& name)
 {
+    // Without included documents the first named child is found by the
+    // document's name index and is most often non-decorative
+    if (n.node_pool()->document_count() == 0)
+    {
+        std::vector<std::size_t> child_indices;
+        fe_indexed_child_by_name(n, name, 1, child_indices);
+        if (child_indices.empty())
+            return Node();  // Null node
+        Node child(child_indices.front(), *n.node_pool());
+        if (!child.is_decorative())
+            return child;
+    }
+    NameSymbolMatch name_match(name.c_str());
     for (std::size_t i = 0, count = n.child_count(); i < count; ++i)
     {
         const auto& child = n.child_at(i);
@@ -473,7 +738,7 @@ fe_first_non_decorative_child_by_name(const Node& n, const std::string& name)
         }
         else if (!child.is_decorative())
         {
-            if (name == child.name())
+            if (name_match(child))
             {
                 return child;
             }
@@ -539,11 +804,18 @@ WASP_PUBLIC std::size_t fe_child_count(const Node& n)
 template<class Node>
 WASP_PUBLIC std::size_t fe_child_count_by_name(const Node& n, const std::string& name, std::size_t limit)
 {
+    // Without included documents the document's name index suffices
+    if (n.node_pool()->document_count() == 0)
+    {
+        std::vector<std::size_t> child_indices;
+        fe_indexed_child_by_name(n, name, limit, child_indices);
+        return child_indices.size();
+    }
     size_t result = 0;
+    NameSymbolMatch name_match(name.c_str());
     for (std::size_t i = 0, count = n.child_count(); i < count; ++i)
     {
         const auto& child = n.child_at(i);
-        const std::string& child_name = child.name();
         if( child.type() == wasp::FILE )
         {
             auto * interp = n.node_pool()->document(child.node_index());
@@ -553,7 +825,7 @@ WASP_PUBLIC std::size_t fe_child_count_by_name(const Node& n, const std::string&
                                                     limit==0?limit:limit-result);
             }
         }
-        else if (child_name == name)
+        else if (name_match(child))
         {
             ++result;
         }
@@ -587,11 +859,23 @@ WASP_PUBLIC typename Node::Collection
 fe_child_by_name(const Node& n, const std::string& name, std::size_t limit)
 {
     typename Node::Collection results;
+    // Without included documents the document's name index suffices
+    if (n.node_pool()->document_count() == 0)
+    {
+        std::vector<std::size_t> child_indices;
+        fe_indexed_child_by_name(n, name, limit, child_indices);
+        results.reserve(child_indices.size());
+        for (std::size_t child_index : child_indices)
+        {
+            results.push_back(Node(child_index, *n.node_pool()));
+        }
+        return results;
+    }
+    NameSymbolMatch name_match(name.c_str());
     for (auto itr = n.begin(); itr != n.end(); itr.next())
     {
-        auto        child      = itr.get();
-        std::string child_name = child.name();
-        if (child_name == name)
+        auto child = itr.get();
+        if (name_match(child))
         {
             results.push_back(child);
         }
@@ -606,12 +890,22 @@ fe_child_by_name(const Node& n, const std::string& name, std::size_t limit)
 template<class Node>
 WASP_PUBLIC Node fe_first_child_by_name(const Node& n, const std::string& name)
 {
+    // Without included documents the document's name index suffices
+    if (n.node_pool()->document_count() == 0)
+    {
+        std::vector<std::size_t> child_indices;
+        fe_indexed_child_by_name(n, name, 1, child_indices);
+        if (child_indices.empty())
+            return Node();  // Null node;
+        return Node(child_indices.front(), *n.node_pool());
+    }
+    NameSymbolMatch name_match(name.c_str());
     for(auto itr = n.begin(); itr != n.end(); itr.next())
     {
-        std::string child_name = itr.get().name();
-        if (name == child_name)
+        auto child = itr.get();
+        if (name_match(child))
         {
-            return itr.get();
+            return child;
         }
     }
     return Node(); // Null node;
@@ -106,6 +106,19 @@ std::string DDINodeView::data() const
     return str.str();
 }
 
+StringView DDINodeView::data_view() const
+{
+    wasp_insist(m_pool->is_leaf(m_node_index),
+                "only a leaf node's data can be viewed without a buffer!");
+    std::string unused;
+    return m_pool->data_view(m_node_index, unused);
+}
+
+StringView DDINodeView::data_view(std::string& buffer) const
+{
+    return m_pool->data_view(m_node_index, buffer);
+}
+
 void DDINodeView::set_data(const char* data)
 {
     NodeView view(node_index(), *node_pool());
@@ -183,6 +196,11 @@ const char* DDINodeView::name() const
     return m_pool->name(m_node_index);
 }
 
+StringView DDINodeView::name_view() const
+{
+    return m_pool->name_view(m_node_index);
+}
+
 std::size_t DDINodeView::line() const
 {
     return m_pool->line(m_node_index);
@@ -227,6 +245,12 @@ std::string DDINodeView::to_string(bool* ok) const
     return view.to_string(ok);
 }
 
+StringView DDINodeView::to_string_view(std::string& buffer) const
+{
+    NodeView view(value_node_index(), *node_pool());
+    return view.to_string_view(buffer);
+}
+
 std::string DDINodeView::last_as_string(bool* ok) const
 {
     return wasp::last_as_string(*this, ok);
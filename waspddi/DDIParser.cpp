@@ -394,7 +394,7 @@ namespace wasp {
     {
       case symbol_kind::S_value_list: // value_list
 #line 95 "DDIParser.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 399 "DDIParser.cpp"
         break;
 
@@ -744,7 +744,7 @@ namespace wasp {
   case 10: // value_list: value
 #line 173 "DDIParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 751 "DDIParser.cpp"
@@ -803,7 +803,7 @@ namespace wasp {
                                     ,quote_less_data.c_str()
                                     ,*(yystack_[0].value.node_indices));
         }
-        delete (yystack_[0].value.node_indices);
+        interpreter.release_child_indices((yystack_[0].value.node_indices));
     }
 #line 809 "DDIParser.cpp"
     break;
@@ -834,7 +834,7 @@ else{
                                     ,quote_less_data.c_str()
                                     ,*(yystack_[0].value.node_indices));
 }
-        delete (yystack_[0].value.node_indices);
+        interpreter.release_child_indices((yystack_[0].value.node_indices));
     }
 #line 840 "DDIParser.cpp"
     break;
@@ -18,6 +18,7 @@
 
 #include "waspddi/DDIParser.hpp"
 #include "waspcore/Interpreter.h"
+#include "waspcore/MappedFile.h"
 #include "waspcore/Definition.h"
 
 #include "waspcore/decl.h"
@@ -168,6 +169,13 @@ class WASP_PUBLIC DDInterpreter : public Interpreter<S>
     const AbstractDefinition* definition() const;
     AbstractDefinition*       definition();
 
+    /**
+     * @brief reset discard the interpreted document, returning the definition
+     * scope to the root of the definition store
+     * The definition store is retained as the schema of subsequent documents.
+     */
+    void reset();
+
     AbstractDefinition::SP definition_store() { return m_definition; }
     void set_definition_store(AbstractDefinition::SP store)
     {
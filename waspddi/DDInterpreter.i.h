@@ -51,7 +51,7 @@ bool DDInterpreter<S>::parseStream(std::istream&      in,
 template<class S>
 bool DDInterpreter<S>::parseFile(const std::string& filename, size_t line)
 {
-    std::ifstream in(filename.c_str());
+    MappedFile in(filename);
     if (!in.good())
     {
         Interpreter<S>::error_diagnostic()
@@ -73,6 +73,14 @@ bool DDInterpreter<S>::parseString(const std::string& input,
     return parseStream(iss, sname, startLine, startColumn);
 }
 
+template<class S>
+void DDInterpreter<S>::reset()
+{
+    Interpreter<S>::reset();
+    // the scope of an interrupted parse must not carry over
+    m_current = m_definition.get();
+    definition();  // create an empty definition if none is stored
+}
 template<class S>
 const AbstractDefinition* DDInterpreter<S>::definition() const
 {
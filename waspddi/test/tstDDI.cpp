@@ -333,3 +333,30 @@ TEST(DDInterpreter, failing_decl_recovered)
     ASSERT_EQ("sect1.1", std::string(root.child_at(1).child_at(2).name()));
     ASSERT_EQ("sect2", std::string(root.child_at(2).name()));
 }
+
+/**
+ * @brief TEST ensures a reset interpreter reinterprets from the root of its
+ * definition store
+ */
+TEST(DDInterpreter, reset)
+{
+    std::stringstream    errors;
+    DefaultDDInterpreter ddi(errors);
+    ddi.definition()->create("sect1")->create("sect1.1");
+    auto store = ddi.definition_store();
+    {
+        std::stringstream input;
+        input << "sect1 1" << std::endl << "  sect1.1 2" << std::endl;
+        ASSERT_TRUE(ddi.parse(input));
+    }
+    std::size_t node_count = ddi.node_count();
+    ddi.reset();
+    ASSERT_EQ(store, ddi.definition_store());
+    ASSERT_EQ(store.get(), ddi.definition());
+    {
+        std::stringstream input;
+        input << "sect1 1" << std::endl << "  sect1.1 2" << std::endl;
+        ASSERT_TRUE(ddi.parse(input));
+    }
+    ASSERT_EQ(node_count, ddi.node_count());
+}
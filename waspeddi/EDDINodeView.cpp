@@ -144,6 +144,19 @@ std::string EDDINodeView::data() const
     return str.str();
 }
 
+StringView EDDINodeView::data_view() const
+{
+    wasp_insist(m_pool->is_leaf(m_node_index),
+                "only a leaf node's data can be viewed without a buffer!");
+    std::string unused;
+    return m_pool->data_view(m_node_index, unused);
+}
+
+StringView EDDINodeView::data_view(std::string& buffer) const
+{
+    return m_pool->data_view(m_node_index, buffer);
+}
+
 void EDDINodeView::set_data(const char* data)
 {
     NodeView view(node_index(), *node_pool());
@@ -203,6 +216,11 @@ const char* EDDINodeView::name() const
     return m_pool->name(m_node_index);
 }
 
+StringView EDDINodeView::name_view() const
+{
+    return m_pool->name_view(m_node_index);
+}
+
 std::size_t EDDINodeView::line() const
 {
     return m_pool->line(m_node_index);
@@ -247,6 +265,12 @@ std::string EDDINodeView::to_string(bool* ok) const
     return view.to_string(ok);
 }
 
+StringView EDDINodeView::to_string_view(std::string& buffer) const
+{
+    NodeView view(value_node_index(), *node_pool());
+    return view.to_string_view(buffer);
+}
+
 std::string EDDINodeView::last_as_string(bool* ok) const
 {
     return wasp::last_as_string(*this, ok);
@@ -18,6 +18,7 @@
 
 #include "waspeddi/EDDIParser.hpp"
 #include "waspcore/Interpreter.h"
+#include "waspcore/MappedFile.h"
 #include "waspcore/Definition.h"
 
 #include "waspcore/decl.h"
@@ -111,6 +112,12 @@ class WASP_PUBLIC EDDInterpreter : public Interpreter<S>
     EDDInterpreter* create_nested_interpreter(Super* parent);
 
     EDDInterpreter* document_parent() const {return m_parent;}
+    /**
+     * @brief concurrent_documents included documents continue the including
+     * document's definition scope and commit its stages, so they must be
+     * interpreted at the point of inclusion
+     */
+    bool concurrent_documents() const { return false; }
 
     /** Invoke the lexer and parser for a stream.
      * @param in        input stream
@@ -207,6 +214,13 @@ class WASP_PUBLIC EDDInterpreter : public Interpreter<S>
         m_current = current;
     }
 
+    /**
+     * @brief reset discard the interpreted document, returning the definition
+     * scope to the root of the definition store
+     * The definition store is retained as the schema of subsequent documents.
+     */
+    void reset();
+
     AbstractDefinition::SP definition_store() { return m_definition; }
     void set_definition_store(AbstractDefinition::SP store)
     {
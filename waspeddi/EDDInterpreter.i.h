@@ -75,7 +75,7 @@ bool EDDInterpreter<S>::parseStream(std::istream&      in,
 template<class S>
 bool EDDInterpreter<S>::parseFile(const std::string& filename, size_t line)
 {
-    std::ifstream in(filename.c_str());
+    MappedFile in(filename);
     if (!in.good())
     {
         Interpreter<S>::error_diagnostic() << position(&filename)
@@ -96,6 +96,14 @@ bool EDDInterpreter<S>::parseString(const std::string& input,
     return parseStream(iss, sname, startLine, startColumn);
 }
 
+template<class S>
+void EDDInterpreter<S>::reset()
+{
+    Interpreter<S>::reset();
+    // the scope of an interrupted parse must not carry over
+    m_current = m_definition.get();
+    definition();  // create an empty definition if none is stored
+}
 template<class S>
 const AbstractDefinition* EDDInterpreter<S>::definition() const
 {
@@ -757,7 +757,7 @@ namespace wasp {
 #line 167 "Expr.bison"
     {
         size_t node_index = ((yystack_[0].value.node_index));
-        (yylhs.value.node_indices) = new std::vector<size_t>();
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices();
         (yylhs.value.node_indices)->push_back(node_index);
     }
 #line 764 "ExprParser.cpp"
@@ -768,7 +768,7 @@ namespace wasp {
     {
         if( (yystack_[2].value.node_indices) == nullptr )
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
         }
         (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
         (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
@@ -797,7 +797,7 @@ namespace wasp {
             {
                 child_indices.push_back((yystack_[1].value.node_indices)->at(i));
             }
-            delete (yystack_[1].value.node_indices);
+            interpreter.release_child_indices((yystack_[1].value.node_indices));
         }
         child_indices.push_back(right_index);
         const std::string & name = interpreter.data(name_index);
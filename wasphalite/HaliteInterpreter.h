@@ -11,6 +11,7 @@
 #include <iostream>
 
 #include "waspcore/Interpreter.h"
+#include "waspcore/MappedFile.h"
 #include "wasphalite/SubStringIndexer.h"
 #include "waspexpr/ExprInterpreter.h"
 #include "waspjson/JSONObjectParser.hpp"
@@ -148,6 +149,12 @@ class WASP_PUBLIC HaliteInterpreter : public Interpreter<S>
      */
     bool parseFile(const std::string& filename, size_t startLine = 1u);
 
+    /**
+     * @brief reset discard the interpreted template, retaining the attribute
+     * delimiters
+     */
+    void reset();
+
     /**
      * @brief evaluate evaluates the template emitting the expansion into out
      * stream
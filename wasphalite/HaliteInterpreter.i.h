@@ -61,7 +61,7 @@ bool HaliteInterpreter<S>::parseStream(std::istream&      in,
 template<class S>
 bool HaliteInterpreter<S>::parseFile(const std::string& filename, size_t line)
 {
-    std::ifstream in(filename.c_str());
+    MappedFile in(filename);
     if (!in.good())
     {
         Interpreter<S>::error_diagnostic() << position(&filename)
@@ -73,6 +73,13 @@ bool HaliteInterpreter<S>::parseFile(const std::string& filename, size_t line)
     return parseStream(in, filename, line);
 }
 template<class S>
+void HaliteInterpreter<S>::reset()
+{
+    Interpreter<S>::reset();
+    m_file_offset = 0;
+    m_has_file    = false;
+}
+template<class S>
 bool HaliteInterpreter<S>::parseString(const std::string& input,
                                        const std::string& sname,
                                        size_t             startLine,
@@ -121,6 +121,19 @@ std::string HaliteNodeView::data() const
     return str.str();
 }
 
+StringView HaliteNodeView::data_view() const
+{
+    wasp_insist(m_pool->is_leaf(m_node_index),
+                "only a leaf node's data can be viewed without a buffer!");
+    std::string unused;
+    return m_pool->data_view(m_node_index, unused);
+}
+
+StringView HaliteNodeView::data_view(std::string& buffer) const
+{
+    return m_pool->data_view(m_node_index, buffer);
+}
+
 void HaliteNodeView::set_data(const char* data)
 {
     NodeView view(node_index(), *node_pool());
@@ -212,6 +225,11 @@ const char* HaliteNodeView::name() const
     return m_pool->name(m_node_index);
 }
 
+StringView HaliteNodeView::name_view() const
+{
+    return m_pool->name_view(m_node_index);
+}
+
 std::size_t HaliteNodeView::line() const
 {
     return m_pool->line(m_node_index);
@@ -256,6 +274,12 @@ std::string HaliteNodeView::to_string(bool* ok) const
     return view.to_string(ok);
 }
 
+StringView HaliteNodeView::to_string_view(std::string& buffer) const
+{
+    NodeView view(value_node_index(), *node_pool());
+    return view.to_string_view(buffer);
+}
+
 std::string HaliteNodeView::last_as_string(bool* ok) const
 {
     return wasp::last_as_string(*this, ok);
@@ -54,6 +54,19 @@ class WASP_PUBLIC HaliteNodeView
      * @return the node's data
      */
     std::string data() const;
+    /**
+     * @brief data_view acquire a view of the leaf node's data without
+     * copying it
+     * Throws if this is a parent node, whose data is formatted; use
+     * data_view(buffer) for any node.
+     */
+    StringView data_view() const;
+    /**
+     * @brief data_view acquire a view of the node's data
+     * @param buffer storage for a parent node's formatted data, reusable
+     * across calls
+     */
+    StringView data_view(std::string& buffer) const;
 
     /**
      * @brief Set the data of this node - this is only legal for LEAF nodes
@@ -209,6 +222,10 @@ class WASP_PUBLIC HaliteNodeView
      * @return the node's name
      */
     const char* name() const;
+    /**
+     * @brief name_view acquire a view of the node's name without copying it
+     */
+    StringView name_view() const;
 
     /**
      * @brief line acquire the node's starting line
@@ -270,6 +287,13 @@ class WASP_PUBLIC HaliteNodeView
      * front and back).
      */
     std::string to_string(bool* ok = nullptr) const;
+    /**
+     * @brief to_string_view acquire a view of the data as to_string would
+     * produce it, without copying a leaf's data
+     * @param buffer storage for data that is not viewed in place, reusable
+     * across calls
+     */
+    StringView to_string_view(std::string& buffer) const;
 
     /**
      * @brief last_as_string acquires this node or last child's node as string
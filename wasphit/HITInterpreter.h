@@ -2,6 +2,7 @@
 #define WASP_HITINTERPRETER_H
 #include "waspcore/TreeNodePool.h"
 #include "waspcore/Interpreter.h"
+#include "waspcore/MappedFile.h"
 
 #include <cstdint>
 #include <string>
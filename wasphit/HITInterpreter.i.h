@@ -42,7 +42,7 @@ bool HITInterpreter<S>::parse(std::istream& in,
 template<class S>
 bool HITInterpreter<S>::parseFile(const std::string& filename, size_t line)
 {
-    std::ifstream in(filename.c_str());
+    MappedFile in(filename);
     if (!in.good())
     {
         Interpreter<S>::error_diagnostic()
@@ -114,6 +114,44 @@ std::string HITNodeView::data() const
     return str.str();
 }
 
+StringView HITNodeView::data_view() const
+{
+    wasp_insist(m_pool->is_leaf(m_node_index),
+                "only a leaf node's data can be viewed without a buffer!");
+    std::string unused;
+    return m_pool->data_view(m_node_index, unused);
+}
+
+StringView HITNodeView::data_view(std::string& buffer) const
+{
+    return m_pool->data_view(m_node_index, buffer);
+}
+
+std::uint64_t HITNodeView::subtree_hash() const
+{
+    return m_pool->subtree_hash(m_node_index);
+}
+
+size_t HITNodeView::packed_size() const
+{
+    return m_pool->packed_size(m_node_index);
+}
+
+Span<const std::int64_t> HITNodeView::packed_integers() const
+{
+    return m_pool->packed_integers(m_node_index);
+}
+
+Span<const double> HITNodeView::packed_reals() const
+{
+    return m_pool->packed_reals(m_node_index);
+}
+
+std::string HITNodeView::packed_data(size_t element) const
+{
+    return m_pool->packed_data(m_node_index, element);
+}
+
 void HITNodeView::set_data(const char* data)
 {
     NodeView view(node_index(), *node_pool());
@@ -176,6 +214,11 @@ const char* HITNodeView::name() const
     return m_pool->name(m_node_index);
 }
 
+StringView HITNodeView::name_view() const
+{
+    return m_pool->name_view(m_node_index);
+}
+
 std::size_t HITNodeView::line() const
 {
     return m_pool->line(m_node_index);
@@ -220,6 +263,12 @@ std::string HITNodeView::to_string(bool* ok) const
     return view.to_string(ok);
 }
 
+StringView HITNodeView::to_string_view(std::string& buffer) const
+{
+    NodeView view(value_node_index(), *node_pool());
+    return view.to_string_view(buffer);
+}
+
 std::string HITNodeView::last_as_string(bool* ok) const
 {
     return wasp::last_as_string(*this, ok);
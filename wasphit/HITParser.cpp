@@ -528,31 +528,31 @@ namespace wasp {
     {
       case symbol_kind::S_object_decl: // object_decl
 #line 114 "HIT.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 533 "HITParser.cpp"
         break;
 
       case symbol_kind::S_object_members: // object_members
 #line 116 "HIT.bison"
-                    { delete (yysym.value.object_children)->second; delete (yysym.value.object_children); }
+                    { interpreter.release_child_indices((yysym.value.object_children)->second); delete (yysym.value.object_children); }
 #line 539 "HITParser.cpp"
         break;
 
       case symbol_kind::S_double_quoted_strings: // double_quoted_strings
 #line 115 "HIT.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 545 "HITParser.cpp"
         break;
 
       case symbol_kind::S_array_members: // array_members
 #line 115 "HIT.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 551 "HITParser.cpp"
         break;
 
       case symbol_kind::S_array: // array
 #line 115 "HIT.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 557 "HITParser.cpp"
         break;
 
@@ -920,9 +920,9 @@ namespace wasp {
         size_t lbracket_index = ((yystack_[2].value.node_index));
         size_t decl_index = ((yystack_[1].value.node_index));
         size_t rbracket_index = ((yystack_[0].value.node_index));
-        (yylhs.value.node_indices) = new std::vector<size_t>{lbracket_index
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices({lbracket_index
                                                    ,decl_index
-                                                   ,rbracket_index};
+                                                   ,rbracket_index});
     }
 #line 928 "HITParser.cpp"
     break;
@@ -932,7 +932,7 @@ namespace wasp {
                                 {
         size_t lbracket_index = ((yystack_[2].value.node_index));
         size_t decl_index = ((yystack_[1].value.node_index));
-        (yylhs.value.node_indices) = new std::vector<size_t>{lbracket_index,decl_index};
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices({lbracket_index,decl_index});
         interpreter.set_failed(true);
         interpreter.error_diagnostic() << yystack_[0].location.begin << ": syntax error, unexpected end of line, expecting ]" << std::endl;
     }
@@ -951,7 +951,7 @@ namespace wasp {
         interpreter.push_token("", wasp::UNKNOWN, byte_offset);
         size_t decl_index = interpreter.push_leaf(wasp::DECL, "decl", decl_token_index);
 
-        (yylhs.value.node_indices) = new std::vector<size_t>{lbracket_index,decl_index};
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices({lbracket_index,decl_index});
         interpreter.set_failed(true);
         interpreter.error_diagnostic() << yystack_[0].location.begin << ": syntax error, unexpected end of line, expecting object name" << std::endl;
     }
@@ -970,7 +970,7 @@ namespace wasp {
         interpreter.push_token("", wasp::UNKNOWN, byte_offset);
         size_t decl_index = interpreter.push_leaf(wasp::DECL, "decl", decl_token_index);
 
-        (yylhs.value.node_indices) = new std::vector<size_t>{lbracket_index,decl_index};
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices({lbracket_index,decl_index});
         interpreter.set_failed(true);
         interpreter.error_diagnostic() << yystack_[0].location.begin << ": syntax error, unexpected end of file, expecting object name" << std::endl;
     }
@@ -982,7 +982,7 @@ namespace wasp {
                                 {
         size_t lbracket_index = ((yystack_[2].value.node_index));
         size_t decl_index = ((yystack_[1].value.node_index));
-        (yylhs.value.node_indices) = new std::vector<size_t>{lbracket_index,decl_index};
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices({lbracket_index,decl_index});
         interpreter.set_failed(true);
         interpreter.error_diagnostic() << yystack_[0].location.begin << ": syntax error, unexpected end of file, expecting ]" << std::endl;
     }
@@ -994,7 +994,7 @@ namespace wasp {
                                     {
         size_t lbracket_index = ((yystack_[2].value.node_index));
         size_t decl_index = ((yystack_[1].value.node_index));
-        (yylhs.value.node_indices) = new std::vector<size_t>{lbracket_index,decl_index};
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices({lbracket_index,decl_index});
         interpreter.set_failed(true);
         interpreter.error_diagnostic() << yystack_[0].location.begin << ": syntax error, unexpected invalid token, expecting ]" << std::endl;
     }
@@ -1007,7 +1007,7 @@ namespace wasp {
         size_t lbracket_index = ((yystack_[3].value.node_index));
         size_t decl_index = ((yystack_[2].value.node_index));
         size_t rbracket_index = ((yystack_[0].value.node_index));
-        (yylhs.value.node_indices) = new std::vector<size_t>{lbracket_index, decl_index, rbracket_index};
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices({lbracket_index, decl_index, rbracket_index});
         interpreter.set_failed(true);
         interpreter.error_diagnostic() << yystack_[1].location.begin << ": syntax error, unexpected invalid token, expecting ]" << std::endl;
     }
@@ -1023,10 +1023,10 @@ namespace wasp {
         size_t rbracket_index = ((yystack_[0].value.node_index));
 
 
-        (yylhs.value.node_indices) = new std::vector<size_t>{lbracket_index
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices({lbracket_index
                 ,dot_slash_index
                 ,decl_index
-                ,rbracket_index};
+                ,rbracket_index});
     }
 #line 1032 "HITParser.cpp"
     break;
@@ -1059,7 +1059,7 @@ namespace wasp {
 #line 422 "HIT.bison"
     {
         size_t node_index = ((yystack_[0].value.node_index));
-        auto indices = new std::vector<size_t>();
+        auto indices = interpreter.acquire_child_indices();
         indices->push_back(node_index);
         if( std::strcmp("type",interpreter.name(node_index)) == 0 )
         {
@@ -1108,7 +1108,7 @@ namespace wasp {
 #line 460 "HIT.bison"
         { // empty object
             (yylhs.value.node_index) = push_object(interpreter, *(yystack_[1].value.node_indices), nullptr, (yystack_[0].value.node_index));
-            delete (yystack_[1].value.node_indices);
+            interpreter.release_child_indices((yystack_[1].value.node_indices));
         }
 #line 1114 "HITParser.cpp"
     break;
@@ -1117,7 +1117,7 @@ namespace wasp {
 #line 465 "HIT.bison"
         {
             (yylhs.value.node_index) = push_object(interpreter, *(yystack_[1].value.node_indices), nullptr, 0);
-            delete (yystack_[1].value.node_indices);
+            interpreter.release_child_indices((yystack_[1].value.node_indices));
             
             if (!interpreter.failed()) interpreter.error_diagnostic() << yystack_[0].location.begin << ": syntax error, unexpected end of file" << std::endl;
             interpreter.set_failed(true);
@@ -1129,7 +1129,7 @@ namespace wasp {
 #line 473 "HIT.bison"
         {
             (yylhs.value.node_index) = push_object(interpreter, *(yystack_[3].value.node_indices), (yystack_[1].value.object_children), (yystack_[0].value.node_index));
-            delete (yystack_[3].value.node_indices);
+            interpreter.release_child_indices((yystack_[3].value.node_indices));
             interpreter.set_failed(true);
         }
 #line 1136 "HITParser.cpp"
@@ -1139,8 +1139,8 @@ namespace wasp {
 #line 479 "HIT.bison"
         {
             (yylhs.value.node_index) = push_object(interpreter, *(yystack_[2].value.node_indices), (yystack_[1].value.object_children), (yystack_[0].value.node_index));
-            delete (yystack_[2].value.node_indices);
-            delete (yystack_[1].value.object_children)->second;
+            interpreter.release_child_indices((yystack_[2].value.node_indices));
+            interpreter.release_child_indices((yystack_[1].value.object_children)->second);
             delete (yystack_[1].value.object_children);
         }
 #line 1147 "HITParser.cpp"
@@ -1150,8 +1150,8 @@ namespace wasp {
 #line 486 "HIT.bison"
         {
             (yylhs.value.node_index) = push_object(interpreter, *(yystack_[2].value.node_indices), (yystack_[1].value.object_children), 0);
-            delete (yystack_[2].value.node_indices);
-            delete (yystack_[1].value.object_children)->second;
+            interpreter.release_child_indices((yystack_[2].value.node_indices));
+            interpreter.release_child_indices((yystack_[1].value.object_children)->second);
             delete (yystack_[1].value.object_children);
             interpreter.set_failed(true);
             interpreter.error_diagnostic() << yystack_[2].location.begin << ": syntax error, unexpected end of file, expecting block terminator" << std::endl;
@@ -1172,7 +1172,7 @@ namespace wasp {
 #line 500 "HIT.bison"
     {
         size_t qstring_index = ((yystack_[0].value.node_index));
-        (yylhs.value.node_indices) = new std::vector<size_t>();
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices();
         (yylhs.value.node_indices)->push_back(qstring_index);
     }
 #line 1179 "HITParser.cpp"
@@ -1326,7 +1326,7 @@ namespace wasp {
 #line 571 "HIT.bison"
     {
         size_t offset = ((yystack_[0].value.node_index));
-        (yylhs.value.node_indices) = new std::vector<size_t>();
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices();
         (yylhs.value.node_indices)->push_back(offset);
     }
 #line 1333 "HITParser.cpp"
@@ -1354,7 +1354,7 @@ namespace wasp {
   case 52: // array: quote quote
 #line 588 "HIT.bison"
     {
-        (yylhs.value.node_indices) = new std::vector<size_t>();
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices();
         (yylhs.value.node_indices)->push_back(((yystack_[1].value.node_index)));
         (yylhs.value.node_indices)->push_back(((yystack_[0].value.node_index)));
     }
@@ -1366,7 +1366,7 @@ namespace wasp {
     {
         (yylhs.value.node_indices) = (yystack_[1].value.node_indices);
         (yylhs.value.node_indices)->insert((yylhs.value.node_indices)->end(), (yystack_[0].value.node_indices)->begin(), (yystack_[0].value.node_indices)->end());
-        delete (yystack_[0].value.node_indices);
+        interpreter.release_child_indices((yystack_[0].value.node_indices));
     }
 #line 1372 "HITParser.cpp"
     break;
@@ -1393,7 +1393,7 @@ namespace wasp {
 
         std::vector<size_t> child_indices = {key_index, assign_index};
         for( size_t child_i : *(yystack_[0].value.node_indices) ) child_indices.push_back(child_i);
-        delete (yystack_[0].value.node_indices);
+        interpreter.release_child_indices((yystack_[0].value.node_indices));
 
         (yylhs.value.node_index) = push_keyed_value_or_array(interpreter, child_indices);
     }
@@ -1409,7 +1409,7 @@ namespace wasp {
 
         std::vector<size_t> child_indices = {key_index, assign_index};
         for( size_t child_i : *(yystack_[0].value.node_indices) ) child_indices.push_back(child_i);
-        delete (yystack_[0].value.node_indices);
+        interpreter.release_child_indices((yystack_[0].value.node_indices));
 
         (yylhs.value.node_index) = push_keyed_value_or_array(interpreter, child_indices);
     }
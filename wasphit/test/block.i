@@ -0,0 +1,3 @@
+[block] 
+  key = 3
+[]
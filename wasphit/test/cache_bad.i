@@ -0,0 +1 @@
+[bad
@@ -0,0 +1 @@
+leaf = 22
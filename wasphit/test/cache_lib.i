@@ -0,0 +1,3 @@
+[lib]
+  !include cache_leaf.i
+[]
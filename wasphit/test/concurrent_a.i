@@ -0,0 +1,3 @@
+[a]
+  !include concurrent_c.i
+[]
@@ -0,0 +1,4 @@
+
+[Block02]
+  !include input02.i
+[]
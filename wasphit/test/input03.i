@@ -0,0 +1,4 @@
+
+[Block03]
+  !include input02.i
+[]
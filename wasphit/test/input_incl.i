@@ -0,0 +1,3 @@
+
+# if is_nested_file() is not checked in findChild the '=' below is returned
+param_02 = 20
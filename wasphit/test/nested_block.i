@@ -0,0 +1,3 @@
+[nested_block] 
+  key = 3
+[]
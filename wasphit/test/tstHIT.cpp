@@ -1,5 +1,6 @@
 #include "wasphit/HITInterpreter.h"
 #include "wasphit/HITNodeView.h"
+#include "waspcore/Diff.h"
 #include "waspcore/utils.h"
 #include "gtest/gtest.h"
 #include <iostream>
@@ -3092,6 +3093,157 @@ TEST(HITInterpreter, file_include_circular_loop)
     ASSERT_EQ(expected_paths, actual_paths.str());
 }
 
+/**
+ * @brief Test included documents interpreted concurrently are attached and
+ * report diagnostics in the order of inclusion
+ */
+TEST(HITInterpreter, file_include_concurrent)
+{
+    {
+        std::ofstream incl_a("concurrent_a.i");
+        incl_a << "[a]" << std::endl
+               << "  !include concurrent_c.i" << std::endl
+               << "[]" << std::endl;
+        std::ofstream incl_b("concurrent_b.i");
+        incl_b << "[b" << std::endl << "[]" << std::endl;
+        std::ofstream incl_c("concurrent_c.i");
+        incl_c << "c = 1" << std::endl << "[c" << std::endl;
+    }
+    std::string input = R"INPUT([first]
+  !include concurrent_a.i
+[]
+[second
+[]
+!include concurrent_b.i
+!include concurrent_missing.i
+!include concurrent_a.i
+[last
+)INPUT";
+
+    std::stringstream serial_errors;
+    DefaultHITInterpreter serial(serial_errors);
+    serial.set_document_threads(1);
+    std::stringstream serial_input(input);
+    ASSERT_FALSE(serial.parse(serial_input));
+
+    std::stringstream expected_errors;
+    expected_errors
+        << "./concurrent_c.i:3.1: syntax error, unexpected end of line, expecting ]" << std::endl
+        << "stream input:5.1: syntax error, unexpected end of line, expecting ]" << std::endl
+        << "./concurrent_b.i:2.1: syntax error, unexpected end of line, expecting ]" << std::endl
+        << "stream input:7.1: could not find 'concurrent_missing.i'" << std::endl
+        << "./concurrent_c.i:3.1: syntax error, unexpected end of line, expecting ]" << std::endl
+        << "stream input:10.1: syntax error, unexpected end of line, expecting ]" << std::endl;
+    ASSERT_EQ(expected_errors.str(), serial_errors.str());
+    ASSERT_DIAGNOSTICS(serial, expected_errors);
+
+    for (size_t threads : {2, 4, 8})
+    {
+        SCOPED_TRACE(threads);
+        std::stringstream errors;
+        DefaultHITInterpreter interpreter(errors);
+        interpreter.set_document_threads(threads);
+        std::stringstream concurrent_input(input);
+        ASSERT_FALSE(interpreter.parse(concurrent_input));
+        ASSERT_EQ(expected_errors.str(), errors.str());
+        ASSERT_DIAGNOSTICS(interpreter, expected_errors);
+        ASSERT_EQ(serial.document_count(), interpreter.document_count());
+
+        std::stringstream expected_xml, actual_xml;
+        wasp::to_xml(HITNodeView(serial.root()), expected_xml);
+        wasp::to_xml(HITNodeView(interpreter.root()), actual_xml);
+        ASSERT_EQ(expected_xml.str(), actual_xml.str());
+    }
+}
+
+/**
+ * @brief Test included documents are shared through the DocumentCache
+ */
+TEST(HITInterpreter, file_include_cache)
+{
+    {
+        std::ofstream lib("cache_lib.i");
+        lib << "[lib]" << std::endl
+            << "  !include cache_leaf.i" << std::endl
+            << "[]" << std::endl;
+        std::ofstream leaf("cache_leaf.i");
+        leaf << "leaf = 1" << std::endl;
+        std::ofstream bad("cache_bad.i");
+        bad << "[bad" << std::endl;
+    }
+    std::string input = R"INPUT([first]
+  !include cache_lib.i
+[]
+!include cache_bad.i
+)INPUT";
+    std::stringstream expected_errors;
+    expected_errors << "./cache_bad.i:2.1: syntax error, unexpected end of "
+                       "line, expecting ]"
+                    << std::endl;
+
+    auto& cache = DocumentCache::instance();
+    cache.clear();
+    cache.set_capacity(1 << 20);
+
+    std::string expected_xml;
+    for (int i = 0; i < 3; ++i)
+    {
+        SCOPED_TRACE(i);
+        std::stringstream     errors;
+        DefaultHITInterpreter interpreter(errors);
+        std::stringstream     input_stream(input);
+        ASSERT_FALSE(interpreter.parse(input_stream));
+        // diagnostics of documents that are not cached are reported by each
+        ASSERT_EQ(expected_errors.str(), errors.str());
+        ASSERT_EQ(2, interpreter.document_count());
+
+        auto leaf = HITNodeView(interpreter.root())
+                        .first_child_by_name("first")
+                        .first_child_by_name("lib")
+                        .first_child_by_name("leaf");
+        ASSERT_FALSE(leaf.is_null());
+        ASSERT_EQ("1", leaf.last_as_string());
+        ASSERT_EQ("./cache_leaf.i", leaf.node_pool()->stream_name());
+
+        std::stringstream xml;
+        wasp::to_xml(HITNodeView(interpreter.root()), xml);
+        if (i == 0) expected_xml = xml.str();
+        ASSERT_EQ(expected_xml, xml.str());
+    }
+    // the library and its nested document are interpreted once
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ(2, cache.hits());
+    ASSERT_EQ(2 + 3, cache.misses());
+
+    // changing the nested document invalidates the library
+    {
+        std::ofstream leaf("cache_leaf.i");
+        leaf << "leaf = 22" << std::endl;
+    }
+    std::stringstream     errors;
+    DefaultHITInterpreter interpreter(errors);
+    std::stringstream     input_stream(input);
+    ASSERT_FALSE(interpreter.parse(input_stream));
+    ASSERT_EQ("22", HITNodeView(interpreter.root())
+                        .first_child_by_name("first")
+                        .first_child_by_name("lib")
+                        .first_child_by_name("leaf")
+                        .last_as_string());
+    ASSERT_EQ(2, cache.hits());
+
+    // documents interpreted with other modes are not shared
+    std::stringstream     indexed_errors;
+    DefaultHITInterpreter indexed(indexed_errors);
+    indexed.enable_line_index();
+    std::stringstream indexed_input(input);
+    ASSERT_FALSE(indexed.parse(indexed_input));
+    ASSERT_EQ(2, cache.hits());
+    ASSERT_EQ(4, cache.size());
+
+    cache.clear();
+    cache.set_capacity(0);
+}
+
 /**
  * @brief Test HIT syntax error - file include self creates circular reference
  */
@@ -5837,3 +5989,205 @@ TEST(HITInterpreter, override_assigns)
     ASSERT_EQ(expect_paths_and_types, "\n" + actual_paths_and_types.str());
     ASSERT_EQ(input_stream.str(), "\n" + interpreter.root().data() + "\n");
 }
+
+TEST(HITInterpreter, diff)
+{
+    std::stringstream original_input, revised_input;
+    original_input << R"INPUT(
+[Mesh]
+  dim = 2
+[]
+[Kernels]
+  [diff]
+    type = Diffusion
+  []
+[]
+)INPUT";
+    // blocks are reordered, appended to, and retyped, which renames them
+    // when type promotion is enabled
+    revised_input << R"INPUT(
+[Kernels]
+  [diff]
+    type = Reaction
+  []
+  [rx]
+  []
+[]
+[Mesh]
+  dim = 2
+[]
+)INPUT";
+    DefaultHITInterpreter original, revised;
+    ASSERT_TRUE(original.parse(original_input));
+    ASSERT_TRUE(revised.parse(revised_input));
+
+    // blocks are matched by their declarators, not their names
+    std::vector<wasp::DiffEdit> edits =
+        wasp::diff(HITNodeView(original.root()), HITNodeView(revised.root()));
+    ASSERT_EQ(2, edits.size());
+    ASSERT_EQ(wasp::DiffEdit::UPDATED, edits[0].type);
+#if DISABLE_HIT_TYPE_PROMOTION
+    ASSERT_EQ("/Kernels/diff/type/value", edits[0].path);
+#else
+    ASSERT_EQ("/Kernels/Reaction_type/type/value", edits[0].path);
+#endif
+    ASSERT_EQ("Diffusion", edits[0].a_data);
+    ASSERT_EQ("Reaction", edits[0].b_data);
+    ASSERT_EQ(7, edits[0].a_line);
+    ASSERT_EQ(4, edits[0].b_line);
+    ASSERT_EQ(wasp::DiffEdit::INSERTED, edits[1].type);
+    ASSERT_EQ("/Kernels/rx", edits[1].path);
+    ASSERT_EQ(6, edits[1].b_line);
+}
+
+/**
+ * @brief Test packed arrays are accessible through the HIT node view
+ */
+TEST(HITInterpreter, pack_arrays)
+{
+    std::stringstream input;
+    input << "[block]" << std::endl
+          << "  x = '1 2 -3" << std::endl
+          << "       4'" << std::endl
+          << "  y = '1 2.5 1e2'" << std::endl
+          << "  z = '1 a 3'" << std::endl
+          << "[]" << std::endl;
+    DefaultHITInterpreter interpreter;
+    ASSERT_TRUE(interpreter.parse(input));
+    std::size_t node_count = interpreter.node_count();
+    interpreter.pack_arrays(3);
+    // the elements of x and y are no longer nodes
+    ASSERT_EQ(node_count - 7, interpreter.node_count());
+
+    HITNodeView block =
+        HITNodeView(interpreter.root()).first_child_by_name("block");
+    HITNodeView x = block.first_child_by_name("x");
+    ASSERT_EQ(4, x.packed_size());
+    auto integers = x.packed_integers();
+    ASSERT_EQ(4, integers.size());
+    ASSERT_EQ(-3, integers[2]);
+    ASSERT_TRUE(x.packed_reals().empty());
+    ASSERT_EQ("4", x.packed_data(3));
+
+    HITNodeView y = block.first_child_by_name("y");
+    ASSERT_EQ(3, y.packed_size());
+    ASSERT_EQ(2.5, y.packed_reals()[1]);
+    ASSERT_EQ(100.0, y.packed_reals()[2]);
+    ASSERT_TRUE(y.packed_integers().empty());
+
+    // non-numeric arrays are retained as nodes
+    HITNodeView z = block.first_child_by_name("z");
+    ASSERT_EQ(0, z.packed_size());
+    ASSERT_TRUE(z.packed_integers().empty());
+    ASSERT_TRUE(z.packed_reals().empty());
+}
+
+namespace
+{
+// record a streamed document's events, one per line
+class EventRecorder : public StreamHandler
+{
+  public:
+    EventRecorder(const DefaultHITInterpreter& interpreter)
+        : interpreter(interpreter)
+        , max_node_count(0)
+        , max_token_count(0)
+        , max_line_count(0)
+    {
+    }
+    void start_object(std::size_t type,
+                      StringView  name,
+                      std::size_t line,
+                      std::size_t column)
+    {
+        record() << "{" << type << " " << name << " " << line << ":" << column;
+    }
+    void key(StringView name, std::size_t line, std::size_t column)
+    {
+        record() << "key " << name << " " << line << ":" << column;
+    }
+    void value(StringView data, std::size_t line, std::size_t column)
+    {
+        record() << "value " << data << " " << line << ":" << column;
+    }
+    void end_object(std::size_t type,
+                    StringView  name,
+                    std::size_t line,
+                    std::size_t column)
+    {
+        record() << "}" << type << " " << name << " " << line << ":" << column;
+    }
+    std::ostream& record()
+    {
+        max_node_count = std::max(max_node_count, interpreter.node_count());
+        max_token_count =
+            std::max(max_token_count, interpreter.retained_token_count());
+        max_line_count =
+            std::max(max_line_count, interpreter.retained_line_count());
+        if (events.tellp() > 0)
+            events << std::endl;
+        return events;
+    }
+    const DefaultHITInterpreter& interpreter;
+    std::size_t                  max_node_count;
+    std::size_t                  max_token_count;
+    std::size_t                  max_line_count;
+    std::stringstream            events;
+};
+}  // namespace
+
+TEST(HITInterpreter, stream)
+{
+    std::stringstream input;
+    input << "a = 1 # comment" << std::endl
+          << "[blk]" << std::endl
+          << "  b = 'x y'" << std::endl
+          << "  [./sub] c = 2 [../]" << std::endl
+          << "[]" << std::endl
+          << "d = 3";
+    DefaultHITInterpreter interpreter;
+    EventRecorder         recorder(interpreter);
+    interpreter.set_stream_handler(&recorder);
+    ASSERT_TRUE(interpreter.parse(input));
+    std::stringstream expected;
+    expected << "key a 1:1" << std::endl
+             << "value 1 1:5" << std::endl
+             << "{" << std::size_t(wasp::OBJECT) << " blk 2:1" << std::endl
+             << "{" << std::size_t(wasp::ARRAY) << " b 3:3" << std::endl
+             << "value x 3:8" << std::endl
+             << "value y 3:10" << std::endl
+             << "}" << std::size_t(wasp::ARRAY) << " b 3:11" << std::endl
+             << "{" << std::size_t(wasp::OBJECT) << " sub 4:3" << std::endl
+             << "key c 4:11" << std::endl
+             << "value 2 4:15" << std::endl
+             << "}" << std::size_t(wasp::OBJECT) << " sub 4:21" << std::endl
+             << "}" << std::size_t(wasp::OBJECT) << " blk 5:2" << std::endl
+             << "key d 6:1" << std::endl
+             << "value 3 6:5";
+    ASSERT_EQ(expected.str(), recorder.events.str());
+    // streamed nodes and their tokens are discarded
+    ASSERT_EQ(0, interpreter.node_count());
+    ASSERT_TRUE(interpreter.root().is_null());
+    ASSERT_EQ(0, interpreter.retained_token_count());
+
+    // the document, its tokens, and its lines are held a statement at a time
+    interpreter.reset();
+    std::stringstream long_input;
+    for (int i = 0; i < 1000; ++i)
+    {
+        long_input << "k" << i << " = " << i << std::endl;
+    }
+    EventRecorder long_recorder(interpreter);
+    interpreter.set_stream_handler(&long_recorder);
+    ASSERT_TRUE(interpreter.parse(long_input));
+    ASSERT_EQ(0, interpreter.node_count());
+    ASSERT_GE(4, long_recorder.max_node_count);
+    ASSERT_GE(4, long_recorder.max_token_count);
+    ASSERT_GE(4, long_recorder.max_line_count);
+    ASSERT_EQ(3000, interpreter.token_count());
+    ASSERT_EQ(1000, interpreter.line_count());
+    ASSERT_GE(4, interpreter.retained_line_count());
+    // lines are numbered as before their predecessors were discarded
+    ASSERT_NE(std::string::npos,
+              long_recorder.events.str().find("value 999 1000:8"));
+}
@@ -17,17 +17,38 @@ static const std::atomic<bool> GLOBAL_STOP(false);
 
 namespace wasp
 {
-HIVE::HIVE() : stop(GLOBAL_STOP)
+HIVE::HIVE()
+    : m_query_cache(&DefaultSIRENQueryCache::global()), stop(GLOBAL_STOP)
 {
 }
 
-HIVE::HIVE(const std::atomic<bool>& stop) : stop(stop)
+HIVE::HIVE(const std::atomic<bool>& stop)
+    : m_query_cache(&DefaultSIRENQueryCache::global()), stop(stop)
 {
 }
 
 HIVE::~HIVE()
 {
 }
+bool HIVE::compile_query(DefaultSIRENQueryCache::Query& query,
+                         const std::string&             statement,
+                         std::ostream&                  err) const
+{
+    if (m_query_cache != nullptr)
+    {
+        query = m_query_cache->compile(statement, err);
+        return query != nullptr;
+    }
+    auto selector = std::make_shared<DefaultSIRENInterpreter>(err);
+    if (!selector->parseString(statement))
+    {
+        query.reset();
+        return false;
+    }
+    query = selector;
+    return true;
+}
+
 void HIVE::sort_errors(std::vector<string>& errors)
 {
     std::sort(errors.begin(), errors.end(), alphanum_less<std::string>());
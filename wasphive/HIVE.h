@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 #include "waspsiren/SIRENInterpreter.h"
+#include "waspsiren/SIRENQueryCache.h"
 #include "waspsiren/SIRENResultSet.h"
 #include "waspcore/decl.h"
 #include "waspcore/wasp_bug.h"
@@ -68,6 +69,13 @@ namespace wasp
  * size_t TAdapter::non_decorative_children_count()const - acquires the count of
  * the non decorative children
  * bool TAdapter::is_decorative()const - determine if the node is decorative
+ * ==== Optional TAdapter API ====
+ * Where present, these avoid copying a leaf's data, otherwise data() and
+ * to_string() are used.
+ * StringView data_view(std::string& buffer)const - a view of the raw data of
+ * the node, formatted into the buffer for parent nodes
+ * StringView to_string_view(std::string& buffer)const - a view of the node's
+ * data as a quoteless string
  * ==== Required SchemaAdapter API ====
  *  !! All the above and the following !!
  * std::string TAdapter::id()const - acquire the id as a quoteless string
@@ -96,6 +104,18 @@ class WASP_PUBLIC HIVE
                        std::string      file    = "",
                        std::ostream&    output  = std::cout);
 
+    /**
+     * @brief set_query_cache set the cache of the compiled selection
+     * statements of the schema's rules
+     * @param cache the cache, the process-wide cache by default, or nullptr
+     * to compile each selection anew
+     */
+    void set_query_cache(DefaultSIRENQueryCache* cache)
+    {
+        m_query_cache = cache;
+    }
+    DefaultSIRENQueryCache* query_cache() const { return m_query_cache; }
+
     static void sort_errors(std::vector<std::string>& errors);
     static std::string combine(std::vector<std::string>& errors)
     {
@@ -115,6 +135,17 @@ class WASP_PUBLIC HIVE
     const int   MAXENUMERRORCOUNT = 6;
 
     std::map<std::string, std::set<std::string>> enumRef;
+    DefaultSIRENQueryCache*                      m_query_cache;
+    /**
+     * @brief compile_query acquire the compiled selection statement
+     * @param query the compiled statement, null if it failed to compile
+     * @param statement the selection statement
+     * @param err the stream on which compilation errors are reported
+     * @return true, iff the statement compiled
+     */
+    bool compile_query(DefaultSIRENQueryCache::Query& query,
+                       const std::string&             statement,
+                       std::ostream&                  err) const;
     /**
      * @brief select_nodes selects nodes for a given path relative to given input.
      * @param results the result set to populate with the nodes selected.
@@ -132,6 +163,53 @@ class WASP_PUBLIC HIVE
                       const std::string&            selection_path,
                       std::vector<std::string>&     errors);
 
+    /**
+     * @brief The SchemaRule enum classifies schema nodes by rule keyword
+     */
+    enum class SchemaRule
+    {
+        NONE,  // not a keyword, i.e., a nested schema object
+        TODO,
+        END_OF_SCHEMA,
+        ANY,
+        DESCRIPTIVE,  // Units, Description, Input* - not validated
+        MIN_OCCURS,
+        MAX_OCCURS,
+        VAL_TYPE,
+        VAL_ENUMS,
+        MIN_VAL_INC,
+        MAX_VAL_INC,
+        MIN_VAL_EXC,
+        MAX_VAL_EXC,
+        EXISTS_IN,
+        NOT_EXISTS_IN,
+        SUM_OVER,
+        SUM_OVER_GROUP,
+        INCREASE_OVER,
+        DECREASE_OVER,
+        CHILD_AT_MOST_ONE,
+        CHILD_EXACTLY_ONE,
+        CHILD_AT_LEAST_ONE,
+        CHILD_COUNT_EQUAL,
+        CHILD_UNIQUENESS,
+    };
+    /**
+     * @brief schema_rule classifies the given schema node by its name
+     * @param schema_node the schema node to classify
+     * @return the rule keyword of the node, SchemaRule::NONE if not a keyword
+     * The keywords are resolved to name symbols once per schema document so
+     * that classification is an integer comparison
+     */
+    template<class SchemaAdapter>
+    SchemaRule schema_rule(const SchemaAdapter& schema_node);
+    /**
+     * @brief m_schema_rules the sorted (name symbol, rule) keyword pairs of
+     * each schema document encountered
+     */
+    std::map<const AbstractInterpreter*,
+             std::vector<std::pair<std::size_t, SchemaRule>>>
+        m_schema_rules;
+
     // TODO document algorithm logic, runtime complexity, expected result
     template<class SchemaAdapter, class InputAdapter>
     bool traverse_schema(SchemaAdapter&            schema_node,
@@ -436,10 +514,11 @@ class WASP_PUBLIC HIVE
         }
 
         // look up this current node's path in the schema
-        DefaultSIRENInterpreter selector(err);
-        selector.parseString(current_node.path());
+        DefaultSIRENQueryCache::Query selector =
+            DefaultSIRENQueryCache::global().compile(current_node.path(), err);
         SIRENResultSet<SR> results;
-        selector.evaluate(schema_root, results);
+        if (selector)
+            selector->evaluate(schema_root, results);
 
         // error if there are more than one of these nodes in the schema
         if (results.size() > 1)
@@ -457,11 +536,14 @@ class WASP_PUBLIC HIVE
                 size_type = JsonSizeType::SINGLETON;
 
                 // look up the parent node's valtype in the schema
-                SIRENInterpreter<> parent_valtype_selector(err);
                 std::string parent_valtype_path = current_node.parent().path() + "/ValType/value";
-                parent_valtype_selector.parseString(parent_valtype_path);
+                DefaultSIRENQueryCache::Query parent_valtype_selector =
+                    DefaultSIRENQueryCache::global().compile(
+                        parent_valtype_path, err);
                 SIRENResultSet<SR> parent_valtype_results;
-                parent_valtype_selector.evaluate(schema_root, parent_valtype_results);
+                if (parent_valtype_selector)
+                    parent_valtype_selector->evaluate(schema_root,
+                                                      parent_valtype_results);
 
                 // if the parent node has a valtype, then if it is int or real
                 // set value_type to number
@@ -14,15 +14,15 @@ bool HIVE::select_nodes(SIRENResultSet<InputAdapter>& results,
 {
     std::stringstream look_up_error;
 
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(selection_path))
+    if (!compile_query(inputSelector, selection_path, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                 look_up_error.str()));
         return false;
     }
-    inputSelector.evaluate(input_node, results);
+    inputSelector->evaluate(input_node, results);
     return true;
 }
 
@@ -37,12 +37,76 @@ bool HIVE::validate(SchemaAdapter&            schema_node,
     }
     bool pass = true;
 
+    // schema documents may differ between validations
+    m_schema_rules.clear();
     pass = traverse_schema(schema_node, input_node, errors);
 
     sort_errors(errors);
     return pass;
 }
 
+template<class SchemaAdapter>
+HIVE::SchemaRule HIVE::schema_rule(const SchemaAdapter& schema_node)
+{
+    static const std::pair<const char*, SchemaRule> keywords[] = {
+        {"ToDo", SchemaRule::TODO},
+        {"EndOfSchema", SchemaRule::END_OF_SCHEMA},
+        {"*", SchemaRule::ANY},
+        {"Units", SchemaRule::DESCRIPTIVE},
+        {"Description", SchemaRule::DESCRIPTIVE},
+        {"InputName", SchemaRule::DESCRIPTIVE},
+        {"InputTerm", SchemaRule::DESCRIPTIVE},
+        {"InputType", SchemaRule::DESCRIPTIVE},
+        {"InputVariants", SchemaRule::DESCRIPTIVE},
+        {"InputAliases", SchemaRule::DESCRIPTIVE},
+        {"InputChoices", SchemaRule::DESCRIPTIVE},
+        {"InputDefault", SchemaRule::DESCRIPTIVE},
+        {"InputTmpl", SchemaRule::DESCRIPTIVE},
+        {"MinOccurs", SchemaRule::MIN_OCCURS},
+        {"MaxOccurs", SchemaRule::MAX_OCCURS},
+        {"ValType", SchemaRule::VAL_TYPE},
+        {"ValEnums", SchemaRule::VAL_ENUMS},
+        {"MinValInc", SchemaRule::MIN_VAL_INC},
+        {"MaxValInc", SchemaRule::MAX_VAL_INC},
+        {"MinValExc", SchemaRule::MIN_VAL_EXC},
+        {"MaxValExc", SchemaRule::MAX_VAL_EXC},
+        {"ExistsIn", SchemaRule::EXISTS_IN},
+        {"NotExistsIn", SchemaRule::NOT_EXISTS_IN},
+        {"SumOver", SchemaRule::SUM_OVER},
+        {"SumOverGroup", SchemaRule::SUM_OVER_GROUP},
+        {"IncreaseOver", SchemaRule::INCREASE_OVER},
+        {"DecreaseOver", SchemaRule::DECREASE_OVER},
+        {"ChildAtMostOne", SchemaRule::CHILD_AT_MOST_ONE},
+        {"ChildExactlyOne", SchemaRule::CHILD_EXACTLY_ONE},
+        {"ChildAtLeastOne", SchemaRule::CHILD_AT_LEAST_ONE},
+        {"ChildCountEqual", SchemaRule::CHILD_COUNT_EQUAL},
+        {"ChildUniqueness", SchemaRule::CHILD_UNIQUENESS},
+    };
+
+    // resolve the keywords' name symbols once per schema document
+    auto* pool = schema_node.node_pool();
+    auto  itr  = m_schema_rules.find(pool);
+    if (itr == m_schema_rules.end())
+    {
+        auto& rules = m_schema_rules[pool];
+        for (const auto& keyword : keywords)
+        {
+            std::size_t symbol = pool->find_name_symbol(keyword.first);
+            if (symbol != static_cast<std::size_t>(-1))
+                rules.push_back(std::make_pair(symbol, keyword.second));
+        }
+        std::sort(rules.begin(), rules.end());
+        itr = m_schema_rules.find(pool);
+    }
+    const auto& rules = itr->second;
+    std::size_t symbol = pool->name_symbol(schema_node.node_index());
+    auto rule = std::lower_bound(rules.begin(), rules.end(),
+                                 std::make_pair(symbol, SchemaRule::NONE));
+    if (rule == rules.end() || rule->first != symbol)
+        return SchemaRule::NONE;
+    return rule->second;
+}
+
 template<class SchemaAdapter, class InputAdapter>
 bool HIVE::traverse_schema(SchemaAdapter&            schema_node,
                            InputAdapter&             input_node,
@@ -66,8 +130,10 @@ bool HIVE::traverse_schema(SchemaAdapter&            schema_node,
      * Determine if this schema input node is marked as UNKNOWN
      */
     SchemaAdapter schema_node_id = schema_node.id_child();
+    std::string   schema_node_id_buffer;
     if (selection.size() != 0 && !schema_node_id.is_null()
-            && schema_node_id.data() == "UNKNOWN")
+            && adapted_data_view(schema_node_id, schema_node_id_buffer) ==
+                   "UNKNOWN")
     {
         for( size_t i_input = 0; i_input < selection.size(); ++i_input)
         {
@@ -85,144 +151,124 @@ bool HIVE::traverse_schema(SchemaAdapter&            schema_node,
 
     for (size_t i = 0, count = children.size(); i < count; i++)
     {
-        SchemaAdapter      tmpNode     = children[i];
-        const std::string& tmpNodeName = tmpNode.name();
-        bool               isToDo      = tmpNodeName == "ToDo";
+        SchemaAdapter tmpNode = children[i];
+        SchemaRule    rule    = schema_rule(tmpNode);
+        bool          isToDo  = rule == SchemaRule::TODO;
 
         // This shortcut to stop processing schema allows one to use
         // enumerations flexibly in the schema without the variables
         // being treated like part of the schema and causing an error to
         // be thrown.
-        if (tmpNodeName == "EndOfSchema")
+        if (rule == SchemaRule::END_OF_SCHEMA)
             break;
 
-        isAny |= tmpNodeName == "*";
+        isAny |= rule == SchemaRule::ANY;
 
-        if (isToDo || (tmpNodeName == "Units") ||
-            (tmpNodeName == "Description") || (tmpNodeName == "InputName") ||
-            (tmpNodeName == "InputTerm") || (tmpNodeName == "InputType") ||
-            (tmpNodeName == "InputVariants") ||
-            (tmpNodeName == "InputAliases") ||
-            (tmpNodeName == "InputChoices") ||
-            (tmpNodeName == "InputDefault") || (tmpNodeName == "InputTmpl"))
+        switch (rule)
         {
-            hasToDo |= isToDo;
-            continue;
-        }
+            case SchemaRule::TODO:
+            case SchemaRule::DESCRIPTIVE:
+                hasToDo |= isToDo;
+                continue;
 
-        else if (tmpNodeName == "MinOccurs")
-        {
-            pass &= validateMinOccurs(tmpNode, input_node, errors);
-        }
+            case SchemaRule::MIN_OCCURS:
+                pass &= validateMinOccurs(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "MaxOccurs")
-        {
-            pass &= validateMaxOccurs(tmpNode, input_node, errors);
-        }
+            case SchemaRule::MAX_OCCURS:
+                pass &= validateMaxOccurs(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "ValType")
-        {
-            pass &= validateValType(tmpNode, input_node, errors);
-        }
+            case SchemaRule::VAL_TYPE:
+                pass &= validateValType(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "ValEnums")
-        {
-            pass &= validateValEnums(tmpNode, input_node, errors);
-        }
+            case SchemaRule::VAL_ENUMS:
+                pass &= validateValEnums(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "MinValInc")
-        {
-            pass &= validateMinValInc(tmpNode, input_node, errors);
-        }
+            case SchemaRule::MIN_VAL_INC:
+                pass &= validateMinValInc(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "MaxValInc")
-        {
-            pass &= validateMaxValInc(tmpNode, input_node, errors);
-        }
+            case SchemaRule::MAX_VAL_INC:
+                pass &= validateMaxValInc(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "MinValExc")
-        {
-            pass &= validateMinValExc(tmpNode, input_node, errors);
-        }
+            case SchemaRule::MIN_VAL_EXC:
+                pass &= validateMinValExc(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "MaxValExc")
-        {
-            pass &= validateMaxValExc(tmpNode, input_node, errors);
-        }
+            case SchemaRule::MAX_VAL_EXC:
+                pass &= validateMaxValExc(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "ExistsIn")
-        {
-            pass &= validateExistsIn(tmpNode, input_node, errors);
-        }
+            case SchemaRule::EXISTS_IN:
+                pass &= validateExistsIn(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "NotExistsIn")
-        {
-            pass &= validateNotExistsIn(tmpNode, input_node, errors);
-        }
+            case SchemaRule::NOT_EXISTS_IN:
+                pass &= validateNotExistsIn(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "SumOver")
-        {
-            pass &= validateSumOver(tmpNode, input_node, errors);
-        }
+            case SchemaRule::SUM_OVER:
+                pass &= validateSumOver(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "SumOverGroup")
-        {
-            pass &= validateSumOverGroup(tmpNode, input_node, errors);
-        }
+            case SchemaRule::SUM_OVER_GROUP:
+                pass &= validateSumOverGroup(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "IncreaseOver")
-        {
-            pass &= validateIncreaseOver(tmpNode, input_node, errors);
-        }
+            case SchemaRule::INCREASE_OVER:
+                pass &= validateIncreaseOver(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "DecreaseOver")
-        {
-            pass &= validateDecreaseOver(tmpNode, input_node, errors);
-        }
+            case SchemaRule::DECREASE_OVER:
+                pass &= validateDecreaseOver(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "ChildAtMostOne")
-        {
-            pass &= validateChildAtMostOne(tmpNode, input_node, errors);
-        }
+            case SchemaRule::CHILD_AT_MOST_ONE:
+                pass &= validateChildAtMostOne(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "ChildExactlyOne")
-        {
-            pass &= validateChildExactlyOne(tmpNode, input_node, errors);
-        }
+            case SchemaRule::CHILD_EXACTLY_ONE:
+                pass &= validateChildExactlyOne(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "ChildAtLeastOne")
-        {
-            pass &= validateChildAtLeastOne(tmpNode, input_node, errors);
-        }
+            case SchemaRule::CHILD_AT_LEAST_ONE:
+                pass &= validateChildAtLeastOne(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "ChildCountEqual")
-        {
-            pass &= validateChildCountEqual(tmpNode, input_node, errors);
-        }
+            case SchemaRule::CHILD_COUNT_EQUAL:
+                pass &= validateChildCountEqual(tmpNode, input_node, errors);
+                break;
 
-        else if (tmpNodeName == "ChildUniqueness")
-        {
-            pass &= validateChildUniqueness(tmpNode, input_node, errors);
-        }
+            case SchemaRule::CHILD_UNIQUENESS:
+                pass &= validateChildUniqueness(tmpNode, input_node, errors);
+                break;
 
-        else
-        {
-            /* Error if there is a non-object schema rule that we do not
-               recognize */
-            if (tmpNode.type() != wasp::OBJECT)
+            default:
             {
-                errors.push_back(FileScope(tmpNode) + Error::BadSchemaRule(
-                    tmpNodeName, tmpNode.line(), tmpNode.column()));
-                return false;
-            }
+                const std::string& tmpNodeName = tmpNode.name();
+                /* Error if there is a non-object schema rule that we do not
+                   recognize */
+                if (tmpNode.type() != wasp::OBJECT)
+                {
+                    errors.push_back(FileScope(tmpNode) + Error::BadSchemaRule(
+                        tmpNodeName, tmpNode.line(), tmpNode.column()));
+                    return false;
+                }
 
-            /* Only continue child schema traversal if this node exists in input
-             */
-            if (selection.size() != 0)
-            {                
-                pass &= traverse_schema(tmpNode, input_node, errors);
+                /* Only continue child schema traversal if this node exists in
+                 * input
+                 */
+                if (selection.size() != 0)
+                {
+                    pass &= traverse_schema(tmpNode, input_node, errors);
+                }
+                definitionChildren.insert(tmpNodeName);
             }
-            definitionChildren.insert(tmpNodeName);
+            break;
         }
     }
     bool          is_wild_card = std::strcmp(schema_node.name(), "*") == 0;
@@ -306,17 +352,19 @@ bool HIVE::validateMinOccurs(SchemaAdapter&            schema_node,
             childNodeCount = selection.adapted(i).child_count_by_name(nodeName);
         if (!issRV.eof() || issRV.fail())
         {
-            std::stringstream       look_up_error;
-            DefaultSIRENInterpreter inputSelectorlookup(look_up_error);
+            std::stringstream             look_up_error;
+            DefaultSIRENQueryCache::Query inputSelectorlookup;
 
-            if (!inputSelectorlookup.parseString(ruleValue.substr(3)))
+            if (!compile_query(inputSelectorlookup, ruleValue.substr(3),
+                               look_up_error))
             {
                 errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node, look_up_error.str()));
                 return false;
             }
             SIRENResultSet<InputAdapter> selectionLookup;
             InputAdapter                 inode = selection.adapted(i);
-            inputSelectorlookup.evaluate(inode, selectionLookup);
+            selectionLookup.set_limit(2);
+            inputSelectorlookup->evaluate(inode, selectionLookup);
 
             if (selectionLookup.size() > 1)
             {
@@ -385,16 +433,16 @@ bool HIVE::validateMaxOccurs(SchemaAdapter&            schema_node,
     std::string       ruleValue      = schema_node.to_string();
     bool              pass           = true;
     std::stringstream look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodeParentPath))
+    if (!compile_query(inputSelector, nodeParentPath, look_up_error))
     {
         errors.push_back(FileScope(schema_node_grandparent) + 
                         Error::SirenParseError(schema_node_grandparent,look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
     std::istringstream issRV(ruleValue);
     int                itestRV;
@@ -416,17 +464,19 @@ bool HIVE::validateMaxOccurs(SchemaAdapter&            schema_node,
 
         if (!issRV.eof() || issRV.fail())
         {
-            std::stringstream       look_up_error;
-            DefaultSIRENInterpreter inputSelectorlookup(look_up_error);
+            std::stringstream             look_up_error;
+            DefaultSIRENQueryCache::Query inputSelectorlookup;
 
-            if (!inputSelectorlookup.parseString(ruleValue.substr(3)))
+            if (!compile_query(inputSelectorlookup, ruleValue.substr(3),
+                               look_up_error))
             {
                 errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,look_up_error.str()));
                 return false;
             }
             SIRENResultSet<InputAdapter> selectionLookup;
             InputAdapter                 inode = selection.adapted(i);
-            inputSelectorlookup.evaluate(inode, selectionLookup);
+            selectionLookup.set_limit(2);
+            inputSelectorlookup->evaluate(inode, selectionLookup);
 
             if (selectionLookup.size() > 1)
             {
@@ -498,21 +548,23 @@ bool HIVE::validateValType(SchemaAdapter&            schema_node,
             "Int Real String RealOrQuestion IntOrYesOrNo IntOrAsterisk Fido"));
         return false;
     }
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> input_selection;
-    inputSelector.evaluate(input_node, input_selection);
+    inputSelector->evaluate(input_node, input_selection);
 
+    std::string valueString;
     for (size_t i = 0; i < input_selection.size(); i++)
     {
-        std::istringstream iss(input_selection.adapted(i).to_string());
+        adapted_string(input_selection.adapted(i), valueString);
+        std::istringstream iss(valueString);
 
         if ((ruleValue == "Int") || (ruleValue == "Real") ||
             (ruleValue == "String"))
@@ -554,13 +606,13 @@ bool HIVE::validateValType(SchemaAdapter&            schema_node,
                 errors.push_back(FileScope(input_selection.adapted(i)) + Error::BadValType(
                     input_selection.adapted(i).line(),
                     input_selection.adapted(i).column(), valueNodeName,
-                    input_selection.adapted(i).to_string(), ruleValue));
+                    valueString, ruleValue));
                 pass = false;
             }
         }
         else if (ruleValue == "RealOrQuestion")
         {
-            if (input_selection.adapted(i).to_string() != "?")
+            if (valueString != "?")
             {
                 float ftest;
                 iss >> std::noskipws >> ftest;
@@ -584,14 +636,14 @@ bool HIVE::validateValType(SchemaAdapter&            schema_node,
                     errors.push_back(FileScope(input_selection.adapted(i)) + Error::BadValType(
                         input_selection.adapted(i).line(),
                         input_selection.adapted(i).column(), valueNodeName,
-                        input_selection.adapted(i).to_string(), ruleValue));
+                        valueString, ruleValue));
                     pass = false;
                 }
             }
         }
         else if (ruleValue == "IntOrYesOrNo")
         {
-            std::string lowerString = input_selection.adapted(i).to_string();
+            std::string lowerString = valueString;
             transform(lowerString.begin(), lowerString.end(),
                       lowerString.begin(), ::tolower);
 
@@ -619,14 +671,14 @@ bool HIVE::validateValType(SchemaAdapter&            schema_node,
                     errors.push_back(FileScope(input_selection.adapted(i)) + Error::BadValType(
                         input_selection.adapted(i).line(),
                         input_selection.adapted(i).column(), valueNodeName,
-                        input_selection.adapted(i).to_string(), ruleValue));
+                        valueString, ruleValue));
                     pass = false;
                 }
             }
         }
         else if (ruleValue == "IntOrAsterisk")
         {
-            if (input_selection.adapted(i).to_string() != "*")
+            if (valueString != "*")
             {
                 int itest;
                 iss >> std::noskipws >> itest;
@@ -650,7 +702,7 @@ bool HIVE::validateValType(SchemaAdapter&            schema_node,
                     errors.push_back(FileScope(input_selection.adapted(i)) + Error::BadValType(
                         input_selection.adapted(i).line(),
                         input_selection.adapted(i).column(), valueNodeName,
-                        input_selection.adapted(i).to_string(), ruleValue));
+                        valueString, ruleValue));
                     pass = false;
                 }
             }
@@ -677,16 +729,16 @@ bool HIVE::validateValEnums(SchemaAdapter&            schema_node,
     // CREATE THE DEQUE OF THE VALUES FOR THIS NODE
     std::stringstream look_up_error;
 
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node_parent) + Error::SirenParseError(schema_node_parent,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
     // CREATE ENUM UNORDERED SET
     std::set<std::string>  enumSet;
@@ -773,9 +825,10 @@ bool HIVE::validateValEnums(SchemaAdapter&            schema_node,
 
     // LOOP OVER THIS DEQUE CHECKING EACH VALUES EXISTANCE IN THE ENUM UNORDERED
     // SET
+    std::string tempString;
     for (size_t i = 0; i < selection.size(); i++)
     {
-        std::string tempString = selection.adapted(i).to_string();
+        adapted_string(selection.adapted(i), tempString);
 
         // if tempString is quoted (single or double), remove quotes before
         // checking
@@ -918,21 +971,23 @@ bool HIVE::validateMinValInc(SchemaAdapter&            schema_node,
     std::string ruleValue = schema_node.to_string();
     bool        pass      = true;
 
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
+    std::string valueString;
     for (size_t i = 0; i < selection.size(); i++)
     {
-        std::istringstream iss(selection.adapted(i).to_string());
+        adapted_string(selection.adapted(i), valueString);
+        std::istringstream iss(valueString);
         float              ftest;
         iss >> std::noskipws >> ftest;
 
@@ -952,7 +1007,7 @@ bool HIVE::validateMinValInc(SchemaAdapter&            schema_node,
 
             errors.push_back(FileScope(selection.adapted(i)) + Error::WrongTypeForRule(
                 selection.adapted(i).line(), selection.adapted(i).column(),
-                valueNodeName, selection.adapted(i).to_string(), ruleName));
+                valueNodeName, valueString, ruleName));
             pass = false;
         }
         else
@@ -963,10 +1018,11 @@ bool HIVE::validateMinValInc(SchemaAdapter&            schema_node,
 
             if (!issRV.eof() || issRV.fail())
             {
-                std::stringstream       look_up_error;
-                DefaultSIRENInterpreter inputSelectorlookup(look_up_error);
+                std::stringstream             look_up_error;
+                DefaultSIRENQueryCache::Query inputSelectorlookup;
 
-                if (!inputSelectorlookup.parseString(ruleValue))
+                if (!compile_query(inputSelectorlookup, ruleValue,
+                                   look_up_error))
                 {
                     errors.push_back(FileScope(schema_node) + 
                         Error::SirenParseError(schema_node,
@@ -975,7 +1031,8 @@ bool HIVE::validateMinValInc(SchemaAdapter&            schema_node,
                 }
                 SIRENResultSet<InputAdapter> selectionLookup;
                 InputAdapter                 inode = selection.adapted(i);
-                inputSelectorlookup.evaluate(inode, selectionLookup);
+                selectionLookup.set_limit(2);
+                inputSelectorlookup->evaluate(inode, selectionLookup);
 
                 if (selectionLookup.size() > 1)
                 {
@@ -998,8 +1055,7 @@ bool HIVE::validateMinValInc(SchemaAdapter&            schema_node,
                             selection.adapted(i).name(), ruleName, ruleValue));
                         pass = false;
                     }
-                    else if (stod(selection.adapted(i).to_string()) <
-                             stod(issRV2.str()))
+                    else if (stod(valueString) < stod(issRV2.str()))
                     {
                         std::string valueNodeName;
 
@@ -1018,13 +1074,13 @@ bool HIVE::validateMinValInc(SchemaAdapter&            schema_node,
                         errors.push_back(FileScope(selection.adapted(i)) + Error::MinMax(
                             selection.adapted(i).line(),
                             selection.adapted(i).column(), valueNodeName,
-                            selection.adapted(i).to_string(), ruleName,
+                            valueString, ruleName,
                             issRV2.str(), ruleValue));
                         pass = false;
                     }
                 }
             }
-            else if (stod(selection.adapted(i).to_string()) < stod(ruleValue))
+            else if (stod(valueString) < stod(ruleValue))
             {
                 std::string valueNodeName;
 
@@ -1040,7 +1096,7 @@ bool HIVE::validateMinValInc(SchemaAdapter&            schema_node,
 
                 errors.push_back(FileScope(selection.adapted(i)) + Error::MinMax(
                     selection.adapted(i).line(), selection.adapted(i).column(),
-                    valueNodeName, selection.adapted(i).to_string(), ruleName,
+                    valueNodeName, valueString, ruleName,
                     ruleValue));
                 pass = false;
             }
@@ -1064,21 +1120,23 @@ bool HIVE::validateMaxValInc(SchemaAdapter&            schema_node,
     std::string ruleValue = schema_node.to_string();
     bool        pass      = true;
 
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node_parent) + Error::SirenParseError(schema_node_parent,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
+    std::string valueString;
     for (size_t i = 0; i < selection.size(); i++)
     {
-        std::istringstream iss(selection.adapted(i).to_string());
+        adapted_string(selection.adapted(i), valueString);
+        std::istringstream iss(valueString);
         float              ftest;
         iss >> std::noskipws >> ftest;
 
@@ -1098,7 +1156,7 @@ bool HIVE::validateMaxValInc(SchemaAdapter&            schema_node,
 
             errors.push_back(FileScope(selection.adapted(i)) +Error::WrongTypeForRule(
                 selection.adapted(i).line(), selection.adapted(i).column(),
-                valueNodeName, selection.adapted(i).to_string(), ruleName));
+                valueNodeName, valueString, ruleName));
             pass = false;
         }
         else
@@ -1109,10 +1167,11 @@ bool HIVE::validateMaxValInc(SchemaAdapter&            schema_node,
 
             if (!issRV.eof() || issRV.fail())
             {
-                std::stringstream       look_up_error;
-                DefaultSIRENInterpreter inputSelectorlookup(look_up_error);
+                std::stringstream             look_up_error;
+                DefaultSIRENQueryCache::Query inputSelectorlookup;
 
-                if (!inputSelectorlookup.parseString(ruleValue))
+                if (!compile_query(inputSelectorlookup, ruleValue,
+                                   look_up_error))
                 {
                     errors.push_back(FileScope(schema_node) +
                         Error::SirenParseError(schema_node,
@@ -1121,7 +1180,8 @@ bool HIVE::validateMaxValInc(SchemaAdapter&            schema_node,
                 }
                 SIRENResultSet<InputAdapter> selectionLookup;
                 InputAdapter                 inode = selection.adapted(i);
-                inputSelectorlookup.evaluate(inode, selectionLookup);
+                selectionLookup.set_limit(2);
+                inputSelectorlookup->evaluate(inode, selectionLookup);
 
                 if (selectionLookup.size() > 1)
                 {
@@ -1145,8 +1205,7 @@ bool HIVE::validateMaxValInc(SchemaAdapter&            schema_node,
                             selection.adapted(i).name(), ruleName, ruleValue));
                         pass = false;
                     }
-                    else if (stod(selection.adapted(i).to_string()) >
-                             stod(issRV2.str()))
+                    else if (stod(valueString) > stod(issRV2.str()))
                     {
                         std::string valueNodeName;
 
@@ -1165,13 +1224,13 @@ bool HIVE::validateMaxValInc(SchemaAdapter&            schema_node,
                         errors.push_back(FileScope(selection.adapted(i)) + Error::MinMax(
                             selection.adapted(i).line(),
                             selection.adapted(i).column(), valueNodeName,
-                            selection.adapted(i).to_string(), ruleName,
+                            valueString, ruleName,
                             issRV2.str(), ruleValue));
                         pass = false;
                     }
                 }
             }
-            else if (stod(selection.adapted(i).to_string()) > stod(ruleValue))
+            else if (stod(valueString) > stod(ruleValue))
             {
                 std::string valueNodeName;
 
@@ -1187,7 +1246,7 @@ bool HIVE::validateMaxValInc(SchemaAdapter&            schema_node,
 
                 errors.push_back(FileScope(selection.adapted(i)) + Error::MinMax(
                     selection.adapted(i).line(), selection.adapted(i).column(),
-                    valueNodeName, selection.adapted(i).to_string(), ruleName,
+                    valueNodeName, valueString, ruleName,
                     ruleValue));
                 pass = false;
             }
@@ -1211,21 +1270,23 @@ bool HIVE::validateMinValExc(SchemaAdapter&            schema_node,
     std::string ruleValue = schema_node.to_string();
     bool        pass      = true;
 
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node_parent) + Error::SirenParseError(schema_node_parent,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
+    std::string valueString;
     for (size_t i = 0; i < selection.size(); i++)
     {
-        std::istringstream iss(selection.adapted(i).to_string());
+        adapted_string(selection.adapted(i), valueString);
+        std::istringstream iss(valueString);
         float              ftest;
         iss >> std::noskipws >> ftest;
 
@@ -1245,7 +1306,7 @@ bool HIVE::validateMinValExc(SchemaAdapter&            schema_node,
 
             errors.push_back(FileScope(selection.adapted(i)) + Error::WrongTypeForRule(
                 selection.adapted(i).line(), selection.adapted(i).column(),
-                valueNodeName, selection.adapted(i).to_string(), ruleName));
+                valueNodeName, valueString, ruleName));
             pass = false;
         }
         else
@@ -1256,10 +1317,11 @@ bool HIVE::validateMinValExc(SchemaAdapter&            schema_node,
 
             if (!issRV.eof() || issRV.fail())
             {
-                std::stringstream       look_up_error;
-                DefaultSIRENInterpreter inputSelectorlookup(look_up_error);
+                std::stringstream             look_up_error;
+                DefaultSIRENQueryCache::Query inputSelectorlookup;
 
-                if (!inputSelectorlookup.parseString(ruleValue))
+                if (!compile_query(inputSelectorlookup, ruleValue,
+                                   look_up_error))
                 {
                     errors.push_back(FileScope(schema_node) + 
                         Error::SirenParseError(schema_node,
@@ -1268,7 +1330,8 @@ bool HIVE::validateMinValExc(SchemaAdapter&            schema_node,
                 }
                 SIRENResultSet<InputAdapter> selectionLookup;
                 InputAdapter                 inode = selection.adapted(i);
-                inputSelectorlookup.evaluate(inode, selectionLookup);
+                selectionLookup.set_limit(2);
+                inputSelectorlookup->evaluate(inode, selectionLookup);
 
                 if (selectionLookup.size() > 1)
                 {
@@ -1292,8 +1355,7 @@ bool HIVE::validateMinValExc(SchemaAdapter&            schema_node,
                             selection.adapted(i).name(), ruleName, ruleValue));
                         pass = false;
                     }
-                    else if (stod(selection.adapted(i).to_string()) <=
-                             stod(issRV2.str()))
+                    else if (stod(valueString) <= stod(issRV2.str()))
                     {
                         std::string valueNodeName;
 
@@ -1312,13 +1374,13 @@ bool HIVE::validateMinValExc(SchemaAdapter&            schema_node,
                         errors.push_back(FileScope(selection.adapted(i)) + Error::MinMax(
                             selection.adapted(i).line(),
                             selection.adapted(i).column(), valueNodeName,
-                            selection.adapted(i).to_string(), ruleName,
+                            valueString, ruleName,
                             issRV2.str(), ruleValue));
                         pass = false;
                     }
                 }
             }
-            else if (stod(selection.adapted(i).to_string()) <= stod(ruleValue))
+            else if (stod(valueString) <= stod(ruleValue))
             {
                 std::string valueNodeName;
 
@@ -1334,7 +1396,7 @@ bool HIVE::validateMinValExc(SchemaAdapter&            schema_node,
 
                 errors.push_back(FileScope(selection.adapted(i)) + Error::MinMax(
                     selection.adapted(i).line(), selection.adapted(i).column(),
-                    valueNodeName, selection.adapted(i).to_string(), ruleName,
+                    valueNodeName, valueString, ruleName,
                     ruleValue));
                 pass = false;
             }
@@ -1358,21 +1420,23 @@ bool HIVE::validateMaxValExc(SchemaAdapter&            schema_node,
     std::string ruleValue = schema_node.to_string();
     bool        pass      = true;
 
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node_parent) + Error::SirenParseError(schema_node_parent,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
+    std::string valueString;
     for (size_t i = 0; i < selection.size(); i++)
     {
-        std::istringstream iss(selection.adapted(i).to_string());
+        adapted_string(selection.adapted(i), valueString);
+        std::istringstream iss(valueString);
         float              ftest;
         iss >> std::noskipws >> ftest;
 
@@ -1392,7 +1456,7 @@ bool HIVE::validateMaxValExc(SchemaAdapter&            schema_node,
 
             errors.push_back(FileScope(selection.adapted(i)) + Error::WrongTypeForRule(
                 selection.adapted(i).line(), selection.adapted(i).column(),
-                valueNodeName, selection.adapted(i).to_string(), ruleName));
+                valueNodeName, valueString, ruleName));
             pass = false;
         }
         else
@@ -1403,10 +1467,11 @@ bool HIVE::validateMaxValExc(SchemaAdapter&            schema_node,
 
             if (!issRV.eof() || issRV.fail())
             {
-                std::stringstream       look_up_error;
-                DefaultSIRENInterpreter inputSelectorLookup(look_up_error);
+                std::stringstream             look_up_error;
+                DefaultSIRENQueryCache::Query inputSelectorLookup;
 
-                if (!inputSelectorLookup.parseString(ruleValue))
+                if (!compile_query(inputSelectorLookup, ruleValue,
+                                   look_up_error))
                 {
                     errors.push_back(FileScope(schema_node) + 
                         Error::SirenParseError(schema_node,
@@ -1415,7 +1480,8 @@ bool HIVE::validateMaxValExc(SchemaAdapter&            schema_node,
                 }
                 SIRENResultSet<InputAdapter> selectionLookup;
                 InputAdapter                 inode = selection.adapted(i);
-                inputSelectorLookup.evaluate(inode, selectionLookup);
+                selectionLookup.set_limit(2);
+                inputSelectorLookup->evaluate(inode, selectionLookup);
 
                 if (selectionLookup.size() > 1)
                 {
@@ -1439,8 +1505,7 @@ bool HIVE::validateMaxValExc(SchemaAdapter&            schema_node,
                             selection.adapted(i).name(), ruleName, ruleValue));
                         pass = false;
                     }
-                    else if (stod(selection.adapted(i).to_string()) >=
-                             stod(issRV2.str()))
+                    else if (stod(valueString) >= stod(issRV2.str()))
                     {
                         std::string valueNodeName;
 
@@ -1459,13 +1524,13 @@ bool HIVE::validateMaxValExc(SchemaAdapter&            schema_node,
                         errors.push_back(FileScope(selection.adapted(i)) + Error::MinMax(
                             selection.adapted(i).line(),
                             selection.adapted(i).column(), valueNodeName,
-                            selection.adapted(i).to_string(), ruleName,
+                            valueString, ruleName,
                             issRV2.str(), ruleValue));
                         pass = false;
                     }
                 }
             }
-            else if (stod(selection.adapted(i).to_string()) >= stod(ruleValue))
+            else if (stod(valueString) >= stod(ruleValue))
             {
                 std::string valueNodeName;
 
@@ -1481,7 +1546,7 @@ bool HIVE::validateMaxValExc(SchemaAdapter&            schema_node,
 
                 errors.push_back(FileScope(selection.adapted(i)) + Error::MinMax(
                     selection.adapted(i).line(), selection.adapted(i).column(),
-                    valueNodeName, selection.adapted(i).to_string(), ruleName,
+                    valueNodeName, valueString, ruleName,
                     ruleValue));
                 pass = false;
             }
@@ -1522,16 +1587,16 @@ bool HIVE::validateExistsIn(SchemaAdapter&            schema_node,
         beforePeriodRule = true;
     }
 
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
-    if (!inputSelector.parseString(nodePath))
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node_parent) + Error::SirenParseError(schema_node_parent,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
     // CREATE LOOKUP UNORDERED SET
     std::unordered_set<std::string> lookupSet;
@@ -1601,8 +1666,7 @@ bool HIVE::validateExistsIn(SchemaAdapter&            schema_node,
     }
     const typename SchemaAdapter::Collection& children =
         schema_node.non_decorative_children();
-    std::map<int, typename DefaultSIRENInterpreter::SharedPtr>
-        childrenSelectors;
+    std::map<int, DefaultSIRENQueryCache::Query> childrenSelectors;
     for (size_t i = 0; i < selection.size(); i++)
     {
         for (int loop = 0, count = children.size(); loop < count; loop++)
@@ -1724,11 +1788,9 @@ bool HIVE::validateExistsIn(SchemaAdapter&            schema_node,
                 {
                     // this avoids runtime cost of reparsing the same
                     // siren expression many times
-                    typename DefaultSIRENInterpreter::SharedPtr
-                        inputSelectorLookup =
-                            std::make_shared<DefaultSIRENInterpreter>(
-                                look_up_error);
-                    if (!inputSelectorLookup->parseString(ruleValue))
+                    DefaultSIRENQueryCache::Query inputSelectorLookup;
+                    if (!compile_query(inputSelectorLookup, ruleValue,
+                                       look_up_error))
                     {
                         errors.push_back(FileScope(schema_node) + 
                             Error::SirenParseError(schema_node,
@@ -1781,7 +1843,8 @@ bool HIVE::validateExistsIn(SchemaAdapter&            schema_node,
             }
         }
         savedParentInputNode     = tmpParentInputNode;
-        std::string lookupString = selection.adapted(i).to_string();
+        std::string lookupString;
+        adapted_string(selection.adapted(i), lookupString);
         if (absRule && (lookupString.at(0) == '-' || lookupString.at(0) == '+'))
         {
             lookupString.erase(lookupString.begin());
@@ -1896,17 +1959,17 @@ bool HIVE::validateNotExistsIn(SchemaAdapter&            schema_node,
     }
 
     // gather all of the nodes for which this rule applies
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node_parent) + Error::SirenParseError(schema_node_parent,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
     // gather all of the lookup paths for this rule
     const typename SchemaAdapter::Collection& lookupPaths =
@@ -1918,10 +1981,10 @@ bool HIVE::validateNotExistsIn(SchemaAdapter&            schema_node,
         std::string lookupPath = lookupPaths[j].to_string();
 
         // std::set up the siren for this specific lookup path
-        std::stringstream       look_up_error;
-        DefaultSIRENInterpreter childSelector(look_up_error);
+        std::stringstream             look_up_error;
+        DefaultSIRENQueryCache::Query childSelector;
 
-        if (!childSelector.parseString(lookupPath))
+        if (!compile_query(childSelector, lookupPath, look_up_error))
         {
             errors.push_back(FileScope(lookupPaths[j]) + Error::SirenParseError(lookupPaths[j],
                                                     look_up_error.str()));
@@ -1937,7 +2000,7 @@ bool HIVE::validateNotExistsIn(SchemaAdapter&            schema_node,
             // relative to this node
             SIRENResultSet<InputAdapter> childSelection;
             InputAdapter                 inode = selection.adapted(i);
-            childSelector.evaluate(inode, childSelection);
+            childSelector->evaluate(inode, childSelection);
 
             // loop over all of these nodes and add their values to
             // a lookup map or a std::set of ranges if an alias
@@ -2122,38 +2185,41 @@ bool HIVE::validateSumOver(SchemaAdapter&            schema_node,
 
     std::stringstream look_up_error;
 
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath + "/" + ruleId))
+    if (!compile_query(inputSelector, nodePath + "/" + ruleId, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    selection.set_limit(1);
+    inputSelector->evaluate(input_node, selection);
 
     if (selection.size() != 0)
     {
-        std::stringstream       look_up_error;
-        DefaultSIRENInterpreter inputSelectorlookup(look_up_error);
+        std::stringstream             look_up_error;
+        DefaultSIRENQueryCache::Query inputSelectorlookup;
 
-        if (!inputSelectorlookup.parseString(selection.adapted(0).path()))
+        if (!compile_query(inputSelectorlookup, selection.adapted(0).path(),
+                           look_up_error))
         {
             errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                     look_up_error.str()));
             return false;
         }
         SIRENResultSet<InputAdapter> selectionLookup;
-        inputSelectorlookup.evaluate(input_node, selectionLookup);
+        inputSelectorlookup->evaluate(input_node, selectionLookup);
 
         for (size_t i = 0; i < selectionLookup.size(); i++)
         {
-            std::stringstream       look_up_error;
-            DefaultSIRENInterpreter sumSelector(look_up_error);
+            std::stringstream             look_up_error;
+            DefaultSIRENQueryCache::Query sumSelector;
 
-            if (!sumSelector.parseString(
-                    nodePath.substr(selection.adapted(0).path().length() + 1)))
+            if (!compile_query(sumSelector,
+                               nodePath.substr(selection.adapted(0).path().length() + 1),
+                               look_up_error))
             {
                 errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                         look_up_error.str()));
@@ -2162,16 +2228,18 @@ bool HIVE::validateSumOver(SchemaAdapter&            schema_node,
 
             SIRENResultSet<InputAdapter> sumSelection;
             InputAdapter                 inode = selectionLookup.adapted(i);
-            sumSelector.evaluate(inode, sumSelection);
+            sumSelector->evaluate(inode, sumSelection);
 
             if (sumSelection.size() != 0)
             {
                 double sum          = 0;
                 bool   numberslegal = true;
 
+                std::string valueString;
                 for (size_t j = 0; j < sumSelection.size(); j++)
                 {
-                    std::istringstream iss(sumSelection.adapted(j).to_string());
+                    adapted_string(sumSelection.adapted(j), valueString);
+                    std::istringstream iss(valueString);
                     float              ftest;
                     iss >> std::noskipws >> ftest;
 
@@ -2194,13 +2262,13 @@ bool HIVE::validateSumOver(SchemaAdapter&            schema_node,
                         errors.push_back(FileScope(sumSelection.adapted(i)) + Error::WrongTypeForRule(
                             sumSelection.adapted(j).line(),
                             sumSelection.adapted(j).column(), valueNodeName,
-                            sumSelection.adapted(j).to_string(), ruleName));
+                            valueString, ruleName));
                         pass         = false;
                         numberslegal = false;
                     }
                     else
                     {
-                        sum += stod(sumSelection.adapted(j).to_string());
+                        sum += stod(valueString);
                     }
                 }
 
@@ -2269,44 +2337,47 @@ bool HIVE::validateSumOverGroup(SchemaAdapter&            schema_node,
     int         groupDivide = group_divide_schema_node.to_int();
     // TODO check zero as divisor
     double                  groupSum = group_sum_schema_node.to_double();
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath + "/" + ruleId))
+    if (!compile_query(inputSelector, nodePath + "/" + ruleId, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node.parent(),
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    selection.set_limit(1);
+    inputSelector->evaluate(input_node, selection);
 
     if (selection.size() != 0)
     {
-        std::stringstream       look_up_error;
-        DefaultSIRENInterpreter inputSelectorlookup(look_up_error);
+        std::stringstream             look_up_error;
+        DefaultSIRENQueryCache::Query inputSelectorlookup;
 
-        if (!inputSelectorlookup.parseString(selection.adapted(0).path()))
+        if (!compile_query(inputSelectorlookup, selection.adapted(0).path(),
+                           look_up_error))
         {
             errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                     look_up_error.str()));
             return false;
         }
         SIRENResultSet<InputAdapter> selectionLookup;
-        inputSelectorlookup.evaluate(input_node, selectionLookup);
+        inputSelectorlookup->evaluate(input_node, selectionLookup);
 
-        DefaultSIRENInterpreter sumSelector(look_up_error);
+        DefaultSIRENQueryCache::Query sumSelector;
 
-        if (!sumSelector.parseString(
-                nodePath.substr(selection.adapted(0).path().length() + 1)))
+        if (!compile_query(sumSelector,
+                           nodePath.substr(selection.adapted(0).path().length() + 1),
+                           look_up_error))
         {
             errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                     look_up_error.str()));
             return false;
         }
-        DefaultSIRENInterpreter comparePathSelector(look_up_error);
+        DefaultSIRENQueryCache::Query comparePathSelector;
 
-        if (!comparePathSelector.parseString(comparePath))
+        if (!compile_query(comparePathSelector, comparePath, look_up_error))
         {
             errors.push_back(FileScope(compare_path_schema_node) + Error::SirenParseError(compare_path_schema_node,
                                                     look_up_error.str()));
@@ -2317,7 +2388,7 @@ bool HIVE::validateSumOverGroup(SchemaAdapter&            schema_node,
         {
             SIRENResultSet<InputAdapter> sumSelection;
             InputAdapter                 inode = selectionLookup.adapted(i);
-            sumSelector.evaluate(inode, sumSelection);
+            sumSelector->evaluate(inode, sumSelection);
 
             typename std::map<int, std::vector<InputAdapter>> groupAddends;
             typename std::map<int, typename std::vector<InputAdapter>>::iterator
@@ -2327,7 +2398,7 @@ bool HIVE::validateSumOverGroup(SchemaAdapter&            schema_node,
             {
                 SIRENResultSet<InputAdapter> comparePathSelection;
                 InputAdapter                 jnode = sumSelection.adapted(j);
-                comparePathSelector.evaluate(jnode, comparePathSelection);
+                comparePathSelector->evaluate(jnode, comparePathSelection);
 
                 int tempCompareQuotient;
 
@@ -2444,37 +2515,40 @@ bool HIVE::validateIncreaseOver(SchemaAdapter&            schema_node,
             schema_node.non_decorative_children()[0].column(), "Mono Strict"));
         return false;
     }
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath + "/" + ruleId))
+    if (!compile_query(inputSelector, nodePath + "/" + ruleId, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node.parent(),
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    selection.set_limit(1);
+    inputSelector->evaluate(input_node, selection);
 
     if (selection.size() != 0)
     {
-        DefaultSIRENInterpreter inputSelectorLookup(look_up_error);
+        DefaultSIRENQueryCache::Query inputSelectorLookup;
 
-        if (!inputSelectorLookup.parseString(selection.adapted(0).path()))
+        if (!compile_query(inputSelectorLookup, selection.adapted(0).path(),
+                           look_up_error))
         {
             errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node.parent(),
                                                     look_up_error.str()));
             return false;
         }
         SIRENResultSet<InputAdapter> selectionLookup;
-        inputSelectorLookup.evaluate(input_node, selectionLookup);
+        inputSelectorLookup->evaluate(input_node, selectionLookup);
 
         for (size_t i = 0; i < selectionLookup.size(); i++)
         {
-            DefaultSIRENInterpreter incrSelector(look_up_error);
+            DefaultSIRENQueryCache::Query incrSelector;
 
-            if (!incrSelector.parseString(
-                    nodePath.substr(selection.adapted(0).path().length() + 1)))
+            if (!compile_query(incrSelector,
+                               nodePath.substr(selection.adapted(0).path().length() + 1),
+                               look_up_error))
             {
                 errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node.parent(),
                                                         look_up_error.str()));
@@ -2483,17 +2557,20 @@ bool HIVE::validateIncreaseOver(SchemaAdapter&            schema_node,
 
             SIRENResultSet<InputAdapter> incrSelection;
             InputAdapter                 inode = selectionLookup.adapted(i);
-            incrSelector.evaluate(inode, incrSelection);
+            incrSelector->evaluate(inode, incrSelection);
 
             bool numberslegal = true;
 
+            std::string valueString;
+            std::string nextValueString;
             for (size_t j = 0;
                  incrSelection.size() != 0 && j < incrSelection.size() - 1; j++)
             {
+                adapted_string(incrSelection.adapted(j), valueString);
+                adapted_string(incrSelection.adapted(j + 1), nextValueString);
                 if (j == 0)
                 {
-                    std::istringstream issFirst(
-                        incrSelection.adapted(j).to_string());
+                    std::istringstream issFirst(valueString);
                     float ftestFirst;
                     issFirst >> std::noskipws >> ftestFirst;
 
@@ -2516,14 +2593,13 @@ bool HIVE::validateIncreaseOver(SchemaAdapter&            schema_node,
                         errors.push_back(FileScope(incrSelection.adapted(j)) + Error::WrongTypeForRule(
                             incrSelection.adapted(j).line(),
                             incrSelection.adapted(j).column(), valueNodeName,
-                            incrSelection.adapted(j).to_string(), ruleName));
+                            valueString, ruleName));
                         pass         = false;
                         numberslegal = false;
                     }
                 }
 
-                std::istringstream issSecond(
-                    incrSelection.adapted(j + 1).to_string());
+                std::istringstream issSecond(nextValueString);
                 float ftestSecond;
                 issSecond >> std::noskipws >> ftestSecond;
 
@@ -2546,14 +2622,13 @@ bool HIVE::validateIncreaseOver(SchemaAdapter&            schema_node,
                     errors.push_back(FileScope(incrSelection.adapted(j+1)) + Error::WrongTypeForRule(
                         incrSelection.adapted(j + 1).line(),
                         incrSelection.adapted(j + 1).column(), valueNodeName,
-                        incrSelection.adapted(j + 1).to_string(), ruleName));
+                        nextValueString, ruleName));
                     pass         = false;
                     numberslegal = false;
                 }
 
                 if ((numberslegal == true) && (ruleValue == "Mono") &&
-                    (stod(incrSelection.adapted(j).to_string()) >
-                     stod(incrSelection.adapted(j + 1).to_string())))
+                    (stod(valueString) > stod(nextValueString)))
                 {
                     errors.push_back(FileScope(selectionLookup.adapted(i)) + Error::IncreaseDecrease(
                         selectionLookup.adapted(i).line(),
@@ -2565,8 +2640,7 @@ bool HIVE::validateIncreaseOver(SchemaAdapter&            schema_node,
                 }
 
                 else if ((numberslegal == true) && (ruleValue == "Strict") &&
-                         (stod(incrSelection.adapted(j).to_string()) >=
-                          stod(incrSelection.adapted(j + 1).to_string())))
+                         (stod(valueString) >= stod(nextValueString)))
                 {
                     errors.push_back(FileScope(selectionLookup.adapted(i)) + Error::IncreaseDecrease(
                         selectionLookup.adapted(i).line(),
@@ -2603,36 +2677,39 @@ bool HIVE::validateDecreaseOver(SchemaAdapter&            schema_node,
         return false;
     }
 
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
     std::string             path = nodePath + "/" + ruleId;
-    if (!inputSelector.parseString(path))
+    if (!compile_query(inputSelector, path, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    selection.set_limit(1);
+    inputSelector->evaluate(input_node, selection);
     if (selection.size() != 0)
     {
-        DefaultSIRENInterpreter inputSelectorlookup(look_up_error);
+        DefaultSIRENQueryCache::Query inputSelectorlookup;
 
-        if (!inputSelectorlookup.parseString(selection.adapted(0).path()))
+        if (!compile_query(inputSelectorlookup, selection.adapted(0).path(),
+                           look_up_error))
         {
             errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                     look_up_error.str()));
             return false;
         }
         SIRENResultSet<InputAdapter> selectionLookup;
-        inputSelectorlookup.evaluate(input_node, selectionLookup);
+        inputSelectorlookup->evaluate(input_node, selectionLookup);
 
         for (size_t i = 0; i < selectionLookup.size(); i++)
         {
-            DefaultSIRENInterpreter decrSelector(look_up_error);
+            DefaultSIRENQueryCache::Query decrSelector;
 
-            if (!decrSelector.parseString(
-                    nodePath.substr(selection.adapted(0).path().length() + 1)))
+            if (!compile_query(decrSelector,
+                               nodePath.substr(selection.adapted(0).path().length() + 1),
+                               look_up_error))
             {
                 errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                         look_up_error.str()));
@@ -2641,17 +2718,20 @@ bool HIVE::validateDecreaseOver(SchemaAdapter&            schema_node,
 
             SIRENResultSet<InputAdapter> decrSelection;
             InputAdapter                 inode = selectionLookup.adapted(i);
-            decrSelector.evaluate(inode, decrSelection);
+            decrSelector->evaluate(inode, decrSelection);
 
             bool numberslegal = true;
 
+            std::string valueString;
+            std::string nextValueString;
             for (size_t j = 0;
                  decrSelection.size() != 0 && j < decrSelection.size() - 1; j++)
             {
+                adapted_string(decrSelection.adapted(j), valueString);
+                adapted_string(decrSelection.adapted(j + 1), nextValueString);
                 if (j == 0)
                 {
-                    std::istringstream issFirst(
-                        decrSelection.adapted(j).to_string());
+                    std::istringstream issFirst(valueString);
                     float ftestFirst;
                     issFirst >> std::noskipws >> ftestFirst;
 
@@ -2674,14 +2754,13 @@ bool HIVE::validateDecreaseOver(SchemaAdapter&            schema_node,
                         errors.push_back(FileScope(decrSelection.adapted(j)) + Error::WrongTypeForRule(
                             decrSelection.adapted(j).line(),
                             decrSelection.adapted(j).column(), valueNodeName,
-                            decrSelection.adapted(j).to_string(), ruleName));
+                            valueString, ruleName));
                         pass         = false;
                         numberslegal = false;
                     }
                 }
 
-                std::istringstream issSecond(
-                    decrSelection.adapted(j + 1).to_string());
+                std::istringstream issSecond(nextValueString);
                 float ftestSecond;
                 issSecond >> std::noskipws >> ftestSecond;
 
@@ -2704,14 +2783,13 @@ bool HIVE::validateDecreaseOver(SchemaAdapter&            schema_node,
                     errors.push_back(FileScope(decrSelection.adapted(j+1)) + Error::WrongTypeForRule(
                         decrSelection.adapted(j + 1).line(),
                         decrSelection.adapted(j + 1).column(), valueNodeName,
-                        decrSelection.adapted(j + 1).to_string(), ruleName));
+                        nextValueString, ruleName));
                     pass         = false;
                     numberslegal = false;
                 }
 
                 if ((numberslegal == true) && (ruleValue == "Mono") &&
-                    (stod(decrSelection.adapted(j).to_string()) <
-                     stod(decrSelection.adapted(j + 1).to_string())))
+                    (stod(valueString) < stod(nextValueString)))
                 {
                     errors.push_back(FileScope(selectionLookup.adapted(i)) + Error::IncreaseDecrease(
                         selectionLookup.adapted(i).line(),
@@ -2723,8 +2801,7 @@ bool HIVE::validateDecreaseOver(SchemaAdapter&            schema_node,
                 }
 
                 else if ((numberslegal == true) && (ruleValue == "Strict") &&
-                         (stod(decrSelection.adapted(j).to_string()) <=
-                          stod(decrSelection.adapted(j + 1).to_string())))
+                         (stod(valueString) <= stod(nextValueString)))
                 {
                     errors.push_back(FileScope(selectionLookup.adapted(i)) + Error::IncreaseDecrease(
                         selectionLookup.adapted(i).line(),
@@ -2752,16 +2829,16 @@ bool HIVE::validateChildAtMostOne(SchemaAdapter&            schema_node,
 
     std::stringstream look_up_error;
 
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node.parent(),
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
     const typename SchemaAdapter::Collection& children =
         schema_node.non_decorative_children();
@@ -2776,9 +2853,9 @@ bool HIVE::validateChildAtMostOne(SchemaAdapter&            schema_node,
         else
             lookupPath = children[j].name();
 
-        DefaultSIRENInterpreter childSelector(look_up_error);
+        DefaultSIRENQueryCache::Query childSelector;
 
-        if (!childSelector.parseString(lookupPath))
+        if (!compile_query(childSelector, lookupPath, look_up_error))
         {
             errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                     look_up_error.str()));
@@ -2789,7 +2866,7 @@ bool HIVE::validateChildAtMostOne(SchemaAdapter&            schema_node,
         {
             SIRENResultSet<InputAdapter> childSelection;
             InputAdapter                 inode = selection.adapted(i);
-            childSelector.evaluate(inode, childSelection);
+            childSelector->evaluate(inode, childSelection);
 
             if (childSelection.size() != 0)
             {
@@ -2869,10 +2946,10 @@ bool HIVE::validateChildExactlyOne(SchemaAdapter&            schema_node,
             lookupPath = children[j].to_string();
         else
             lookupPath = children[j].name();
-        std::stringstream       look_up_error;
-        DefaultSIRENInterpreter childSelector(look_up_error);
+        std::stringstream             look_up_error;
+        DefaultSIRENQueryCache::Query childSelector;
 
-        if (!childSelector.parseString(lookupPath))
+        if (!compile_query(childSelector, lookupPath, look_up_error))
         {
             errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                     look_up_error.str()));
@@ -2883,7 +2960,7 @@ bool HIVE::validateChildExactlyOne(SchemaAdapter&            schema_node,
         {
             SIRENResultSet<InputAdapter> childSelection;
             InputAdapter                 inode = selection.adapted(i);
-            childSelector.evaluate(inode, childSelection);
+            childSelector->evaluate(inode, childSelection);
 
             if (childSelection.size() != 0)
             {
@@ -2982,10 +3059,10 @@ bool HIVE::validateChildAtLeastOne(SchemaAdapter&            schema_node,
             lookupPath = children[j].to_string();
         else
             lookupPath = children[j].name();
-        std::stringstream       look_up_error;
-        DefaultSIRENInterpreter childSelector(look_up_error);
+        std::stringstream             look_up_error;
+        DefaultSIRENQueryCache::Query childSelector;
 
-        if (!childSelector.parseString(lookupPath))
+        if (!compile_query(childSelector, lookupPath, look_up_error))
         {
             errors.push_back(FileScope(children[j]) + Error::SirenParseError(children[j],
                                                     look_up_error.str()));
@@ -2995,7 +3072,7 @@ bool HIVE::validateChildAtLeastOne(SchemaAdapter&            schema_node,
         {
             SIRENResultSet<InputAdapter> childSelection;
             InputAdapter                 inode = selection.adapted(i);
-            childSelector.evaluate(inode, childSelection);
+            childSelector->evaluate(inode, childSelection);
 
             if (childSelection.size() != 0)
             {
@@ -3073,17 +3150,17 @@ bool HIVE::validateChildCountEqual(SchemaAdapter&            schema_node,
         return false;
     }
 
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
     for (size_t i = 0; i < selection.size(); i++)
     {
@@ -3095,11 +3172,11 @@ bool HIVE::validateChildCountEqual(SchemaAdapter&            schema_node,
 
         for (size_t j = 0; j < children.size(); j++)
         {
-            DefaultSIRENInterpreter childSelector(look_up_error);
+            DefaultSIRENQueryCache::Query childSelector;
             std::string lookupPath = children[j].child_count() == 0 ?
                                      children[j].to_string() :
                                      children[j].name();
-            if (!childSelector.parseString(lookupPath))
+            if (!compile_query(childSelector, lookupPath, look_up_error))
             {
                 errors.push_back(FileScope(children[j]) + Error::SirenParseError(children[j],
                                                         look_up_error.str()));
@@ -3107,7 +3184,7 @@ bool HIVE::validateChildCountEqual(SchemaAdapter&            schema_node,
             }
             SIRENResultSet<InputAdapter> childSelection;
             InputAdapter                 inode = selection.adapted(i);
-            childSelector.evaluate(inode, childSelection);
+            childSelector->evaluate(inode, childSelection);
 
             int localSumCount = 0;
             if (children[j].child_count() != 0)
@@ -3198,17 +3275,17 @@ bool HIVE::validateChildUniqueness(SchemaAdapter&            schema_node,
     }
 
     // gather all of the nodes for which this rule applies
-    std::stringstream       look_up_error;
-    DefaultSIRENInterpreter inputSelector(look_up_error);
+    std::stringstream             look_up_error;
+    DefaultSIRENQueryCache::Query inputSelector;
 
-    if (!inputSelector.parseString(nodePath))
+    if (!compile_query(inputSelector, nodePath, look_up_error))
     {
         errors.push_back(FileScope(schema_node) + Error::SirenParseError(schema_node,
                                                 look_up_error.str()));
         return false;
     }
     SIRENResultSet<InputAdapter> selection;
-    inputSelector.evaluate(input_node, selection);
+    inputSelector->evaluate(input_node, selection);
 
     // gather all of the lookup paths for this rule
     const typename SchemaAdapter::Collection& lookupPaths =
@@ -3229,9 +3306,9 @@ bool HIVE::validateChildUniqueness(SchemaAdapter&            schema_node,
 
             // gather all of the nodes that are adapted this lookup path
             // relative to this node
-            DefaultSIRENInterpreter childSelector(look_up_error);
+            DefaultSIRENQueryCache::Query childSelector;
 
-            if (!childSelector.parseString(lookupPath))
+            if (!compile_query(childSelector, lookupPath, look_up_error))
             {
                 errors.push_back(FileScope(lookupPaths[j]) + Error::SirenParseError(lookupPaths[j],
                                                         look_up_error.str()));
@@ -3239,7 +3316,7 @@ bool HIVE::validateChildUniqueness(SchemaAdapter&            schema_node,
             }
             SIRENResultSet<InputAdapter> childSelection;
             InputAdapter                 inode = selection.adapted(i);
-            childSelector.evaluate(inode, childSelection);
+            childSelector->evaluate(inode, childSelection);
 
             // for this node, for this lookup path, loop over all of the
             // relative nodes
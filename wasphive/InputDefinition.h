@@ -17,6 +17,7 @@
 #include <set>
 #include <algorithm>
 #include "waspsiren/SIRENInterpreter.h"
+#include "waspsiren/SIRENQueryCache.h"
 #include "waspsiren/SIRENResultSet.h"
 
 namespace wasp
@@ -1242,13 +1243,13 @@ class ExistsInRule{
 
             for (auto path : this->lookupPathsList)
             {
-                SIRENInterpreter<> selector;
+                auto selector = DefaultSIRENQueryCache::global().compile( path , std::cerr );
 
-                if( !selector.parseString( path ) ) break;
+                if( !selector ) break;
 
                 SIRENResultSet<INPUTNV> results;
 
-                auto selected = selector.evaluate( given_node , results );
+                auto selected = selector->evaluate( given_node , results );
 
                 for(size_t i = 0; i < selected; i++)
                 {
@@ -1288,13 +1289,13 @@ class ExistsInRule{
 
             for (auto path : this->lookupPathsList)
             {
-                SIRENInterpreter<> selector;
+                auto selector = DefaultSIRENQueryCache::global().compile( path , std::cerr );
 
-                if( !selector.parseString( path ) ) break;
+                if( !selector ) break;
 
                 SIRENResultSet<INPUTNV> results;
 
-                auto selected = selector.evaluate( given_node , results );
+                auto selected = selector->evaluate( given_node , results );
 
                 for(size_t i = 0; i < selected; i++)
                 {
@@ -1664,13 +1665,13 @@ class ChildAtMostOneRule{
 
                 // lookup other paths in the input
 
-                SIRENInterpreter<> selector;
+                auto selector = DefaultSIRENQueryCache::global().compile( pair_path , std::cerr );
 
-                if( !selector.parseString( pair_path ) ) continue;
+                if( !selector ) continue;
 
                 SIRENResultSet<INPUTNV> results;
 
-                auto selected = selector.evaluate( *node , results );
+                auto selected = selector->evaluate( *node , results );
 
                 if( selected > 0 )
                 {
@@ -1767,13 +1768,13 @@ class ChildExactlyOneRule{
 
                 // lookup other paths in the input
 
-                SIRENInterpreter<> selector;
+                auto selector = DefaultSIRENQueryCache::global().compile( pair_path , std::cerr );
 
-                if( !selector.parseString( pair_path ) ) continue;
+                if( !selector ) continue;
 
                 SIRENResultSet<INPUTNV> results;
 
-                auto selected = selector.evaluate( *node , results );
+                auto selected = selector->evaluate( *node , results );
 
                 if( selected > 0 )
                 {
@@ -8,6 +8,9 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "wasphive/test/Paths.h"
 
@@ -208,4 +211,100 @@ TEST(HIVE, validation_with_imports)
 {
     SCOPED_TRACE("imports");
     do_test("imports");
-}
\ No newline at end of file
+}
+/**
+ * @brief Test frozen documents are validated and traversed by many threads
+ * at once
+ */
+TEST(HIVE, frozen_concurrent_validation)
+{
+    std::vector<std::string> names = {"ExistsIn", "SumOverGroup",
+                                      "ChildUniqueness", "UnknownNode"};
+    std::vector<HIVETest>    tests(names.size());
+    std::vector<std::string> expected(names.size());
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        auto& t = tests[i];
+        ASSERT_TRUE(load_streams(t, names[i] + ".fail.son",
+                                 names[i] + ".pass.son",
+                                 names[i] + ".fail.gld", names[i] + ".sch"));
+        ASSERT_TRUE(load_ast(t));
+        t.schema_interpreter->freeze();
+        t.input_fail_interpreter->freeze();
+        ASSERT_TRUE(t.schema_interpreter->frozen());
+        expected[i] = t.output_data->str();
+    }
+
+    // a document with a parent large enough to be indexed by name
+    std::stringstream input;
+    const size_t      object_count = 1000;
+    for (size_t i = 0; i < object_count; ++i)
+    {
+        input << "obj" << i % 10 << "{ value=" << i << " }" << std::endl;
+    }
+    DefaultSONInterpreter large;
+    ASSERT_TRUE(large.parse(input));
+    large.freeze();
+    // a frozen document cannot be reinterpreted until reset
+    std::stringstream again("x=1");
+    ASSERT_THROW(large.parse(again), std::runtime_error);
+
+    const size_t             thread_count = 8;
+    std::vector<std::string> results(thread_count);
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < thread_count; ++thread)
+    {
+        threads.emplace_back([&, thread]() {
+            std::stringstream result;
+            for (int repeat = 0; repeat < 10; ++repeat)
+            {
+                for (auto& t : tests)
+                {
+                    HIVE                     hive;
+                    std::vector<std::string> errors;
+                    SONNodeView schema = t.schema_interpreter->root();
+                    SONNodeView fail   = t.input_fail_interpreter->root();
+                    hive.validate(schema, fail, errors);
+                    result << HIVE::combine(errors);
+                }
+                SONNodeView root = large.root();
+                for (size_t n = 0; n < 10; ++n)
+                {
+                    std::string name = "obj" + std::to_string(n);
+                    result << root.child_count_by_name(name) << " "
+                           << root.first_child_by_name(name)
+                                  .first_child_by_name("value")
+                                  .last_as_string()
+                           << std::endl;
+                }
+            }
+            results[thread] = result.str();
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::stringstream expected_result;
+    for (int repeat = 0; repeat < 10; ++repeat)
+    {
+        for (const auto& e : expected)
+        {
+            expected_result << e;
+        }
+        for (size_t n = 0; n < 10; ++n)
+        {
+            expected_result << object_count / 10 << " " << n << std::endl;
+        }
+    }
+    for (const auto& result : results)
+    {
+        ASSERT_EQ(expected_result.str(), result);
+    }
+
+    large.reset();
+    ASSERT_FALSE(large.frozen());
+    std::stringstream reparse("x=1");
+    ASSERT_TRUE(large.parse(reparse));
+}
@@ -0,0 +1,86 @@
+#include "waspcore/wasp_bug.h"
+#include "waspson/SONInterpreter.h"
+#include "wasphive/HIVE.h"
+#include "waspson/SONNodeView.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace wasp;
+
+/**
+ * @brief validate_large_input validates a large input whose every other value
+ * violates the schema, producing diagnostics that require line and column
+ * lookups for a significant fraction of the document's tokens
+ * @param line_index whether the input interpreter indexes token lines
+ * @param errors the validation errors produced
+ */
+void validate_large_input(bool line_index, std::vector<std::string>& errors)
+{
+    // ~500k tokens, one value per line
+    const std::size_t value_count = 500000;
+    std::stringstream input;
+    input << "test{" << std::endl << "    values=[" << std::endl;
+    for (std::size_t i = 0; i < value_count; ++i)
+    {
+        input << "        " << (i % 2 == 0 ? "1" : "100") << std::endl;
+    }
+    input << "    ]" << std::endl << "}" << std::endl;
+
+    std::stringstream schema;
+    schema << "test{ values{ value{ MaxValInc=50 } } }";
+
+    DefaultSONInterpreter schema_interpreter;
+    ASSERT_TRUE(schema_interpreter.parse(schema));
+
+    DefaultSONInterpreter input_interpreter;
+    if (line_index)
+    {
+        input_interpreter.enable_line_index();
+    }
+    wasp_timer(parse_timer);
+    wasp_timer_start(parse_timer);
+    ASSERT_TRUE(input_interpreter.parse(input));
+    wasp_timer_stop(parse_timer);
+    ASSERT_EQ(line_index, input_interpreter.has_line_index());
+    ASSERT_GE(input_interpreter.token_count(), value_count);
+
+    HIVE        hive;
+    SONNodeView schema_root = schema_interpreter.root();
+    SONNodeView input_root  = input_interpreter.root();
+    wasp_timer(validate_timer);
+    wasp_timer_start(validate_timer);
+    ASSERT_FALSE(hive.validate(schema_root, input_root, errors));
+    wasp_timer_stop(validate_timer);
+    ASSERT_EQ(value_count / 2, errors.size());
+
+    wasp_timer_block(std::cout << (line_index ? "indexed" : "searched")
+                               << " lines - parse "
+                               << parse_timer.duration() / 1e6 << " ms, "
+                               << "validate "
+                               << validate_timer.duration() / 1e6 << " ms"
+                               << std::endl);
+}
+
+TEST(HIVE, benchmark_line_index)
+{
+    std::vector<std::string> searched_errors, indexed_errors;
+    {
+        SCOPED_TRACE("searched");
+        validate_large_input(false, searched_errors);
+    }
+    {
+        SCOPED_TRACE("indexed");
+        validate_large_input(true, indexed_errors);
+    }
+    ASSERT_EQ(searched_errors.size(), indexed_errors.size());
+    for (std::size_t i = 0; i < searched_errors.size(); ++i)
+    {
+        ASSERT_EQ(searched_errors[i], indexed_errors[i]);
+    }
+    ASSERT_EQ("line:4 column:9 - Validation Error: values value \"100\" is "
+              "greater than the allowed maximum inclusive value of 50",
+              indexed_errors.front());
+}
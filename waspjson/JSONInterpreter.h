@@ -18,6 +18,7 @@
 #include "waspcore/Object.h"
 #include "waspjson/JSONParser.hpp"
 #include "waspcore/Interpreter.h"
+#include "waspcore/MappedFile.h"
 #include "waspcore/wasp_node.h"
 #include "waspcore/decl.h"
 
@@ -46,7 +46,7 @@ bool JSONInterpreter<S>::parseStream(std::istream&      in,
 template<class S>
 bool JSONInterpreter<S>::parseFile(const std::string& filename, size_t line)
 {
-    std::ifstream in(filename.c_str());
+    MappedFile in(filename);
     if (!in.good())
     {
         Interpreter<S>::error_diagnostic()
@@ -122,6 +122,44 @@ std::string JSONNodeView::data() const
     return str.str();
 }
 
+StringView JSONNodeView::data_view() const
+{
+    wasp_insist(m_pool->is_leaf(m_node_index),
+                "only a leaf node's data can be viewed without a buffer!");
+    std::string unused;
+    return m_pool->data_view(m_node_index, unused);
+}
+
+StringView JSONNodeView::data_view(std::string& buffer) const
+{
+    return m_pool->data_view(m_node_index, buffer);
+}
+
+std::uint64_t JSONNodeView::subtree_hash() const
+{
+    return m_pool->subtree_hash(m_node_index);
+}
+
+size_t JSONNodeView::packed_size() const
+{
+    return m_pool->packed_size(m_node_index);
+}
+
+Span<const std::int64_t> JSONNodeView::packed_integers() const
+{
+    return m_pool->packed_integers(m_node_index);
+}
+
+Span<const double> JSONNodeView::packed_reals() const
+{
+    return m_pool->packed_reals(m_node_index);
+}
+
+std::string JSONNodeView::packed_data(size_t element) const
+{
+    return m_pool->packed_data(m_node_index, element);
+}
+
 void JSONNodeView::set_data(const char* data)
 {
     NodeView view(node_index(), *node_pool());
@@ -213,6 +251,11 @@ const char* JSONNodeView::name() const
     return m_pool->name(m_node_index);
 }
 
+StringView JSONNodeView::name_view() const
+{
+    return m_pool->name_view(m_node_index);
+}
+
 std::size_t JSONNodeView::line() const
 {
     return m_pool->line(m_node_index);
@@ -260,6 +303,19 @@ std::string JSONNodeView::to_string(bool* ok) const
     return result;
 }
 
+StringView JSONNodeView::to_string_view(std::string& buffer) const
+{
+    NodeView   view(node_index(), *node_pool());
+    StringView data = view.to_string_view(buffer);
+    // only escaped data differs from its unescaped string
+    if (std::find(data.begin(), data.end(), '\\') == data.end())
+    {
+        return data;
+    }
+    buffer = json_unescape_string(std::string(data.data(), data.size()));
+    return StringView(buffer);
+}
+
 std::string JSONNodeView::last_as_string(bool* ok) const
 {
     return wasp::last_as_string(*this, ok);
@@ -62,8 +62,21 @@
 #undef yylex
 #define yylex lexer->lex
 
+/* append the member, and any separator preceding it, to the members of an
+ * object or array, unless they are members of the root and streamed */
+static void push_member(wasp::AbstractInterpreter& interpreter
+                        ,std::vector<size_t>& members
+                        ,const std::vector<size_t>& member_indices)
+{
+    if (!interpreter.stream_root_members(member_indices))
+    {
+        members.insert(members.end()
+                       ,member_indices.begin(), member_indices.end());
+    }
+}
+
 
-#line 67 "JSONParser.cpp"
+#line 80 "JSONParser.cpp"
 
 
 
@@ -157,7 +170,7 @@
 
 #line 34 "JSONParser.bison"
 namespace wasp {
-#line 161 "JSONParser.cpp"
+#line 174 "JSONParser.cpp"
 
   /// Build a parser object.
   JSONParser::JSONParser (class AbstractInterpreter& interpreter_yyarg, std::istream &input_stream_yyarg, std::shared_ptr<class JSONLexerImpl> lexer_yyarg)
@@ -370,32 +383,32 @@ namespace wasp {
     {
       case symbol_kind::S_declaration: // declaration
 #line 98 "JSONParser.bison"
-                    { delete (yysym.value.node_indices); }
-#line 375 "JSONParser.cpp"
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
+#line 388 "JSONParser.cpp"
         break;
 
       case symbol_kind::S_array: // array
 #line 98 "JSONParser.bison"
-                    { delete (yysym.value.node_indices); }
-#line 381 "JSONParser.cpp"
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
+#line 394 "JSONParser.cpp"
         break;
 
       case symbol_kind::S_object: // object
 #line 98 "JSONParser.bison"
-                    { delete (yysym.value.node_indices); }
-#line 387 "JSONParser.cpp"
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
+#line 400 "JSONParser.cpp"
         break;
 
       case symbol_kind::S_array_members: // array_members
 #line 98 "JSONParser.bison"
-                    { delete (yysym.value.node_indices); }
-#line 393 "JSONParser.cpp"
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
+#line 406 "JSONParser.cpp"
         break;
 
       case symbol_kind::S_object_members: // object_members
 #line 98 "JSONParser.bison"
-                    { delete (yysym.value.node_indices); }
-#line 399 "JSONParser.cpp"
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
+#line 412 "JSONParser.cpp"
         break;
 
       default:
@@ -541,7 +554,7 @@ namespace wasp {
     lexer = std::make_shared<JSONLexerImpl>(interpreter,&input_stream);
 }
 
-#line 545 "JSONParser.cpp"
+#line 558 "JSONParser.cpp"
 
 
     /* Initialize the stack.  The initial state will be set in
@@ -677,110 +690,110 @@ namespace wasp {
           switch (yyn)
             {
   case 2: // comma: ","
-#line 117 "JSONParser.bison"
+#line 130 "JSONParser.bison"
     {
         auto token_index = ((yystack_[0].value.token_index));
         (yylhs.value.node_index) = interpreter.push_leaf(wasp::WASP_COMMA,",",token_index);
     }
-#line 686 "JSONParser.cpp"
+#line 699 "JSONParser.cpp"
     break;
 
   case 3: // BOOLEAN: "true"
-#line 121 "JSONParser.bison"
+#line 134 "JSONParser.bison"
           { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 692 "JSONParser.cpp"
+#line 705 "JSONParser.cpp"
     break;
 
   case 4: // BOOLEAN: "false"
-#line 121 "JSONParser.bison"
+#line 134 "JSONParser.bison"
                        { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 698 "JSONParser.cpp"
+#line 711 "JSONParser.cpp"
     break;
 
   case 5: // lbrace: "{"
-#line 124 "JSONParser.bison"
+#line 137 "JSONParser.bison"
     {
         auto token_index = ((yystack_[0].value.token_index));
         (yylhs.value.node_index) = interpreter.push_leaf(wasp::LBRACE,"{",token_index);
     }
-#line 707 "JSONParser.cpp"
+#line 720 "JSONParser.cpp"
     break;
 
   case 6: // rbrace: "}"
-#line 129 "JSONParser.bison"
+#line 142 "JSONParser.bison"
     {
         auto token_index = ((yystack_[0].value.token_index));
         (yylhs.value.node_index) = interpreter.push_leaf(wasp::RBRACE,"}",token_index);
     }
-#line 716 "JSONParser.cpp"
+#line 729 "JSONParser.cpp"
     break;
 
   case 7: // lbracket: "["
-#line 134 "JSONParser.bison"
+#line 147 "JSONParser.bison"
     {
         auto token_index = ((yystack_[0].value.token_index));
         (yylhs.value.node_index) = interpreter.push_leaf(wasp::LBRACKET,"[",token_index);
     }
-#line 725 "JSONParser.cpp"
+#line 738 "JSONParser.cpp"
     break;
 
   case 8: // rbracket: "]"
-#line 139 "JSONParser.bison"
+#line 152 "JSONParser.bison"
     {
         auto token_index = ((yystack_[0].value.token_index));
         (yylhs.value.node_index) = interpreter.push_leaf(wasp::RBRACKET,"]",token_index);
     }
-#line 734 "JSONParser.cpp"
+#line 747 "JSONParser.cpp"
     break;
 
   case 9: // ANY_STRING: "quoted string"
-#line 144 "JSONParser.bison"
+#line 157 "JSONParser.bison"
              { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 740 "JSONParser.cpp"
+#line 753 "JSONParser.cpp"
     break;
 
   case 10: // PRIMITIVE: "quoted string"
-#line 145 "JSONParser.bison"
+#line 158 "JSONParser.bison"
             { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 746 "JSONParser.cpp"
+#line 759 "JSONParser.cpp"
     break;
 
   case 11: // PRIMITIVE: "integer"
-#line 145 "JSONParser.bison"
+#line 158 "JSONParser.bison"
                       { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 752 "JSONParser.cpp"
+#line 765 "JSONParser.cpp"
     break;
 
   case 12: // PRIMITIVE: "double"
-#line 145 "JSONParser.bison"
+#line 158 "JSONParser.bison"
                                 { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 758 "JSONParser.cpp"
+#line 771 "JSONParser.cpp"
     break;
 
   case 13: // PRIMITIVE: BOOLEAN
-#line 145 "JSONParser.bison"
+#line 158 "JSONParser.bison"
                                          { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 764 "JSONParser.cpp"
+#line 777 "JSONParser.cpp"
     break;
 
   case 14: // PRIMITIVE: "null"
-#line 145 "JSONParser.bison"
+#line 158 "JSONParser.bison"
                                                    { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 770 "JSONParser.cpp"
+#line 783 "JSONParser.cpp"
     break;
 
   case 15: // primitive: PRIMITIVE
-#line 148 "JSONParser.bison"
+#line 161 "JSONParser.bison"
 {
     size_t token_index = ((yystack_[0].value.token_index));
     (yylhs.value.node_index) = interpreter.push_leaf(wasp::VALUE,"value"
                      ,token_index);
 }
-#line 780 "JSONParser.cpp"
+#line 793 "JSONParser.cpp"
     break;
 
   case 16: // decl: ANY_STRING
-#line 154 "JSONParser.bison"
+#line 167 "JSONParser.bison"
     {
         auto token_index = ((yystack_[0].value.token_index));
         std::string quote_less_data = interpreter.token_data(token_index);
@@ -789,127 +802,129 @@ namespace wasp {
                                    ,"decl"
                                    ,token_index);
     }
-#line 793 "JSONParser.cpp"
+#line 806 "JSONParser.cpp"
     break;
 
   case 17: // ASSIGNMENT: ":"
-#line 162 "JSONParser.bison"
+#line 175 "JSONParser.bison"
              { (yylhs.value.token_index) = (yystack_[0].value.token_index); }
-#line 799 "JSONParser.cpp"
+#line 812 "JSONParser.cpp"
     break;
 
   case 18: // assignment: ASSIGNMENT
-#line 163 "JSONParser.bison"
+#line 176 "JSONParser.bison"
                         {
              auto token_index = ((yystack_[0].value.token_index));
              (yylhs.value.node_index) = interpreter.push_leaf(wasp::ASSIGN,":",token_index);
             }
-#line 808 "JSONParser.cpp"
+#line 821 "JSONParser.cpp"
     break;
 
   case 19: // declaration: decl assignment
-#line 168 "JSONParser.bison"
+#line 181 "JSONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
-#line 818 "JSONParser.cpp"
+#line 831 "JSONParser.cpp"
     break;
 
   case 20: // array: lbracket rbracket
-#line 176 "JSONParser.bison"
+#line 189 "JSONParser.bison"
     {
-        (yylhs.value.node_indices) = new std::vector<size_t>();
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices();
         (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
         (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
     }
-#line 828 "JSONParser.cpp"
+#line 841 "JSONParser.cpp"
     break;
 
   case 21: // array: lbracket "end of file"
-#line 182 "JSONParser.bison"
+#line 195 "JSONParser.bison"
     {
         error(yystack_[0].location, "array has unmatched left bracket!");
         YYERROR;
         (yylhs.value.node_indices) = nullptr;
     }
-#line 838 "JSONParser.cpp"
+#line 851 "JSONParser.cpp"
     break;
 
   case 22: // array: lbracket array_members "end of file"
-#line 188 "JSONParser.bison"
+#line 201 "JSONParser.bison"
     {
         std::string name = "object";
-        auto last_component_type = interpreter.type((yystack_[1].value.node_indices)->back());
+        size_t last_component_type = (yystack_[1].value.node_indices)->empty() ? size_t(wasp::UNKNOWN)
+                                                 : interpreter.type((yystack_[1].value.node_indices)->back());
         if( (yystack_[1].value.node_indices)->size() ==0 ) error(yystack_[2].location, name+" has unmatched left bracket!");
         else if( last_component_type == wasp::OBJECT ) error(yystack_[2].location, name+" or one of its components has unmatched left bracket!");
         else error(yystack_[2].location, name+" has unmatched left bracket!");
-        delete (yystack_[1].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
         YYERROR;
         (yylhs.value.node_indices) = nullptr;
     }
-#line 853 "JSONParser.cpp"
+#line 867 "JSONParser.cpp"
     break;
 
   case 23: // array: lbracket array_members rbracket
-#line 199 "JSONParser.bison"
+#line 213 "JSONParser.bison"
     {
             (yystack_[1].value.node_indices)->insert((yystack_[1].value.node_indices)->begin(),(yystack_[2].value.node_index));
             (yystack_[1].value.node_indices)->push_back((yystack_[0].value.node_index));
             (yylhs.value.node_indices) = (yystack_[1].value.node_indices);
     }
-#line 863 "JSONParser.cpp"
+#line 877 "JSONParser.cpp"
     break;
 
   case 24: // object: lbrace rbrace
-#line 205 "JSONParser.bison"
+#line 219 "JSONParser.bison"
     {
-        (yylhs.value.node_indices) = new std::vector<size_t>();
+        (yylhs.value.node_indices) = interpreter.acquire_child_indices();
         (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
         (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
     }
-#line 873 "JSONParser.cpp"
+#line 887 "JSONParser.cpp"
     break;
 
   case 25: // object: lbrace "end of file"
-#line 211 "JSONParser.bison"
+#line 225 "JSONParser.bison"
     {
         error(yystack_[0].location, "object has unmatched left brace!");
         YYERROR;
         (yylhs.value.node_indices) = nullptr;
     }
-#line 883 "JSONParser.cpp"
+#line 897 "JSONParser.cpp"
     break;
 
   case 26: // object: lbrace object_members "end of file"
-#line 217 "JSONParser.bison"
+#line 231 "JSONParser.bison"
     {
         // TODO capture partial definition
         std::string name = "object";
-        auto last_component_type = interpreter.type((yystack_[1].value.node_indices)->back());
+        size_t last_component_type = (yystack_[1].value.node_indices)->empty() ? size_t(wasp::UNKNOWN)
+                                                 : interpreter.type((yystack_[1].value.node_indices)->back());
         if( (yystack_[1].value.node_indices)->size() ==0 ) error(yystack_[2].location, name+" has unmatched left brace!");
         else if( last_component_type == wasp::OBJECT ) error(yystack_[2].location, name+" or one of its components has unmatched left brace!");
         else error(yystack_[2].location, name+" has unmatched left brace!");
-        delete (yystack_[1].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
         YYERROR;
         (yylhs.value.node_indices) = nullptr;
     }
-#line 899 "JSONParser.cpp"
+#line 914 "JSONParser.cpp"
     break;
 
   case 27: // object: lbrace object_members rbrace
-#line 229 "JSONParser.bison"
+#line 244 "JSONParser.bison"
     {
         (yystack_[1].value.node_indices)->insert((yystack_[1].value.node_indices)->begin(),(yystack_[2].value.node_index));
         (yystack_[1].value.node_indices)->push_back((yystack_[0].value.node_index));
         (yylhs.value.node_indices) = (yystack_[1].value.node_indices);
     }
-#line 909 "JSONParser.cpp"
+#line 924 "JSONParser.cpp"
     break;
 
   case 28: // keyed_primitive: declaration primitive
-#line 237 "JSONParser.bison"
+#line 252 "JSONParser.bison"
     {
         (yystack_[1].value.node_indices)->push_back((yystack_[0].value.node_index));
         std::string quote_less_data = interpreter.data((yystack_[1].value.node_indices)->front());
@@ -917,13 +932,13 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::KEYED_VALUE
                                     ,quote_less_data.c_str()
                                     ,*(yystack_[1].value.node_indices));
-        delete (yystack_[1].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
     }
-#line 923 "JSONParser.cpp"
+#line 938 "JSONParser.cpp"
     break;
 
   case 29: // keyed_object: declaration object
-#line 247 "JSONParser.bison"
+#line 262 "JSONParser.bison"
     {
         for( size_t i = 0; i < (yystack_[0].value.node_indices)->size(); ++i )
         {
@@ -934,14 +949,14 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::OBJECT
                                     ,quote_less_data.c_str()
                                     ,*(yystack_[1].value.node_indices));
-        delete (yystack_[1].value.node_indices);
-        delete (yystack_[0].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
+        interpreter.release_child_indices((yystack_[0].value.node_indices));
     }
-#line 941 "JSONParser.cpp"
+#line 956 "JSONParser.cpp"
     break;
 
   case 30: // keyed_array: declaration array
-#line 261 "JSONParser.bison"
+#line 276 "JSONParser.bison"
     {
         for( size_t i = 0; i < (yystack_[0].value.node_indices)->size(); ++i )
         {
@@ -952,166 +967,160 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::ARRAY
                                     ,quote_less_data.c_str()
                                     ,*(yystack_[1].value.node_indices));
-        delete (yystack_[1].value.node_indices);
-        delete (yystack_[0].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
+        interpreter.release_child_indices((yystack_[0].value.node_indices));
     }
-#line 959 "JSONParser.cpp"
+#line 974 "JSONParser.cpp"
     break;
 
   case 31: // array_members: object
-#line 275 "JSONParser.bison"
+#line 290 "JSONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             size_t obj_i = interpreter.push_parent(wasp::OBJECT
                                         ,"value"
                                         ,*(yystack_[0].value.node_indices));
-            (yylhs.value.node_indices)->push_back(obj_i);
-            delete (yystack_[0].value.node_indices);
+            push_member(interpreter, *(yylhs.value.node_indices), {obj_i});
+            interpreter.release_child_indices((yystack_[0].value.node_indices));
         }
-#line 972 "JSONParser.cpp"
+#line 987 "JSONParser.cpp"
     break;
 
   case 32: // array_members: array_members comma object
-#line 284 "JSONParser.bison"
+#line 299 "JSONParser.bison"
         {
             (yylhs.value.node_indices) = (yystack_[2].value.node_indices);
-            (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
             size_t obj_i = interpreter.push_parent(wasp::OBJECT
                                         ,"value"
                                         ,*(yystack_[0].value.node_indices));
-            (yylhs.value.node_indices)->push_back(obj_i);
-            delete (yystack_[0].value.node_indices);
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[1].value.node_index), obj_i});
+            interpreter.release_child_indices((yystack_[0].value.node_indices));
         }
-#line 986 "JSONParser.cpp"
+#line 1000 "JSONParser.cpp"
     break;
 
   case 33: // array_members: array
-#line 294 "JSONParser.bison"
+#line 308 "JSONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             size_t arr_i = interpreter.push_parent(wasp::ARRAY
                                         ,"value"
                                         ,*(yystack_[0].value.node_indices));
-            (yylhs.value.node_indices)->push_back(arr_i);
-            delete (yystack_[0].value.node_indices);
+            push_member(interpreter, *(yylhs.value.node_indices), {arr_i});
+            interpreter.release_child_indices((yystack_[0].value.node_indices));
         }
-#line 999 "JSONParser.cpp"
+#line 1013 "JSONParser.cpp"
     break;
 
   case 34: // array_members: array_members comma array
-#line 303 "JSONParser.bison"
+#line 317 "JSONParser.bison"
         {
             (yylhs.value.node_indices) = (yystack_[2].value.node_indices);
-            (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
             size_t arr_i = interpreter.push_parent(wasp::ARRAY
                                         ,"value"
                                         ,*(yystack_[0].value.node_indices));
-            (yylhs.value.node_indices)->push_back(arr_i);
-            delete (yystack_[0].value.node_indices);
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[1].value.node_index), arr_i});
+            interpreter.release_child_indices((yystack_[0].value.node_indices));
         }
-#line 1013 "JSONParser.cpp"
+#line 1026 "JSONParser.cpp"
     break;
 
   case 35: // array_members: primitive
-#line 313 "JSONParser.bison"
+#line 326 "JSONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
-            (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[0].value.node_index)});
         }
-#line 1022 "JSONParser.cpp"
+#line 1035 "JSONParser.cpp"
     break;
 
   case 36: // array_members: array_members comma primitive
-#line 318 "JSONParser.bison"
+#line 331 "JSONParser.bison"
         {
             (yylhs.value.node_indices) = (yystack_[2].value.node_indices);
-            (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
-            (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[1].value.node_index), (yystack_[0].value.node_index)});
         }
-#line 1032 "JSONParser.cpp"
+#line 1044 "JSONParser.cpp"
     break;
 
   case 37: // object_members: keyed_object
-#line 324 "JSONParser.bison"
+#line 336 "JSONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
-            (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[0].value.node_index)});
         }
-#line 1041 "JSONParser.cpp"
+#line 1053 "JSONParser.cpp"
     break;
 
   case 38: // object_members: object_members comma keyed_object
-#line 329 "JSONParser.bison"
+#line 341 "JSONParser.bison"
         {
             (yylhs.value.node_indices) = (yystack_[2].value.node_indices);
-            (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
-            (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[1].value.node_index), (yystack_[0].value.node_index)});
         }
-#line 1051 "JSONParser.cpp"
+#line 1062 "JSONParser.cpp"
     break;
 
   case 39: // object_members: keyed_array
-#line 335 "JSONParser.bison"
+#line 346 "JSONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
-            (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[0].value.node_index)});
         }
-#line 1060 "JSONParser.cpp"
+#line 1071 "JSONParser.cpp"
     break;
 
   case 40: // object_members: object_members comma keyed_array
-#line 340 "JSONParser.bison"
+#line 351 "JSONParser.bison"
         {
             (yylhs.value.node_indices) = (yystack_[2].value.node_indices);
-            (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
-            (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[1].value.node_index), (yystack_[0].value.node_index)});
         }
-#line 1070 "JSONParser.cpp"
+#line 1080 "JSONParser.cpp"
     break;
 
   case 41: // object_members: keyed_primitive
-#line 346 "JSONParser.bison"
+#line 356 "JSONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
-            (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[0].value.node_index)});
         }
-#line 1079 "JSONParser.cpp"
+#line 1089 "JSONParser.cpp"
     break;
 
   case 42: // object_members: object_members comma keyed_primitive
-#line 351 "JSONParser.bison"
+#line 361 "JSONParser.bison"
         {
             (yylhs.value.node_indices) = (yystack_[2].value.node_indices);
-            (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
-            (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
+            push_member(interpreter, *(yylhs.value.node_indices), {(yystack_[1].value.node_index), (yystack_[0].value.node_index)});
         }
-#line 1089 "JSONParser.cpp"
+#line 1098 "JSONParser.cpp"
     break;
 
   case 44: // start: object
-#line 357 "JSONParser.bison"
+#line 366 "JSONParser.bison"
                 {
             interpreter.staged_type(0) = wasp::OBJECT;
             interpreter.push_staged_child(*(yystack_[0].value.node_indices));
-            delete (yystack_[0].value.node_indices);
+            interpreter.release_child_indices((yystack_[0].value.node_indices));
             if(interpreter.single_parse() ) {lexer->rewind();YYACCEPT;}
         }
-#line 1100 "JSONParser.cpp"
+#line 1109 "JSONParser.cpp"
     break;
 
   case 45: // start: array
-#line 363 "JSONParser.bison"
+#line 372 "JSONParser.bison"
                {
             interpreter.staged_type(0) = wasp::ARRAY;
             interpreter.push_staged_child(*(yystack_[0].value.node_indices));
-            delete (yystack_[0].value.node_indices);
+            interpreter.release_child_indices((yystack_[0].value.node_indices));
             if(interpreter.single_parse() ) {lexer->rewind();YYACCEPT;}
         }
-#line 1111 "JSONParser.cpp"
+#line 1120 "JSONParser.cpp"
     break;
 
 
-#line 1115 "JSONParser.cpp"
+#line 1124 "JSONParser.cpp"
 
             default:
               break;
@@ -1581,11 +1590,11 @@ namespace wasp {
   const short
   JSONParser::yyrline_[] =
   {
-       0,   116,   116,   121,   121,   123,   128,   133,   138,   144,
-     145,   145,   145,   145,   145,   147,   153,   162,   163,   167,
-     175,   181,   187,   198,   204,   210,   216,   228,   236,   246,
-     260,   274,   283,   293,   302,   312,   317,   323,   328,   334,
-     339,   345,   350,   356,   357,   363
+       0,   129,   129,   134,   134,   136,   141,   146,   151,   157,
+     158,   158,   158,   158,   158,   160,   166,   175,   176,   180,
+     188,   194,   200,   212,   218,   224,   230,   243,   251,   261,
+     275,   289,   298,   307,   316,   325,   330,   335,   340,   345,
+     350,   355,   360,   365,   366,   372
   };
 
   void
@@ -1666,9 +1675,9 @@ namespace wasp {
 
 #line 34 "JSONParser.bison"
 } // wasp
-#line 1670 "JSONParser.cpp"
+#line 1679 "JSONParser.cpp"
 
-#line 372 "JSONParser.bison"
+#line 381 "JSONParser.bison"
  /*** Additional Code ***/
 
 void wasp::JSONParser::error(const JSONParser::location_type& l,
@@ -5,6 +5,7 @@
  * Created on September 26, 2013, 11:43 AM
  */
 
+#include <algorithm>
 #include <cstdlib>
 #include <sstream>
 #include <string>
@@ -269,6 +270,110 @@ TEST(JSON, simple_array)
     ASSERT_EQ(input.str(), document.data());
 }
 
+TEST(JSON, pack_arrays)
+{
+    std::stringstream input;
+    input << R"I({"x":[1, 2.5 ,-3], "y":[[1,2],[3,4]]})I";
+    DefaultJSONInterpreter interpreter;
+    ASSERT_TRUE(interpreter.parse(input));
+    interpreter.pack_arrays(2);
+    auto x = interpreter.root().first_child_by_name("x");
+    ASSERT_EQ(3, x.packed_size());
+    ASSERT_EQ(-3.0, x.packed_reals()[2]);
+    // the elements' commas are printed immediately following them
+    ASSERT_EQ(R"I("x":[1, 2.5, -3])I", x.data());
+    auto y = interpreter.root().first_child_by_name("y");
+    ASSERT_EQ(0, y.packed_size());
+    ASSERT_EQ(4, y.child_at(5).packed_integers()[1]);
+    std::stringstream printed;
+    wasp::print(printed, interpreter.root());
+    ASSERT_EQ(R"I({"x":[1, 2.5, -3], "y":[[1,2],[3,4]]})I", printed.str());
+}
+
+namespace
+{
+// record a streamed document's events, one per line
+class EventRecorder : public StreamHandler
+{
+  public:
+    EventRecorder(const DefaultJSONInterpreter& interpreter)
+        : interpreter(interpreter), max_node_count(0)
+    {
+    }
+    void start_object(std::size_t type, StringView name, std::size_t, std::size_t)
+    {
+        record() << "{" << type << " " << name;
+    }
+    void key(StringView name, std::size_t, std::size_t)
+    {
+        record() << "key " << name;
+    }
+    void value(StringView data, std::size_t, std::size_t)
+    {
+        record() << "value " << data;
+    }
+    void end_object(std::size_t type, StringView name, std::size_t, std::size_t)
+    {
+        record() << "}" << type << " " << name;
+    }
+    std::ostream& record()
+    {
+        max_node_count = std::max(max_node_count, interpreter.node_count());
+        if (events.tellp() > 0)
+            events << std::endl;
+        return events;
+    }
+    const DefaultJSONInterpreter& interpreter;
+    std::size_t                   max_node_count;
+    std::stringstream             events;
+};
+}  // namespace
+
+TEST(JSON, stream)
+{
+    std::stringstream input;
+    input << R"I({"a":1, "o":{"b":[true, null]}, "c":"s"})I";
+    DefaultJSONInterpreter interpreter;
+    EventRecorder          recorder(interpreter);
+    interpreter.set_stream_handler(&recorder);
+    ASSERT_TRUE(interpreter.parse(input));
+    std::stringstream expected;
+    expected << "key a" << std::endl
+             << "value 1" << std::endl
+             << "{" << std::size_t(wasp::OBJECT) << " o" << std::endl
+             << "{" << std::size_t(wasp::ARRAY) << " b" << std::endl
+             << "value true" << std::endl
+             << "value null" << std::endl
+             << "}" << std::size_t(wasp::ARRAY) << " b" << std::endl
+             << "}" << std::size_t(wasp::OBJECT) << " o" << std::endl
+             << "key c" << std::endl
+             << "value \"s\"";
+    ASSERT_EQ(expected.str(), recorder.events.str());
+    ASSERT_EQ(0, interpreter.node_count());
+
+    // the root array's elements are streamed as they are parsed
+    interpreter.reset();
+    std::stringstream array_input;
+    array_input << "[";
+    for (int i = 0; i < 1000; ++i)
+    {
+        array_input << (i > 0 ? ", " : "") << R"I({"k":)I" << i << "}";
+    }
+    array_input << "]";
+    EventRecorder array_recorder(interpreter);
+    interpreter.set_stream_handler(&array_recorder);
+    ASSERT_TRUE(interpreter.parse(array_input));
+    ASSERT_EQ(0, interpreter.node_count());
+    ASSERT_GE(10, array_recorder.max_node_count);
+    std::stringstream last;
+    last << "{" << std::size_t(wasp::OBJECT) << " value" << std::endl
+         << "key k" << std::endl
+         << "value 999" << std::endl
+         << "}" << std::size_t(wasp::OBJECT) << " value";
+    const std::string events = array_recorder.events.str();
+    ASSERT_EQ(last.str(), events.substr(events.size() - last.str().size()));
+}
+
 TEST(JSON, simple_nulls)
 {
     DataObject::SP    json;
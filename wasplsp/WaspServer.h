@@ -218,6 +218,11 @@ class WASP_PUBLIC WaspServer : public ServerImpl
      */
     std::shared_ptr<INPUT> parser;
 
+    /**
+     * @brief parse_errors - stream capturing the errors of the server parser
+     */
+    std::stringstream parse_errors;
+
     /**
      * @brief validator - validator to be used in parseDocumentForDiagnostics
      */
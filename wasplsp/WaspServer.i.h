@@ -72,11 +72,23 @@ bool WaspServer<INPUT,INPUTNV,SCHEMA,SCHEMANV,VALIDATOR,CONNECTION>::
 
     bool pass = true;
 
-    // make a new parser capturing errors to a stream and set the server parser
+    // reuse the server parser, retaining its pool capacity across changes,
+    // capturing errors to the server's parse error stream
 
-    std::stringstream parse_errors;
+    this->parse_errors.str( "" );
 
-    this->parser = std::make_shared<INPUT>(parse_errors);
+    this->parse_errors.clear();
+
+    if ( this->parser == nullptr )
+    {
+        this->parser = std::make_shared<INPUT>( this->parse_errors );
+    }
+    else
+    {
+        this->parser->reset();
+    }
+
+    this->parser->reserve_for_bytes( this->document_text.size() );
 
     // use the parser to parse the entire currently set document text
 
@@ -84,13 +96,13 @@ bool WaspServer<INPUT,INPUTNV,SCHEMA,SCHEMANV,VALIDATOR,CONNECTION>::
     {
         // walk over parse_errors stream if there are any parse errors
 
-        while( parse_errors.good() )
+        while( this->parse_errors.good() )
         {
             std::string error;
 
             // get each parse error line
 
-            std::getline( parse_errors, error );
+            std::getline( this->parse_errors, error );
 
             if ( error.empty() ) continue;
 
@@ -2,6 +2,7 @@
 #ifndef WASP_SIRENINTERPRETER_H
 #define WASP_SIRENINTERPRETER_H
 
+#include <algorithm>
 #include <string>
 #include <cstring>
 #include <cstdint>
@@ -11,6 +12,7 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <set>
 #include <memory>
 
 #include "waspcore/TreeNodePool.h"
@@ -132,11 +134,181 @@ class WASP_PUBLIC SIRENInterpreter : public Interpreter<S>
      * node.
      * bool TAdapter::has_parent()const - indicate the node has a parent.
      * std::string TAdapter::data()const - acquires the data of the node.
+     * Optionally, StringView TAdapter::data_view(std::string& buffer)const -
+     * acquires the data of the node without copying a leaf's data.
+     * When the result set has a limit, evaluation stops once it is reached.
      */
     template<typename TAdapter>
     size_t evaluate(TAdapter& node, SIRENResultSet<TAdapter>& result) const;
+    /**
+     * @brief count determine the number of nodes the processed expression
+     * selects from the adapted node, without storing them in a result set
+     * @param node the adapted node
+     * @param limit the limit (0 reserved as no limit) on the count, at which
+     * evaluation stops, e.g., max occurrences + 1
+     * @return the number of selected nodes, at most \limit
+     */
+    template<typename TAdapter>
+    size_t count(TAdapter& node, size_t limit = 0) const;
+    /**
+     * @brief first acquire the first node the processed expression selects
+     * from the adapted node, evaluation stopping once it is selected
+     * @param node the adapted node
+     * @param match the first selected node, assigned iff there is one
+     * @return true, iff a node is selected
+     */
+    template<typename TAdapter>
+    bool first(TAdapter& node, TAdapter& match) const;
+
+    /**
+     * @brief evaluate_all evaluate many processed expressions against the
+     * adapted node
+     * @param node the adapted node that fulfills the required interface
+     * @param queries the processed expressions, e.g., SIRENInterpreter
+     * pointers or SIRENQueryCache::Query programs
+     * @param results the result set of each query, resized to the number of
+     * queries if smaller
+     * @return the number of results stored across all \results
+     * The queries' selection steps are merged into a trie, so the steps that
+     * lead several queries are evaluated once, and the children of a shared
+     * step's nodes are visited once for all the child name steps that follow
+     * it. Steps predicated on a grand child's value, e.g., 'obj[id=a]' and
+     * 'obj[id=b]', share the visit of their name's children and test their
+     * predicates in one pass. The results are those of evaluating each query
+     * individually.
+     * Queries with steps the trie does not merge (e.g., '//') are evaluated
+     * individually.
+     */
+    template<typename TAdapter, typename TQuery>
+    static size_t evaluate_all(TAdapter&                              node,
+                               const std::vector<TQuery>&             queries,
+                               std::vector<SIRENResultSet<TAdapter>>& results);
 
   private:
+    /**
+     * @brief The StepTrie struct merges the selection steps of many queries
+     * Node 0 leads the node-relative selections and node 1 the document
+     * root-based selections.
+     */
+    struct StepTrie
+    {
+        struct Node
+        {
+            Node() : program(nullptr) {}
+            /**
+             * @brief program the first query to take the step, whose tree
+             * holds the step
+             */
+            const SIRENInterpreter* program;
+            NodeView                step;
+            /**
+             * @brief queries the queries selecting the nodes this step stages
+             */
+            std::vector<std::size_t> queries;
+            /**
+             * @brief children the trie nodes of the steps that follow, by
+             * step type and text
+             */
+            std::map<std::string, std::size_t> children;
+        };
+        StepTrie() : nodes(2) {}
+        std::vector<Node> nodes;
+    };
+    /**
+     * @brief flatten_steps acquire the selection steps of the given
+     * selection, in order
+     * @return false, iff the selection has steps the trie does not merge
+     */
+    static bool flatten_steps(const NodeView&        context,
+                              std::vector<NodeView>& steps);
+    /**
+     * @brief evaluate_steps evaluate the steps following the given trie node
+     * @param trie the merged steps
+     * @param trie_node the trie node whose step staged the nodes
+     * @param stage the nodes staged by the trie node's step
+     * @param results the result sets of the queries
+     */
+    template<typename TAdapter>
+    static void evaluate_steps(const StepTrie&                        trie,
+                               std::size_t                            trie_node,
+                               const std::vector<TAdapter>&           stage,
+                               std::vector<SIRENResultSet<TAdapter>>& results);
+    /**
+     * @brief step_pattern acquire the child name pattern of a child name step
+     * or of a child step predicated on a grand child's value, e.g., 'obj' of
+     * 'obj' or 'obj[id=value]'
+     * @return the pattern, or nullptr for other steps
+     */
+    static const char* step_pattern(const NodeView& step);
+    /**
+     * @brief select_predicated select the children accepted by each of the
+     * given predicates, visiting each child's grand children once per
+     * predicate name pattern
+     * @param predicates the 'id=value' predicates
+     * @param children the children to test
+     * @param accepted the children accepted by each predicate, in child order
+     */
+    template<typename TAdapter>
+    static void
+    select_predicated(const std::vector<NodeView>&        predicates,
+                      const std::vector<TAdapter>&        children,
+                      std::vector<std::vector<TAdapter>>& accepted);
+    /**
+     * @brief select_names select the staged nodes' children matching each of
+     * the given name patterns, visiting each staged node's children once
+     * @param patterns the name patterns
+     * @param stage the staged nodes
+     * @param selected the children matching each pattern, in child order
+     */
+    template<typename TAdapter>
+    static void select_names(const std::vector<const char*>&      patterns,
+                             const std::vector<TAdapter>&         stage,
+                             std::vector<std::vector<TAdapter>>& selected);
+    /**
+     * @brief The NameStep class selects the children named by a selection
+     * step's name pattern
+     * The pattern is resolved to the name symbols it matches once per
+     * document (node pool). A step matching a single name, e.g., a literal
+     * 'material' or a prefix 'mat*' of a single name, is answered from the
+     * parent's name index rather than by visiting every child. Documents with
+     * included documents are scanned, as their children are iterated into the
+     * included documents.
+     */
+    class NameStep
+    {
+      public:
+        NameStep(const char* pattern) : m_pattern(pattern), m_pool(nullptr) {}
+        /**
+         * @brief select append the node's children matching the pattern, in
+         * child order
+         * @param limit the limit (0 reserved as no limit) on the number of
+         * children appended
+         * @return the number of children appended
+         */
+        template<typename TAdapter>
+        std::size_t select(const TAdapter&        node,
+                           std::vector<TAdapter>& children,
+                           std::size_t            limit = 0);
+
+      private:
+        const char*              m_pattern;
+        const void*              m_pool;
+        std::vector<std::size_t> m_symbols;
+        std::vector<std::size_t> m_child_indices;
+    };
+    /**
+     * @brief select stage the nodes the processed expression selects from
+     * the adapted node
+     * @param node the adapted node
+     * @param result the result set to store evaluated results on
+     * @param stage the stage populated with the selected nodes
+     * @param limit the limit (0 reserved as no limit) on the selected nodes
+     */
+    template<typename TAdapter>
+    void select(TAdapter&                 node,
+                SIRENResultSet<TAdapter>& result,
+                std::vector<TAdapter>&    stage,
+                size_t                    limit) const;
     /**
      * @brief evaluate a node in a given context
      * @param context the context of the evaluation (any, child, predicated
@@ -144,30 +316,36 @@ class WASP_PUBLIC SIRENInterpreter : public Interpreter<S>
      * @param node the adapter input node to evaluate
      * @param result the result set to store evaluated results on
      * @param stage the stage for on which matches will be conducted
+     * @param limit the limit (0 reserved as no limit) on the nodes staged by
+     * the context's final step, at which the step stops
      * @return the number of evaluations captured in the result set for the
      * given context
      */
     template<typename TAdapter>
     size_t evaluate(const NodeView&           context,
                     SIRENResultSet<TAdapter>& result,
-                    std::vector<TAdapter>&    stage) const;
+                    std::vector<TAdapter>&    stage,
+                    size_t                    limit = 0) const;
 
     /**
      * @brief search_child_name searches the staged node's children for
      * specifically named children
      * @param context the context to search for ( the child's name pattern )
      * @param stage the stage on which to search
+     * @param limit the limit (0 reserved as no limit) on the matches
      * Loops through each staged node searching its children for specifically
      * named child nodes
      */
     template<typename TAdapter>
     void search_child_name(const NodeView&        context,
-                           std::vector<TAdapter>& stage) const;
+                           std::vector<TAdapter>& stage,
+                           size_t                 limit = 0) const;
     /**
      * @brief search_conditional_predicated_child searches the staged node's
      * children for specifically named children with grandchild attributes
      * @param context the context to search for ( the child's name pattern )
      * @param stage the stage on which to search
+     * @param limit the limit (0 reserved as no limit) on the matches
      * Loops through each staged node searching its children for specifically
      * named child nodes
      * that contain some predicated selection criteria. E.g., 'obj[name=fred]'
@@ -177,13 +355,15 @@ class WASP_PUBLIC SIRENInterpreter : public Interpreter<S>
     template<typename TAdapter>
     void
     search_conditional_predicated_child(const NodeView&        context,
-                                        std::vector<TAdapter>& stage) const;
+                                        std::vector<TAdapter>& stage,
+                                        size_t                 limit = 0) const;
 
     /**
      * @brief search_index_predicated_child searches the staged node's children
      * for specifically named children at given indices
      * @param context the context to search for ( the child's name pattern )
      * @param stage the stage on which to search
+     * @param limit the limit (0 reserved as no limit) on the matches
      * Loops through each staged node searching its children for specifically
      * named child nodes
      * that contain some predicated selection criteria. E.g., 'obj[1:10:3]'
@@ -192,10 +372,28 @@ class WASP_PUBLIC SIRENInterpreter : public Interpreter<S>
      */
     template<typename TAdapter>
     void search_index_predicated_child(const NodeView&        context,
-                                       std::vector<TAdapter>& stage) const;
+                                       std::vector<TAdapter>& stage,
+                                       size_t                 limit = 0) const;
+    /**
+     * @brief recursive_child_select selects the staged node's descendants
+     * and evaluates the subsequent selection relative to them
+     * @param context the context to search for ( 'left // right' or
+     * '// right' )
+     * @param result the result set
+     * @param stage the stage on which to search
+     * @param limit the limit (0 reserved as no limit) on the right
+     * selection's matches
+     * The staged nodes and their descendants are staged, in document order,
+     * for the right selection. When the right selection leads with a named
+     * step, e.g., '//material', only nodes with a descendant of that name are
+     * staged, and subtrees whose descendant name filter excludes the name are
+     * not visited.
+     */
     template<typename TAdapter>
-    void recursive_child_select(const NodeView&        context,
-                                std::vector<TAdapter>& stage) const;
+    void recursive_child_select(const NodeView&           context,
+                                SIRENResultSet<TAdapter>& result,
+                                std::vector<TAdapter>&    stage,
+                                size_t                    limit = 0) const;
 };  // end of SIRENInterpreter class
 
 #include "waspsiren/SIRENInterpreter.i.h"
@@ -41,6 +41,47 @@ template<typename TAdapter>
 std::size_t
 SIRENInterpreter<S>::evaluate(TAdapter&                 node,
                               SIRENResultSet<TAdapter>& result) const
+{
+    if (Interpreter<S>::root().child_count() == 0)
+        return 0;
+    if (result.full())
+        return result.result_count();
+    std::vector<TAdapter> stage;
+    select(node, result, stage,
+           result.limit() == 0 ? 0 : result.limit() - result.result_count());
+    for (std::size_t i = 0; i < stage.size(); ++i)
+    {
+        result.push(stage[i]);
+    }
+    return result.result_count();
+}
+template<class S>
+template<typename TAdapter>
+std::size_t SIRENInterpreter<S>::count(TAdapter& node, std::size_t limit) const
+{
+    SIRENResultSet<TAdapter> unused;
+    std::vector<TAdapter>    stage;
+    select(node, unused, stage, limit);
+    return stage.size();
+}
+template<class S>
+template<typename TAdapter>
+bool SIRENInterpreter<S>::first(TAdapter& node, TAdapter& match) const
+{
+    SIRENResultSet<TAdapter> unused;
+    std::vector<TAdapter>    stage;
+    select(node, unused, stage, 1);
+    if (stage.empty())
+        return false;
+    match = stage.front();
+    return true;
+}
+template<class S>
+template<typename TAdapter>
+void SIRENInterpreter<S>::select(TAdapter&                 node,
+                                 SIRENResultSet<TAdapter>& result,
+                                 std::vector<TAdapter>&    stage,
+                                 std::size_t               limit) const
 {
     // the first selection
     // is either a document root-based selection
@@ -48,7 +89,7 @@ SIRENInterpreter<S>::evaluate(TAdapter&                 node,
     NodeView selection_root = Interpreter<S>::root();
 
     if (selection_root.child_count() == 0)
-        return 0;
+        return;
 
     NodeView first_selection = selection_root.child_at(0);
 
@@ -58,12 +99,14 @@ SIRENInterpreter<S>::evaluate(TAdapter&                 node,
     bool is_root_oriented =
         first_selection.type() == wasp::DOCUMENT_ROOT
         // first selection of 'any' is a root oriented selection
-        || first_selection.type() == wasp::ANY;
+        // unless it descends from a node-relative selection, e.g., 'obj//x'
+        || (first_selection.type() == wasp::ANY &&
+            (first_selection.child_count() == 0 ||
+             first_selection.child_at(0).type() == wasp::ANY));
     bool is_only_root_oriented = is_root_oriented &&
                                  first_selection.child_count() <=
                                      1;  // is it only '/', not '/' and 'child'
 
-    std::vector<TAdapter> stage;
     if (is_root_oriented)
     {
         TAdapter anode(node);
@@ -71,31 +114,329 @@ SIRENInterpreter<S>::evaluate(TAdapter&                 node,
         {
             anode = anode.parent();
         }
+        stage.push_back(anode);
         // the root of the document
         if (is_only_root_oriented)
-        {
-            result.push(anode);
-            return result.result_count();
-        }
-        stage.push_back(anode);
+            return;
     }
     else
     {
         stage.push_back(node);
     }
 
-    evaluate(first_selection, result, stage);
-    for (std::size_t i = 0; i < stage.size(); ++i)
+    evaluate(first_selection, result, stage, limit);
+    // steps that do not stop at the limit, e.g., '..', are truncated
+    if (limit != 0 && stage.size() > limit)
+        stage.resize(limit);
+}
+template<class S>
+template<typename TAdapter, typename TQuery>
+std::size_t SIRENInterpreter<S>::evaluate_all(
+    TAdapter&                              node,
+    const std::vector<TQuery>&             queries,
+    std::vector<SIRENResultSet<TAdapter>>& results)
+{
+    if (results.size() < queries.size())
+        results.resize(queries.size());
+    StepTrie              trie;
+    std::vector<NodeView> steps;
+    for (std::size_t q = 0; q < queries.size(); ++q)
     {
-        result.push(stage[i]);
+        const SIRENInterpreter& program        = *queries[q];
+        NodeView                selection_root = program.root();
+        if (selection_root.child_count() == 0)
+            continue;
+        NodeView first_selection = selection_root.child_at(0);
+        bool     is_root_oriented =
+            first_selection.type() == wasp::DOCUMENT_ROOT ||
+            first_selection.type() == wasp::ANY;
+        steps.clear();
+        if (!flatten_steps(first_selection, steps))
+        {
+            program.evaluate(node, results[q]);
+            continue;
+        }
+        std::size_t trie_node = is_root_oriented ? 1 : 0;
+        for (const NodeView& step : steps)
+        {
+            std::string key = std::to_string(step.type()) + ':' + step.data();
+            auto itr = trie.nodes[trie_node].children.find(key);
+            if (itr == trie.nodes[trie_node].children.end())
+            {
+                std::size_t child = trie.nodes.size();
+                trie.nodes[trie_node].children[key] = child;
+                trie.nodes.emplace_back();
+                trie.nodes.back().program = &program;
+                trie.nodes.back().step    = step;
+                trie_node                 = child;
+            }
+            else
+            {
+                trie_node = itr->second;
+            }
+        }
+        trie.nodes[trie_node].queries.push_back(q);
+    }
+
+    std::vector<TAdapter> stage(1, node);
+    evaluate_steps(trie, 0, stage, results);
+    if (!trie.nodes[1].children.empty() || !trie.nodes[1].queries.empty())
+    {
+        // the root of the document
+        while (stage.front().has_parent())
+        {
+            stage.front() = stage.front().parent();
+        }
+        evaluate_steps(trie, 1, stage, results);
+    }
+    std::size_t result_count = 0;
+    for (std::size_t q = 0; q < queries.size(); ++q)
+    {
+        result_count += results[q].result_count();
+    }
+    return result_count;
+}
+template<class S>
+bool SIRENInterpreter<S>::flatten_steps(const NodeView&        context,
+                                        std::vector<NodeView>& steps)
+{
+    switch (context.type())
+    {
+        default:
+            return false;
+        case DOCUMENT_ROOT:  // '/' relative_selection
+            return context.child_count() <= 1 ||
+                   flatten_steps(context.child_at(1), steps);
+        case OBJECT:  // selection / selection
+            return flatten_steps(context.child_at(0), steps) &&
+                   flatten_steps(context.child_at(2), steps);
+        case DECL:
+        case PARENT:
+        case PREDICATED_CHILD:
+            steps.push_back(context);
+            return true;
+    }
+}
+template<class S>
+template<typename TAdapter>
+void SIRENInterpreter<S>::evaluate_steps(
+    const StepTrie&                        trie,
+    std::size_t                            trie_node,
+    const std::vector<TAdapter>&           stage,
+    std::vector<SIRENResultSet<TAdapter>>& results)
+{
+    const typename StepTrie::Node& node = trie.nodes[trie_node];
+    for (std::size_t q : node.queries)
+    {
+        for (std::size_t i = 0; i < stage.size() && !results[q].full(); ++i)
+        {
+            results[q].push(stage[i]);
+        }
+    }
+    if (stage.empty())
+        return;
+    // the child name and name predicated steps following this step are
+    // grouped by name pattern, each pattern's children selected in a shared
+    // visit of the children
+    std::vector<const char*>              patterns;
+    std::vector<std::vector<std::size_t>> pattern_nodes;
+    SIRENResultSet<TAdapter>              unused;
+    for (const auto& child : node.children)
+    {
+        const typename StepTrie::Node& next    = trie.nodes[child.second];
+        const char*                    pattern = step_pattern(next.step);
+        if (pattern == nullptr)
+        {
+            std::vector<TAdapter> next_stage(stage);
+            next.program->evaluate(next.step, unused, next_stage);
+            evaluate_steps(trie, child.second, next_stage, results);
+            continue;
+        }
+        std::size_t p = 0;
+        while (p < patterns.size() && std::strcmp(patterns[p], pattern) != 0)
+            ++p;
+        if (p == patterns.size())
+        {
+            patterns.push_back(pattern);
+            pattern_nodes.emplace_back();
+        }
+        pattern_nodes[p].push_back(child.second);
+    }
+    if (patterns.empty())
+        return;
+    std::vector<std::vector<TAdapter>> selected(patterns.size());
+    if (patterns.size() == 1)
+    {
+        NameStep name_step(patterns.front());
+        for (const TAdapter& staged : stage)
+        {
+            name_step.select(staged, selected.front());
+        }
+    }
+    else
+    {
+        select_names(patterns, stage, selected);
+    }
+    for (std::size_t p = 0; p < patterns.size(); ++p)
+    {
+        std::vector<std::size_t> predicated_nodes;
+        std::vector<NodeView>    predicates;
+        for (std::size_t trie_child : pattern_nodes[p])
+        {
+            const NodeView& step = trie.nodes[trie_child].step;
+            if (step.type() == DECL)
+            {
+                evaluate_steps(trie, trie_child, selected[p], results);
+                continue;
+            }
+            predicated_nodes.push_back(trie_child);
+            predicates.push_back(step.child_at(2));
+        }
+        if (predicated_nodes.empty())
+            continue;
+        // the predicates are tested in one pass of the selected children
+        std::vector<std::vector<TAdapter>> accepted(predicated_nodes.size());
+        select_predicated(predicates, selected[p], accepted);
+        for (std::size_t i = 0; i < predicated_nodes.size(); ++i)
+        {
+            evaluate_steps(trie, predicated_nodes[i], accepted[i], results);
+        }
+    }
+}
+template<class S>
+const char* SIRENInterpreter<S>::step_pattern(const NodeView& step)
+{
+    if (step.type() == DECL)
+        return step.name();
+    // obj [ id=value ]
+    if (step.type() == PREDICATED_CHILD &&
+        step.child_at(2).type() == KEYED_VALUE)
+        return step.child_at(0).name();
+    return nullptr;
+}
+template<class S>
+template<typename TAdapter>
+void SIRENInterpreter<S>::select_predicated(
+    const std::vector<NodeView>&        predicates,
+    const std::vector<TAdapter>&        children,
+    std::vector<std::vector<TAdapter>>& accepted)
+{
+    // the predicates grouped by grand child name pattern, each pattern's
+    // grand children selected once per child
+    std::vector<const char*>              names;
+    std::vector<NameStep>                 name_steps;
+    std::vector<std::vector<std::size_t>> name_predicates;
+    std::vector<std::string>              values(predicates.size());
+    for (std::size_t k = 0; k < predicates.size(); ++k)
+    {
+        // id = [0], '=' = [1], value = [2]
+        const char* name = predicates[k].child_at(0).name();
+        values[k]        = predicates[k].child_at(2).data();
+        std::size_t g    = 0;
+        while (g < names.size() && std::strcmp(names[g], name) != 0)
+            ++g;
+        if (g == names.size())
+        {
+            names.push_back(name);
+            name_steps.emplace_back(name);
+            name_predicates.emplace_back();
+        }
+        name_predicates[g].push_back(k);
+    }
+    std::vector<TAdapter> g_children;
+    // storage for the data of parent grand children, leaves are viewed
+    std::string       g_child_node_buffer;
+    std::vector<bool> child_accepted(predicates.size());
+    for (const TAdapter& child_node : children)
+    {
+        std::fill(child_accepted.begin(), child_accepted.end(), false);
+        for (std::size_t g = 0; g < name_steps.size(); ++g)
+        {
+            g_children.clear();
+            name_steps[g].select(child_node, g_children);
+            for (const TAdapter& g_child_node : g_children)
+            {
+                StringView data =
+                    adapted_data_view(g_child_node, g_child_node_buffer);
+                for (std::size_t k : name_predicates[g])
+                {
+                    if (!child_accepted[k] && values[k] == data)
+                        child_accepted[k] = true;
+                }
+            }
+        }
+        for (std::size_t k = 0; k < predicates.size(); ++k)
+        {
+            if (child_accepted[k])
+                accepted[k].push_back(child_node);
+        }
+    }
+}
+template<class S>
+template<typename TAdapter>
+void SIRENInterpreter<S>::select_names(
+    const std::vector<const char*>&     patterns,
+    const std::vector<TAdapter>&        stage,
+    std::vector<std::vector<TAdapter>>& selected)
+{
+    // the patterns matching each name symbol, as (symbol, pattern) pairs
+    std::vector<std::pair<std::size_t, std::size_t>> routes;
+    std::vector<std::size_t>                         symbols;
+    const AbstractInterpreter*                       routed_pool = nullptr;
+    for (const TAdapter& node : stage)
+    {
+        AbstractInterpreter* pool = node.node_pool();
+        if (pool->document_count() > 0)
+        {
+            // included documents' children are iterated, and matched by name
+            for (auto itr = node.begin(); itr != node.end(); itr.next())
+            {
+                const TAdapter& child_node = itr.get();
+                for (std::size_t p = 0; p < patterns.size(); ++p)
+                {
+                    if (wildcard_string_match(patterns[p], child_node.name()))
+                        selected[p].push_back(child_node);
+                }
+            }
+            continue;
+        }
+        if (pool != routed_pool)
+        {
+            routed_pool = pool;
+            routes.clear();
+            for (std::size_t p = 0; p < patterns.size(); ++p)
+            {
+                symbols.clear();
+                pool->find_name_symbols(patterns[p], symbols);
+                for (std::size_t symbol : symbols)
+                {
+                    routes.emplace_back(symbol, p);
+                }
+            }
+            std::sort(routes.begin(), routes.end());
+        }
+        if (routes.empty())
+            continue;
+        for (std::size_t i = 0, count = node.child_count(); i < count; ++i)
+        {
+            TAdapter    child_node = node.child_at(i);
+            std::size_t symbol     = pool->name_symbol(child_node.node_index());
+            auto        route      = std::lower_bound(
+                routes.begin(), routes.end(),
+                std::make_pair(symbol, std::size_t(0)));
+            for (; route != routes.end() && route->first == symbol; ++route)
+            {
+                selected[route->second].push_back(child_node);
+            }
+        }
     }
-    return result.result_count();
 }
 template<class S>
 template<typename TAdapter>
 std::size_t SIRENInterpreter<S>::evaluate(const NodeView&           context,
                                           SIRENResultSet<TAdapter>& result,
-                                          std::vector<TAdapter>&    stage) const
+                                          std::vector<TAdapter>&    stage,
+                                          std::size_t               limit) const
 {
     switch (context.type())
     {
@@ -106,13 +447,13 @@ std::size_t SIRENInterpreter<S>::evaluate(const NodeView&           context,
             if (context.child_count() > 0)
             {  // '/' relative_selection
                 NodeView child_context = context.child_at(1);
-                evaluate(child_context, result, stage);
+                evaluate(child_context, result, stage, limit);
             }
             break;
         case SEPARATOR:
             break;
         case DECL:  // named child search
-            search_child_name(context, stage);
+            search_child_name(context, stage, limit);
             break;
         case PARENT:  // select parent of current nodes '..'
         {
@@ -133,10 +474,13 @@ std::size_t SIRENInterpreter<S>::evaluate(const NodeView&           context,
             if (evaluate(left_selection, result, stage) > 0)
             {
                 NodeView right_selection = context.child_at(2);
-                evaluate(right_selection, result, stage);
+                evaluate(right_selection, result, stage, limit);
             }
         }
         break;
+        case ANY:  // '//' selection or selection '//' selection
+            recursive_child_select(context, result, stage, limit);
+            break;
         case PREDICATED_CHILD:  // obj[id=value] or obj[1:3:2]
         {
             // 'obj' = [0]
@@ -145,11 +489,11 @@ std::size_t SIRENInterpreter<S>::evaluate(const NodeView&           context,
             NodeView predicate_node = context.child_at(2);
             if (predicate_node.type() == KEYED_VALUE)
             {
-                search_conditional_predicated_child(context, stage);
+                search_conditional_predicated_child(context, stage, limit);
             }
             else if (predicate_node.type() == INDEX)
             {
-                search_index_predicated_child(context, stage);
+                search_index_predicated_child(context, stage, limit);
             }
         }
         break;
@@ -159,35 +503,91 @@ std::size_t SIRENInterpreter<S>::evaluate(const NodeView&           context,
 }
 template<class S>
 template<typename TAdapter>
+std::size_t
+SIRENInterpreter<S>::NameStep::select(const TAdapter&        node,
+                                      std::vector<TAdapter>& children,
+                                      std::size_t            limit)
+{
+    AbstractInterpreter* pool  = node.node_pool();
+    std::size_t          first = children.size();
+    if (pool->document_count() > 0)
+    {
+        for (auto itr = node.begin(); itr != node.end(); itr.next())
+        {
+            const TAdapter& child_node = itr.get();
+            if (wildcard_string_match(m_pattern, child_node.name()))
+            {
+                children.push_back(child_node);
+                // limit of 0 is reserved as no limit
+                if (children.size() - first == limit)
+                    break;
+            }
+        }
+        return children.size() - first;
+    }
+    if (pool != m_pool)
+    {
+        m_pool = pool;
+        m_symbols.clear();
+        pool->find_name_symbols(m_pattern, m_symbols);
+    }
+    if (m_symbols.size() == 1)
+    {
+        m_child_indices.clear();
+        pool->child_by_name_symbol(node.node_index(), m_symbols.front(),
+                                   limit, m_child_indices);
+        for (std::size_t child_index : m_child_indices)
+        {
+            children.push_back(TAdapter(child_index, *pool));
+        }
+    }
+    else if (!m_symbols.empty())
+    {
+        for (std::size_t i = 0, count = node.child_count(); i < count; ++i)
+        {
+            TAdapter child_node = node.child_at(i);
+            if (std::binary_search(m_symbols.begin(), m_symbols.end(),
+                                   pool->name_symbol(child_node.node_index())))
+            {
+                children.push_back(child_node);
+                // limit of 0 is reserved as no limit
+                if (children.size() - first == limit)
+                    break;
+            }
+        }
+    }
+    return children.size() - first;
+}
+template<class S>
+template<typename TAdapter>
 void SIRENInterpreter<S>::search_child_name(const NodeView&        context,
-                                            std::vector<TAdapter>& stage) const
+                                            std::vector<TAdapter>& stage,
+                                            std::size_t            limit) const
 {
     if (stage.empty())
         return;
     // the name for which to search
-    const char* name       = context.name();
+    NameStep    name_step(context.name());
     std::size_t stage_size = stage.size();
+    std::size_t matches    = 0;
     for (std::size_t index = 0; index < stage_size; ++index)
     {
+        // copied, as matching children are pushed back onto the stage
         TAdapter node = stage[index];
-        auto itr = node.begin();
-        while(itr)
-        {
-            const TAdapter& child_node = itr.get();
-            // if child is a match, push back onto stage
-            if (wildcard_string_match(name, child_node.name()))
-            {
-                stage.push_back(child_node);
-            }
-            itr.next();
-        }
+        matches += name_step.select(node, stage,
+                                    limit == 0 ? 0 : limit - matches);
+        // limit of 0 is reserved as no limit
+        if (limit != 0 && matches == limit)
+            break;
     }
     stage.erase(stage.begin(), stage.begin() + stage_size);
 }
 template<class S>
 template<typename TAdapter>
 void SIRENInterpreter<S>::search_conditional_predicated_child(
-    const NodeView& context, std::vector<TAdapter>& stage) const
+    const NodeView&        context,
+    std::vector<TAdapter>& stage,
+    std::size_t            limit) const
 {
     // context should be something like
     // obj [ id=value ]
@@ -212,54 +612,58 @@ void SIRENInterpreter<S>::search_conditional_predicated_child(
     const char*        predicate_name  = predicate_name_context.name();
     const std::string& predicate_value = predicate_value_context.data();
     std::size_t        stage_size      = stage.size();
+    NameStep           name_step(name);
+    NameStep           predicate_step(predicate_name);
+    // the matching children and the grand children named by the predicate
+    std::vector<TAdapter> children, g_children;
+    // storage for the data of parent grand children, leaves are viewed
+    std::string g_child_node_buffer;
     for (std::size_t index = 0; index < stage_size; ++index)
     {
-        TAdapter node = stage[index];
-        for (auto citr = node.begin(); citr != node.end(); citr.next())
+        children.clear();
+        name_step.select(stage[index], children);
+        for (const TAdapter& child_node : children)
         {
-            const TAdapter& child_node = citr.get();
-            // if child is a match, push back onto stage
-            if (wildcard_string_match(name, child_node.name()))
+            // prior to pushing, must determine if the
+            // predicate passes
+            // TODO - added expression evaluator
+            // for proper robustness.
+            // string compare fails quickly '1' == '1.0' fails, but should
+            // not considering user is expecting it is a numeric comparison.
+            bool predicate_accepted = false;  // assume predicate fails
+            g_children.clear();
+            predicate_step.select(child_node, g_children);
+            for (const TAdapter& g_child_node : g_children)
             {
-                // prior to pushing, must determine if the
-                // predicate passes
-                // TODO - added expression evaluator
-                // for proper robustness.
-                // string compare fails quickly '1' == '1.0' fails, but should
-                // not considering user is expecting it is a numeric comparison.
-                bool predicate_accepted = false;  // assume predicate fails
-                for (auto gitr = child_node.begin(); gitr != child_node.end();
-                     gitr.next())
-                {
-                    const TAdapter& g_child_node = gitr.get();
-                    // if grand child name is a match, need to determine
-                    // if value matches
-                    if (wildcard_string_match(predicate_name,
-                                              g_child_node.name()))
-                    {
-                        const std::string& g_child_node_value =
-                            g_child_node.data();
-                        predicate_accepted =
-                            predicate_value == g_child_node_value;
-                        if (predicate_accepted)
-                        {
-                            break;  // break from grandchild loop
-                        }
-                    }
-                }
+                // if grand child name is a match, need to determine
+                // if value matches
+                predicate_accepted =
+                    predicate_value ==
+                    adapted_data_view(g_child_node, g_child_node_buffer);
                 if (predicate_accepted)
                 {
-                    stage.push_back(child_node);
+                    break;  // break from grandchild loop
                 }
             }
+            if (predicate_accepted)
+            {
+                stage.push_back(child_node);
+                // limit of 0 is reserved as no limit
+                if (stage.size() - stage_size == limit)
+                    break;
+            }
         }
+        if (limit != 0 && stage.size() - stage_size == limit)
+            break;
     }
     stage.erase(stage.begin(), stage.begin() + stage_size);
 }
 template<class S>
 template<typename TAdapter>
 void SIRENInterpreter<S>::search_index_predicated_child(
-    const NodeView& context, std::vector<TAdapter>& stage) const
+    const NodeView&        context,
+    std::vector<TAdapter>& stage,
+    std::size_t            limit) const
 {
     // context should be something like
     // obj [ 1 ] | obj [ 1:10 ] | obj [ 1:10:2 ]
@@ -279,7 +683,8 @@ void SIRENInterpreter<S>::search_index_predicated_child(
     std::size_t incident_count = 0;
 
     // the names for which to search
-    const char* name = child_name_context.name();
+    NameStep              name_step(child_name_context.name());
+    std::vector<TAdapter> children;
 
     // single index selection - start = end, stride =1
     if (predicate_context.child_count() == 1)
@@ -306,34 +711,118 @@ void SIRENInterpreter<S>::search_index_predicated_child(
     }
     int stride_remainder   = 1;  // always start at 1 to capture first node
     std::size_t stage_size = stage.size();
-    for (std::size_t index = 0; index < stage_size; ++index)
+    for (std::size_t index = 0; index < stage_size && incident_count < end_i;
+         ++index)
     {
-        TAdapter node = stage[index];
-        for (auto citr = node.begin(); citr != node.end(); citr.next())
+        children.clear();
+        name_step.select(stage[index], children);
+        for (const TAdapter& child_node : children)
         {
-            const TAdapter& child_node = citr.get();
-            // if child is a match, push back onto stage
-            if (strcmp(name, child_node.name()) == 0)
+            ++incident_count;  // increment prior to comparison - 1 based
+                               // indices
+            bool within_range =
+                incident_count >= start_i && incident_count <= end_i;
+            if (within_range)
+                --stride_remainder;
+            if (within_range && stride_remainder == 0)
             {
-                ++incident_count;  // increment prior to comparison - 1 based
-                                   // indices
-                bool within_range =
-                    incident_count >= start_i && incident_count <= end_i;
-                if (within_range)
-                    --stride_remainder;
-                if (within_range && stride_remainder == 0)
-                {
-                    stage.push_back(child_node);
-                    stride_remainder = (int)stride;  // reset stride
-                }
+                stage.push_back(child_node);
+                stride_remainder = (int)stride;  // reset stride
             }
             // early terminate when our range has been exhausted
-            else if (incident_count > end_i)
-            {
+            // or the limit (0 reserved as no limit) has been reached
+            if (incident_count >= end_i ||
+                (limit != 0 && stage.size() - stage_size == limit))
                 break;
+        }
+        if (limit != 0 && stage.size() - stage_size == limit)
+            break;
+    }
+    stage.erase(stage.begin(), stage.begin() + stage_size);
+}
+template<class S>
+template<typename TAdapter>
+void SIRENInterpreter<S>::recursive_child_select(
+    const NodeView&           context,
+    SIRENResultSet<TAdapter>& result,
+    std::vector<TAdapter>&    stage,
+    std::size_t               limit) const
+{
+    // context should be something like
+    // '//' = [0], right selection = [1]
+    // or
+    // left selection = [0], '//' = [1], right selection = [2]
+    std::size_t count = context.child_count();
+    if (count < 2)
+        return;
+    if (count == 3 && evaluate(context.child_at(0), result, stage) == 0)
+        return;
+    NodeView right_selection = context.child_at(count - 1);
+
+    // the name of the right selection's leading step, if any
+    NodeView lead = right_selection;
+    while ((lead.type() == OBJECT || lead.type() == ANY) &&
+           lead.child_count() > 0)
+    {
+        lead = lead.child_at(0);
+    }
+    if (lead.type() == PREDICATED_CHILD)
+        lead = lead.child_at(0);
+    const char* name = lead.type() == DECL ? lead.name() : nullptr;
+
+    // the symbols of the lead name, resolved once per document (node pool)
+    const void*              resolved_pool = nullptr;
+    std::vector<std::size_t> symbols;
+    // whether any of the node's descendants may have the lead name
+    auto may_lead = [&](const TAdapter& node) {
+        AbstractInterpreter* pool = node.node_pool();
+        // included documents' descendants are not filtered
+        if (name == nullptr || pool->document_count() > 0)
+            return true;
+        if (pool != resolved_pool)
+        {
+            resolved_pool = pool;
+            symbols.clear();
+            pool->find_name_symbols(name, symbols);
+        }
+        // a filter per symbol is only worthwhile for a few symbols
+        if (symbols.size() > 8)
+            return true;
+        for (std::size_t symbol : symbols)
+        {
+            if (pool->may_have_descendant(node.node_index(), symbol))
+                return true;
+        }
+        return false;
+    };
+
+    std::size_t           stage_size = stage.size();
+    std::vector<TAdapter> pending, children;
+    // nested staged nodes' descendants are staged once
+    std::set<std::pair<const void*, std::size_t>> visited;
+    for (std::size_t index = 0; index < stage_size; ++index)
+    {
+        pending.push_back(stage[index]);
+        while (!pending.empty())
+        {
+            TAdapter node = pending.back();
+            pending.pop_back();
+            if (stage_size > 1 &&
+                !visited.emplace(node.node_pool(), node.node_index()).second)
+                continue;
+            if (!may_lead(node))
+                continue;
+            stage.push_back(node);
+            // children are pending in reverse, to be staged in order
+            children.clear();
+            for (auto itr = node.begin(); itr != node.end(); itr.next())
+            {
+                children.push_back(itr.get());
             }
+            pending.insert(pending.end(), children.rbegin(), children.rend());
         }
     }
     stage.erase(stage.begin(), stage.begin() + stage_size);
+    evaluate(right_selection, result, stage, limit);
 }
 #endif
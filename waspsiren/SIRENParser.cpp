@@ -364,13 +364,13 @@ namespace wasp {
     {
       case symbol_kind::S_key_declaration: // key_declaration
 #line 121 "SIRENParser.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 369 "SIRENParser.cpp"
         break;
 
       case symbol_kind::S_tag: // tag
 #line 121 "SIRENParser.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 375 "SIRENParser.cpp"
         break;
 
@@ -1164,7 +1164,7 @@ namespace wasp {
   case 55: // tag: decl
 #line 443 "SIRENParser.bison"
         {
-             (yylhs.value.node_indices) = new std::vector<size_t>();
+             (yylhs.value.node_indices) = interpreter.acquire_child_indices();
              (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1171 "SIRENParser.cpp"
@@ -1185,7 +1185,7 @@ namespace wasp {
                                      //  |_ value (1.2..blah)
                                     ,quote_less_data.c_str()
                                     ,*(yystack_[1].value.node_indices));
-        delete (yystack_[1].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
     }
 #line 1191 "SIRENParser.cpp"
     break;
@@ -0,0 +1,118 @@
+#ifndef WASP_SIRENQUERYCACHE_H
+#define WASP_SIRENQUERYCACHE_H
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "waspsiren/SIRENInterpreter.h"
+#include "waspcore/decl.h"
+
+namespace wasp
+{
+/**
+ * @brief The SIRENQueryCache class maps selection statements to their
+ * compiled (parsed) SIREN programs
+ * Compiled programs are immutable - their trees are frozen - so a program is
+ * shared by, and evaluated concurrently from, any number of threads.
+ * The least recently used programs are evicted once the capacity is exceeded.
+ * Statements that fail to compile are not cached.
+ */
+template<class S = SIRENNodePool>
+class WASP_PUBLIC SIRENQueryCache
+{
+  public:
+    typedef SIRENInterpreter<S> Interpreter_type;
+    /**
+     * @brief Query a compiled program, null if the statement failed to compile
+     */
+    typedef std::shared_ptr<const Interpreter_type> Query;
+
+    static const std::size_t default_capacity = 4096;
+
+    SIRENQueryCache(std::size_t capacity = default_capacity);
+
+    /**
+     * @brief global acquire the process-wide cache used by HIVE and the
+     * selection utilities
+     */
+    static SIRENQueryCache& global();
+
+    /**
+     * @brief compile acquire the compiled program of the given statement,
+     * compiling it if it is not cached
+     * @param statement the selection statement, e.g., '/object/child/x'
+     * @param err the stream on which compilation errors are reported
+     * @param sname the statement's stream name for error messages
+     * @return the compiled program, null if the statement failed to compile
+     */
+    Query compile(const std::string& statement,
+                  std::ostream&      err,
+                  const std::string& sname = "selection statement");
+
+    /**
+     * @brief capacity the maximum number of cached programs
+     */
+    std::size_t capacity() const;
+    /**
+     * @brief set_capacity change the maximum number of cached programs,
+     * evicting the least recently used as needed
+     * A capacity of zero disables caching.
+     */
+    void set_capacity(std::size_t capacity);
+    /**
+     * @brief size the number of cached programs
+     */
+    std::size_t size() const;
+    /**
+     * @brief hits the number of compilations answered by the cache
+     */
+    std::size_t hits() const;
+    /**
+     * @brief misses the number of compilations of uncached statements
+     */
+    std::size_t misses() const;
+    /**
+     * @brief evictions the number of programs evicted to respect the capacity
+     */
+    std::size_t evictions() const;
+    /**
+     * @brief clear evict all programs and reset the statistics
+     */
+    void clear();
+
+  private:
+    /**
+     * @brief The Program struct owns a compiled interpreter and the error
+     * stream it references
+     */
+    struct Program
+    {
+        Program() : interpreter(errors) {}
+        std::stringstream errors;
+        Interpreter_type  interpreter;
+    };
+    typedef std::list<std::pair<std::string, Query>> Entries;
+
+    void evict();
+
+    mutable std::mutex m_mutex;
+    /**
+     * @brief m_entries the cached programs, most recently used first
+     */
+    Entries                                                   m_entries;
+    std::unordered_map<std::string, typename Entries::iterator> m_index;
+    std::size_t                                               m_capacity;
+    std::size_t                                               m_hits;
+    std::size_t                                               m_misses;
+    std::size_t                                               m_evictions;
+};
+#include "waspsiren/SIRENQueryCache.i.h"
+
+typedef SIRENQueryCache<> DefaultSIRENQueryCache;
+}  // namespace wasp
+#endif
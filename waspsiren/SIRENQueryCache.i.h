@@ -0,0 +1,125 @@
+#ifndef SIREN_SIRENQUERYCACHE_I_H
+#define SIREN_SIRENQUERYCACHE_I_H
+
+template<class S>
+const std::size_t SIRENQueryCache<S>::default_capacity;
+
+template<class S>
+SIRENQueryCache<S>::SIRENQueryCache(std::size_t capacity)
+    : m_capacity(capacity), m_hits(0), m_misses(0), m_evictions(0)
+{
+}
+
+template<class S>
+SIRENQueryCache<S>& SIRENQueryCache<S>::global()
+{
+    static SIRENQueryCache cache;
+    return cache;
+}
+
+template<class S>
+typename SIRENQueryCache<S>::Query
+SIRENQueryCache<S>::compile(const std::string& statement,
+                            std::ostream&      err,
+                            const std::string& sname)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        itr = m_index.find(statement);
+        if (itr != m_index.end())
+        {
+            ++m_hits;
+            m_entries.splice(m_entries.begin(), m_entries, itr->second);
+            return itr->second->second;
+        }
+        ++m_misses;
+    }
+    // compile outside of the lock, so concurrent misses do not serialize
+    std::shared_ptr<Program> program = std::make_shared<Program>();
+    if (!program->interpreter.parseString(statement, sname))
+    {
+        err << program->errors.str();
+        return Query();
+    }
+    program->interpreter.freeze();
+    Query query(program, &program->interpreter);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_capacity == 0)
+        return query;
+    auto itr = m_index.find(statement);
+    // another thread compiled the statement concurrently
+    if (itr != m_index.end())
+        return itr->second->second;
+    m_entries.emplace_front(statement, query);
+    m_index.emplace(statement, m_entries.begin());
+    evict();
+    return query;
+}
+
+template<class S>
+void SIRENQueryCache<S>::evict()
+{
+    while (m_entries.size() > m_capacity)
+    {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+        ++m_evictions;
+    }
+}
+
+template<class S>
+std::size_t SIRENQueryCache<S>::capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+template<class S>
+void SIRENQueryCache<S>::set_capacity(std::size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    evict();
+}
+
+template<class S>
+std::size_t SIRENQueryCache<S>::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+template<class S>
+std::size_t SIRENQueryCache<S>::hits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+template<class S>
+std::size_t SIRENQueryCache<S>::misses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+template<class S>
+std::size_t SIRENQueryCache<S>::evictions() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_evictions;
+}
+
+template<class S>
+void SIRENQueryCache<S>::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_index.clear();
+    m_hits      = 0;
+    m_misses    = 0;
+    m_evictions = 0;
+}
+
+#endif
@@ -67,6 +67,26 @@ class WASP_PUBLIC SIRENResultSet
     void push(const TAdapter& node);
     void push(const std::string& name, const std::string& data);
 
+    /**
+     * @brief limit the number of results at which evaluation into the set
+     * stops
+     * @return the limit, 0 if the set is unlimited
+     */
+    std::size_t limit() const { return m_limit; }
+    /**
+     * @brief set_limit stop evaluations into the set once it contains the
+     * given number of results
+     * E.g., a limit of 1 acquires only the first match, and a limit of n + 1
+     * determines whether there are more than n matches, without selecting
+     * every match. The final selection step stops once the limit is reached.
+     * @param limit the limit, 0 (the default) for an unlimited set
+     */
+    void set_limit(std::size_t limit) { m_limit = limit; }
+    /**
+     * @brief full determine if the set has reached its limit
+     */
+    bool full() const { return m_limit != 0 && results.size() >= m_limit; }
+
   private:
     // a result could be an adapted result from a parse tree (TreeNodeView)
     // or a calculated, named result (count,10)
@@ -78,6 +98,7 @@ class WASP_PUBLIC SIRENResultSet
         SCALAR
     };
     std::vector<std::pair<type, unsigned int>> results;
+    std::size_t                                m_limit;
 };
 #include "waspsiren/SIRENResultSet.i.h"
 }  // end of namespace
@@ -2,7 +2,7 @@
 #define SIREN_SIRENRESULTSET_I_H
 
 template<typename TAdapter>
-SIRENResultSet<TAdapter>::SIRENResultSet()
+SIRENResultSet<TAdapter>::SIRENResultSet() : m_limit(0)
 {
 }
 template<typename TAdapter>
@@ -10,6 +10,7 @@ SIRENResultSet<TAdapter>::SIRENResultSet(const SIRENResultSet<TAdapter>& orig)
     : adapted_results(orig.adapted_results)
     , scalar_results(orig.scalar_results)
     , results(orig.results)
+    , m_limit(orig.m_limit)
 {
 }
 template<typename TAdapter>
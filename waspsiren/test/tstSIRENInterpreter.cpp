@@ -1,7 +1,9 @@
 #include "waspsiren/SIRENInterpreter.h"
 #include "waspcore/Interpreter.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 
 using namespace wasp;
@@ -625,3 +627,293 @@ TEST(SIREN, selection_on_keyed_values)
         }
     }
 }
+
+/**
+ * @brief push_materials push a document of materials
+ * document
+ * |_ materials
+ *   |_ material (id = m0) ... material (id = m99)
+ *   |_ mesh ... mesh, interleaved every 10th material
+ * There are enough children for the materials to be indexed by name.
+ */
+void push_materials(DummyInterp<TreeNodePool<>>& interp)
+{
+    std::vector<size_t> children;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto token_i = interp.token_count();
+        interp.push_token(("m" + std::to_string(i)).c_str(), wasp::STRING, i);
+        interp.push_leaf(wasp::VALUE, "id", token_i);
+        interp.push_parent(wasp::OBJECT, "material", {interp.size() - 1});
+        children.push_back(interp.size() - 1);
+        if (i % 10 == 0)
+        {
+            token_i = interp.token_count();
+            interp.push_token("1", wasp::INTEGER, i);
+            interp.push_leaf(wasp::VALUE, "mesh", token_i);
+            children.push_back(interp.size() - 1);
+        }
+    }
+    interp.push_parent(wasp::OBJECT, "materials", children);
+    interp.push_parent(wasp::DOCUMENT_ROOT, "document", {interp.size() - 1});
+}
+
+TEST(SIREN, selection_on_indexed_children)
+{
+    DummyInterp<TreeNodePool<>> interp;
+    push_materials(interp);
+    NodeView document(interp.size() - 1, interp);
+
+    auto select = [&document](const std::string& statement) {
+        DefaultSIRENInterpreter siren;
+        EXPECT_TRUE(siren.parseString(statement));
+        SIRENResultSet<NodeView> set;
+        siren.evaluate(document, set);
+        std::vector<std::string> selected;
+        for (size_t i = 0; i < set.result_count(); ++i)
+        {
+            NodeView node = set.adapted(i);
+            selected.push_back(node.name() +
+                               std::string(node.child_count() > 0
+                                               ? node.child_at(0).data()
+                                               : node.data()));
+        }
+        return selected;
+    };
+    for (int frozen = 0; frozen < 2; ++frozen)
+    {
+        SCOPED_TRACE(frozen);
+        ASSERT_EQ(100, select("/materials/material").size());
+        ASSERT_EQ(10, select("/materials/mesh").size());
+        ASSERT_EQ(110, select("/materials/m*").size());
+        ASSERT_EQ(100, select("/materials/*al").size());
+        ASSERT_EQ(110, select("/materials/*").size());
+        ASSERT_TRUE(select("/materials/x*").empty());
+        // matches are in child order
+        std::vector<std::string> selected = select("/materials/m*");
+        selected.resize(3);
+        ASSERT_EQ((std::vector<std::string>{"materialm0", "mesh1",
+                                            "materialm1"}),
+                  selected);
+        ASSERT_EQ((std::vector<std::string>{"materialm42"}),
+                  select("/materials/material[id=m42]"));
+        ASSERT_EQ((std::vector<std::string>{"materialm42"}),
+                  select("/materials/mat*[i*=m42]"));
+        ASSERT_TRUE(select("/materials/material[id=m100]").empty());
+        ASSERT_EQ((std::vector<std::string>{"materialm2"}),
+                  select("/materials/material[3]"));
+        ASSERT_EQ((std::vector<std::string>{"materialm1", "materialm2",
+                                            "materialm3"}),
+                  select("/materials/material[2:4]"));
+        ASSERT_EQ((std::vector<std::string>{"mesh1", "mesh1"}),
+                  select("/materials/mesh[2:3]"));
+        interp.freeze();
+    }
+}
+
+TEST(SIREN, evaluate_all)
+{
+    DummyInterp<TreeNodePool<>> interp;
+    push_materials(interp);
+    NodeView document(interp.size() - 1, interp);
+    NodeView materials = document.child_at(0);
+
+    std::vector<std::string> statements = {
+        "/",
+        "/materials",
+        "/materials/material",
+        "/materials/material/id",
+        "/materials/mesh",
+        "/materials/m*",
+        "/materials/*al/i?",
+        "/materials/material[id=m42]",
+        "/materials/material[id=m42]/id",
+        "/materials/material[3]",
+        "/materials/material[2:4]/id",
+        "/materials/material[id=m7]/..",
+        "/materials/x",
+        "material[id=m9]",
+        "mesh",
+        "//id",
+        "/materials/material",
+        "/materials/material[id=m7]",
+        "/materials/material[id=m8]/id",
+        "/materials/material[i?=m8]",
+        "/materials/material[id=x]"};
+    std::vector<std::unique_ptr<DefaultSIRENInterpreter>> queries;
+    for (const std::string& statement : statements)
+    {
+        queries.emplace_back(new DefaultSIRENInterpreter());
+        ASSERT_TRUE(queries.back()->parseString(statement)) << statement;
+    }
+    for (int frozen = 0; frozen < 2; ++frozen)
+    {
+        SCOPED_TRACE(frozen);
+        std::vector<SIRENResultSet<NodeView>> results;
+        std::size_t result_count =
+            DefaultSIRENInterpreter::evaluate_all(materials, queries, results);
+        ASSERT_EQ(queries.size(), results.size());
+        // the results are those of evaluating each query individually
+        std::size_t expected_count = 0;
+        for (std::size_t q = 0; q < queries.size(); ++q)
+        {
+            SCOPED_TRACE(statements[q]);
+            SIRENResultSet<NodeView> expected;
+            expected_count += queries[q]->evaluate(materials, expected);
+            ASSERT_EQ(expected.result_count(), results[q].result_count());
+            for (std::size_t r = 0; r < expected.result_count(); ++r)
+            {
+                ASSERT_EQ(expected.adapted(r).node_index(),
+                          results[q].adapted(r).node_index());
+            }
+        }
+        ASSERT_EQ(expected_count, result_count);
+        ASSERT_EQ(100, results[2].result_count());
+        ASSERT_EQ(results[2].result_count(), results[16].result_count());
+        ASSERT_EQ(1, results[7].result_count());
+        ASSERT_EQ(3, results[10].result_count());
+        ASSERT_EQ(1, results[11].result_count());
+        ASSERT_EQ(0, results[12].result_count());
+        ASSERT_EQ(10, results[14].result_count());
+        ASSERT_EQ(1, results[17].result_count());
+        ASSERT_EQ(1, results[18].result_count());
+        ASSERT_EQ(1, results[19].result_count());
+        ASSERT_EQ(0, results[20].result_count());
+        interp.freeze();
+    }
+}
+
+TEST(SIREN, descendant_selection)
+{
+    DummyInterp<TreeNodePool<>> interp;
+    // document
+    // |_ a
+    // | |_ b (1)
+    // | |_ c
+    // |   |_ b (2)
+    // |_ d
+    // | |_ e (3)
+    // |_ b (4)
+    auto push_value = [&interp](const char* name, const char* data) {
+        auto token_i = interp.token_count();
+        interp.push_token(data, wasp::INTEGER, token_i);
+        interp.push_leaf(wasp::VALUE, name, token_i);
+        return interp.size() - 1;
+    };
+    size_t b1 = push_value("b", "1");
+    size_t b2 = push_value("b", "2");
+    interp.push_parent(wasp::OBJECT, "c", {b2});
+    size_t c = interp.size() - 1;
+    interp.push_parent(wasp::OBJECT, "a", {b1, c});
+    size_t a  = interp.size() - 1;
+    size_t e3 = push_value("e", "3");
+    interp.push_parent(wasp::OBJECT, "d", {e3});
+    size_t d  = interp.size() - 1;
+    size_t b4 = push_value("b", "4");
+    interp.push_parent(wasp::DOCUMENT_ROOT, "document", {a, d, b4});
+    NodeView document(interp.size() - 1, interp);
+
+    auto select = [](const NodeView& node, const std::string& statement) {
+        DefaultSIRENInterpreter siren;
+        EXPECT_TRUE(siren.parseString(statement));
+        SIRENResultSet<NodeView> set;
+        NodeView                 context(node);
+        siren.evaluate(context, set);
+        std::vector<size_t> selected;
+        for (size_t i = 0; i < set.result_count(); ++i)
+        {
+            selected.push_back(set.adapted(i).node_index());
+        }
+        return selected;
+    };
+    for (int frozen = 0; frozen < 2; ++frozen)
+    {
+        SCOPED_TRACE(frozen);
+        // the children of the document, a, and c, in that order
+        ASSERT_EQ((std::vector<size_t>{b4, b1, b2}), select(document, "//b"));
+        ASSERT_EQ((std::vector<size_t>{e3}), select(document, "//e"));
+        ASSERT_EQ((std::vector<size_t>{b2}), select(document, "//c/b"));
+        // indices count the matches of all staged nodes
+        ASSERT_EQ((std::vector<size_t>{b1}), select(document, "//b[2]"));
+        ASSERT_EQ((std::vector<size_t>{b1, b2}), select(document, "/a//b"));
+        ASSERT_EQ((std::vector<size_t>{b1, b2}), select(document, "//a//b"));
+        ASSERT_EQ((std::vector<size_t>{document.node_index(), a, c}),
+                  select(document, "//b/.."));
+        ASSERT_EQ(7, select(document, "//*").size());
+        ASSERT_TRUE(select(document, "//x").empty());
+        ASSERT_TRUE(select(document, "/d//b").empty());
+        // relative to the given node
+        NodeView node_a(a, interp);
+        ASSERT_EQ((std::vector<size_t>{b2}), select(node_a, "c//b"));
+        ASSERT_EQ((std::vector<size_t>{b4, b1, b2}), select(node_a, "//b"));
+        interp.freeze();
+    }
+}
+
+TEST(SIREN, limited_selection)
+{
+    DummyInterp<TreeNodePool<>> interp;
+    push_materials(interp);
+    NodeView document(interp.size() - 1, interp);
+
+    std::vector<std::string> statements = {"/",
+                                           "/materials/material",
+                                           "/materials/m*",
+                                           "/materials/material/id",
+                                           "/materials/material[id=m42]",
+                                           "/materials/mat*[i*=m4*]",
+                                           "/materials/material[2:6]",
+                                           "/materials/mesh[3]",
+                                           "/materials/material/..",
+                                           "/materials/material/id/..",
+                                           "//id",
+                                           "//material[id=m9*]",
+                                           "/materials/x"};
+    for (int frozen = 0; frozen < 2; ++frozen)
+    {
+        SCOPED_TRACE(frozen);
+        for (const std::string& statement : statements)
+        {
+            SCOPED_TRACE(statement);
+            DefaultSIRENInterpreter siren;
+            ASSERT_TRUE(siren.parseString(statement));
+            SIRENResultSet<NodeView> all;
+            siren.evaluate(document, all);
+            ASSERT_EQ(all.result_count(), siren.count(document));
+            for (size_t limit = 1; limit <= 6; ++limit)
+            {
+                // the first matches of the unlimited selection
+                SIRENResultSet<NodeView> set;
+                set.set_limit(limit);
+                size_t expected = std::min(limit, all.result_count());
+                ASSERT_EQ(expected, siren.evaluate(document, set));
+                ASSERT_EQ(expected == limit, set.full());
+                for (size_t i = 0; i < expected; ++i)
+                {
+                    ASSERT_EQ(all.adapted(i).node_index(),
+                              set.adapted(i).node_index());
+                }
+                ASSERT_EQ(expected, siren.count(document, limit));
+            }
+            NodeView first;
+            ASSERT_EQ(all.result_count() > 0, siren.first(document, first));
+            if (all.result_count() > 0)
+            {
+                ASSERT_EQ(all.adapted(0).node_index(), first.node_index());
+            }
+        }
+        // a full set is not evaluated into
+        DefaultSIRENInterpreter siren;
+        ASSERT_TRUE(siren.parseString("/materials/mesh"));
+        SIRENResultSet<NodeView> set;
+        set.set_limit(3);
+        ASSERT_EQ(3, siren.evaluate(document, set));
+        ASSERT_EQ(3, siren.evaluate(document, set));
+        set.set_limit(5);
+        ASSERT_FALSE(set.full());
+        ASSERT_EQ(5, siren.evaluate(document, set));
+        ASSERT_EQ(10, siren.count(document));
+        ASSERT_EQ(2, siren.count(document, 2));
+        interp.freeze();
+    }
+}
@@ -0,0 +1,111 @@
+#include "waspsiren/SIRENQueryCache.h"
+#include "waspcore/Interpreter.h"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace wasp;
+
+TEST(SIRENQueryCache, compile)
+{
+    DefaultSIRENQueryCache cache(2);
+    ASSERT_EQ(2, cache.capacity());
+    std::stringstream errors;
+
+    DefaultSIRENQueryCache::Query a = cache.compile("/a", errors);
+    ASSERT_TRUE(a != nullptr);
+    ASSERT_TRUE(a->frozen());
+    ASSERT_EQ(0, cache.hits());
+    ASSERT_EQ(1, cache.misses());
+    // the same statement acquires the same program
+    ASSERT_EQ(a, cache.compile("/a", errors));
+    ASSERT_EQ(1, cache.hits());
+    ASSERT_EQ(1, cache.size());
+
+    // the least recently used program is evicted
+    DefaultSIRENQueryCache::Query b = cache.compile("/b", errors);
+    ASSERT_EQ(a, cache.compile("/a", errors));
+    cache.compile("/c", errors);
+    ASSERT_EQ(2, cache.size());
+    ASSERT_EQ(1, cache.evictions());
+    ASSERT_EQ(a, cache.compile("/a", errors));
+    ASSERT_NE(b, cache.compile("/b", errors));
+    ASSERT_EQ(3, cache.hits());
+    ASSERT_EQ(4, cache.misses());
+    // evicted programs remain usable by their holders
+    ASSERT_EQ(1, b->root().child_count());
+
+    // failures are reported and not cached
+    ASSERT_TRUE(errors.str().empty());
+    ASSERT_TRUE(cache.compile("/a[", errors) == nullptr);
+    ASSERT_FALSE(errors.str().empty());
+    ASSERT_EQ(2, cache.size());
+
+    cache.set_capacity(0);
+    ASSERT_EQ(0, cache.size());
+    ASSERT_TRUE(cache.compile("/a", errors) != nullptr);
+    ASSERT_EQ(0, cache.size());
+    cache.clear();
+    ASSERT_EQ(0, cache.hits());
+    ASSERT_EQ(0, cache.misses());
+}
+
+TEST(SIRENQueryCache, concurrent_evaluation)
+{
+    DummyInterp<TreeNodePool<>> interp;
+    // document
+    // |_ key
+    //   |_ value (1)
+    //   |_ value (2)
+    std::vector<std::size_t> values;
+    for (int i = 0; i < 2; ++i)
+    {
+        std::size_t token_i = interp.token_count();
+        interp.push_token(std::to_string(i + 1).c_str(), wasp::INTEGER, i);
+        interp.push_leaf(wasp::VALUE, "value", token_i);
+        values.push_back(interp.size() - 1);
+    }
+    interp.push_parent(wasp::ARRAY, "key", values);
+    interp.push_parent(wasp::DOCUMENT_ROOT, "document", {interp.size() - 1});
+    interp.freeze();
+    NodeView document(interp.size() - 1, interp);
+
+    DefaultSIRENQueryCache cache;
+    std::vector<std::size_t> counts(8, 0);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < counts.size(); ++t)
+    {
+        threads.emplace_back([&cache, &counts, &document, t]() {
+            std::stringstream errors;
+            for (int i = 0; i < 100; ++i)
+            {
+                auto query = cache.compile(
+                    i % 2 ? "/key/value" : "/key/value[2]", errors);
+                SIRENResultSet<NodeView> set;
+                counts[t] += query->evaluate(document, set);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (std::size_t count : counts)
+    {
+        ASSERT_EQ(150, count);
+    }
+    ASSERT_EQ(800, cache.hits() + cache.misses());
+    ASSERT_EQ(2, cache.size());
+
+    // compiled programs are evaluated together
+    std::stringstream errors;
+    std::vector<DefaultSIRENQueryCache::Query> queries = {
+        cache.compile("/key/value", errors),
+        cache.compile("/key/value[2]", errors)};
+    std::vector<SIRENResultSet<NodeView>> sets;
+    ASSERT_EQ(3, DefaultSIRENInterpreter::evaluate_all(document, queries, sets));
+    ASSERT_EQ(2, sets[0].result_count());
+    ASSERT_EQ(1, sets[1].result_count());
+}
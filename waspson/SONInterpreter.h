@@ -18,6 +18,7 @@
 
 #include "waspson/SONParser.hpp"
 #include "waspcore/Interpreter.h"
+#include "waspcore/MappedFile.h"
 
 #include "waspcore/decl.h"
 
@@ -48,7 +48,7 @@ bool SONInterpreter<S>::parseStream(std::istream&      in,
 template<class S>
 bool SONInterpreter<S>::parseFile(const std::string& filename, size_t line)
 {
-    std::ifstream in(filename.c_str());
+    MappedFile in(filename);
     if (!in.good())
     {
         Interpreter<S>::error_diagnostic()
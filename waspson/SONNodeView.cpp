@@ -141,6 +141,44 @@ std::string SONNodeView::data() const
     return str.str();
 }
 
+StringView SONNodeView::data_view() const
+{
+    wasp_insist(m_pool->is_leaf(m_node_index),
+                "only a leaf node's data can be viewed without a buffer!");
+    std::string unused;
+    return m_pool->data_view(m_node_index, unused);
+}
+
+StringView SONNodeView::data_view(std::string& buffer) const
+{
+    return m_pool->data_view(m_node_index, buffer);
+}
+
+std::uint64_t SONNodeView::subtree_hash() const
+{
+    return m_pool->subtree_hash(m_node_index);
+}
+
+size_t SONNodeView::packed_size() const
+{
+    return m_pool->packed_size(m_node_index);
+}
+
+Span<const std::int64_t> SONNodeView::packed_integers() const
+{
+    return m_pool->packed_integers(m_node_index);
+}
+
+Span<const double> SONNodeView::packed_reals() const
+{
+    return m_pool->packed_reals(m_node_index);
+}
+
+std::string SONNodeView::packed_data(size_t element) const
+{
+    return m_pool->packed_data(m_node_index, element);
+}
+
 void SONNodeView::set_data(const char* data)
 {
     NodeView view(node_index(), *node_pool());
@@ -216,6 +254,11 @@ const char* SONNodeView::name() const
     return m_pool->name(m_node_index);
 }
 
+StringView SONNodeView::name_view() const
+{
+    return m_pool->name_view(m_node_index);
+}
+
 std::size_t SONNodeView::line() const
 {
     return m_pool->line(m_node_index);
@@ -260,6 +303,12 @@ std::string SONNodeView::to_string(bool* ok) const
     return view.to_string(ok);
 }
 
+StringView SONNodeView::to_string_view(std::string& buffer) const
+{
+    NodeView view(value_node_index(), *node_pool());
+    return view.to_string_view(buffer);
+}
+
 std::string SONNodeView::last_as_string(bool* ok) const
 {
     return wasp::last_as_string(*this, ok);
@@ -54,6 +54,48 @@ class WASP_PUBLIC SONNodeView
      * @return the node's data
      */
     std::string data() const;
+    /**
+     * @brief data_view acquire a view of the leaf node's data without
+     * copying it
+     * Throws if this is a parent node, whose data is formatted; use
+     * data_view(buffer) for any node.
+     */
+    StringView data_view() const;
+    /**
+     * @brief data_view acquire a view of the node's data
+     * @param buffer storage for a parent node's formatted data, reusable
+     * across calls
+     */
+    StringView data_view(std::string& buffer) const;
+
+    /**
+     * @brief subtree_hash the structural hash of this node's subtree
+     * Subtrees of equal names, types and leaf data hash equal regardless of
+     * their position, suiting detection of duplicate blocks and diffing.
+     */
+    std::uint64_t subtree_hash() const;
+
+    /**
+     * @brief packed_size the number of elements of this packed array
+     * The elements of an array packed by the document's pack_arrays are not
+     * child nodes; they are acquired through the packed_* accessors.
+     * @return the element count, or zero if this is not a packed array
+     */
+    size_t packed_size() const;
+    /**
+     * @brief packed_integers acquire the elements of this packed array of
+     * integers, empty if this is not one
+     */
+    Span<const std::int64_t> packed_integers() const;
+    /**
+     * @brief packed_reals acquire the elements of this packed array of
+     * reals, empty if this is not one
+     */
+    Span<const double> packed_reals() const;
+    /**
+     * @brief packed_data acquire the text of the given packed element
+     */
+    std::string packed_data(size_t element) const;
 
     /**
      * @brief Set the data of this node - this is only legal for LEAF nodes
@@ -211,6 +253,10 @@ class WASP_PUBLIC SONNodeView
      * @return the node's name
      */
     const char* name() const;
+    /**
+     * @brief name_view acquire a view of the node's name without copying it
+     */
+    StringView name_view() const;
 
     /**
      * @brief line acquire the node's starting line
@@ -272,6 +318,13 @@ class WASP_PUBLIC SONNodeView
      * front and back).
      */
     std::string to_string(bool* ok = nullptr) const;
+    /**
+     * @brief to_string_view acquire a view of the data as to_string would
+     * produce it, without copying a leaf's data
+     * @param buffer storage for data that is not viewed in place, reusable
+     * across calls
+     */
+    StringView to_string_view(std::string& buffer) const;
 
     /**
      * @brief last_as_string acquires this node or last child's node as string
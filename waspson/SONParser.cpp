@@ -370,31 +370,31 @@ namespace wasp {
     {
       case symbol_kind::S_key_declaration: // key_declaration
 #line 135 "SONParser.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 375 "SONParser.cpp"
         break;
 
       case symbol_kind::S_declaration: // declaration
 #line 135 "SONParser.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 381 "SONParser.cpp"
         break;
 
       case symbol_kind::S_tag: // tag
 #line 134 "SONParser.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 387 "SONParser.cpp"
         break;
 
       case symbol_kind::S_members: // members
 #line 134 "SONParser.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 393 "SONParser.cpp"
         break;
 
       case symbol_kind::S_array_members: // array_members
 #line 134 "SONParser.bison"
-                    { delete (yysym.value.node_indices); }
+                    { interpreter.release_child_indices((yysym.value.node_indices)); }
 #line 399 "SONParser.cpp"
         break;
 
@@ -1295,7 +1295,7 @@ namespace wasp {
   case 68: // tag: decl
 #line 494 "SONParser.bison"
         {
-             (yylhs.value.node_indices) = new std::vector<size_t>();
+             (yylhs.value.node_indices) = interpreter.acquire_child_indices();
              (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1302 "SONParser.cpp"
@@ -1304,7 +1304,7 @@ namespace wasp {
   case 69: // tag: decl lparen identifier rparen
 #line 499 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[3].value.node_index));
             (yylhs.value.node_indices)->push_back((yystack_[2].value.node_index));
             (yylhs.value.node_indices)->push_back((yystack_[1].value.node_index));
@@ -1321,7 +1321,7 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::ARRAY
                 ,wasp::strip_quotes(interpreter.data((yystack_[2].value.node_indices)->front())).c_str()
                 ,*(yystack_[2].value.node_indices));
-        delete (yystack_[2].value.node_indices);
+        interpreter.release_child_indices((yystack_[2].value.node_indices));
     }
 #line 1327 "SONParser.cpp"
     break;
@@ -1334,7 +1334,7 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::ARRAY
                                     , name.c_str()
                                         ,*(yystack_[2].value.node_indices));
-        delete (yystack_[2].value.node_indices);
+        interpreter.release_child_indices((yystack_[2].value.node_indices));
         error(yystack_[1].location, name+" has unmatched left bracket!");
         YYERROR;
     }
@@ -1351,7 +1351,7 @@ namespace wasp {
         else if( last_component_type == wasp::ARRAY ) error(yystack_[2].location, name+" or one of its components has unmatched left bracket!");
         else error(yystack_[2].location, name+" has unmatched left bracket!");
 
-        delete (yystack_[3].value.node_indices);
+        interpreter.release_child_indices((yystack_[3].value.node_indices));
         YYERROR;
     }
 #line 1358 "SONParser.cpp"
@@ -1363,7 +1363,7 @@ namespace wasp {
         // TODO capture partial definition
         std::string name = interpreter.name((yystack_[2].value.node_indices)->front());
         error(yystack_[1].location, name+" has unmatched left bracket!");
-        delete (yystack_[2].value.node_indices);
+        interpreter.release_child_indices((yystack_[2].value.node_indices));
         YYERROR;
     }
 #line 1370 "SONParser.cpp"
@@ -1379,8 +1379,8 @@ namespace wasp {
         else if( last_component_type == wasp::ARRAY ) error(yystack_[2].location, name+" or one of its components has unmatched left bracket!");
         else error(yystack_[2].location, name+" has unmatched left bracket!");
 
-        delete (yystack_[1].value.node_indices);
-        delete (yystack_[3].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
+        interpreter.release_child_indices((yystack_[3].value.node_indices));
         YYERROR;
     }
 #line 1387 "SONParser.cpp"
@@ -1398,8 +1398,8 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::ARRAY
             ,wasp::strip_quotes(interpreter.data((yystack_[3].value.node_indices)->front())).c_str()
             ,*(yystack_[3].value.node_indices));
-        delete (yystack_[3].value.node_indices);
-        delete (yystack_[1].value.node_indices);
+        interpreter.release_child_indices((yystack_[3].value.node_indices));
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
 
     }
 #line 1406 "SONParser.cpp"
@@ -1413,7 +1413,7 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::OBJECT
             ,wasp::strip_quotes(interpreter.data((yystack_[2].value.node_indices)->front())).c_str()
             ,*(yystack_[2].value.node_indices));
-        delete (yystack_[2].value.node_indices);
+        interpreter.release_child_indices((yystack_[2].value.node_indices));
     }
 #line 1419 "SONParser.cpp"
     break;
@@ -1426,7 +1426,7 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::OBJECT
                                      , name.c_str()
                                      , *(yystack_[2].value.node_indices));
-        delete (yystack_[2].value.node_indices);
+        interpreter.release_child_indices((yystack_[2].value.node_indices));
         error(yystack_[1].location, name+" has unmatched left brace!");
         YYERROR;
     }
@@ -1442,8 +1442,8 @@ namespace wasp {
         if( (yystack_[1].value.node_indices)->size() ==0 ) error(yystack_[2].location, name+" has unmatched left brace!");
         else if( last_component_type == wasp::OBJECT ) error(yystack_[2].location, name+" or one of its components has unmatched left brace!");
         else error(yystack_[2].location, name+" has unmatched left brace!");
-        delete (yystack_[1].value.node_indices);
-        delete (yystack_[3].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
+        interpreter.release_child_indices((yystack_[3].value.node_indices));
         YYERROR;
     }
 #line 1450 "SONParser.cpp"
@@ -1458,7 +1458,7 @@ namespace wasp {
                                      , name.c_str()
                                      , *(yystack_[2].value.node_indices));
         error(yystack_[1].location, name+" has unmatched left brace!");
-        delete (yystack_[2].value.node_indices);
+        interpreter.release_child_indices((yystack_[2].value.node_indices));
         YYERROR;
     }
 #line 1465 "SONParser.cpp"
@@ -1474,8 +1474,8 @@ namespace wasp {
         else if( last_component_type == wasp::OBJECT ) error(yystack_[2].location, name+" or one of its components has unmatched left brace!");
         else error(yystack_[2].location, name+" has unmatched left brace!");
 
-        delete (yystack_[1].value.node_indices);
-        delete (yystack_[3].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
+        interpreter.release_child_indices((yystack_[3].value.node_indices));
         YYERROR;
     }
 #line 1482 "SONParser.cpp"
@@ -1493,8 +1493,8 @@ namespace wasp {
         (yylhs.value.node_index) = interpreter.push_parent(wasp::OBJECT
                                     ,wasp::strip_quotes(interpreter.data((yystack_[3].value.node_indices)->front())).c_str()
                                         ,*(yystack_[3].value.node_indices));
-        delete (yystack_[3].value.node_indices);
-        delete (yystack_[1].value.node_indices);
+        interpreter.release_child_indices((yystack_[3].value.node_indices));
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
     }
 #line 1500 "SONParser.cpp"
     break;
@@ -1514,7 +1514,7 @@ namespace wasp {
                                      //  |_ value (1.2..blah)
                                     ,quote_less_data.c_str()
                                     ,*(yystack_[1].value.node_indices));
-        delete (yystack_[1].value.node_indices);
+        interpreter.release_child_indices((yystack_[1].value.node_indices));
     }
 #line 1520 "SONParser.cpp"
     break;
@@ -1522,7 +1522,7 @@ namespace wasp {
   case 83: // members: filler
 #line 666 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1529 "SONParser.cpp"
@@ -1540,7 +1540,7 @@ namespace wasp {
   case 85: // members: object
 #line 676 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1547 "SONParser.cpp"
@@ -1558,7 +1558,7 @@ namespace wasp {
   case 87: // members: array
 #line 686 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1565 "SONParser.cpp"
@@ -1576,7 +1576,7 @@ namespace wasp {
   case 89: // members: keyedvalue
 #line 696 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1583 "SONParser.cpp"
@@ -1594,7 +1594,7 @@ namespace wasp {
   case 91: // members: comment
 #line 706 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1601 "SONParser.cpp"
@@ -1621,7 +1621,7 @@ namespace wasp {
   case 94: // members: import_file
 #line 721 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1628 "SONParser.cpp"
@@ -1639,7 +1639,7 @@ namespace wasp {
   case 96: // array_members: exp
 #line 733 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1646 "SONParser.cpp"
@@ -1657,7 +1657,7 @@ namespace wasp {
   case 98: // array_members: filler
 #line 744 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1664 "SONParser.cpp"
@@ -1675,7 +1675,7 @@ namespace wasp {
   case 100: // array_members: object
 #line 754 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1682 "SONParser.cpp"
@@ -1693,7 +1693,7 @@ namespace wasp {
   case 102: // array_members: array
 #line 764 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1700 "SONParser.cpp"
@@ -1711,7 +1711,7 @@ namespace wasp {
   case 104: // array_members: keyedvalue
 #line 774 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1718 "SONParser.cpp"
@@ -1729,7 +1729,7 @@ namespace wasp {
   case 106: // array_members: comment
 #line 784 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1736 "SONParser.cpp"
@@ -1756,7 +1756,7 @@ namespace wasp {
   case 109: // array_members: import_file
 #line 799 "SONParser.bison"
         {
-            (yylhs.value.node_indices) = new std::vector<size_t>();
+            (yylhs.value.node_indices) = interpreter.acquire_child_indices();
             (yylhs.value.node_indices)->push_back((yystack_[0].value.node_index));
         }
 #line 1763 "SONParser.cpp"
@@ -1821,7 +1821,7 @@ namespace wasp {
                 child_indices.push_back( (yystack_[1].value.node_indices)->at(i) );
             }
             child_indices.push_back(end_i);
-            delete (yystack_[1].value.node_indices);
+            interpreter.release_child_indices((yystack_[1].value.node_indices));
             (yylhs.value.node_index) = interpreter.push_parent(wasp::EXECUTION_UNIT
                         ,wasp::strip_quotes(interpreter.data(name_i)).c_str()
                         ,child_indices);
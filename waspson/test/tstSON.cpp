@@ -5,11 +5,16 @@
  * Created on September 26, 2013, 11:43 AM
  */
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <stdexcept>
+#include <fstream>
 #include <functional>
+#include "waspcore/Diff.h"
 #include "waspson/SONInterpreter.h"
 #include "waspson/SONNodeView.h"
 #include <waspson/son_config.h>
@@ -1807,4 +1812,693 @@ TEST(SON, only_include)
 </document>
 )INPUT";
     ASSERT_EQ(expected_xml, xml.str());
-}
\ No newline at end of file
+}
+/**
+ * @brief snapshot round trip of a document with a nested include
+ */
+TEST(SON, snapshot)
+{
+    { // Scope for file buffer to be flushed before reading
+    std::ofstream block_file("snapshot_data.son");
+    block_file << "  key = 3" << std::endl << "  obj{ v = [ 1 2 ] }" << std::endl;
+    block_file.close();
+    }
+
+    std::stringstream input;
+    input << "first = 'one'" << std::endl
+          << R"I(`import ('snapshot_data.son'))I" << std::endl
+          << "last{ x = 4.5 }" << std::endl;
+
+    DefaultSONInterpreter interpreter;
+    interpreter.enable_line_index();
+    ASSERT_TRUE(interpreter.parse(input));
+    ASSERT_EQ(1, interpreter.document_count());
+    ASSERT_TRUE(interpreter.save_snapshot("snapshot.wasp"));
+
+    DefaultSONInterpreter loaded;
+    ASSERT_TRUE(loaded.load_snapshot("snapshot.wasp"));
+    ASSERT_TRUE(loaded.has_line_index());
+    ASSERT_EQ(interpreter.stream_name(), loaded.stream_name());
+    ASSERT_EQ(interpreter.node_count(), loaded.node_count());
+    ASSERT_EQ(interpreter.token_count(), loaded.token_count());
+    ASSERT_EQ(interpreter.document_count(), loaded.document_count());
+
+    std::stringstream expected_paths, actual_paths;
+    interpreter.root().paths(expected_paths);
+    loaded.root().paths(actual_paths);
+    ASSERT_EQ(expected_paths.str(), actual_paths.str());
+
+    // the nested document is restored with its parent linkage
+    std::stringstream expected_xml, actual_xml;
+    wasp::to_xml(SONNodeView(interpreter.root()), expected_xml);
+    wasp::to_xml(SONNodeView(loaded.root()), actual_xml);
+    ASSERT_EQ(expected_xml.str(), actual_xml.str());
+
+    std::vector<std::string> expected = {"first", "key", "obj", "last"};
+    SONNodeView root = loaded.root();
+    size_t index = 0;
+    for (auto itr = root.begin(); itr != root.end(); itr.next(), ++index)
+    {
+        ASSERT_LT(index, expected.size());
+        ASSERT_EQ(expected[index], itr.get().name());
+        ASSERT_EQ(root, itr.get().parent());
+    }
+    ASSERT_EQ(expected.size(), index);
+    // the import is the root's second child
+    auto* nested = loaded.document(root.child_at(1).node_index());
+    ASSERT_NE(nullptr, nested);
+    ASSERT_EQ(&loaded, nested->document_parent());
+    ASSERT_EQ("./snapshot_data.son", nested->stream_name());
+    ASSERT_EQ(2, nested->line(nested->root().first_child_by_name("obj")
+                                  .node_index()));
+
+    // truncated and foreign files are rejected
+    {
+        std::ifstream     full("snapshot.wasp", std::ios_base::binary);
+        std::stringstream content;
+        content << full.rdbuf();
+        std::ofstream truncated("snapshot_truncated.wasp",
+                                std::ios_base::binary);
+        truncated << content.str().substr(0, content.str().size() / 2);
+    }
+    std::stringstream errors;
+    DefaultSONInterpreter invalid(errors);
+    ASSERT_FALSE(invalid.load_snapshot("snapshot_truncated.wasp"));
+    ASSERT_FALSE(invalid.load_snapshot("snapshot_data.son"));
+    ASSERT_EQ(2, invalid.error_diagnostics().size());
+
+    // snapshots of the same document are identical
+    std::stringstream snapshot, resaved;
+    ASSERT_TRUE(interpreter.save_snapshot(snapshot));
+    ASSERT_TRUE(loaded.save_snapshot(resaved));
+    ASSERT_EQ(snapshot.str(), resaved.str());
+
+    // a snapshot truncated within the nested document leaves the loaded
+    // document unchanged
+    std::stringstream nested_truncated(
+        snapshot.str().substr(0, snapshot.str().size() - 4));
+    ASSERT_FALSE(loaded.load_snapshot(nested_truncated));
+    ASSERT_EQ(interpreter.node_count(), loaded.node_count());
+    ASSERT_EQ(1, loaded.document_count());
+    actual_xml.str("");
+    wasp::to_xml(SONNodeView(loaded.root()), actual_xml);
+    ASSERT_EQ(expected_xml.str(), actual_xml.str());
+}
+
+/**
+ * @brief pre-order relayout of a document with a nested include
+ */
+TEST(SON, relayout)
+{
+    { // Scope for file buffer to be flushed before reading
+    std::ofstream block_file("relayout_data.son");
+    block_file << "key = 3" << std::endl << "obj{ v = [ 1 2 ] }" << std::endl;
+    block_file.close();
+    }
+
+    std::stringstream input;
+    input << "first = 'one'" << std::endl
+          << R"I(`import ('relayout_data.son'))I" << std::endl
+          << "last{ x = 4.5 y = [ 6 7 ] }" << std::endl;
+
+    DefaultSONInterpreter interpreter;
+    interpreter.enable_line_index();
+    ASSERT_TRUE(interpreter.parse(input));
+    ASSERT_FALSE(interpreter.preordered());
+    std::stringstream expected_xml, expected_paths;
+    wasp::to_xml(SONNodeView(interpreter.root()), expected_xml);
+    interpreter.root().paths(expected_paths);
+    size_t import_index = interpreter.root().child_at(1).node_index();
+    size_t last_index   = interpreter.root().child_at(2).node_index();
+    ASSERT_TRUE(interpreter.is_descendant(interpreter.root().node_index(),
+                                          last_index));
+
+    std::vector<size_t> new_index = interpreter.relayout();
+    ASSERT_EQ(interpreter.node_count(), new_index.size());
+    ASSERT_TRUE(interpreter.preordered());
+    ASSERT_EQ(0, interpreter.root().node_index());
+    ASSERT_EQ(interpreter.node_count(), interpreter.subtree_end(0));
+
+    // the document, including the nested document, is unchanged
+    std::stringstream actual_xml, actual_paths;
+    wasp::to_xml(SONNodeView(interpreter.root()), actual_xml);
+    interpreter.root().paths(actual_paths);
+    ASSERT_EQ(expected_xml.str(), actual_xml.str());
+    ASSERT_EQ(expected_paths.str(), actual_paths.str());
+    auto* nested = interpreter.document(new_index[import_index]);
+    ASSERT_NE(nullptr, nested);
+    ASSERT_EQ(new_index[import_index],
+              interpreter.document_node(nested));
+    ASSERT_EQ(0, nested->root().node_index());
+    ASSERT_EQ(2, nested->line(nested->root().first_child_by_name("obj")
+                                  .node_index()));
+
+    // each subtree is the contiguous range following its root
+    SONNodeView last = interpreter.root().child_at(2);
+    ASSERT_EQ(new_index[last_index], last.node_index());
+    size_t end = interpreter.subtree_end(last.node_index());
+    ASSERT_EQ(interpreter.node_count(), end);
+    std::vector<std::string> names;
+    for (size_t i = last.node_index(); i < end; ++i)
+    {
+        ASSERT_TRUE(i == last.node_index() ||
+                    interpreter.is_descendant(last.node_index(), i));
+        names.push_back(interpreter.name(i));
+    }
+    ASSERT_EQ((std::vector<std::string>{"last", "decl", "{", "x", "decl", "=",
+                                        "value", "y", "decl", "=", "[",
+                                        "value", "value", "]", "}"}),
+              names);
+    ASSERT_FALSE(interpreter.is_descendant(last.node_index(), 1));
+    ASSERT_FALSE(interpreter.is_descendant(last.node_index(),
+                                           last.node_index()));
+
+    // the layout is retained by snapshots
+    std::stringstream snapshot;
+    ASSERT_TRUE(interpreter.save_snapshot(snapshot));
+    DefaultSONInterpreter loaded;
+    ASSERT_TRUE(loaded.load_snapshot(snapshot));
+    ASSERT_TRUE(loaded.preordered());
+    ASSERT_EQ(end, loaded.subtree_end(last.node_index()));
+    std::stringstream loaded_xml;
+    wasp::to_xml(SONNodeView(loaded.root()), loaded_xml);
+    ASSERT_EQ(expected_xml.str(), loaded_xml.str());
+}
+
+TEST(SON, nodes_of_type)
+{
+    { // Scope for file buffer to be flushed before reading
+    std::ofstream block_file("type_index_data.son");
+    block_file << "key = 3" << std::endl << "obj{ v = [ 1 2 ] }" << std::endl;
+    block_file.close();
+    }
+
+    std::stringstream input;
+    input << "first{ a = 1 }" << std::endl
+          << R"I(`import ('type_index_data.son'))I" << std::endl
+          << "last{ x = 4.5 }" << std::endl;
+
+    DefaultSONInterpreter interpreter;
+    interpreter.enable_type_index();
+    ASSERT_TRUE(interpreter.type_indexed());
+    ASSERT_TRUE(interpreter.parse(input));
+
+    std::vector<size_t> nodes;
+    interpreter.nodes_of_type(wasp::OBJECT, nodes);
+    std::vector<std::string> names;
+    for (size_t node_index : nodes)
+    {
+        names.push_back(interpreter.name(node_index));
+    }
+    ASSERT_EQ((std::vector<std::string>{"first", "last"}), names);
+    // the import's decl and the import itself
+    interpreter.nodes_of_type(wasp::FILE, nodes);
+    ASSERT_EQ(2, nodes.size());
+    ASSERT_EQ(std::string("import"), interpreter.name(nodes[1]));
+
+    // the nested document is indexed too
+    auto* nested = interpreter.document(nodes[1]);
+    ASSERT_NE(nullptr, nested);
+    ASSERT_TRUE(nested->type_indexed());
+    nested->nodes_of_type(wasp::OBJECT, nodes);
+    ASSERT_EQ(1, nodes.size());
+    ASSERT_EQ(std::string("obj"), nested->name(nodes[0]));
+    nested->nodes_of_type(wasp::ARRAY, nodes);
+    ASSERT_EQ(1, nodes.size());
+}
+
+TEST(SON, to_doubles)
+{
+    std::stringstream input;
+    input << "values = [ 1 2.5 -3e2 'x' ]" << std::endl << "count = 4";
+    DefaultSONInterpreter interpreter;
+    ASSERT_TRUE(interpreter.parse(input));
+    SONNodeView values = interpreter.root().first_child_by_name("values");
+    auto        array  = values.non_decorative_children();
+    ASSERT_EQ(4, array.size());
+
+    bool ok = true;
+    ASSERT_EQ((std::vector<double>{1.0, 2.5, -300.0, 0.0}),
+              wasp::to_doubles(array, &ok));
+    ASSERT_FALSE(ok);
+    array.pop_back();
+    // repeated conversions acquire the cached values
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        ASSERT_EQ((std::vector<double>{1.0, 2.5, -300.0}),
+                  wasp::to_doubles(array, &ok));
+        ASSERT_TRUE(ok);
+    }
+    SONNodeView count = interpreter.root().first_child_by_name("count");
+    ASSERT_EQ(4, count.to_int(&ok));
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(4.0, count.to_double(&ok));
+    ASSERT_TRUE(ok);
+    // parent data is converted as formatted
+    ASSERT_EQ(0, values.to_int(&ok));
+    ASSERT_FALSE(ok);
+
+    // frozen documents convert without caching
+    interpreter.freeze();
+    ASSERT_EQ(2.5, array[1].to_double(&ok));
+    ASSERT_TRUE(ok);
+}
+
+TEST(SON, data_view)
+{
+    std::stringstream input;
+    input << "key = 'value'" << std::endl << "obj{ x = 1 }";
+    DefaultSONInterpreter interpreter;
+    ASSERT_TRUE(interpreter.parse(input));
+    SONNodeView key   = interpreter.root().first_child_by_name("key");
+    SONNodeView value = key.first_child_by_name("value");
+    SONNodeView obj   = interpreter.root().first_child_by_name("obj");
+
+    ASSERT_EQ("key", key.name_view());
+    ASSERT_EQ(key.name(), key.name_view().data());
+    // leaf data is viewed in place
+    ASSERT_EQ("'value'", value.data_view());
+    std::string buffer;
+    ASSERT_EQ(value.data(), value.data_view(buffer));
+    ASSERT_TRUE(buffer.empty());
+    // parent data is formatted into the buffer
+    ASSERT_EQ(obj.data(), obj.data_view(buffer));
+    ASSERT_EQ(obj.data(), buffer);
+    ASSERT_THROW(obj.data_view(), std::runtime_error);
+    NodeView node(obj.node_index(), *obj.node_pool());
+    ASSERT_EQ("obj", node.name_view());
+    ASSERT_EQ(obj.data(), node.data_view(buffer));
+    // the buffer is overwritten rather than appended to
+    buffer = "stale";
+    ASSERT_EQ(obj.data(), obj.data_view(buffer));
+    ASSERT_EQ(obj.data(), buffer);
+
+    // string views are quoteless, as to_string
+    buffer.clear();
+    ASSERT_EQ("value", key.to_string_view(buffer));
+    ASSERT_EQ(key.to_string(), value.to_string_view(buffer));
+    ASSERT_TRUE(buffer.empty());
+    std::string result = "stale";
+    ASSERT_EQ(key.to_string(), adapted_string(key, result));
+    ASSERT_EQ(obj.to_string(), adapted_string(obj, result));
+    ASSERT_EQ(obj.data(), adapted_data_view(obj, buffer));
+}
+
+namespace
+{
+// an adapter without the optional view accessors
+struct DataAdapter
+{
+    std::string data() const { return "'data'"; }
+    std::string to_string() const { return "data"; }
+};
+}  // namespace
+
+TEST(SON, adapted_view_defaults)
+{
+    DataAdapter adapter;
+    std::string buffer;
+    ASSERT_EQ("'data'", adapted_data_view(adapter, buffer));
+    ASSERT_EQ("data", adapted_string_view(adapter, buffer));
+    std::string result;
+    ASSERT_EQ("data", adapted_string(adapter, result));
+}
+
+TEST(SON, pack_arrays)
+{
+    std::stringstream input;
+    input << "x = [ 1 2 -3" << std::endl
+          << "      4 ]" << std::endl
+          << "y = [ 1 2.50 1e2 ]" << std::endl
+          << "z = [ 1 'a' 3 ]" << std::endl
+          << "w = [ 1 2 ]";
+    DefaultSONInterpreter interpreter;
+    ASSERT_TRUE(interpreter.parse(input));
+    std::size_t node_count  = interpreter.node_count();
+    std::size_t token_count = interpreter.token_count();
+    interpreter.pack_arrays(3);
+    // the elements of x and y are no longer nodes or tokens
+    ASSERT_EQ(node_count - 7, interpreter.node_count());
+    ASSERT_EQ(token_count - 7, interpreter.token_count());
+
+    SONNodeView x = interpreter.root().first_child_by_name("x");
+    ASSERT_EQ(4, x.packed_size());
+    ASSERT_EQ(4, x.child_count());  // decl, =, [, and ]
+    auto integers = x.packed_integers();
+    ASSERT_EQ(4, integers.size());
+    ASSERT_EQ(-3, integers[2]);
+    ASSERT_EQ(4, std::accumulate(integers.begin(), integers.end(), 0));
+    ASSERT_TRUE(x.packed_reals().empty());
+    ASSERT_EQ("4", x.packed_data(3));
+    ASSERT_EQ(2, interpreter.packed_line(x.node_index(), 3));
+    ASSERT_EQ(7, interpreter.packed_column(x.node_index(), 3));
+
+    // mixed integers and reals are packed as reals
+    SONNodeView y = interpreter.root().first_child_by_name("y");
+    auto        reals = y.packed_reals();
+    ASSERT_EQ(3, reals.size());
+    ASSERT_EQ(2.5, reals[1]);
+    ASSERT_EQ(100.0, reals[2]);
+    ASSERT_TRUE(y.packed_integers().empty());
+    // elements print as the shortest text of their value
+    ASSERT_EQ("1e+02", y.packed_data(2));
+    ASSERT_EQ("y = [ 1 2.5  1e+02 ]", y.data());
+
+    // non-numeric and short arrays are retained as nodes
+    SONNodeView z = interpreter.root().first_child_by_name("z");
+    ASSERT_EQ(0, z.packed_size());
+    ASSERT_EQ(7, z.child_count());
+    SONNodeView w = interpreter.root().first_child_by_name("w");
+    ASSERT_EQ(0, w.packed_size());
+    ASSERT_EQ(2, w.child_at(4).to_int());
+
+    std::stringstream printed;
+    wasp::print(printed, interpreter.root());
+    ASSERT_EQ("x = [ 1 2 -3\n      4 ]\ny = [ 1 2.5  1e+02 ]\n"
+              "z = [ 1 'a' 3 ]\nw = [ 1 2 ]",
+              printed.str());
+
+    // packed arrays survive relayout and snapshots
+    interpreter.relayout();
+    x = interpreter.root().first_child_by_name("x");
+    ASSERT_EQ(-3, x.packed_integers()[2]);
+    std::stringstream snapshot;
+    ASSERT_TRUE(interpreter.save_snapshot(snapshot));
+    DefaultSONInterpreter restored;
+    ASSERT_TRUE(restored.load_snapshot(snapshot));
+    std::stringstream restored_printed;
+    wasp::print(restored_printed, restored.root());
+    ASSERT_EQ(printed.str(), restored_printed.str());
+    ASSERT_EQ(2.5,
+              restored.root().first_child_by_name("y").packed_reals()[1]);
+}
+
+TEST(SON, parse_file_lines)
+{
+    std::string content = "a = 1\n\n  o { b = [ 1\n 2 ] }\n";
+    {
+        std::ofstream file("parse_file_lines.son");
+        file << content;
+    }
+    // a mapped file's lines are swept ahead of the lexer
+    DefaultSONInterpreter mapped, streamed;
+    ASSERT_TRUE(mapped.parseFile("parse_file_lines.son"));
+    std::stringstream input(content);
+    ASSERT_TRUE(streamed.parse(input));
+    ASSERT_EQ(4, mapped.line_count());
+    ASSERT_EQ(streamed.line_count(), mapped.line_count());
+    ASSERT_EQ(streamed.node_count(), mapped.node_count());
+    for (std::size_t i = 0; i < mapped.node_count(); ++i)
+    {
+        SCOPED_TRACE(i);
+        ASSERT_EQ(streamed.line(i), mapped.line(i));
+        ASSERT_EQ(streamed.column(i), mapped.column(i));
+        ASSERT_EQ(streamed.last_line(i), mapped.last_line(i));
+        ASSERT_EQ(streamed.last_column(i), mapped.last_column(i));
+    }
+    std::remove("parse_file_lines.son");
+}
+
+namespace
+{
+// record a streamed document's events, one per line
+class EventRecorder : public StreamHandler
+{
+  public:
+    EventRecorder(const DefaultSONInterpreter& interpreter)
+        : interpreter(interpreter), max_node_count(0)
+    {
+    }
+    void start_object(std::size_t type,
+                      StringView  name,
+                      std::size_t line,
+                      std::size_t column)
+    {
+        record() << "{" << type << " " << name << " " << line << ":" << column;
+    }
+    void key(StringView name, std::size_t line, std::size_t column)
+    {
+        record() << "key " << name << " " << line << ":" << column;
+    }
+    void value(StringView data, std::size_t line, std::size_t column)
+    {
+        record() << "value " << data << " " << line << ":" << column;
+    }
+    void end_object(std::size_t type,
+                    StringView  name,
+                    std::size_t line,
+                    std::size_t column)
+    {
+        record() << "}" << type << " " << name << " " << line << ":" << column;
+    }
+    std::ostream& record()
+    {
+        max_node_count = std::max(max_node_count, interpreter.node_count());
+        if (events.tellp() > 0)
+            events << std::endl;
+        return events;
+    }
+    const DefaultSONInterpreter& interpreter;
+    std::size_t                max_node_count;
+    std::stringstream          events;
+};
+}  // namespace
+
+TEST(SON, stream)
+{
+    std::stringstream input;
+    input << "a = 1 % comment" << std::endl
+          << "o { b = 'x' }" << std::endl
+          << "[blk]" << std::endl
+          << "c = [ 2 3 ]" << std::endl
+          << "[empty]";
+    DefaultSONInterpreter interpreter;
+    EventRecorder         recorder(interpreter);
+    interpreter.set_stream_handler(&recorder);
+    ASSERT_TRUE(interpreter.parse(input));
+    std::stringstream expected;
+    expected << "key a 1:1" << std::endl
+             << "value 1 1:5" << std::endl
+             << "{" << std::size_t(wasp::OBJECT) << " o 2:1" << std::endl
+             << "key b 2:5" << std::endl
+             << "value 'x' 2:9" << std::endl
+             << "}" << std::size_t(wasp::OBJECT) << " o 2:13" << std::endl
+             << "{" << std::size_t(wasp::OBJECT) << " blk 3:1" << std::endl
+             << "{" << std::size_t(wasp::ARRAY) << " c 4:1" << std::endl
+             << "value 2 4:7" << std::endl
+             << "value 3 4:9" << std::endl
+             << "}" << std::size_t(wasp::ARRAY) << " c 4:11" << std::endl
+             << "}" << std::size_t(wasp::OBJECT) << " blk 4:11" << std::endl
+             << "{" << std::size_t(wasp::OBJECT) << " empty 5:1" << std::endl
+             << "}" << std::size_t(wasp::OBJECT) << " empty 5:7";
+    ASSERT_EQ(expected.str(), recorder.events.str());
+    // streamed nodes are discarded
+    ASSERT_EQ(0, interpreter.node_count());
+    ASSERT_TRUE(interpreter.root().is_null());
+
+    // the document is held a statement at a time
+    interpreter.reset();
+    std::stringstream long_input;
+    for (int i = 0; i < 1000; ++i)
+    {
+        long_input << "k" << i << " = [ " << i << " " << i + 1 << " ]"
+                   << std::endl;
+    }
+    EventRecorder long_recorder(interpreter);
+    interpreter.set_stream_handler(&long_recorder);
+    ASSERT_TRUE(interpreter.parse(long_input));
+    ASSERT_EQ(0, interpreter.node_count());
+    ASSERT_GE(8, long_recorder.max_node_count);
+    ASSERT_EQ(6000, interpreter.token_count());
+    ASSERT_NE(std::string::npos,
+              long_recorder.events.str().find("value 1000 1000:14"));
+
+    // an included document's events follow those of the include
+    {  // Scope for file buffer to be flushed before reading
+        std::ofstream included_file("stream_data.son");
+        included_file << "i = 7" << std::endl;
+    }
+    interpreter.reset();
+    std::stringstream include_input;
+    include_input << "a = 1" << std::endl
+                  << R"I(`import ('stream_data.son'))I" << std::endl
+                  << "z = 2";
+    EventRecorder include_recorder(interpreter);
+    interpreter.set_stream_handler(&include_recorder);
+    ASSERT_TRUE(interpreter.parse(include_input));
+    std::stringstream include_expected;
+    include_expected << "key a 1:1" << std::endl
+                     << "value 1 1:5" << std::endl
+                     << "{" << std::size_t(wasp::FILE) << " import 2:1"
+                     << std::endl
+                     << "value 'stream_data.son' 2:10" << std::endl
+                     << "key i 1:1" << std::endl
+                     << "value 7 1:5" << std::endl
+                     << "}" << std::size_t(wasp::FILE) << " import 2:27"
+                     << std::endl
+                     << "key z 3:1" << std::endl
+                     << "value 2 3:5";
+    ASSERT_EQ(include_expected.str(), include_recorder.events.str());
+    // the include is retained with its document
+    ASSERT_EQ(1, interpreter.document_count());
+    ASSERT_EQ(1, interpreter.root().child_count());
+}
+
+TEST(SON, subtree_hash)
+{
+    std::stringstream input;
+    input << "a { b = 1 c = [ 1 2 ] }" << std::endl
+          << "a {" << std::endl
+          << "  b=1" << std::endl
+          << "  c=[1 2]" << std::endl
+          << "}" << std::endl
+          << "a { b = 2 c = [ 1 2 ] }" << std::endl
+          << "d { b = 1 c = [ 1 2 ] }";
+    DefaultSONInterpreter interpreter;
+    ASSERT_TRUE(interpreter.parse(input));
+    SONNodeView root = interpreter.root();
+    ASSERT_EQ(4, root.child_count());
+    // equal blocks hash equal regardless of their layout and position
+    ASSERT_EQ(root.child_at(0).subtree_hash(), root.child_at(1).subtree_hash());
+    // differing data or names do not
+    ASSERT_NE(root.child_at(0).subtree_hash(), root.child_at(2).subtree_hash());
+    ASSERT_NE(root.child_at(0).subtree_hash(), root.child_at(3).subtree_hash());
+    ASSERT_EQ(root.child_at(0).first_child_by_name("c").subtree_hash(),
+              root.child_at(3).first_child_by_name("c").subtree_hash());
+
+    // hashes follow changes to the document
+    SONNodeView b = root.child_at(2).first_child_by_name("b");
+    b.child_at(2).set_data("1");
+    ASSERT_EQ(root.child_at(0).subtree_hash(), root.child_at(2).subtree_hash());
+    // packing renumbers the nodes
+    interpreter.pack_arrays(2);
+    root = interpreter.root();
+    ASSERT_EQ(2, root.child_at(0).first_child_by_name("c").packed_size());
+    ASSERT_EQ(root.child_at(0).subtree_hash(), root.child_at(1).subtree_hash());
+
+    // an equal document hashes equal
+    std::stringstream input2;
+    input2 << "a{b=1 c=[1 2]} a{b=1 c=[1 2]} a{b=1 c=[1 2]} d{b=1 c=[1 2]}";
+    DefaultSONInterpreter interpreter2;
+    ASSERT_TRUE(interpreter2.parse(input2));
+    interpreter2.pack_arrays(2);
+    ASSERT_EQ(root.subtree_hash(), interpreter2.root().subtree_hash());
+}
+
+TEST(SON, diff)
+{
+    std::stringstream original_input, revised_input;
+    original_input << "object(a){ x = 1 y = 2 }" << std::endl
+                   << "object(b){ x = 1 }" << std::endl
+                   << "arr = [ 1 2 3 ]";
+    // b is moved, a's y updated, arr and the document appended to
+    revised_input << "object(b){ x = 1 }" << std::endl
+                  << "object(a){" << std::endl
+                  << "   x = 1" << std::endl
+                  << "   y = 3" << std::endl
+                  << "}" << std::endl
+                  << "arr = [ 1 2 3 4 ]" << std::endl
+                  << "z = 5";
+    DefaultSONInterpreter original, revised;
+    ASSERT_TRUE(original.parse(original_input));
+    ASSERT_TRUE(revised.parse(revised_input));
+    SONNodeView a = original.root(), b = revised.root();
+
+    std::vector<DiffEdit> edits = diff(a, b);
+    ASSERT_EQ(3, edits.size());
+    ASSERT_EQ(DiffEdit::UPDATED, edits[0].type);
+    ASSERT_EQ("/object/y/value", edits[0].path);
+    ASSERT_EQ("2", edits[0].a_data);
+    ASSERT_EQ("3", edits[0].b_data);
+    ASSERT_EQ(1, edits[0].a_line);
+    ASSERT_EQ(22, edits[0].a_column);
+    ASSERT_EQ(4, edits[0].b_line);
+    ASSERT_EQ(8, edits[0].b_column);
+    ASSERT_EQ(DiffEdit::INSERTED, edits[1].type);
+    ASSERT_EQ("/arr/value", edits[1].path);
+    ASSERT_EQ("4", edits[1].b_data);
+    ASSERT_EQ(std::size_t(DiffEdit::npos), edits[1].a_node_index);
+    ASSERT_EQ(DiffEdit::INSERTED, edits[2].type);
+    ASSERT_EQ("/z", edits[2].path);
+    ASSERT_EQ(7, edits[2].b_line);
+    std::stringstream printed;
+    printed << edits[0];
+    ASSERT_EQ("updated /object/y/value at 1.22 -> 4.8 (2 -> 3)",
+              printed.str());
+
+    // the reverse difference deletes, a parent's deletions preceding its
+    // descendants' edits
+    edits = diff(b, a);
+    ASSERT_EQ(3, edits.size());
+    ASSERT_EQ(DiffEdit::DELETED, edits[0].type);
+    ASSERT_EQ("/z", edits[0].path);
+    ASSERT_EQ(std::size_t(DiffEdit::npos), edits[0].b_node_index);
+    ASSERT_EQ(DiffEdit::UPDATED, edits[1].type);
+    ASSERT_EQ(DiffEdit::DELETED, edits[2].type);
+    ASSERT_EQ("/arr/value", edits[2].path);
+
+    // a tree does not differ from itself
+    ASSERT_TRUE(diff(a, a).empty());
+
+    // packed elements differ as their array
+    original.pack_arrays(2);
+    revised.pack_arrays(2);
+    edits = diff(SONNodeView(original.root()), SONNodeView(revised.root()));
+    ASSERT_EQ(3, edits.size());
+    ASSERT_EQ(DiffEdit::UPDATED, edits[1].type);
+    ASSERT_EQ("/arr", edits[1].path);
+}
+
+TEST(SON, reset)
+{
+    { // Scope for file buffer to be flushed before reading
+    std::ofstream block_file("reset_data.son");
+    block_file << "key = 3" << std::endl;
+    block_file.close();
+    }
+    std::stringstream errors;
+    DefaultSONInterpreter interpreter(errors);
+    interpreter.enable_line_index();
+    {
+        std::stringstream input;
+        input << "first{ a = 1 }" << std::endl
+              << R"I(`import ('reset_data.son'))I" << std::endl
+              << "bad = ";
+        ASSERT_FALSE(interpreter.parse(input));
+        ASSERT_EQ(1, interpreter.document_count());
+        ASSERT_FALSE(interpreter.error_diagnostics().empty());
+    }
+    interpreter.reset();
+    ASSERT_EQ(0, interpreter.node_count());
+    ASSERT_EQ(0, interpreter.token_count());
+    ASSERT_EQ(0, interpreter.document_count());
+    ASSERT_TRUE(interpreter.error_diagnostics().empty());
+    ASSERT_TRUE(interpreter.root().is_null());
+    ASSERT_TRUE(interpreter.has_line_index());
+
+    std::stringstream input;
+    input << "second = 2" << std::endl << "third{ b = [ 3 4 ] }";
+    ASSERT_TRUE(interpreter.parse(input));
+    std::stringstream paths;
+    interpreter.root().paths(paths);
+    ASSERT_EQ(R"I(/
+/second
+/second/decl (second)
+/second/= (=)
+/second/value (2)
+/third
+/third/decl (third)
+/third/{ ({)
+/third/b
+/third/b/decl (b)
+/third/b/= (=)
+/third/b/[ ([)
+/third/b/value (3)
+/third/b/value (4)
+/third/b/] (])
+/third/} (})
+)I", paths.str());
+    ASSERT_EQ(2, interpreter.line(interpreter.root()
+                                      .first_child_by_name("third")
+                                      .node_index()));
+}
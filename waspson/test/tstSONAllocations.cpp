@@ -0,0 +1,121 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include "waspson/SONInterpreter.h"
+#include "gtest/gtest.h"
+
+using namespace wasp;
+
+// Count all heap allocations made by this test executable
+// Every scalar, array, and sized form is replaced so that each allocation
+// is released by the matching replacement
+static std::atomic<std::size_t> allocation_count(0);
+
+static void* counted_allocation(std::size_t size)
+{
+    ++allocation_count;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size)
+{
+    return counted_allocation(size);
+}
+void* operator new[](std::size_t size)
+{
+    return counted_allocation(size);
+}
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+#if __cpp_sized_deallocation
+void operator delete(void* ptr, std::size_t size) noexcept
+{
+    (void) size; // suppress unused variable warning
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t size) noexcept
+{
+    (void) size; // suppress unused variable warning
+    std::free(ptr);
+}
+#endif
+
+/**
+ * @brief document acquire a document of the given number of objects, each
+ * containing an array and a keyed value
+ */
+std::string document(std::size_t object_count)
+{
+    std::stringstream input;
+    for (std::size_t i = 0; i < object_count; ++i)
+    {
+        input << "obj" << i << "{ a=[ 1 2 3 4 5 ] b=" << i << " }"
+              << std::endl;
+    }
+    return input.str();
+}
+/**
+ * @brief parse_allocations parses the given document
+ * @return the number of heap allocations made by the parse
+ */
+std::size_t parse_allocations(DefaultSONInterpreter& interpreter,
+                              const std::string&     text)
+{
+    std::stringstream input(text);
+    std::size_t       before = allocation_count;
+    EXPECT_TRUE(interpreter.parse(input));
+    return allocation_count - before;
+}
+
+TEST(SON, parse_allocations)
+{
+    const std::size_t     object_count = 20000;
+    DefaultSONInterpreter interpreter;
+    std::size_t allocations =
+        parse_allocations(interpreter, document(object_count));
+    std::cout << "parsed " << object_count << " objects, "
+              << interpreter.node_count() << " nodes, with " << allocations
+              << " allocations ("
+              << static_cast<double>(allocations) / object_count
+              << " per object)" << std::endl;
+    // Child index lists are recycled by the interpreter, leaving only the
+    // amortized growth of the token and node pools
+    ASSERT_LT(allocations, object_count / 10);
+}
+
+TEST(SON, reparse_allocations)
+{
+    const std::size_t     object_count = 20000;
+    std::string           text         = document(object_count);
+    DefaultSONInterpreter interpreter;
+    std::size_t first = parse_allocations(interpreter, text);
+    std::size_t node_count = interpreter.node_count();
+
+    // a reset interpreter retains its pool capacity
+    interpreter.reset();
+    ASSERT_EQ(0, interpreter.node_count());
+    std::size_t second = parse_allocations(interpreter, text);
+    ASSERT_EQ(node_count, interpreter.node_count());
+
+    // a reserved interpreter allocates its pools once
+    DefaultSONInterpreter reserved;
+    reserved.reserve_for_bytes(text.size());
+    std::size_t third = parse_allocations(reserved, text);
+    ASSERT_EQ(node_count, reserved.node_count());
+
+    std::cout << "parsed " << object_count << " objects with " << first
+              << " allocations, " << second << " after reset, and " << third
+              << " after reserving" << std::endl;
+    ASSERT_LT(second, first / 4);
+    ASSERT_LT(third, first / 2);
+}
@@ -13,7 +13,7 @@
 #include "wasphive/HIVE.h"
 #include "waspcore/version.h"
 #include "waspcore/wasp_bug.h"
-#include "waspsiren/SIRENInterpreter.h"
+#include "waspsiren/SIRENQueryCache.h"
 #include "waspsiren/SIRENResultSet.h"
 using namespace std;
 using namespace wasp;
@@ -83,11 +83,12 @@ int main(int argc, char** argv)
         std::stringstream select_statement_errors;
         std::string       select_statement = argv[j];
         std::cout << "Selecting " << select_statement << std::endl;
-        DefaultSIRENInterpreter siren(select_statement_errors);
-        std::string             selection_name =
+        std::string selection_name =
             "selection statement " + std::to_string(j - 2);
-        bool parsed = siren.parseString(select_statement, selection_name);
-        if (!parsed)
+        DefaultSIRENQueryCache::Query siren =
+            DefaultSIRENQueryCache::global().compile(
+                select_statement, select_statement_errors, selection_name);
+        if (!siren)
         {
             std::cout << "Failed to process statement." << std::endl;
             std::cout << select_statement_errors.str() << std::endl;
@@ -100,7 +101,7 @@ int main(int argc, char** argv)
             SIRENResultSet<decltype(context)> results;
             wasp_timer(select_time);
             wasp_timer_start(select_time);
-            siren.evaluate(context, results);
+            siren->evaluate(context, results);
             wasp_timer_stop(select_time);
             wasp_timer_block(std::cout
                              << "Selection Timer (" << select_statement
@@ -108,6 +109,8 @@ int main(int argc, char** argv)
                              << " nanoseconds with " << select_time.intervals()
                              << " invervals" << std::endl);
             select_from_node.clear();
+            // storage for selected parents' data, leaf data is viewed
+            std::string data_buffer;
             for (size_t r = 0; r < results.size(); ++r)
             {
                 auto selected = results.adapted(r);
@@ -117,7 +120,7 @@ int main(int argc, char** argv)
                               << select_statement << "' ----" << std::endl;
 
                 std::cout << r + 1 << ") " << selected.path() << std::endl;
-                std::cout << selected.data() << std::endl;
+                std::cout << selected.data_view(data_buffer) << std::endl;
                 new_select_from.push_back(selected);
             }
         }
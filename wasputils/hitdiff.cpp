@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "waspcore/Diff.h"
+#include "waspcore/version.h"
+#include "waspcore/wasp_bug.h"
+#include "wasphit/HITInterpreter.h"
+#include "wasphit/HITNodeView.h"
+using namespace wasp;
+
+int main(int argc, char* argv[])
+{
+    if (argc == 2 &&
+        (std::string(argv[1]) == "-v" || std::string(argv[1]) == "--version"))
+    {
+        std::cout << wasp_version_info::name << " "
+                  << wasp_version_info::full_version << std::endl;
+        return 0;
+    }
+
+    if (argc != 3)
+    {
+        std::cout << "Workbench Analysis Sequence Processor (HIT)"
+                  << std::endl
+                  << argv[0]
+                  << " : An application for listing the differences between "
+                     "HIT formatted inputs."
+                  << std::endl;
+        std::cout << " Usage : " << argv[0]
+                  << " path/to/original/input path/to/revised/input"
+                  << std::endl
+                  << "Returns 0 if the inputs are equal, 1 if they differ, "
+                     "and 2 if either cannot be parsed"
+                  << std::endl;
+        std::cout << " Usage : " << argv[0]
+                  << " --version\t(print version info)" << std::endl;
+        return 2;
+    }
+    std::stringstream     errors;
+    DefaultHITInterpreter original(errors), revised(errors);
+    for (int j = 1; j < 3; ++j)
+    {
+        DefaultHITInterpreter& interpreter = j == 1 ? original : revised;
+        if (!interpreter.parseFile(argv[j]))
+        {
+            std::cerr << "***Error : Parsing of " << argv[j] << " failed!"
+                      << std::endl
+                      << errors.str() << std::endl;
+            return 2;
+        }
+    }
+    wasp_timer(diff_time);
+    wasp_timer_start(diff_time);
+    std::vector<DiffEdit> edits =
+        diff(HITNodeView(original.root()), HITNodeView(revised.root()));
+    wasp_timer_stop(diff_time);
+    wasp_timer_block(std::cout << "Diff Timer duration: "
+                               << diff_time.duration() << " nanoseconds with "
+                               << diff_time.intervals() << " invervals"
+                               << std::endl);
+    for (const DiffEdit& edit : edits)
+    {
+        std::cout << edit << std::endl;
+    }
+    return edits.empty() ? 0 : 1;
+}
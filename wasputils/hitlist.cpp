@@ -32,10 +32,13 @@ int main(int argc, char* argv[])
                   << " --version\t(print version info)" << std::endl;
         return 1;
     }
+    // reuse the interpreter, retaining its capacity across inputs
+    std::stringstream     errors;
+    DefaultHITInterpreter interpreter(errors);
     for (int j = 1; j < argc; ++j)
     {
-        std::stringstream        errors;
-        DefaultHITInterpreter interpreter(errors);
+        errors.str("");
+        interpreter.reset();
         wasp_timer(parse_time);
         wasp_timer_start(parse_time);
         bool parsed = interpreter.parseFile(argv[j]);
@@ -63,9 +63,11 @@ int main(int argc, char* argv[])
         return -1;
     }
 
+    // reuse the input interpreter, retaining its capacity across inputs
+    DefaultJSONInterpreter input_interp(errors);
     for (int j = 2; j < argcount; ++j)
     {   
-        DefaultJSONInterpreter input_interp(errors);
+        input_interp.reset();
         wasp_timer(parse_input_time);
         wasp_timer_start(parse_input_time);
         bool parsed_input = input_interp.parseFile(argv[j]);
@@ -62,12 +62,16 @@ int main(int argc, char* argv[])
         return -1;
     }
 
+    // documents included by several inputs are interpreted once
+    DocumentCache::instance().set_capacity(256 * 1024 * 1024);
+    // reuse the input interpreter, retaining its capacity across inputs
+    SONInterpreter<
+    TreeNodePool<unsigned int, unsigned int,
+                TokenPool<unsigned int, unsigned int, unsigned int>>>
+    input_interp(errors);
     for (int j = 2; j < argcount; ++j)
     {   
-        SONInterpreter<
-        TreeNodePool<unsigned int, unsigned int,
-                    TokenPool<unsigned int, unsigned int, unsigned int>>>
-        input_interp(errors);
+        input_interp.reset();
         wasp_timer(parse_input_time);
         wasp_timer_start(parse_input_time);
         bool parsed_input = input_interp.parseFile(argv[j]);